@@ -0,0 +1,63 @@
+// benchmarks/bench_bloom.cpp
+// Bloom glow + combine: full-resolution Gaussian vs 8-bit downsample pyramid, by frame size and radius
+#include "effects/bloom.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+using cppengine::effects::Bloom;
+using cppengine::effects::BloomMode;
+using cppengine::effects::BloomOptions;
+
+namespace {
+
+double time_ms(const std::function<void()>& fn, int iterations) {
+    fn();  // warm-up (scratch allocation, page faults)
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+double bloom_ms(const cv::Mat& image, const BloomOptions& options, int iterations) {
+    cv::Mat glow, out;
+    return time_ms([&] {
+        Bloom::glow(image, 0.7f, options, glow);
+        Bloom::combine(image, glow, 0.5f, options, out);
+    }, iterations);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 10;
+    cpp_engine::utils::Logger::instance().set_level(cpp_engine::utils::LogLevel::ERROR);
+
+    std::cout << cv::getNumThreads() << " threads, " << iterations << " iterations\n";
+    std::cout << std::setw(12) << "size" << std::setw(8) << "radius" << std::setw(8) << "levels"
+              << std::setw(14) << "gaussian_ms" << std::setw(14) << "pyramid_ms" << std::setw(10) << "speedup"
+              << "\n";
+
+    for (const cv::Size size : {cv::Size(1920, 1080), cv::Size(3840, 2160)}) {
+        cv::Mat image(size, CV_8UC3);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+        for (int radius : {10, 40, 160}) {
+            BloomOptions gaussian, pyramid;
+            gaussian.mode = BloomMode::GAUSSIAN;
+            gaussian.radius = pyramid.radius = radius;
+            const double gaussian_time = bloom_ms(image, gaussian, iterations);
+            const double pyramid_time = bloom_ms(image, pyramid, iterations);
+            std::cout << std::setw(12) << (std::to_string(size.width) + "x" + std::to_string(size.height))
+                      << std::setw(8) << radius << std::setw(8) << Bloom::pyramid_levels(radius, size.height, size.width)
+                      << std::setw(14) << std::fixed << std::setprecision(2) << gaussian_time
+                      << std::setw(14) << pyramid_time
+                      << std::setw(9) << gaussian_time / pyramid_time << "x\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+// benchmarks/bench_generator_api.cpp
+// Per-request cost of a generated image served from memory (render + encode) against what the
+// subprocess path adds: the encode written to a file and read back, and a process spawn
+// (fork + exec of argv[2], /bin/true by default, so a lower bound for the generator binary)
+#include "generators/image_generator.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using cpp_engine::generators::ImageGenerator;
+using cpp_engine::generators::ImageRequest;
+using cpp_engine::generators::ProceduralKind;
+using cppengine::optimization::EncodeOptions;
+using cppengine::optimization::ImageEncoder;
+
+namespace {
+
+double time_ms(const std::function<void()>& fn, int iterations) {
+    fn();  // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+void spawn(const std::string& program) {
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        ::execl(program.c_str(), program.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    int status = 0;
+    if (pid > 0) ::waitpid(pid, &status, 0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 5;
+    const std::string program = argc > 2 ? argv[2] : "/bin/true";
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_generator_api.png").string();
+    const ImageGenerator generator;
+    volatile size_t sink = 0;
+
+    std::cout << iterations << " iterations, spawning " << program << "\n";
+    std::cout << std::setw(11) << "size" << std::setw(11) << "kind" << std::setw(11) << "render_ms"
+              << std::setw(12) << "memory_ms" << std::setw(12) << "file_ms" << std::setw(11) << "spawn_ms"
+              << std::setw(13) << "saved_ms" << "\n";
+    const double spawn_ms = time_ms([&] { spawn(program); }, iterations);
+
+    for (int side : {256, 512, 1024}) {
+        for (ProceduralKind kind : {ProceduralKind::PERLIN, ProceduralKind::METALLIC}) {
+            ImageRequest request;
+            request.kind = kind;
+            request.width = side;
+            request.height = side;
+            request.seed = 42;
+            cv::Mat image;
+            const double render_ms = time_ms([&] { generator.render(request, image); }, iterations);
+            std::vector<unsigned char> bytes;
+            const double memory_ms = time_ms([&] {
+                generator.encode(request, "png", bytes);
+                sink = sink + bytes.size();
+            }, iterations);
+            // What the subprocess path does besides spawning: render, encode to a file, read it back
+            const double file_ms = time_ms([&] {
+                generator.render(request, image);
+                ImageEncoder::write(path, image, EncodeOptions());
+                std::ifstream in(path, std::ios::binary);
+                bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+                sink = sink + bytes.size();
+            }, iterations);
+
+            std::cout << std::setw(11) << (std::to_string(side) + "x" + std::to_string(side)) << std::setw(11)
+                      << cpp_engine::generators::ProceduralGenerator::kind_name(kind) << std::fixed
+                      << std::setprecision(2) << std::setw(11) << render_ms << std::setw(12) << memory_ms
+                      << std::setw(12) << file_ms << std::setw(11) << spawn_ms << std::setw(13)
+                      << file_ms + spawn_ms - memory_ms << "\n";
+        }
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,92 @@
+// benchmarks/bench_image_sequence.cpp
+// Image-to-video assembly fps: a sequential imread + cv::resize + cv::VideoWriter loop against
+// VideoGenerator::generate_video_from_images at increasing decoder counts. The inputs are 1080p
+// JPEGs scaled to 720p, so decoding and resizing dominate until the encoder becomes the bottleneck
+#include "generators/procedural_video.h"
+#include "generators/video_generator.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using cpp_engine::generators::ImageSequenceOptions;
+using cpp_engine::generators::ImageSequenceStats;
+using cpp_engine::generators::ProceduralKind;
+using cpp_engine::generators::ProceduralVideo;
+using cpp_engine::generators::VideoEncoderOptions;
+using cpp_engine::generators::VideoGenerator;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void report(const std::string& name, int frames, double seconds) {
+    std::cout << std::setw(40) << name << std::fixed << std::setprecision(1) << std::setw(10) << frames / seconds
+              << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int frames = argc > 1 ? std::stoi(argv[1]) : 240;
+    const int out_width = 1280, out_height = 720;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "bench_image_sequence";
+    std::filesystem::create_directories(dir);
+
+    // A cycle of distinct 1080p frames written as separate files, so every image is read and decoded
+    const ProceduralVideo video;
+    std::vector<cv::Mat> cycle(8);
+    for (int i = 0; i < static_cast<int>(cycle.size()); ++i) {
+        video.render_frame(ProceduralKind::PERLIN, 1920, 1080, 7, i * 4, cycle[i]);
+    }
+    std::vector<std::string> paths;
+    for (int i = 0; i < frames; ++i) {
+        paths.push_back((dir / ("frame_" + std::to_string(i) + ".jpg")).string());
+        cv::imwrite(paths.back(), cycle[i % cycle.size()]);
+    }
+
+    VideoEncoderOptions video_options;
+    video_options.codec = "mjpeg";  // cheap to encode, keeps the input side visible
+    const int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::cout << frames << " JPEGs 1920x1080 -> " << out_width << "x" << out_height << ", " << hardware
+              << " hardware threads\n";
+    std::cout << std::setw(40) << "path" << std::setw(10) << "fps" << "\n";
+
+    {
+        const std::string output = (dir / "sequential.avi").string();
+        const auto start = Clock::now();
+        cv::VideoWriter writer(output, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), 30.0,
+                               cv::Size(out_width, out_height));
+        cv::Mat scaled;
+        for (const std::string& path : paths) {
+            cv::resize(cv::imread(path), scaled, cv::Size(out_width, out_height), 0, 0, cv::INTER_AREA);
+            writer.write(scaled);
+        }
+        writer.release();
+        report("imread + resize + VideoWriter", frames, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    VideoGenerator generator;
+    generator.set_video_options(video_options);
+    std::vector<int> decoder_counts;
+    for (int decoders = 1; decoders < hardware; decoders *= 2) decoder_counts.push_back(decoders);
+    decoder_counts.push_back(hardware);
+    for (int decoders : decoder_counts) {
+        ImageSequenceOptions options;
+        options.width = out_width;
+        options.height = out_height;
+        options.decoders = decoders;
+        ImageSequenceStats stats;
+        if (!generator.generate_video_from_images(paths, (dir / "pipeline.avi").string(), options, &stats)) continue;
+        report("generate_video_from_images " + std::to_string(decoders) + " decoders", stats.frames, stats.seconds);
+    }
+    std::filesystem::remove_all(dir);
+    return 0;
+}
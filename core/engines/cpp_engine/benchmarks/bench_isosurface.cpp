@@ -0,0 +1,56 @@
+// benchmarks/bench_isosurface.cpp
+// Marching cubes over a noise-displaced sphere per resolution: time, output size, the slab working
+// set against what holding the sampled volume would take, and the process peak RSS so far
+// (resolutions run in increasing order, so each row's peak belongs to that resolution)
+#include "generators/isosurface.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <sys/resource.h>
+
+using cpp_engine::generators::IsosurfaceExtractor;
+using cpp_engine::generators::IsosurfaceOptions;
+using cpp_engine::generators::Mesh;
+
+namespace {
+
+double peak_rss_mb() {
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;  // kilobytes on Linux
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int max_resolution = argc > 1 ? std::stoi(argv[1]) : 512;
+    const auto field = IsosurfaceExtractor::displaced_sphere(0.7f, 0.15f, 2.0f, 42);
+
+    std::cout << cv::getNumThreads() << " threads\n";
+    std::cout << std::setw(7) << "cells" << std::setw(11) << "ms" << std::setw(12) << "triangles" << std::setw(11)
+              << "mesh_MB" << std::setw(13) << "working_MB" << std::setw(12) << "volume_MB" << std::setw(10)
+              << "seams" << std::setw(13) << "peak_rss_MB" << "\n";
+    for (int resolution = 64; resolution <= max_resolution; resolution *= 2) {
+        IsosurfaceOptions options;
+        options.resolution = resolution;
+        Mesh mesh;
+        IsosurfaceExtractor::Stats stats;
+        const auto start = std::chrono::steady_clock::now();
+        IsosurfaceExtractor::extract(field, options, mesh, &stats);
+        const double ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const double mesh_mb = (mesh.positions.size() + mesh.normals.size()) * sizeof(float) / 1e6 +
+                               mesh.indices.size() * sizeof(uint32_t) / 1e6;
+        const double samples = resolution + 1.0;
+        std::cout << std::setw(7) << resolution << std::fixed << std::setprecision(1) << std::setw(11) << ms
+                  << std::setw(12) << mesh.triangle_count() << std::setw(11) << mesh_mb << std::setw(13)
+                  << stats.peak_working_bytes / 1e6 << std::setw(12) << samples * samples * samples * 4 / 1e6
+                  << std::setw(10) << stats.seam_vertices << std::setw(13) << peak_rss_mb() << "\n";
+    }
+    return 0;
+}
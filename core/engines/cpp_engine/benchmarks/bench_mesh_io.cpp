@@ -0,0 +1,116 @@
+// benchmarks/bench_mesh_io.cpp
+// Sphere tessellation on one thread and on all of them, then each mesh format's write (encode +
+// one file write) and read (load + parse) next to the original exporter's ofstream OBJ
+#include "generators/mesh_io.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using cpp_engine::generators::Mesh;
+using cpp_engine::generators::MeshFormat;
+using cpp_engine::generators::MeshIO;
+using cpp_engine::generators::MeshTessellator;
+using cpp_engine::generators::SphereOptions;
+
+namespace {
+
+double time_ms(const std::function<void()>& fn, int iterations) {
+    fn();  // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+// The exporter before MeshIO: one formatted stream insertion per value
+void write_obj_stream(const std::string& path, const Mesh& mesh) {
+    std::ofstream out(path);
+    for (size_t v = 0; v < mesh.vertex_count(); ++v) {
+        const float* p = mesh.positions.data() + v * 3;
+        out << "v " << p[0] << " " << p[1] << " " << p[2] << "\n";
+    }
+    for (size_t t = 0; t < mesh.triangle_count(); ++t) {
+        const uint32_t* f = mesh.indices.data() + t * 3;
+        out << "f " << f[0] + 1 << " " << f[1] + 1 << " " << f[2] + 1 << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 3;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "bench_mesh_io";
+    const int threads = cv::getNumThreads();
+    volatile size_t sink = 0;
+
+    std::cout << iterations << " iterations, " << threads << " threads\n";
+    std::cout << std::setw(11) << "sphere" << std::setw(11) << "triangles" << std::setw(14) << "tess_1t_ms"
+              << std::setw(14) << "tess_all_ms" << std::setw(14) << "displaced_ms" << "\n";
+    for (int latitude : {128, 512, 1024}) {
+        SphereOptions options;
+        options.latitude = latitude;
+        options.longitude = latitude * 2;
+        Mesh mesh;
+        cv::setNumThreads(1);
+        const double serial_ms = time_ms([&] { MeshTessellator::sphere(options, mesh); }, iterations);
+        cv::setNumThreads(threads);
+        const double parallel_ms = time_ms([&] { MeshTessellator::sphere(options, mesh); }, iterations);
+        options.displacement = 0.1f;
+        const double displaced_ms = time_ms([&] { MeshTessellator::sphere(options, mesh); }, iterations);
+        std::cout << std::setw(11) << (std::to_string(latitude) + "x" + std::to_string(latitude * 2))
+                  << std::setw(11) << mesh.triangle_count() << std::fixed << std::setprecision(2) << std::setw(14)
+                  << serial_ms << std::setw(14) << parallel_ms << std::setw(14) << displaced_ms << "\n";
+    }
+
+    std::cout << "\n" << std::setw(11) << "sphere" << std::setw(12) << "format" << std::setw(11) << "MB"
+              << std::setw(12) << "write_ms" << std::setw(11) << "read_ms" << "\n";
+    for (int latitude : {128, 512, 1024}) {
+        SphereOptions options;
+        options.latitude = latitude;
+        options.longitude = latitude * 2;
+        options.displacement = 0.1f;
+        Mesh mesh, loaded;
+        MeshTessellator::sphere(options, mesh);
+        const std::string label = std::to_string(latitude) + "x" + std::to_string(latitude * 2);
+        auto report = [&](const std::string& format, const std::string& path, double write_ms, double read_ms) {
+            std::cout << std::setw(11) << label << std::setw(12) << format << std::fixed << std::setprecision(2)
+                      << std::setw(11) << std::filesystem::file_size(path) / 1e6 << std::setw(12) << write_ms
+                      << std::setw(11) << read_ms << "\n";
+        };
+
+        // The stream exporter writes positions only, so it is compared against MeshIO's normal-free OBJ
+        Mesh flat = mesh;
+        flat.normals.clear();
+        const std::string stream_path = (dir / "stream.obj").string();
+        std::filesystem::create_directories(dir);
+        const double stream_ms = time_ms([&] { write_obj_stream(stream_path, flat); }, iterations);
+        const double stream_read_ms = time_ms([&] {
+            MeshIO::read(stream_path, loaded);
+            sink = sink + loaded.indices.size();
+        }, iterations);
+        report("obj-stream", stream_path, stream_ms, stream_read_ms);
+
+        for (const char* name : {"flat.obj", "mesh.obj", "mesh.ply", "mesh.glb"}) {
+            const std::string path = (dir / name).string();
+            const Mesh& source = name[0] == 'f' ? flat : mesh;
+            const double write_ms = time_ms([&] { MeshIO::write(path, source); }, iterations);
+            const double read_ms = time_ms([&] {
+                MeshIO::read(path, loaded);
+                sink = sink + loaded.indices.size();
+            }, iterations);
+            MeshFormat format;
+            MeshIO::format_for(path, format);
+            report(std::string(MeshIO::format_name(format)) + (source.has_normals() ? "+n" : ""), path, write_ms,
+                   read_ms);
+        }
+    }
+    std::filesystem::remove_all(dir);
+    return 0;
+}
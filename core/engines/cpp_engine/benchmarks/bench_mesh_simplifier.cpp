@@ -0,0 +1,50 @@
+// benchmarks/bench_mesh_simplifier.cpp
+// Quadric decimation of a noise-displaced UV sphere (about 5M triangles by default) to 10% and 1%,
+// with the queue alone and behind the parallel clustering pre-pass
+#include "generators/mesh_simplifier.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using cpp_engine::generators::Mesh;
+using cpp_engine::generators::MeshSimplifier;
+using cpp_engine::generators::MeshTessellator;
+using cpp_engine::generators::SimplifyOptions;
+using cpp_engine::generators::SphereOptions;
+
+int main(int argc, char* argv[]) {
+    const int latitude = argc > 1 ? std::stoi(argv[1]) : 1120;
+    SphereOptions sphere;
+    sphere.latitude = latitude;
+    sphere.longitude = latitude * 2;
+    sphere.displacement = 0.1f;
+    sphere.seed = 42;
+    Mesh input;
+    MeshTessellator::sphere(sphere, input);
+
+    std::cout << cv::getNumThreads() << " threads, " << input.triangle_count() << " input triangles\n";
+    std::cout << std::setw(10) << "target" << std::setw(10) << "cluster" << std::setw(12) << "clustered"
+              << std::setw(10) << "output" << std::setw(11) << "ms" << std::setw(12) << "max_error" << "\n";
+    for (size_t divisor : {10, 100}) {
+        for (bool cluster : {false, true}) {
+            SimplifyOptions options;
+            options.target_triangles = input.triangle_count() / divisor;
+            options.cluster_above = cluster ? 1000000 : 0;
+            Mesh output;
+            MeshSimplifier::Stats stats;
+            const auto start = std::chrono::steady_clock::now();
+            MeshSimplifier::simplify(input, options, output, &stats);
+            const double ms =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout << std::setw(10) << options.target_triangles << std::setw(10) << (cluster ? "yes" : "no")
+                      << std::setw(12) << stats.clustered_triangles << std::setw(10) << stats.output_triangles
+                      << std::fixed << std::setprecision(1) << std::setw(11) << ms << std::setprecision(5)
+                      << std::setw(12) << stats.max_error << "\n";
+        }
+    }
+    return 0;
+}
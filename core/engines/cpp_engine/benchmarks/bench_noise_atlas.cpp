@@ -0,0 +1,97 @@
+// benchmarks/bench_noise_atlas.cpp
+// Noise atlas cache: build and map cost per key, then fBm rows in megapixels/s evaluated with
+// fractal_row() vs sampled from the mmap'd float16 atlas (whole pixels and bilinear offsets)
+#include "generators/noise_atlas.h"
+#include "generators/perlin_noise.h"
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using cpp_engine::generators::FractalParams;
+using cpp_engine::generators::NoiseAtlasKey;
+using cpp_engine::generators::NoiseAtlasOptions;
+using cpp_engine::generators::NoiseAtlasStore;
+using cpp_engine::generators::PerlinNoise;
+
+namespace {
+
+double time_ms(const std::function<void()>& fn, int iterations) {
+    fn();  // warm-up (scratch allocation, page faults)
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+double once_ms(const std::function<void()>& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 3;
+    NoiseAtlasOptions options;
+    options.directory = (std::filesystem::temp_directory_path() / "bench_noise_atlas").string();
+    std::filesystem::remove_all(options.directory);
+    const float scale = 0.01f;
+
+    std::cout << "path " << PerlinNoise::simd_path() << ", atlas " << options.size << " requested, "
+              << iterations << " iterations\n";
+    std::cout << std::setw(12) << "size" << std::setw(9) << "octaves" << std::setw(10) << "build_ms"
+              << std::setw(9) << "map_ms" << std::setw(12) << "eval_mp_s" << std::setw(13) << "atlas_mp_s"
+              << std::setw(10) << "speedup" << std::setw(14) << "bilinear_mp_s" << "\n";
+
+    volatile double sink = 0.0;
+    for (int octaves : {4, 8}) {
+        FractalParams params;
+        params.octaves = octaves;
+        const NoiseAtlasKey key{42, octaves, params.persistence, scale};
+        // Cold: render + write + map; warm: a fresh store maps the existing file
+        const double build_ms = once_ms([&] { NoiseAtlasStore(options).get(key); });
+        NoiseAtlasStore store(options);
+        std::shared_ptr<const cpp_engine::generators::NoiseAtlas> atlas;
+        const double map_ms = once_ms([&] { atlas = store.get(key); });
+        if (!atlas) {
+            std::cerr << "atlas build failed in " << options.directory << "\n";
+            return 1;
+        }
+        const PerlinNoise noise(42);
+
+        for (const auto& size : {std::make_pair(1920, 1080), std::make_pair(3840, 2160)}) {
+            const int width = size.first, height = size.second;
+            const double megapixels = width * static_cast<double>(height) / 1e6;
+            std::vector<float> row(width);
+            const double eval_ms = time_ms([&] {
+                for (int y = 0; y < height; ++y) {
+                    noise.fractal_row(0.0f, static_cast<float>(y), width, scale, params, row.data());
+                }
+                sink = sink + row[0];
+            }, iterations);
+            const double atlas_ms = time_ms([&] {
+                for (int y = 0; y < height; ++y) atlas->sample_row(0.0f, static_cast<float>(y), width, row.data());
+                sink = sink + row[0];
+            }, iterations);
+            const double bilinear_ms = time_ms([&] {
+                for (int y = 0; y < height; ++y) atlas->sample_row(0.5f, y + 0.5f, width, row.data());
+                sink = sink + row[0];
+            }, iterations);
+
+            std::cout << std::setw(12) << (std::to_string(width) + "x" + std::to_string(height))
+                      << std::setw(9) << octaves << std::setw(10) << std::fixed << std::setprecision(1) << build_ms
+                      << std::setw(9) << std::setprecision(2) << map_ms << std::setw(12) << std::setprecision(1)
+                      << megapixels / (eval_ms / 1000.0) << std::setw(13) << megapixels / (atlas_ms / 1000.0)
+                      << std::setw(9) << eval_ms / atlas_ms << "x" << std::setw(14)
+                      << megapixels / (bilinear_ms / 1000.0) << "\n";
+        }
+    }
+    std::filesystem::remove_all(options.directory);
+    return 0;
+}
@@ -0,0 +1,100 @@
+// benchmarks/bench_procedural.cpp
+// Tiled procedural generators by image size and thread count, then animated video frames/s by render
+// threads; checks every thread count gives the same pixels
+#include "generators/procedural_generator.h"
+#include "generators/procedural_video.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using cpp_engine::generators::ProceduralGenerator;
+using cpp_engine::generators::ProceduralKind;
+using cpp_engine::generators::ProceduralVideo;
+using cpp_engine::generators::ProceduralVideoOptions;
+
+namespace {
+
+double time_ms(const std::function<void()>& fn, int iterations) {
+    fn();  // warm-up (pool threads, page faults)
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 3;
+    cpp_engine::utils::Logger::instance().set_level(cpp_engine::utils::LogLevel::ERROR);
+    const int cpus = cv::getNumberOfCPUs();
+    std::vector<int> thread_counts;
+    for (int t = 1; t < cpus; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(cpus);
+
+    std::cout << cpus << " cpus, " << iterations << " iterations\n";
+    std::cout << std::setw(12) << "kind" << std::setw(12) << "size" << std::setw(9) << "threads"
+              << std::setw(12) << "ms" << std::setw(10) << "mp_s" << std::setw(10) << "scaling"
+              << std::setw(11) << "identical" << "\n";
+
+    const ProceduralGenerator generator;
+    for (ProceduralKind kind : {ProceduralKind::PERLIN, ProceduralKind::SILHOUETTE, ProceduralKind::METALLIC}) {
+        for (const cv::Size size : {cv::Size(1920, 1080), cv::Size(3840, 2160), cv::Size(7680, 4320)}) {
+            cv::Mat reference, image;
+            double single_ms = 0.0;
+            for (int threads : thread_counts) {
+                cv::setNumThreads(threads);
+                const double ms = time_ms([&] { generator.generate(kind, size.width, size.height, 42, image); },
+                                          iterations);
+                if (threads == 1) {
+                    single_ms = ms;
+                    reference = image.clone();
+                }
+                const bool identical = cv::norm(image, reference, cv::NORM_INF) == 0.0;
+                std::cout << std::setw(12) << ProceduralGenerator::kind_name(kind)
+                          << std::setw(12) << (std::to_string(size.width) + "x" + std::to_string(size.height))
+                          << std::setw(9) << threads << std::setw(12) << std::fixed << std::setprecision(1) << ms
+                          << std::setw(10) << size.area() / ms / 1000.0
+                          << std::setw(9) << std::setprecision(2) << single_ms / ms << "x"
+                          << std::setw(11) << (identical ? "yes" : "NO") << "\n";
+            }
+        }
+    }
+    cv::setNumThreads(-1);
+
+    // Video: whole frames in parallel, delivered in order to a sink that only checksums
+    const int frames = 48;
+    std::cout << "\nvideo, 1920x1080, " << frames << " frames\n";
+    std::cout << std::setw(12) << "kind" << std::setw(9) << "threads" << std::setw(10) << "fps"
+              << std::setw(10) << "scaling" << std::setw(11) << "identical" << "\n";
+    for (ProceduralKind kind : {ProceduralKind::PERLIN, ProceduralKind::SILHOUETTE, ProceduralKind::METALLIC}) {
+        double single_fps = 0.0;
+        double reference_sum = 0.0;
+        for (int threads : thread_counts) {
+            ProceduralVideoOptions options;
+            options.render_threads = threads;
+            ProceduralVideo video(options);
+            double sum = 0.0;
+            video.render(kind, 1920, 1080, frames, 42, [&](int index, const cv::Mat& frame) {
+                sum += (index + 1) * cv::sum(frame)[0];
+                return true;
+            });
+            if (threads == 1) {
+                single_fps = video.stats().fps();
+                reference_sum = sum;
+            }
+            std::cout << std::setw(12) << ProceduralGenerator::kind_name(kind) << std::setw(9) << threads
+                      << std::setw(10) << std::setprecision(1) << video.stats().fps()
+                      << std::setw(9) << std::setprecision(2) << video.stats().fps() / single_fps << "x"
+                      << std::setw(11) << (sum == reference_sum ? "yes" : "NO") << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+// benchmarks/bench_resize.cpp
+// Thumbnail cost: full decode + cv::resize vs DCT-scaled decode + Resampler, and pyramid outputs
+#include "filters/image_filter.h"
+#include "filters/resample.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using cppengine::filters::ImageFilter;
+using cppengine::filters::ResizeKernel;
+
+namespace {
+
+double time_ms(const std::function<void()>& fn, int iterations) {
+    fn();  // warm-up (scratch allocation, page faults)
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int width = argc > 1 ? std::stoi(argv[1]) : 6000;   // 24 MP by default
+    const int height = argc > 2 ? std::stoi(argv[2]) : 4000;
+    const int iterations = argc > 3 ? std::stoi(argv[3]) : 3;
+
+    // Smooth content so the JPEG looks like a photo rather than noise
+    cv::Mat image(height / 8, width / 8, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    cv::resize(image, image, cv::Size(width, height), 0, 0, cv::INTER_CUBIC);
+    std::vector<unsigned char> jpeg;
+    cv::imencode(".jpg", image, jpeg, {cv::IMWRITE_JPEG_QUALITY, 90});
+
+    ImageFilter filter;
+    cv::Mat decoded, thumb;
+    std::cout << "source " << width << "x" << height << " JPEG " << jpeg.size() / 1024 << " KiB, "
+              << iterations << " iterations\n";
+    std::cout << std::setw(8) << "target" << std::setw(10) << "kernel" << std::setw(16) << "full+cv_ms"
+              << std::setw(16) << "full+ours_ms" << std::setw(16) << "reduced_ms" << std::setw(10) << "speedup" << "\n";
+
+    for (int target : {2048, 1024, 512, 256}) {
+        for (ResizeKernel kernel : {ResizeKernel::AREA, ResizeKernel::LANCZOS3}) {
+            const int cv_interp = kernel == ResizeKernel::AREA ? cv::INTER_AREA : cv::INTER_LANCZOS4;
+            const int target_h = static_cast<int>(static_cast<int64_t>(height) * target / width);
+            const double baseline = time_ms([&] {
+                decoded = cv::imdecode(jpeg, cv::IMREAD_COLOR);
+                cv::resize(decoded, thumb, cv::Size(target, target_h), 0, 0, cv_interp);
+            }, iterations);
+            const double full = time_ms([&] {
+                decoded = cv::imdecode(jpeg, cv::IMREAD_COLOR);
+                filter.resize(decoded, thumb, target, 0, kernel);
+            }, iterations);
+            const double reduced = time_ms([&] {
+                ImageFilter::decode_for_size(jpeg, target, 0, decoded);
+                filter.resize(decoded, thumb, target, 0, kernel);
+            }, iterations);
+            std::cout << std::setw(8) << target << std::setw(10) << (kernel == ResizeKernel::AREA ? "area" : "lanczos")
+                      << std::setw(16) << std::fixed << std::setprecision(2) << baseline
+                      << std::setw(16) << full << std::setw(16) << reduced
+                      << std::setw(9) << std::setprecision(1) << (baseline / reduced) << "x\n";
+        }
+    }
+
+    const std::vector<int> widths = {1024, 512, 256, 128};
+    std::vector<cv::Mat> levels;
+    const double separate = time_ms([&] {
+        for (int w : widths) {
+            ImageFilter::decode_for_size(jpeg, w, 0, decoded);
+            filter.resize(decoded, thumb, w, 0, ResizeKernel::LANCZOS3);
+        }
+    }, iterations);
+    const double pyramid = time_ms([&] {
+        ImageFilter::decode_for_size(jpeg, widths.front(), 0, decoded);
+        filter.pyramid(decoded, levels, widths, ResizeKernel::LANCZOS3);
+    }, iterations);
+    std::cout << "pyramid 1024,512,256,128 lanczos: separate decodes " << std::setprecision(2) << separate
+              << " ms, one decode " << pyramid << " ms\n";
+    return 0;
+}
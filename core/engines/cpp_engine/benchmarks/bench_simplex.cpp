@@ -0,0 +1,88 @@
+// benchmarks/bench_simplex.cpp
+// Simplex vs Perlin fBm rows in megapixels/s across dimensions and octave counts, values only and
+// with the analytic gradient; 4D exists only as simplex (the looping-video field)
+#include "generators/perlin_noise.h"
+#include "generators/simplex_noise.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using cpp_engine::generators::FractalParams;
+using cpp_engine::generators::PerlinNoise;
+using cpp_engine::generators::SimplexNoise;
+
+namespace {
+
+double time_ms(const std::function<void()>& fn, int iterations) {
+    fn();  // warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::stoi(argv[1]) : 3;
+    const int width = 1920, height = 1080;
+    const double megapixels = width * static_cast<double>(height) / 1e6;
+    const float scale = 0.01f, z = 0.37f, w = 1.3f;
+    const PerlinNoise perlin(42);
+    const SimplexNoise simplex(42);
+    std::vector<float> row(width), dx(width), dy(width);
+    volatile double sink = 0.0;
+
+    // Every (x0, y) -> row call, run over a full frame
+    auto frame = [&](const std::function<void(float)>& fn) {
+        return [&, fn] {
+            for (int y = 0; y < height; ++y) fn(static_cast<float>(y));
+            sink = sink + row[0];
+        };
+    };
+
+    std::cout << "perlin " << PerlinNoise::simd_path() << ", simplex " << SimplexNoise::simd_path() << ", "
+              << width << "x" << height << ", " << iterations << " iterations\n";
+    std::cout << std::setw(5) << "dim" << std::setw(9) << "octaves" << std::setw(10) << "gradient"
+              << std::setw(11) << "perlin" << std::setw(11) << "simplex" << std::setw(10) << "ratio" << "\n";
+
+    for (int octaves : {1, 4, 8}) {
+        FractalParams params;
+        params.octaves = octaves;
+        for (bool gradient : {false, true}) {
+            float* gx = gradient ? dx.data() : nullptr;
+            float* gy = gradient ? dy.data() : nullptr;
+            for (int dim : {2, 3, 4}) {
+                double perlin_ms = 0.0;
+                if (dim == 2) {
+                    perlin_ms = time_ms(frame([&](float y) {
+                        if (gradient) perlin.fractal_row_gradient(0.0f, y, width, scale, params, row.data(), gx, gy);
+                        else perlin.fractal_row(0.0f, y, width, scale, params, row.data());
+                    }), iterations);
+                } else if (dim == 3) {
+                    perlin_ms = time_ms(frame([&](float y) {
+                        perlin.fractal_row_3d(0.0f, y, z, width, scale, params, row.data(), gx, gy);
+                    }), iterations);
+                }
+                const double simplex_ms = time_ms(frame([&](float y) {
+                    if (dim == 2) simplex.fractal_row(0.0f, y, width, scale, params, row.data(), gx, gy);
+                    else if (dim == 3) simplex.fractal_row_3d(0.0f, y, z, width, scale, params, row.data(), gx, gy);
+                    else simplex.fractal_row_4d(0.0f, y, z, w, width, scale, params, row.data(), gx, gy);
+                }), iterations);
+
+                std::cout << std::setw(5) << dim << std::setw(9) << octaves << std::setw(10)
+                          << (gradient ? "yes" : "no") << std::fixed << std::setprecision(1);
+                if (perlin_ms > 0.0) std::cout << std::setw(11) << megapixels / (perlin_ms / 1000.0);
+                else std::cout << std::setw(11) << "-";
+                std::cout << std::setw(11) << megapixels / (simplex_ms / 1000.0);
+                if (perlin_ms > 0.0) std::cout << std::setw(9) << std::setprecision(2) << perlin_ms / simplex_ms << "x";
+                std::cout << "\n";
+            }
+        }
+    }
+    return 0;
+}
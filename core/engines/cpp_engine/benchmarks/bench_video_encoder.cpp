@@ -0,0 +1,92 @@
+// benchmarks/bench_video_encoder.cpp
+// Encode fps of pre-rendered 1080p procedural frames: the old inline cv::VideoWriter mp4v loop
+// against VideoEncoder (queued encoder thread; with libavcodec, threaded mpeg4 and x264 at two
+// presets). Rendering is excluded, so the numbers are the encoder's ceiling
+#include "generators/procedural_video.h"
+#include "generators/video_encoder.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using cpp_engine::generators::ProceduralKind;
+using cpp_engine::generators::ProceduralVideo;
+using cpp_engine::generators::VideoEncoder;
+using cpp_engine::generators::VideoEncoderOptions;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void report(const std::string& name, int frames, double seconds, const std::string& path) {
+    std::error_code error;
+    const auto bytes = std::filesystem::file_size(path, error);
+    std::cout << std::setw(52) << name << std::fixed << std::setprecision(1) << std::setw(10) << frames / seconds
+              << std::setw(10) << (error ? 0.0 : bytes / 1048576.0) << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int frames = argc > 1 ? std::stoi(argv[1]) : 120;
+    const int width = argc > 2 ? std::stoi(argv[2]) : 1920;
+    const int height = argc > 3 ? std::stoi(argv[3]) : 1080;
+    const double fps = 30.0;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "bench_video_encoder";
+    std::filesystem::create_directories(dir);
+
+    // A short cycle of distinct frames; frames are only read, so the same Mats can be queued repeatedly
+    const ProceduralVideo video;
+    std::vector<cv::Mat> cycle(8);
+    for (int i = 0; i < static_cast<int>(cycle.size()); ++i) {
+        video.render_frame(ProceduralKind::PERLIN, width, height, 42, i * 4, cycle[i]);
+    }
+
+    std::cout << frames << " frames " << width << "x" << height << ", " << cv::getNumThreads() << " threads, "
+              << (VideoEncoder::libavcodec_available() ? "libavcodec" : "no libavcodec") << "\n";
+    std::cout << std::setw(52) << "path" << std::setw(10) << "fps" << std::setw(10) << "MB" << "\n";
+
+    {
+        const std::string path = (dir / "videowriter_mp4v.mp4").string();
+        cv::VideoWriter writer(path, cv::VideoWriter::fourcc('m', 'p', '4', 'v'), fps, cv::Size(width, height));
+        const auto start = Clock::now();
+        for (int i = 0; i < frames; ++i) writer.write(cycle[i % cycle.size()]);
+        writer.release();
+        report("cv::VideoWriter mp4v (inline)", frames, seconds_since(start), path);
+    }
+
+    struct Case {
+        std::string name;
+        std::string codec;
+        std::string preset;
+    };
+    const std::vector<Case> cases = {
+        {"VideoEncoder mp4v", "mp4v", ""},
+        {"VideoEncoder h264 veryfast crf23", "h264", "veryfast"},
+        {"VideoEncoder h264 ultrafast crf23", "h264", "ultrafast"},
+    };
+    for (const Case& c : cases) {
+        VideoEncoderOptions options;
+        options.codec = c.codec;
+        options.preset = c.preset;
+        const std::string path = (dir / (c.codec + (c.preset.empty() ? "" : "_" + c.preset) + ".mp4")).string();
+        VideoEncoder encoder;
+        const auto start = Clock::now();
+        if (!encoder.open(path, width, height, fps, options)) continue;
+        for (int i = 0; i < frames; ++i) encoder.write(cycle[i % cycle.size()]);
+        encoder.close();
+        report(c.name + " [" + VideoEncoder::backend_name(encoder.backend()) + "]", frames, seconds_since(start),
+               path);
+    }
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,45 @@
+#ifndef CPP_ENGINE_EFFECTS_BLOOM_H
+#define CPP_ENGINE_EFFECTS_BLOOM_H
+
+#include <string>
+
+namespace cv { class Mat; }
+
+namespace cppengine {
+namespace effects {
+
+enum class BloomMode {
+    GAUSSIAN,  // full-resolution float blur, kernel 2 * radius + 1 (the original bloom)
+    PYRAMID    // 8-bit mip chain of half-size blurs, additive upsampling
+};
+
+struct BloomOptions {
+    BloomMode mode = BloomMode::PYRAMID;
+    int radius = 10;  // glow reach in pixels; GAUSSIAN cost grows with it, PYRAMID adds a level per doubling
+};
+
+/**
+ * Bloom - Bright-pass glow shared by EffectsEngine::apply_bloom and the parameter sweep
+ * glow() depends only on the threshold, so sweeps over intensity reuse it.
+ * PYRAMID: threshold in 8 bits, pyrDown per level, pyrUp + add back to
+ * half size, one final pyrUp to full size; cost stays near one
+ * full-resolution pass whatever the radius.
+ */
+class Bloom {
+public:
+    // "gaussian" | "pyramid"
+    static bool parse_mode(const std::string& name, BloomMode& mode);
+
+    // Number of half-size levels for a radius, bounded by the image size
+    static int pyramid_levels(int radius, int rows, int cols);
+
+    // GAUSSIAN: CV_32FC3 in [0, 1]; PYRAMID: CV_8UC3
+    static void glow(const cv::Mat& image, float threshold, const BloomOptions& options, cv::Mat& glow);
+    static void combine(const cv::Mat& image, const cv::Mat& glow, float intensity, const BloomOptions& options,
+                        cv::Mat& output);
+};
+
+} // namespace effects
+} // namespace cppengine
+
+#endif // CPP_ENGINE_EFFECTS_BLOOM_H
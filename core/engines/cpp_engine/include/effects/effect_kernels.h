@@ -0,0 +1,45 @@
+#ifndef CPP_ENGINE_EFFECTS_EFFECT_KERNELS_H
+#define CPP_ENGINE_EFFECTS_EFFECT_KERNELS_H
+
+#include <cstdint>
+
+namespace cppengine {
+namespace effects {
+
+/**
+ * Row kernels behind EffectsEngine's per-pixel effects
+ * Each call handles one row of an 8-bit interleaved image; EffectsEngine runs
+ * them over row bands in parallel. SSE2/AVX2 when available, scalar tails.
+ * Products are rounded like cv::saturate_cast<uchar>(float).
+ */
+namespace kernels {
+
+// dst[i] = saturate(src[i] * factors[i])
+void multiply_row(const uint8_t* src, const float* factors, uint8_t* dst, int n);
+
+// Directional lighting from Sobel gradients: per pixel normal (gx/255, gy/255, 1),
+// intensity max(0.3, 0.7 * dot(normal, light) + 0.3). flat_row / column 0 use
+// the (0, 0, 1) normal. scratch holds cols * (channels + 1) floats.
+void lighting_row(const uint8_t* src, const float* grad_x, const float* grad_y, uint8_t* dst,
+                  int cols, int channels, bool flat_row, const float light[3], float* scratch);
+
+// dst = src * lut[mask]; scratch holds cols * channels floats
+void shadow_row(const uint8_t* src, const uint8_t* mask, uint8_t* dst, int cols, int channels,
+                const float lut[256], float* scratch);
+
+// Horizontal sub-pixel shift with 1/32 pixel bilinear weights, zero outside the row
+struct ShiftTap {
+    int offset = 0;  // integer part of the source position relative to x
+    int frac = 0;    // 0..31, weight of the sample at offset + 1
+};
+ShiftTap make_shift_tap(float source_offset);
+
+// BGR row: blue sampled through blue_tap, red through red_tap, green copied
+void chromatic_row(const uint8_t* src, uint8_t* dst, int cols, const ShiftTap& blue_tap, const ShiftTap& red_tap);
+
+} // namespace kernels
+
+} // namespace effects
+} // namespace cppengine
+
+#endif // CPP_ENGINE_EFFECTS_EFFECT_KERNELS_H
@@ -1,15 +1,27 @@
 #ifndef CPP_ENGINE_EFFECTS_EFFECTS_ENGINE_H
 #define CPP_ENGINE_EFFECTS_EFFECTS_ENGINE_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "effects/bloom.h"
+#include "effects/remap_cache.h"
+#include "optimization/image_encoder.h"
+
+namespace cv { class Mat; }
+
 namespace cppengine {
 namespace effects {
 
+class ParticleSystem;
+
 /**
  * EffectsEngine - Advanced visual effects
  * Supports: Lighting, shadows, particles, distortions, chromatic aberration
+ *
+ * File variants decode, apply the in-memory effect and encode; the cv::Mat
+ * variants are what batch and video pipelines call per frame.
  */
 class EffectsEngine {
 public:
@@ -27,6 +39,9 @@ public:
     // Particle effects
     bool add_particles(const std::string& input_file, const std::string& output_file,
                       int particle_count, const std::string& particle_type);
+    // Animated particles over a clip: one simulation stepped per frame, ~particle_count alive
+    bool add_particles_video(const std::string& input_file, const std::string& output_file,
+                             int particle_count, const std::string& particle_type);
     
     // Distortion effects
     bool apply_wave_distortion(const std::string& input_file, const std::string& output_file,
@@ -42,8 +57,36 @@ public:
     bool apply_bloom(const std::string& input_file, const std::string& output_file,
                     float threshold, float intensity);
     
+    // In-memory variants
+    bool apply_lighting(const cv::Mat& image, cv::Mat& result, float light_x, float light_y, float light_z);
+    bool apply_shadows(const cv::Mat& image, cv::Mat& result, float shadow_intensity);
+    bool add_particles(const cv::Mat& image, cv::Mat& result, int particle_count, const std::string& particle_type);
+    bool apply_wave_distortion(const cv::Mat& image, cv::Mat& result, float amplitude, float frequency);
+    bool apply_radial_distortion(const cv::Mat& image, cv::Mat& result, float distortion_factor);
+    bool apply_chromatic_aberration(const cv::Mat& image, cv::Mat& result, float red_shift, float blue_shift);
+    bool apply_bloom(const cv::Mat& image, cv::Mat& result, float threshold, float intensity);
+
+    // Bins and splats the current particles over frame (tile-parallel); the caller steps the system
+    static bool render_particles(ParticleSystem& system, const cv::Mat& frame, cv::Mat& result);
+    // Seed of the particle emitters: same seed, same particles
+    void set_particle_seed(uint64_t seed) { particle_seed_ = seed; }
+    // Bloom algorithm and glow radius (default: pyramid, radius 10)
+    void set_bloom_options(const BloomOptions& options) { bloom_options_ = options; }
+
+    // Encoding used by the file variants (profile, latency budget) and the outcome of the last one
+    void set_encode_options(const optimization::EncodeOptions& options) { encode_options_ = options; }
+    const optimization::EncodeResult& last_encode() const { return last_encode_; }
+
+    // Sampling of the cached remap tables behind wave/radial distortion (default: nearest, as before)
+    void set_remap_interpolation(RemapInterpolation interpolation) { remap_interpolation_ = interpolation; }
+    
 private:
     int effect_quality_;
+    optimization::EncodeOptions encode_options_;
+    optimization::EncodeResult last_encode_;
+    RemapInterpolation remap_interpolation_ = RemapInterpolation::NEAREST;
+    uint64_t particle_seed_ = 42;
+    BloomOptions bloom_options_;
 };
 
 } // namespace effects
@@ -0,0 +1,101 @@
+#ifndef CPP_ENGINE_EFFECTS_REMAP_CACHE_H
+#define CPP_ENGINE_EFFECTS_REMAP_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cppengine {
+namespace effects {
+
+enum class RemapInterpolation {
+    NEAREST,   // one source pixel per output pixel, same as the original per-pixel loops
+    BILINEAR   // four taps, 1/32 pixel fixed-point weights
+};
+
+/**
+ * RemapTable - Precomputed source coordinates for a geometric effect
+ * Built once per (size, parameters); apply() is then a gather over a
+ * continuous 8-bit interleaved image (AVX2 gathers, scalar fallback).
+ */
+struct RemapTable {
+    int rows = 0;
+    int cols = 0;
+    bool bilinear = false;
+    std::vector<int32_t> index;        // source pixel (top-left tap when bilinear) per output pixel, -1 = black
+    std::vector<uint16_t> weights;     // bilinear only: fx | fy << 8, each in [0, 32]
+    std::vector<uint8_t> gather_safe;  // per output row: every tap readable as a 32-bit word
+
+    size_t bytes() const;
+
+    static std::shared_ptr<RemapTable> wave(int rows, int cols, float amplitude, float frequency,
+                                            RemapInterpolation interpolation);
+    static std::shared_ptr<RemapTable> radial(int rows, int cols, float distortion_factor,
+                                              RemapInterpolation interpolation);
+
+    // Output rows [row_begin, row_end); src and dst are rows x cols x channels, continuous
+    void apply(const uint8_t* src, uint8_t* dst, int channels, int row_begin, int row_end) const;
+};
+
+/**
+ * RemapCache - Bounded LRU of remap tables shared by every EffectsEngine
+ * Video frames with the same size and parameters reuse one table, so after
+ * the first frame a distortion is a single pass over the image.
+ */
+class RemapCache {
+public:
+    enum class Kind { WAVE, RADIAL };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    static constexpr size_t DEFAULT_CAPACITY_BYTES = 256u << 20;
+
+    explicit RemapCache(size_t capacity_bytes = DEFAULT_CAPACITY_BYTES);
+
+    static RemapCache& instance();
+
+    std::shared_ptr<const RemapTable> wave(int rows, int cols, float amplitude, float frequency,
+                                           RemapInterpolation interpolation);
+    std::shared_ptr<const RemapTable> radial(int rows, int cols, float distortion_factor,
+                                             RemapInterpolation interpolation);
+
+    void set_capacity_bytes(size_t capacity_bytes);
+    void clear();
+    Stats stats() const;
+
+private:
+    struct Key {
+        Kind kind;
+        int rows, cols;
+        float p0, p1;
+        RemapInterpolation interpolation;
+        bool operator==(const Key& other) const;
+    };
+    struct Entry {
+        Key key;
+        std::shared_ptr<const RemapTable> table;
+    };
+
+    std::shared_ptr<const RemapTable> lookup(const Key& key, const std::function<std::shared_ptr<RemapTable>()>& build);
+    void evict_locked();
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  // most recently used first
+    size_t capacity_bytes_;
+    Stats stats_;
+};
+
+} // namespace effects
+} // namespace cppengine
+
+#endif // CPP_ENGINE_EFFECTS_REMAP_CACHE_H
@@ -5,12 +5,22 @@
 #include <vector>
 #include <cstdint>
 
+#include "filters/morphology.h"
+#include "filters/resample.h"
+#include "optimization/image_encoder.h"
+
+namespace cv { class Mat; }
+
 namespace cppengine {
 namespace filters {
 
 /**
  * ImageFilter - Image processing and filtering
  * Blur, sharpen, color manipulation, edge detection
+ *
+ * Every operation has a file form (decode, filter, encode) and an in-memory
+ * form on cv::Mat used by batch and video pipelines. An instance keeps scratch
+ * buffers, so use one instance per thread.
  */
 class ImageFilter {
 public:
@@ -33,9 +43,52 @@ public:
     // Morphological operations
     bool dilate(const std::string& input_file, const std::string& output_file, int kernel_size);
     bool erode(const std::string& input_file, const std::string& output_file, int kernel_size);
+    bool morph_open(const std::string& input_file, const std::string& output_file, int kernel_size);
+    bool morph_close(const std::string& input_file, const std::string& output_file, int kernel_size);
+    bool morph_gradient(const std::string& input_file, const std::string& output_file, int kernel_size);
+    
+    // Resizing; width or height 0 keeps the aspect ratio. JPEGs much larger than the
+    // target are decoded at 1/2, 1/4 or 1/8 scale (DCT scaling) before resampling.
+    bool resize(const std::string& input_file, const std::string& output_file,
+                int width, int height, ResizeKernel kernel = ResizeKernel::AREA);
+    // One decode, one output per width: <stem>_<width><ext> next to output_file
+    bool pyramid(const std::string& input_file, const std::string& output_file,
+                 const std::vector<int>& widths, ResizeKernel kernel = ResizeKernel::AREA);
+    
+    // In-memory variants
+    bool apply_blur(const cv::Mat& image, cv::Mat& result, int radius);
+    bool apply_sharpen(const cv::Mat& image, cv::Mat& result, float strength);
+    bool apply_gaussian_blur(const cv::Mat& image, cv::Mat& result, int kernel_size);
+    bool adjust_brightness(const cv::Mat& image, cv::Mat& result, float factor);
+    bool adjust_contrast(const cv::Mat& image, cv::Mat& result, float factor);
+    bool adjust_saturation(const cv::Mat& image, cv::Mat& result, float factor);
+    bool detect_edges(const cv::Mat& image, cv::Mat& result);
+    bool dilate(const cv::Mat& image, cv::Mat& result, int kernel_size);
+    bool erode(const cv::Mat& image, cv::Mat& result, int kernel_size);
+    bool morph_open(const cv::Mat& image, cv::Mat& result, int kernel_size);
+    bool morph_close(const cv::Mat& image, cv::Mat& result, int kernel_size);
+    bool morph_gradient(const cv::Mat& image, cv::Mat& result, int kernel_size);
+    bool resize(const cv::Mat& image, cv::Mat& result, int width, int height,
+                ResizeKernel kernel = ResizeKernel::AREA);
+    // results[i] has widths[i]; each level is resampled from the smallest earlier level
+    // at least twice its size, so the cost stays close to that of the largest output
+    bool pyramid(const cv::Mat& image, std::vector<cv::Mat>& results, const std::vector<int>& widths,
+                 ResizeKernel kernel = ResizeKernel::AREA);
+    
+    // Decode with the largest JPEG DCT scaling that still yields at least width x height
+    // (0 = any); other formats decode at full size
+    static bool decode_for_size(const std::vector<unsigned char>& bytes, int width, int height, cv::Mat& image);
+
+    // Encoding used by the file variants (profile, latency budget) and the outcome of the last one
+    void set_encode_options(const optimization::EncodeOptions& options) { encode_options_ = options; }
+    const optimization::EncodeResult& last_encode() const { return last_encode_; }
     
 private:
     int thread_count_;
+    Morphology morphology_;
+    Resampler resampler_;
+    optimization::EncodeOptions encode_options_;
+    optimization::EncodeResult last_encode_;
 };
 
 } // namespace filters
@@ -0,0 +1,62 @@
+#ifndef CPP_ENGINE_FILTERS_MORPHOLOGY_H
+#define CPP_ENGINE_FILTERS_MORPHOLOGY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cppengine {
+namespace filters {
+
+enum class MorphOp {
+    ERODE,
+    DILATE
+};
+
+/**
+ * Morphology - Rectangular min/max filtering in O(1) per pixel
+ * Van Herk/Gil-Werman separable passes on 8-bit interleaved buffers,
+ * SIMD across the row. Out-of-image samples are ignored (same result as
+ * cv::erode/cv::dilate with a MORPH_RECT element and default border).
+ */
+class Morphology {
+public:
+    Morphology();
+    ~Morphology();
+
+    // src and dst may alias; channels is the interleave factor (1, 3 or 4)
+    void erode(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+               int rows, int cols, int channels, int kernel_w, int kernel_h);
+    void dilate(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                int rows, int cols, int channels, int kernel_w, int kernel_h);
+
+    // Compound operations, both passes run back-to-back through the same scratch buffers
+    void open(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+              int rows, int cols, int channels, int kernel_w, int kernel_h);
+    void close(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+               int rows, int cols, int channels, int kernel_w, int kernel_h);
+    void gradient(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                  int rows, int cols, int channels, int kernel_w, int kernel_h);
+
+    // One vertical pass: dst[y] = op(src[y - k/2 .. y - k/2 + k - 1]) per byte column
+    static void vertical_pass(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                              int rows, int row_bytes, int ksize, MorphOp op,
+                              std::vector<uint8_t>& scratch);
+
+    // Pixel transpose of an interleaved 8-bit buffer (channels bytes per pixel)
+    static void transpose(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                          int rows, int cols, int channels);
+
+private:
+    void apply(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+               int rows, int cols, int channels, int kernel_w, int kernel_h, MorphOp op);
+
+    std::vector<uint8_t> strip_scratch_;
+    std::vector<uint8_t> transposed_;
+    std::vector<uint8_t> intermediate_;
+};
+
+} // namespace filters
+} // namespace cppengine
+
+#endif // CPP_ENGINE_FILTERS_MORPHOLOGY_H
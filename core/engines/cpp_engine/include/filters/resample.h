@@ -0,0 +1,64 @@
+#ifndef CPP_ENGINE_FILTERS_RESAMPLE_H
+#define CPP_ENGINE_FILTERS_RESAMPLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cppengine {
+namespace filters {
+
+enum class ResizeKernel {
+    AREA,      // exact pixel-area average when shrinking, bilinear when enlarging
+    LANCZOS3   // windowed sinc, support widened by the scale factor when shrinking
+};
+
+/**
+ * Resampler - Separable antialiased resize of 8-bit interleaved buffers
+ * Vertical pass (SIMD across the row) into an 8-bit intermediate, then a
+ * horizontal pass over the already reduced rows (SIMD per output pixel for
+ * 1, 3 and 4 channels, bit-identical to scalar). Weights are 14-bit fixed
+ * point and sum exactly to one, so flat regions stay flat. Keeps its
+ * buffers: use one instance per thread.
+ */
+class Resampler {
+public:
+    Resampler();
+    ~Resampler();
+
+    void resize(const uint8_t* src, size_t src_step, int src_rows, int src_cols,
+                uint8_t* dst, size_t dst_step, int dst_rows, int dst_cols,
+                int channels, ResizeKernel kernel);
+
+private:
+    struct Taps {
+        std::vector<int> start;        // first source index per output index
+        std::vector<int16_t> weights;  // max_taps per output index, zero padded
+        int max_taps = 0;
+    };
+
+    static void build_taps(int in_size, int out_size, ResizeKernel kernel, Taps& taps);
+
+    Taps horizontal_taps_;
+    Taps vertical_taps_;
+    std::vector<uint8_t> intermediate_;
+};
+
+// Width/height from a JPEG's SOF marker without decoding; false for non-JPEG data
+bool read_jpeg_size(const uint8_t* data, size_t size, int& width, int& height);
+
+// EXIF orientation (1-8) of a JPEG, 1 if it has none. 5-8 are transposed: decoders that apply it,
+// as cv::imdecode does, return the SOF width and height swapped
+int read_jpeg_orientation(const uint8_t* data, size_t size);
+
+// Width/height from a PNG's IHDR chunk; false for non-PNG data
+bool read_png_size(const uint8_t* data, size_t size, int& width, int& height);
+
+// Largest DCT scale denominator (1, 2, 4 or 8) that still decodes at least dst size; src is the
+// size as decoded, so swap the SOF size first for EXIF orientations 5-8
+int reduced_decode_factor(int src_width, int src_height, int dst_width, int dst_height);
+
+} // namespace filters
+} // namespace cppengine
+
+#endif // CPP_ENGINE_FILTERS_RESAMPLE_H
@@ -1,17 +1,48 @@
 // generators/image_generator.h
 #pragma once
 
+#include "generators/procedural_generator.h"
+#include "optimization/image_encoder.h"
+
 #include <string>
 #include <vector>
 
+namespace cv { class Mat; }
+
 namespace cpp_engine::generators {
 
+struct ImageRequest {
+    ProceduralKind kind = ProceduralKind::PERLIN;
+    int width = 512;
+    int height = 512;
+    unsigned int seed = 0;
+    NoiseBackend noise = NoiseBackend::PERLIN;
+};
+
+/**
+ * ImageGenerator - Procedural images as a library call
+ * render() hands back the BGR pixels and encode() the encoded bytes
+ * (ImageEncoder profiles), both in memory: a server answers a request
+ * without spawning the generator binary, writing a file and reading it
+ * back. The file variants are thin wrappers over the same path. Requests
+ * keep no state on the instance, so one generator can serve concurrent
+ * requests; set the options before sharing it.
+ */
 class ImageGenerator {
 public:
     ImageGenerator();
+    explicit ImageGenerator(const ProceduralOptions& options);
     ~ImageGenerator();
-    
+
     void set_quality(int quality);
+    void set_encode_options(const cppengine::optimization::EncodeOptions& options) { encode_options_ = options; }
+
+    // out becomes a height x width CV_8UC3 image
+    bool render(const ImageRequest& request, cv::Mat& out) const;
+    // format as for ImageEncoder ("png", "jpg", "webp"...); result, when given, gets the encode outcome
+    bool encode(const ImageRequest& request, const std::string& format, std::vector<unsigned char>& bytes,
+                cppengine::optimization::EncodeResult* result = nullptr) const;
+
     bool generate_perlin(int width, int height, int seed, const std::string& output_path);
     bool generate_image(const std::string& prompt, const std::string& output_path, int width = 512, int height = 512);
     bool generate_image_from_text(const std::string& text, const std::string& output_path);
@@ -19,6 +50,8 @@ public:
 
 private:
     int quality_;
+    ProceduralOptions options_;
+    cppengine::optimization::EncodeOptions encode_options_;
 };
 
-} // namespace cpp_engine::generators
\ No newline at end of file
+} // namespace cpp_engine::generators
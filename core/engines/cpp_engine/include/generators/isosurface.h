@@ -0,0 +1,54 @@
+// generators/isosurface.h
+#pragma once
+
+#include "generators/mesh.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace cpp_engine::generators {
+
+// Scalar field sampled a lattice row at a time: out[i] = f(x0 + i * step, y, z), world units
+using FieldRow = std::function<void(float x0, float y, float z, float step, int count, float* out)>;
+
+struct IsosurfaceOptions {
+    int resolution = 128;  // cells per axis; the lattice has resolution + 1 samples per axis
+    float extent = 1.0f;   // the cube [-extent, extent]^3 is sampled
+    float iso = 0.0f;      // inside where f < iso, so signed distances give outward normals
+    int slab_cells = 16;   // cell layers per slab, the unit of parallel work
+    bool normals = true;
+};
+
+/**
+ * IsosurfaceExtractor - Marching cubes over z slabs
+ * Each slab walks its cell layers holding just two lattice layers of
+ * samples, so the volume is never materialized, and deduplicates edge
+ * vertices in its own open-addressing table keyed by the global lattice
+ * edge. Slabs run in parallel waves of one per thread; after each wave
+ * the slab meshes are appended to the output in slab order, mapping the
+ * vertices on a slab's bottom plane onto the ones the slab below made on
+ * the same edges, and are freed. The output is therefore watertight,
+ * identical for any thread count, and peak memory is the mesh plus one
+ * wave of slabs. The case table is derived at startup from the cube's
+ * faces: each run of inside corners around a face contributes one
+ * contour segment, so neighbouring cells resolve an ambiguous shared
+ * face the same way.
+ */
+class IsosurfaceExtractor {
+public:
+    struct Stats {
+        int slabs = 0;
+        size_t seam_vertices = 0;       // vertices shared between slabs, merged instead of duplicated
+        size_t peak_working_bytes = 0;  // samples, slab meshes and edge tables of the largest wave
+    };
+
+    static bool extract(const FieldRow& field, const IsosurfaceOptions& options, Mesh& out, Stats* stats = nullptr);
+
+    // |p| - radius + amplitude * fBm(p * noise_scale): a noise-displaced sphere as a signed distance
+    static FieldRow displaced_sphere(float radius, float amplitude, float noise_scale, unsigned int seed,
+                                     const FractalParams& fractal = FractalParams());
+    // fBm(p * noise_scale): at iso 0 a sponge of caves through the whole cube
+    static FieldRow noise_volume(float noise_scale, unsigned int seed, const FractalParams& fractal = FractalParams());
+};
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,60 @@
+// generators/mesh.h
+#pragma once
+
+#include "generators/perlin_noise.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cpp_engine::generators {
+
+/**
+ * Mesh - Indexed triangle mesh in flat arrays
+ * positions and normals are xyz triples (normals empty or one per vertex),
+ * indices three per triangle. The arrays are laid out exactly as GLB and
+ * binary PLY store them, so writers copy them without per-vertex work.
+ */
+struct Mesh {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<uint32_t> indices;
+
+    size_t vertex_count() const { return positions.size() / 3; }
+    size_t triangle_count() const { return indices.size() / 3; }
+    bool has_normals() const { return !normals.empty(); }
+    // Per-axis bounds of the positions; false (bounds untouched) when the mesh is empty
+    bool bounds(float min_out[3], float max_out[3]) const;
+    // Sizes consistent and every index in range
+    bool valid() const;
+    // Replaces normals with the area-weighted average of the adjacent triangle normals
+    void compute_normals();
+};
+
+// UV sphere, optionally displaced along its normal by 3D simplex fBm
+struct SphereOptions {
+    int latitude = 8;     // rings between the poles
+    int longitude = 16;   // vertices per ring
+    float radius = 1.0f;
+    float displacement = 0.0f;  // fBm amplitude as a fraction of the radius; 0 keeps a perfect sphere
+    float noise_scale = 2.0f;   // noise units per unit of the sphere direction
+    unsigned int seed = 0;
+    FractalParams fractal;
+    bool normals = true;
+};
+
+/**
+ * MeshTessellator - Parametric surfaces straight into preallocated arrays
+ * The vertex and index counts of a grid surface are known up front, so the
+ * arrays are sized once and latitude rows are filled in parallel, each row
+ * writing only its own slice: no push_back, no merge, and the result does
+ * not depend on the thread count. The sphere keeps the layout of the
+ * original OBJ exporter: (latitude + 1) rings of longitude vertices and two
+ * triangles per quad, poles included.
+ */
+class MeshTessellator {
+public:
+    static bool sphere(const SphereOptions& options, Mesh& out);
+};
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,39 @@
+// generators/mesh_io.h
+#pragma once
+
+#include "generators/mesh.h"
+
+#include <string>
+#include <vector>
+
+namespace cpp_engine::generators {
+
+enum class MeshFormat { OBJ, PLY, GLB };
+
+/**
+ * MeshIO - Mesh serialization to OBJ, binary PLY and GLB
+ * Every encoder sizes its output once and fills it in a single pass:
+ * GLB is the 12-byte header, a JSON chunk and one BIN chunk holding the
+ * position, normal and uint32 index buffers back to back (each a buffer
+ * view, 4-byte aligned); binary PLY is a short ASCII header followed by
+ * the vertex records and 13-byte face records. write() then hands the
+ * whole buffer to the file in one call. The readers parse what the
+ * writers produce (GLB: POSITION/NORMAL floats with uint8/16/32 indices;
+ * PLY: little-endian float vertices with a uchar-counted triangle list)
+ * and exist for round trips and for timing what a loader pays per format.
+ */
+class MeshIO {
+public:
+    // From the path's extension (.obj, .ply, .glb, case-insensitive); false if none matches
+    static bool format_for(const std::string& path, MeshFormat& format);
+    static const char* format_name(MeshFormat format);
+
+    static bool encode(const Mesh& mesh, MeshFormat format, std::vector<unsigned char>& bytes);
+    static bool decode(const unsigned char* data, size_t size, MeshFormat format, Mesh& out);
+
+    // Creates the parent directory; the format comes from the extension
+    static bool write(const std::string& path, const Mesh& mesh);
+    static bool read(const std::string& path, Mesh& out);
+};
+
+} // namespace cpp_engine::generators
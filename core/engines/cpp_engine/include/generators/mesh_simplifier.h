@@ -0,0 +1,49 @@
+// generators/mesh_simplifier.h
+#pragma once
+
+#include "generators/mesh.h"
+
+#include <cstddef>
+
+namespace cpp_engine::generators {
+
+struct SimplifyOptions {
+    // At least one of the two bounds must be set; simplify() refuses options with neither
+    size_t target_triangles = 0;  // stop once at most this many remain; 0: no triangle target
+    float max_error = 0.0f;       // stop before a collapse moving the surface further than this; 0: unbounded
+    bool preserve_boundary = true;
+    // Meshes above this many triangles are first vertex-clustered in parallel to about four times
+    // the target (or to this count without one); 0 disables the pre-pass
+    size_t cluster_above = 0;
+};
+
+/**
+ * MeshSimplifier - Quadric error metric decimation
+ * Garland-Heckbert edge collapses on an indexed mesh with per-vertex
+ * triangle lists: every vertex accumulates the plane quadrics of its
+ * faces (plus heavily weighted planes through boundary edges), every
+ * edge is costed at the position minimizing the summed quadric, and the
+ * cheapest edge is collapsed from a heap whose stale entries are dropped
+ * when popped (vertex versions). A collapse is refused if it would make
+ * the surface non-manifold (link condition) or flip a triangle. Errors
+ * are distances: the square root of the summed squared distances to the
+ * merged planes. The optional pre-pass snaps vertices to a uniform grid,
+ * computing cells and remapping triangles in parallel, which brings
+ * multi-million-triangle meshes down to a size the queue handles quickly.
+ * The result does not depend on the thread count.
+ */
+class MeshSimplifier {
+public:
+    struct Stats {
+        size_t input_triangles = 0;
+        size_t clustered_triangles = 0;  // after the pre-pass; equals the input when it did not run
+        size_t output_triangles = 0;
+        size_t collapses = 0;
+        float max_error = 0.0f;  // largest error of an applied collapse
+    };
+
+    // in and out may be the same mesh; normals are recomputed when in has them
+    static bool simplify(const Mesh& in, const SimplifyOptions& options, Mesh& out, Stats* stats = nullptr);
+};
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,123 @@
+// generators/noise_atlas.h
+#pragma once
+
+#include "generators/perlin_noise.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace cpp_engine::generators {
+
+// What an atlas holds: the fBm of one seed, octave setup and pixel scale (lacunarity 2)
+struct NoiseAtlasKey {
+    unsigned int seed = 0;
+    int octaves = 4;
+    float persistence = 0.5f;
+    float scale = 0.01f;  // noise units per pixel of the generator sampling it
+
+    bool operator<(const NoiseAtlasKey& other) const;
+    bool operator==(const NoiseAtlasKey& other) const;
+    // "atlas_<seed>_<octaves>_<persistence bits>_<scale bits>_<size>.f16"
+    std::string file_name(int size) const;
+    // The generator settings this key stands for
+    bool matches(float scale, const FractalParams& params) const;
+};
+
+/**
+ * NoiseAtlas - Tileable fBm tile mapped read-only from disk
+ * size x size float16 texels of the key's fBm on a lattice that wraps every
+ * period_cells cells, so the tile repeats seamlessly in both directions.
+ * One texel is one generator pixel whenever size * scale is a whole number
+ * of cells, which the store arranges; sample_row() then converts stored
+ * halves straight to floats, and falls back to wrapped bilinear fetches
+ * otherwise. The file is mapped MAP_SHARED, so every process sampling the
+ * same atlas shares one copy in the page cache.
+ */
+class NoiseAtlas {
+public:
+    ~NoiseAtlas();
+    NoiseAtlas(const NoiseAtlas&) = delete;
+    NoiseAtlas& operator=(const NoiseAtlas&) = delete;
+
+    // Maps path; null (logged) if it is missing, truncated or holds another key
+    static std::shared_ptr<const NoiseAtlas> open(const std::string& path, const NoiseAtlasKey& key);
+    // Renders the atlas in parallel and writes it to path (via a temporary file and rename)
+    static bool build(const NoiseAtlasKey& key, int size, const std::string& path);
+    // Texels per side for a requested size: rounded so the tile spans whole lattice cells
+    static int fitted_size(const NoiseAtlasKey& key, int requested);
+
+    const NoiseAtlasKey& key() const { return key_; }
+    int size() const { return size_; }
+    int period_cells() const { return period_; }
+    size_t bytes() const { return mapped_bytes_; }
+
+    float texel(int x, int y) const;       // wraps
+    float sample(float x, float y) const;  // bilinear, in texels, wraps
+    // out[i] = the fBm at generator pixel (x0 + i, y), as fractal_row() would lay it out
+    void sample_row(float x0, float y, int count, float* out) const;
+
+private:
+    NoiseAtlas() = default;
+
+    NoiseAtlasKey key_;
+    int size_ = 0;
+    int period_ = 0;
+    float texels_per_pixel_ = 1.0f;
+    const uint16_t* texels_ = nullptr;
+    void* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+};
+
+struct NoiseAtlasOptions {
+    std::string directory;                      // empty = NoiseAtlasStore::default_directory()
+    size_t max_disk_bytes = size_t(256) << 20;  // least recently used atlases beyond this are deleted
+    int size = 1024;                            // requested texels per side, see NoiseAtlas::fitted_size()
+};
+
+/**
+ * NoiseAtlasStore - Persistent cache of noise atlases
+ * get() returns the atlas of a key from memory, else maps it from the
+ * directory, else builds and writes it first. Files are shared by every
+ * process using the directory; each use refreshes the file's mtime, and
+ * after a build the least recently used files are deleted until the
+ * directory fits max_disk_bytes (mappings already open stay valid).
+ * Thread-safe.
+ */
+class NoiseAtlasStore {
+public:
+    struct Stats {
+        int memory_hits = 0;
+        int disk_hits = 0;
+        int builds = 0;
+        int evictions = 0;
+    };
+
+    explicit NoiseAtlasStore(const NoiseAtlasOptions& options = NoiseAtlasOptions());
+
+    // Null (logged) if the atlas could not be built or written
+    std::shared_ptr<const NoiseAtlas> get(const NoiseAtlasKey& key);
+    // Atlas bytes currently in the directory
+    size_t disk_bytes() const;
+    // Deletes least recently used atlases until the directory fits the budget; keep is spared
+    void evict(const std::string& keep = std::string());
+
+    Stats stats() const;
+    const NoiseAtlasOptions& options() const { return options_; }
+
+    // $XDG_CACHE_HOME/cpp_engine/noise_atlas, or ~/.cache/cpp_engine/noise_atlas
+    static std::string default_directory();
+
+private:
+    void evict_locked(const std::string& keep);
+
+    NoiseAtlasOptions options_;
+    mutable std::mutex mutex_;
+    std::map<NoiseAtlasKey, std::shared_ptr<const NoiseAtlas>> atlases_;
+    Stats stats_;
+};
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,57 @@
+// generators/perlin_noise.h
+#pragma once
+
+#include <cstdint>
+
+namespace cpp_engine::generators {
+
+struct FractalParams {
+    int octaves = 4;           // at most PerlinNoise::MAX_OCTAVES
+    float persistence = 0.5f;  // amplitude ratio between octaves
+    float lacunarity = 2.0f;   // frequency ratio between octaves
+};
+
+/**
+ * PerlinNoise - 2D gradient noise and fBm, evaluated a row at a time
+ * Same lattice as the original generator (mt19937-shuffled permutation,
+ * +-x +-y gradients, quintic fade), in float. fractal_row() builds one
+ * table per octave of the gradient signs of every lattice cell the row
+ * crosses, then evaluates 16 (AVX-512), 8 (AVX2) or 4 (SSE2) pixels per
+ * step with all octaves accumulated in registers; scalar tail.
+ */
+class PerlinNoise {
+public:
+    static constexpr int MAX_OCTAVES = 16;
+
+    explicit PerlinNoise(unsigned int seed = 0);
+
+    float noise(float x, float y) const;  // [-1, 1]
+    float fractal(float x, float y, const FractalParams& params) const;
+    // noise() on a lattice that wraps every period cells in x and y, so it tiles with that period;
+    // period 256 gives noise() itself
+    float noise_periodic(float x, float y, int period) const;
+    // 3D noise on the same permutation, gradients (+-1, +-1, +-1); z is typically time
+    float noise3(float x, float y, float z) const;  // [-1, 1]
+    float fractal3(float x, float y, float z, const FractalParams& params) const;
+
+    // out[i] = fractal((x0 + i) * scale, y * scale) for i in [0, count); x0/y in pixels
+    void fractal_row(float x0, float y, int count, float scale, const FractalParams& params, float* out) const;
+    // Same values plus the analytic gradient in pixel units, dx[i] = d out[i] / dx, dy[i] = d out[i] / dy,
+    // on the same SIMD paths; one noise evaluation instead of three for finite differences
+    void fractal_row_gradient(float x0, float y, int count, float scale, const FractalParams& params,
+                              float* out, float* dx, float* dy) const;
+
+    // out[i] = fractal3((x0 + i) * scale, y * scale, z), plus the pixel-unit gradient when dx and dy are
+    // given; z is in noise units (not scaled). Successive z on one PerlinNoise give a smoothly evolving
+    // field, which is how animated textures reuse the lattice across frames.
+    void fractal_row_3d(float x0, float y, float z, int count, float scale, const FractalParams& params,
+                        float* out, float* dx = nullptr, float* dy = nullptr) const;
+
+    // "avx512", "avx2", "sse2" or "scalar": the fractal_row path compiled in
+    static const char* simd_path();
+
+private:
+    int perm_[512];
+};
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,71 @@
+// generators/procedural_generator.h
+#pragma once
+
+#include <string>
+
+namespace cv { class Mat; }
+
+namespace cpp_engine::generators {
+
+class PerlinNoise;
+class NoiseAtlasStore;
+struct NoiseField;
+
+enum class ProceduralKind {
+    PERLIN,      // fBm, hue-cycled (gray in, gray out: the cycle needs saturation)
+    SILHOUETTE,  // gold Canny contours of fBm, dilated
+    METALLIC     // bump-mapped brushed metal with a centre highlight
+};
+
+enum class NoiseBackend {
+    PERLIN,  // gradient noise over the 2^N corners of a cell; the default, and what atlases cache
+    SIMPLEX  // N + 1 corners of a simplex: cheaper in 3D (animation), and the one with a 4D field
+};
+
+struct ProceduralOptions {
+    int tile_size = 256;                        // square tiles in pixels; output does not depend on it
+    NoiseBackend noise = NoiseBackend::PERLIN;  // of generate(); render() takes any field
+    NoiseAtlasStore* atlas = nullptr;           // not owned; generate() samples cached Perlin noise from it
+};
+
+/**
+ * ProceduralGenerator - Tiled, multi-threaded procedural textures
+ * The canvas is cut into fixed tile_size x tile_size tiles that OpenCV's
+ * shared thread pool (cv::parallel_for_) renders independently; each tile
+ * runs noise, colorization and post-processing in one pass over its own
+ * pixels, so the result is bit-identical for a given seed whatever the
+ * thread count or scheduling. Silhouette keeps one whole-image step,
+ * cv::Canny, whose hysteresis links edges across tiles; its base and its
+ * colorize + dilate pass are tiled on either side of it. options.noise
+ * picks the noise backend. With an atlas store, generate() reads the Perlin
+ * fBm of perlin and silhouette from the seed's tileable atlas instead of
+ * evaluating it (the field then repeats every atlas size; metallic needs
+ * gradients and always evaluates).
+ */
+class ProceduralGenerator {
+public:
+    explicit ProceduralGenerator(const ProceduralOptions& options = ProceduralOptions());
+
+    // out becomes a height x width CV_8UC3 image
+    bool generate(ProceduralKind kind, int width, int height, unsigned int seed, cv::Mat& out) const;
+    // Animated: the 3D field of noise at time (noise units); reuse one PerlinNoise across frames
+    bool generate_frame(ProceduralKind kind, int width, int height, const PerlinNoise& noise, float time,
+                        cv::Mat& out) const;
+    // Any field, e.g. a simplex frame or a 4D slice
+    bool render(ProceduralKind kind, int width, int height, const NoiseField& field, cv::Mat& out) const;
+
+    int tile_count(int width, int height) const;
+    const ProceduralOptions& options() const { return options_; }
+
+    // "perlin", "silhouette", "metallic"; a trailing "_video" is accepted too
+    static bool parse_kind(const std::string& name, ProceduralKind& kind);
+    static const char* kind_name(ProceduralKind kind);
+    // "perlin" or "simplex"
+    static bool parse_backend(const std::string& name, NoiseBackend& backend);
+    static const char* backend_name(NoiseBackend backend);
+
+private:
+    ProceduralOptions options_;
+};
+
+} // namespace cpp_engine::generators
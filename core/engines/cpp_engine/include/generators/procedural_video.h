@@ -0,0 +1,61 @@
+// generators/procedural_video.h
+#pragma once
+
+#include "generators/procedural_generator.h"
+
+#include <functional>
+
+namespace cpp_engine::generators {
+
+struct ProceduralVideoOptions {
+    int render_threads = 0;        // frames rendered at once; 0 = hardware concurrency
+    int max_frames_in_flight = 0;  // rendered or rendering but not yet delivered; 0 = 2 * render_threads
+    float time_step = 0.02f;       // noise units per frame along the time axis
+    int loop_frames = 0;           // > 0: loop every loop_frames frames through 4D simplex noise
+    ProceduralOptions tiles;       // tiling and noise backend (tiles.noise) inside each frame
+};
+
+/**
+ * ProceduralVideo - Temporally coherent procedural video
+ * Frame i is the 3D noise field of the seed at time i * time_step, so
+ * successive frames evolve smoothly and all share one permutation instead
+ * of reseeding per frame. With loop_frames, frame i instead samples the 4D
+ * simplex field on a circle in (z, w) whose circumference is loop_frames *
+ * time_step, so the last frame leads smoothly back into the first at the
+ * same speed of change. Render threads claim frames in order and render
+ * them concurrently; finished frames go through a bounded queue to the
+ * encoder side (the calling thread), which reorders them and hands them to
+ * the sink one by one. At most max_frames_in_flight frames exist at once,
+ * so memory stays flat however long the video. Frames depend only on
+ * (kind, size, seed, index): any thread count gives the same video.
+ */
+class ProceduralVideo {
+public:
+    // Called in frame order on the calling thread; returning false stops rendering
+    using FrameSink = std::function<bool(int index, const cv::Mat& frame)>;
+
+    struct Stats {
+        int frames = 0;          // delivered to the sink
+        double seconds = 0.0;
+        double render_ms = 0.0;  // summed over render threads
+        double sink_ms = 0.0;    // time spent in the sink (encoding)
+
+        double fps() const;
+    };
+
+    explicit ProceduralVideo(const ProceduralVideoOptions& options = ProceduralVideoOptions());
+
+    // False if the size is invalid, a frame failed or the sink stopped early
+    bool render(ProceduralKind kind, int width, int height, int frames, unsigned int seed, const FrameSink& sink);
+    // Frame index alone, identical to what render() delivers for it
+    bool render_frame(ProceduralKind kind, int width, int height, unsigned int seed, int index, cv::Mat& out) const;
+
+    const Stats& stats() const { return stats_; }
+    const ProceduralVideoOptions& options() const { return options_; }
+
+private:
+    ProceduralVideoOptions options_;
+    Stats stats_;
+};
+
+} // namespace cpp_engine::generators
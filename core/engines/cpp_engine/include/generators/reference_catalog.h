@@ -0,0 +1,114 @@
+// generators/reference_catalog.h
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_engine::generators {
+
+enum class ReferenceFormat : uint8_t { UNKNOWN = 0, JPEG, PNG, BMP };
+
+struct ReferenceImage {
+    std::string path;
+    int width = 0;
+    int height = 0;
+    ReferenceFormat format = ReferenceFormat::UNKNOWN;
+    uint64_t phash = 0;      // difference hash of a 9x8 grayscale thumbnail, see hamming()
+    int64_t mtime_ns = 0;
+    uint64_t bytes = 0;
+};
+
+struct ReferenceCatalogOptions {
+    std::string root = "java_ai_system/data/downloaded_images";  // one folder per search name
+    std::string index_path;  // empty = <root>/.reference_index
+    bool watch = true;       // inotify; without it each lookup stats the folder instead
+    int save_delay_ms = 2000;  // watched changes are batched this long before the index is saved
+};
+
+/**
+ * ReferenceCatalog - Indexed reference images of the downloaded_images folders
+ * images(name) returns the .png/.jpg/.jpeg/.bmp files of root/name with
+ * their size, format, perceptual hash and mtime, sorted by path. A folder
+ * is scanned on its first lookup (only new or changed files are probed,
+ * in parallel) and then kept current by an inotify watch, so later
+ * lookups are a map find and a shared_ptr copy. Scans, probes and index
+ * writes run without the catalog lock; only their result is swapped in.
+ * The catalog is persisted to a compact binary index, after scans and a
+ * few seconds after watched changes: at startup a folder is trusted as
+ * long as its directory mtime still matches the stored one, and
+ * otherwise rescanned reusing the entries of unchanged files. Files
+ * rewritten in place while nothing watches are only seen once the folder
+ * changes. Thread-safe.
+ */
+class ReferenceCatalog {
+public:
+    using Images = std::shared_ptr<const std::vector<ReferenceImage>>;
+
+    struct Stats {
+        int folders_loaded = 0;   // from the index file
+        int folders_scanned = 0;
+        int images_probed = 0;    // read and hashed (scans and watch events)
+        int events = 0;           // inotify events applied
+        int folders_tracked = 0;  // existing folders looked up or loaded; missing ones are not kept
+    };
+
+    explicit ReferenceCatalog(const ReferenceCatalogOptions& options = ReferenceCatalogOptions());
+    ~ReferenceCatalog();  // stops watching and saves the index if it changed
+
+    ReferenceCatalog(const ReferenceCatalog&) = delete;
+    ReferenceCatalog& operator=(const ReferenceCatalog&) = delete;
+
+    // Never null; empty if the folder does not exist or name is not a single plain path component
+    // ("", ".", "..", anything with '/')
+    Images images(const std::string& name);
+    // Writes the index (via a temporary file and rename); also done after every scan that changed
+    // a folder, by the watcher after changes and on destruction. False (logged) on failure
+    bool save();
+
+    Stats stats() const;
+    const ReferenceCatalogOptions& options() const { return options_; }
+
+    // Header size and format plus the hash; false if the file is not a readable image
+    static bool probe(const std::string& path, ReferenceImage& image);
+    // Differing hash bits: 0 for the same picture, up to ~10 for re-encodes and rescales
+    static int hamming(uint64_t a, uint64_t b);
+    // Process-wide catalog with default options
+    static ReferenceCatalog& shared();
+
+private:
+    struct Folder {
+        int64_t dir_mtime_ns = -1;  // -1: not reconciled with the directory
+        std::unordered_map<std::string, ReferenceImage> files;  // by file name
+        Images snapshot;            // null once files changed
+        int watch = -1;
+        bool verified = false;      // checked against the directory since this process started
+        uint64_t generation = 0;    // bumped by every change, so an unlocked scan sees what it raced
+    };
+
+    bool load();
+    std::string serialize_locked() const;
+    bool write_index(const std::string& index) const;
+    Images snapshot_locked(Folder& folder);
+    void watch_locked(const std::string& name, Folder& folder);
+    void forget_locked(const std::string& name);
+    void watch_loop();
+    std::string folder_path(const std::string& name) const;
+
+    ReferenceCatalogOptions options_;
+    mutable std::mutex mutex_;
+    std::mutex save_mutex_;  // orders index writes; taken before mutex_
+    std::unordered_map<std::string, Folder> folders_;
+    std::unordered_map<int, std::string> watched_;  // inotify watch -> folder name
+    Stats stats_;
+    bool dirty_ = false;
+    int inotify_fd_ = -1;
+    int wake_fds_[2] = {-1, -1};
+    std::thread watcher_;
+};
+
+} // namespace cpp_engine::generators
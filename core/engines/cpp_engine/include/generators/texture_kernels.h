@@ -0,0 +1,76 @@
+// generators/texture_kernels.h
+#pragma once
+
+#include "generators/perlin_noise.h"
+
+#include <cstdint>
+
+namespace cpp_engine::generators {
+
+class NoiseAtlas;
+class SimplexNoise;
+
+struct MetallicParams {
+    float scale = 0.02f;     // noise units per pixel
+    FractalParams fractal;   // 4 octaves, persistence 0.5, lacunarity 2
+    float bump = 0.5f;       // normal tilt per unit of noise slope
+    float specular = 0.45f;  // Blinn-Phong weight, exponent 32
+};
+
+/**
+ * NoiseField - What the row kernels sample
+ * The static 2D fBm of a noise, its 3D fBm at one time for animation (frames
+ * at successive times share the permutation and evolve smoothly instead of
+ * being reseeded), or with simplex noise a 2D slice (z, w) of its 4D fBm,
+ * which loops when (z, w) goes round a circle. A static Perlin field may
+ * carry an atlas of the same seed; row() then samples it whenever the atlas
+ * key matches the requested scale and octaves (gradients are always
+ * evaluated).
+ */
+struct NoiseField {
+    NoiseField(const PerlinNoise& noise) : perlin(&noise) {}  // implicit: a noise is its static field
+    NoiseField(const PerlinNoise& noise, const NoiseAtlas* atlas) : perlin(&noise), atlas(atlas) {}
+    NoiseField(const PerlinNoise& noise, float time) : perlin(&noise), dimensions(3), z(time) {}
+    NoiseField(const SimplexNoise& noise) : simplex(&noise) {}
+    NoiseField(const SimplexNoise& noise, float time) : simplex(&noise), dimensions(3), z(time) {}
+    NoiseField(const SimplexNoise& noise, float z, float w) : simplex(&noise), dimensions(4), z(z), w(w) {}
+
+    void row(float x0, float y, int count, float scale, const FractalParams& params, float* out) const;
+    void row_gradient(float x0, float y, int count, float scale, const FractalParams& params, float* out,
+                      float* dx, float* dy) const;
+
+    const PerlinNoise* perlin = nullptr;  // exactly one of perlin and simplex is set
+    const SimplexNoise* simplex = nullptr;
+    int dimensions = 2;                 // 2 static, 3 at z = time, 4 at (z, w) (simplex only)
+    float z = 0.0f, w = 0.0f;           // noise units along the extra axes
+    const NoiseAtlas* atlas = nullptr;  // static Perlin fields only; null = evaluate
+};
+
+/**
+ * Row kernels of the procedural texture generators
+ * Each call shades pixels [x_begin, x_end) of row y of a width x height
+ * texture into dst; rows and row segments are independent, so callers may
+ * split the canvas any way and run the pieces in parallel.
+ */
+namespace kernels {
+
+// Brushed-metal BGR: height, analytic normal, diffuse + specular lighting and
+// the centre highlight in one pass. scratch holds 3 * (x_end - x_begin) floats.
+void metallic_row(const NoiseField& field, const MetallicParams& params, int y, int x_begin, int x_end,
+                  int width, int height, uint8_t* dst, float* scratch);
+
+// Gray fBm, (n + 1) / 2 * 255 truncated, repeated over channels bytes per pixel.
+// scratch holds x_end - x_begin floats.
+void gray_row(const NoiseField& field, float scale, const FractalParams& fractal, int y, int x_begin, int x_end,
+              int channels, uint8_t* dst, float* scratch);
+
+// Silhouette BGR: gold (255, 200, 50) where the 3x3 cross around a pixel touches
+// an edge, black elsewhere, i.e. colorize then dilate with the 3x3 ellipse.
+// above/edges/below are whole edge-map rows (width bytes), above/below null
+// outside the image; dst receives pixels [x_begin, x_end) only.
+void silhouette_row(const uint8_t* above, const uint8_t* edges, const uint8_t* below, int x_begin, int x_end,
+                    int width, uint8_t* dst);
+
+} // namespace kernels
+
+} // namespace cpp_engine::generators
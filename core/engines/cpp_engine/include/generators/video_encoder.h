@@ -0,0 +1,72 @@
+// generators/video_encoder.h
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace cv { class Mat; }
+
+namespace cpp_engine::generators {
+
+struct VideoEncoderOptions {
+    std::string codec = "h264";      // h264, hevc, vp9, mpeg4/mp4v, mjpeg, or a fourcc for the fallback
+    std::string preset = "veryfast"; // x264/x265 speed preset; ignored by codecs without one
+    int crf = 23;                    // constant quality, used when bitrate_kbps is 0
+    int bitrate_kbps = 0;
+    int threads = 0;                 // encoder threads (frame + slice); 0: one per core
+    size_t queue_frames = 8;         // frames buffered between write() and the encoder thread
+};
+
+/**
+ * VideoEncoder - Threaded video file writer
+ * write() hands a BGR frame to a bounded queue and returns; a dedicated
+ * thread converts and encodes, so rendering the next frame overlaps
+ * encoding the previous ones and a fast producer blocks once the queue
+ * is full instead of buffering without limit. Frames are queued by
+ * reference, not copied: the caller must not write into a Mat after
+ * passing it (render into a new or pooled Mat per frame).
+ *
+ * Built with libavcodec (WITH_FFMPEG), frames go straight from the Mat
+ * to the encoder's YUV planes through swscale, converted in parallel
+ * bands, and the codec runs with frame and slice threading, x264-style
+ * presets and CRF or a target bitrate. Otherwise, or when libavcodec has
+ * no encoder for the codec, the same queue feeds cv::VideoWriter.
+ */
+class VideoEncoder {
+public:
+    enum class Backend { NONE, LIBAVCODEC, VIDEO_WRITER };
+
+    struct Stats {
+        size_t frames = 0;        // encoded and written
+        double encode_ms = 0.0;   // encoder thread busy time (conversion + encoding)
+        size_t peak_queued = 0;
+    };
+
+    VideoEncoder();
+    ~VideoEncoder();  // closes
+
+    VideoEncoder(const VideoEncoder&) = delete;
+    VideoEncoder& operator=(const VideoEncoder&) = delete;
+
+    static bool libavcodec_available();
+    static const char* backend_name(Backend backend);
+
+    // fps > 0; libavcodec takes even sizes only (4:2:0), odd ones go to cv::VideoWriter
+    bool open(const std::string& path, int width, int height, double fps,
+              const VideoEncoderOptions& options = VideoEncoderOptions());
+    // CV_8UC3 of the opened size; false once an encode failed or the encoder is closed
+    bool write(const cv::Mat& frame);
+    // Drains the queue and finishes the file; false if any frame failed
+    bool close();
+
+    bool is_open() const;
+    Backend backend() const;
+    Stats stats() const;  // final after close()
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace cpp_engine::generators
@@ -1,26 +1,96 @@
 // generators/video_generator.h
 #pragma once
 
+#include "generators/procedural_video.h"
+#include "generators/video_encoder.h"
+#include "optimization/image_encoder.h"
+
+#include <functional>
 #include <string>
 #include <vector>
 
 namespace cpp_engine::generators {
 
+struct VideoRequest {
+    ProceduralKind kind = ProceduralKind::PERLIN;
+    int width = 512;
+    int height = 512;
+    int frames = 60;
+    unsigned int seed = 0;
+    NoiseBackend noise = NoiseBackend::PERLIN;
+    int loop_frames = 0;  // see ProceduralVideoOptions::loop_frames
+};
+
+struct ImageSequenceOptions {
+    int width = 0;                 // output size; 0 (both): the first image's, one of them: keep its aspect
+    int height = 0;
+    double fps = 30.0;
+    int decoders = 0;              // read + decode threads; 0 = hardware concurrency
+    int resizers = 0;              // resize threads; 0 = half the decoders
+    int max_frames_in_flight = 0;  // claimed by a decoder but not yet encoded; 0 = 2 * decoders
+};
+
+struct ImageSequenceStats {
+    int frames = 0;      // written to the video
+    int failed = 0;      // unreadable images, skipped
+    int reused = 0;      // repeats of the previous path, written without decoding
+    int resized = 0;
+    double seconds = 0.0;
+    double decode_ms = 0.0;  // summed over decoder threads
+
+    double fps() const { return seconds > 0.0 ? frames / seconds : 0.0; }
+};
+
+/**
+ * VideoGenerator - Procedural video as a library call
+ * render() streams the frames of a request to a callback in order as they
+ * come out of ProceduralVideo, and encode_frames() streams each frame
+ * encoded (e.g. JPEG for an MJPEG response), so a caller can forward
+ * frames while later ones are still rendering instead of waiting for a
+ * finished file. generate_perlin_video() writes a container through
+ * VideoEncoder (libavcodec when built with it, else cv::VideoWriter)
+ * with the configured codec, preset and rate control.
+ * generate_video_from_images() assembles an image sequence the same
+ * way: decoder threads read and decode (JPEGs at the smallest DCT scale
+ * still covering the output), resize workers bring other sizes to the
+ * output size, and the calling thread restores frame order and encodes.
+ * Frames are claimed within a window of the last encoded one, so memory
+ * stays flat for any sequence length. Like ImageGenerator, calls keep no
+ * state on the instance.
+ */
 class VideoGenerator {
 public:
+    using FrameSink = ProceduralVideo::FrameSink;
+    // Frame index and its encoded bytes, in frame order; returning false stops rendering
+    using EncodedFrameSink = std::function<bool(int index, const std::vector<unsigned char>& bytes)>;
+
     VideoGenerator();
+    explicit VideoGenerator(const ProceduralVideoOptions& options);
     ~VideoGenerator();
-    
+
     void set_codec(const std::string& codec);
-    void set_bitrate(int bitrate);
+    void set_bitrate(int bitrate);  // kbps; 0 selects constant quality (CRF)
+    void set_video_options(const VideoEncoderOptions& options) { video_options_ = options; }
+    void set_encode_options(const cppengine::optimization::EncodeOptions& options) { encode_options_ = options; }
+
+    // False if the request is invalid, a frame failed or the sink stopped early; stats, when given,
+    // gets the render statistics
+    bool render(const VideoRequest& request, const FrameSink& sink, ProceduralVideo::Stats* stats = nullptr) const;
+    bool encode_frames(const VideoRequest& request, const std::string& format, const EncodedFrameSink& sink,
+                       ProceduralVideo::Stats* stats = nullptr) const;
+
     bool generate_perlin_video(int width, int height, int frames, int fps, int seed, const std::string& output_path);
     bool generate_video(const std::string& prompt, const std::string& output_path, int duration_seconds = 10);
+    // Unreadable images are logged and skipped; false if nothing could be written
     bool generate_video_from_images(const std::vector<std::string>& image_paths, const std::string& output_path);
+    bool generate_video_from_images(const std::vector<std::string>& image_paths, const std::string& output_path,
+                                    const ImageSequenceOptions& options, ImageSequenceStats* stats = nullptr);
     std::vector<std::string> get_available_models();
 
 private:
-    std::string codec_;
-    int bitrate_;
+    VideoEncoderOptions video_options_;
+    ProceduralVideoOptions options_;
+    cppengine::optimization::EncodeOptions encode_options_;
 };
 
-} // namespace cpp_engine::generators
\ No newline at end of file
+} // namespace cpp_engine::generators
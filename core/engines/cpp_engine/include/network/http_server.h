@@ -24,6 +24,7 @@ public:
         std::string cpp_bin;
         int default_timeout_seconds = 60;
         int retention_seconds = 3600;
+        bool memfd_handoff = false;  // allow /process "handoff": "memfd" (Linux)
     };
 
     /**
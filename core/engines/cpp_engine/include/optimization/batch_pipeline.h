@@ -0,0 +1,79 @@
+#ifndef CPP_ENGINE_OPTIMIZATION_BATCH_PIPELINE_H
+#define CPP_ENGINE_OPTIMIZATION_BATCH_PIPELINE_H
+
+#include "optimization/image_encoder.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cv { class Mat; }
+
+namespace cppengine {
+namespace optimization {
+
+/**
+ * BatchPipeline - Overlapped decode/process/encode over many images
+ * Decoder threads read and decode, a worker pool processes, encoder threads
+ * encode and write; stages are connected by bounded queues so memory stays
+ * flat and codec I/O overlaps with processing.
+ */
+class BatchPipeline {
+public:
+    struct Config {
+        int decoder_threads = 0;   // 0 = derived from hardware concurrency
+        int worker_threads = 0;
+        int encoder_threads = 0;
+        size_t queue_capacity = 0; // 0 = 2 * worker_threads
+        int progress_every = 100;  // images between progress lines, 0 = quiet
+        bool report_encodes = false;  // an "[encode] ..." line per written image, as single-image commands print
+        EncodeOptions encode;
+        int decode_width = 0;      // > 0: JPEGs may be decoded reduced down to this size
+        int decode_height = 0;
+    };
+
+    struct Job {
+        std::string input_file;
+        std::string output_file;
+    };
+
+    struct Stats {
+        size_t images_total = 0;
+        size_t images_ok = 0;
+        size_t images_failed = 0;
+        uint64_t bytes_in = 0;
+        uint64_t bytes_out = 0;
+        double seconds = 0.0;
+        double encode_ms = 0.0;    // summed over encoder threads
+
+        double images_per_second() const;
+        double mb_per_second() const;  // input + output bytes
+    };
+
+    // One processor per worker thread, so processors may keep per-thread scratch state
+    using Processor = std::function<bool(const cv::Mat& image, cv::Mat& result)>;
+    using ProcessorFactory = std::function<Processor()>;
+
+    BatchPipeline();
+    explicit BatchPipeline(const Config& config);
+    ~BatchPipeline();
+
+    Stats run(const std::vector<Job>& jobs, const ProcessorFactory& make_processor);
+
+    // Expand a directory (image files, sorted) or a text file with one path per line
+    static std::vector<std::string> collect_inputs(const std::string& dir_or_list);
+
+    // Map inputs to output_dir, keeping each path relative to the inputs' common directory
+    // (plain file names for a flat directory); creates the output directories. Inputs that
+    // would still share an output (the same file listed twice) get a _<n> suffix and a warning
+    static std::vector<Job> make_jobs(const std::vector<std::string>& inputs, const std::string& output_dir);
+
+private:
+    Config config_;
+};
+
+} // namespace optimization
+} // namespace cppengine
+
+#endif // CPP_ENGINE_OPTIMIZATION_BATCH_PIPELINE_H
@@ -0,0 +1,129 @@
+#ifndef CPP_ENGINE_OPTIMIZATION_FRAME_POOL_H
+#define CPP_ENGINE_OPTIMIZATION_FRAME_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cv {
+class Mat;
+class MatAllocator;
+}
+
+namespace cppengine {
+namespace optimization {
+
+struct FramePoolOptions {
+    size_t max_cached_bytes = size_t(1) << 30;  // free blocks kept for reuse; beyond that, releases go back to the OS
+    bool huge_pages = false;                     // blocks >= 2 MB: 2 MB aligned + MADV_HUGEPAGE (transparent huge pages)
+};
+
+/**
+ * FramePool - Size-class pool for image buffers
+ * Requests are rounded up to a class (powers of two up to 4 KB, then four
+ * classes per octave, at most 25% slack) and served from that class's free
+ * list; released blocks are kept for the next request of the same class, so
+ * a video loop that allocates the same temporaries every frame stops calling
+ * malloc and page-faulting after the first frame. Blocks of 2 MB and more are
+ * mmap'd and may be backed by huge pages. Thread-safe.
+ *
+ * Mats reach the pool through allocator(): either mat() for one buffer or
+ * ScopedFramePool to make it the default for every cv::Mat created meanwhile.
+ * The block goes back to the pool when the last Mat referencing it is released.
+ */
+class FramePool {
+public:
+    static constexpr size_t HUGE_PAGE_BYTES = size_t(2) << 20;
+
+    struct Stats {
+        uint64_t hits = 0;        // acquires served from a free list
+        uint64_t misses = 0;      // acquires that allocated a new block
+        uint64_t releases = 0;
+        uint64_t drops = 0;       // releases freed because the cache was full
+        size_t blocks_in_use = 0;
+        size_t bytes_in_use = 0;  // class sizes, not requested sizes
+        size_t peak_bytes_in_use = 0;
+        size_t blocks_cached = 0;
+        size_t bytes_cached = 0;
+        uint64_t huge_page_blocks = 0;  // misses served with huge-page advice
+
+        double hit_rate() const;
+        std::string summary() const;
+    };
+
+    struct ClassOccupancy {
+        size_t block_bytes = 0;
+        size_t in_use = 0;
+        size_t cached = 0;
+    };
+
+    explicit FramePool(const FramePoolOptions& options = FramePoolOptions());
+    // Frees the cached blocks; blocks still in use are leaked rather than freed under a live Mat
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    // Process-wide pool, never destroyed: Mats held by other statics may outlive static destructors
+    static FramePool& instance();
+
+    void* acquire(size_t bytes);
+    void release(void* block, size_t bytes);  // bytes as passed to acquire()
+
+    // Continuous rows x cols Mat over a pooled block
+    cv::Mat mat(int rows, int cols, int type);
+    cv::MatAllocator* allocator();
+
+    void set_options(const FramePoolOptions& options);  // a smaller budget trims the cache now
+    FramePoolOptions options() const;
+    void trim();  // frees every cached block
+    void reset_stats();
+    Stats stats() const;
+    std::vector<ClassOccupancy> occupancy() const;  // classes currently holding blocks, smallest first
+
+    // Size class a request is served from
+    static size_t block_bytes(size_t bytes);
+
+private:
+    struct SizeClass {
+        std::vector<void*> free;  // LIFO: the most recently released block is the warmest
+        size_t in_use = 0;
+    };
+
+    static size_t class_index(size_t bytes);
+    static size_t class_bytes(size_t index);
+    static void* allocate_block(size_t bytes, bool huge_pages, bool& huge);
+    static void free_block(void* block, size_t bytes);
+    void drop_cached_locked(size_t budget);
+
+    mutable std::mutex mutex_;
+    FramePoolOptions options_;
+    std::vector<SizeClass> classes_;
+    Stats stats_;
+    std::unique_ptr<cv::MatAllocator> allocator_;
+};
+
+/**
+ * ScopedFramePool - Makes a pool the default cv::Mat allocator for a scope
+ * Mats created inside keep drawing from / returning to the pool after the
+ * scope ends; only new allocations go back to the previous allocator.
+ */
+class ScopedFramePool {
+public:
+    explicit ScopedFramePool(FramePool& pool = FramePool::instance());
+    ~ScopedFramePool();
+
+    ScopedFramePool(const ScopedFramePool&) = delete;
+    ScopedFramePool& operator=(const ScopedFramePool&) = delete;
+
+private:
+    cv::MatAllocator* previous_;
+};
+
+} // namespace optimization
+} // namespace cppengine
+
+#endif // CPP_ENGINE_OPTIMIZATION_FRAME_POOL_H
@@ -0,0 +1,61 @@
+#ifndef CPP_ENGINE_OPTIMIZATION_IMAGE_ENCODER_H
+#define CPP_ENGINE_OPTIMIZATION_IMAGE_ENCODER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cv { class Mat; }
+
+namespace cppengine {
+namespace optimization {
+
+enum class EncodeProfile {
+    AUTO,       // resolved from the latency budget at encode time
+    FASTEST,
+    BALANCED,
+    SMALLEST
+};
+
+struct EncodeOptions {
+    EncodeProfile profile = EncodeProfile::BALANCED;
+    double latency_budget_ms = 0.0;  // only used by AUTO; <= 0 means BALANCED
+};
+
+struct EncodeResult {
+    bool success = false;
+    std::string format;                                // extension without dot: png, jpg, webp...
+    EncodeProfile profile = EncodeProfile::BALANCED;   // never AUTO once resolved
+    size_t bytes = 0;
+    double encode_ms = 0.0;
+
+    // One parseable line, e.g. "[encode] format=png profile=fastest bytes=1234 encode_ms=5.20"
+    std::string summary() const;
+};
+
+/**
+ * ImageEncoder - Profile-driven encoding in place of bare cv::imwrite
+ * Profiles map to PNG compression level/strategy, JPEG quality/optimized
+ * Huffman and WebP quality. AUTO picks the smallest output whose predicted
+ * encode time fits the latency budget, using per-format costs that are
+ * refined from every measured encode.
+ */
+class ImageEncoder {
+public:
+    static EncodeProfile parse_profile(const std::string& name);  // throws std::invalid_argument
+    static std::string profile_name(EncodeProfile profile);
+
+    static std::vector<int> params_for(const std::string& format, EncodeProfile profile);
+    static EncodeProfile select_profile(const std::string& format, size_t pixels, double latency_budget_ms);
+    static double predicted_ms(const std::string& format, EncodeProfile profile, size_t pixels);
+
+    // format may be "png", ".png" or a file name/path with that extension
+    static EncodeResult encode(const cv::Mat& image, const std::string& format,
+                               const EncodeOptions& options, std::vector<unsigned char>& out);
+    static EncodeResult write(const std::string& output_file, const cv::Mat& image, const EncodeOptions& options);
+};
+
+} // namespace optimization
+} // namespace cppengine
+
+#endif // CPP_ENGINE_OPTIMIZATION_IMAGE_ENCODER_H
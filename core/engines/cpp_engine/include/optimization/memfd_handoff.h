@@ -0,0 +1,30 @@
+#ifndef CPP_ENGINE_OPTIMIZATION_MEMFD_HANDOFF_H
+#define CPP_ENGINE_OPTIMIZATION_MEMFD_HANDOFF_H
+
+#include "optimization/image_encoder.h"
+
+#include <string>
+
+namespace cv { class Mat; }
+
+namespace cppengine {
+namespace optimization {
+
+/**
+ * MemfdHandoff - Image I/O through inherited memfds instead of files
+ * A spec is either a path or "fd:<n>[.<ext>]". Input fds are decoded straight
+ * from a read-only mapping; output fds receive the encoded bytes (format from
+ * ext, png by default) and are sealed so the parent sees a final image.
+ */
+class MemfdHandoff {
+public:
+    static bool is_fd_spec(const std::string& spec);
+
+    static bool load(const std::string& spec, cv::Mat& image);
+    static EncodeResult store(const std::string& spec, const cv::Mat& image, const EncodeOptions& options);
+};
+
+} // namespace optimization
+} // namespace cppengine
+
+#endif // CPP_ENGINE_OPTIMIZATION_MEMFD_HANDOFF_H
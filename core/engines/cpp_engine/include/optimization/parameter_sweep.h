@@ -0,0 +1,61 @@
+#ifndef CPP_ENGINE_OPTIMIZATION_PARAMETER_SWEEP_H
+#define CPP_ENGINE_OPTIMIZATION_PARAMETER_SWEEP_H
+
+#include "optimization/image_encoder.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cv { class Mat; }
+
+namespace cppengine {
+namespace optimization {
+
+/**
+ * ParameterSweep - Many parameter variants of one operation from one decode
+ * Operations with shared intermediate state compute it once per sweep:
+ *   blur        one summed-area table, every radius is four lookups per pixel
+ *   saturation  one BGR->HSV conversion, a per-factor LUT on the S plane
+ *   brightness, contrast  a 256-entry LUT per value
+ *   bloom       one bright-pass glow per threshold (default BloomOptions)
+ *               shared by every intensity using it (params threshold:intensity)
+ * Other operations go through the fallback, still without decoding again.
+ */
+class ParameterSweep {
+public:
+    using Params = std::vector<float>;
+    using Fallback = std::function<bool(const cv::Mat& image, const Params& params, cv::Mat& result)>;
+
+    struct Output {
+        std::string file;
+        EncodeResult encode;
+    };
+
+    ParameterSweep();
+    ~ParameterSweep();
+
+    void set_encode_options(const EncodeOptions& options) { encode_options_ = options; }
+    void set_fallback(Fallback fallback) { fallback_ = std::move(fallback); }
+
+    static bool has_shared_state(const std::string& op);
+    // "0.8:0.3" -> {0.8, 0.3}; throws std::invalid_argument
+    static Params parse_params(const std::string& variant);
+
+    bool run(const std::string& op, const cv::Mat& image, const std::vector<Params>& variants,
+             std::vector<cv::Mat>& results);
+
+    // Decodes input_file once and writes <stem>_<op>_<variant><ext> next to output_file
+    bool run(const std::string& op, const std::string& input_file, const std::string& output_file,
+             const std::vector<std::string>& variants, std::vector<Output>& outputs);
+
+private:
+    EncodeOptions encode_options_;
+    Fallback fallback_;
+};
+
+} // namespace optimization
+} // namespace cppengine
+
+#endif // CPP_ENGINE_OPTIMIZATION_PARAMETER_SWEEP_H
@@ -0,0 +1,79 @@
+#ifndef CPP_ENGINE_OPTIMIZATION_VIDEO_PIPELINE_H
+#define CPP_ENGINE_OPTIMIZATION_VIDEO_PIPELINE_H
+
+#include "generators/video_encoder.h"
+
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <opencv2/core.hpp>
+
+namespace cppengine {
+namespace optimization {
+
+/**
+ * VideoPipeline - Overlapped decode/transform/encode over the frames of one video
+ * A dedicated thread decodes, a pool transforms frames concurrently and the
+ * calling thread takes them back in sequence order for the encoder, so a
+ * run costs about the slowest stage per frame instead of the sum of all
+ * three. Stages are connected by bounded rings; frame buffers come from
+ * the FramePool and go back to it once encoded. The decoder never gets more
+ * than ring_frames ahead of the last frame delivered, which bounds the
+ * reorder buffer too. The first stage to fail stops the run.
+ */
+class VideoPipeline {
+public:
+    struct Config {
+        int transform_threads = 0;  // 0 = hardware concurrency
+        size_t ring_frames = 0;     // frames in flight between decode and delivery; 0 = 2 * transform_threads
+        cpp_engine::generators::VideoEncoderOptions encode;  // run(input, output, ...) only
+    };
+
+    struct Frame {
+        int64_t sequence = 0;
+        cv::Mat image;
+        std::any context;  // per-frame state from the source for the transform, e.g. a simulation snapshot
+    };
+
+    struct Stats {
+        bool ok = false;
+        size_t frames = 0;          // delivered to the sink
+        double seconds = 0.0;
+        double decode_ms = 0.0;
+        double transform_ms = 0.0;  // summed over transform threads
+        double encode_ms = 0.0;     // in the sink; run(input, output): the encoder thread's busy time
+        size_t peak_reorder = 0;    // frames held back waiting for an earlier one
+
+        double fps() const;
+        // Per-frame cost of each stage; a pipelined run approaches the largest
+        std::string summary() const;
+    };
+
+    // Decode thread: fills frame.image (and context) with the next frame; false at the end
+    using Source = std::function<bool(Frame& frame)>;
+    // Transform threads; out starts as a pooled buffer of the input's size and type
+    using Transform = std::function<bool(Frame& frame, cv::Mat& out)>;
+    // One transform per thread, so transforms may keep per-thread scratch state
+    using TransformFactory = std::function<Transform()>;
+    // Calling thread, in sequence order; false stops the run
+    using Sink = std::function<bool(int64_t sequence, const cv::Mat& frame)>;
+
+    VideoPipeline();
+    explicit VideoPipeline(const Config& config);
+    ~VideoPipeline();
+
+    Stats run(const Source& source, const TransformFactory& make_transform, const Sink& sink);
+    // cv::VideoCapture in, VideoEncoder out at the input's size and frame rate
+    Stats run(const std::string& input_file, const std::string& output_file, const TransformFactory& make_transform);
+
+private:
+    Config config_;
+};
+
+} // namespace optimization
+} // namespace cppengine
+
+#endif // CPP_ENGINE_OPTIMIZATION_VIDEO_PIPELINE_H
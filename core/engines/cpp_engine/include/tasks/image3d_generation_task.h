@@ -3,6 +3,7 @@
  * @class Image3DGenerationTask
  * @brief Génération d'images 3D.
  */
+#include <cstddef>
 #include <string>
 #include <stdexcept>
 
@@ -11,9 +12,17 @@ public:
     Image3DGenerationTask();
     ~Image3DGenerationTask();
     void configure(const std::string& modelPath);
+    // Grille du marching cubes (cellules par axe) et graine du bruit
+    void set_resolution(int resolution);
+    void set_seed(unsigned int seed);
+    // Nombre de triangles visé après simplification (0: maillage complet)
+    void set_target_triangles(size_t target);
     bool run(const std::string& outputPath);
     void log(const std::string& message) const;
 private:
     std::string modelPath_;
     bool configured_;
+    int resolution_;
+    unsigned int seed_;
+    size_t targetTriangles_;
 };
@@ -1,9 +1,11 @@
 #ifndef CPP_ENGINE_UTILS_LOGGER_H
 #define CPP_ENGINE_UTILS_LOGGER_H
 
+#include <atomic>
 #include <string>
 #include <fstream>
 #include <memory>
+#include <mutex>
 
 namespace cpp_engine {
 namespace utils {
@@ -39,7 +41,8 @@ private:
     void log(LogLevel level, const std::string& message);
     
     std::ofstream log_file_;
-    LogLevel level_;
+    std::atomic<LogLevel> level_{LogLevel::INFO};  // checked before taking the mutex
+    std::mutex mutex_;  // pipelines log from many threads
 };
 
 } // namespace utils
@@ -0,0 +1,63 @@
+#ifndef CPP_ENGINE_UTILS_SHARED_MEMORY_H
+#define CPP_ENGINE_UTILS_SHARED_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cppengine {
+namespace utils {
+
+/**
+ * SharedMemoryBuffer - Anonymous memfd used to hand image bytes to a child process
+ * The producer writes once and seals the buffer (no grow/shrink/write), the
+ * consumer maps it read-only. Nothing touches a filesystem or the page cache
+ * of a disk. Descriptors are close-on-exec; use inherit() in the forked child
+ * for the ones exec'd code should see. Linux only; elsewhere create() fails.
+ */
+class SharedMemoryBuffer {
+public:
+    SharedMemoryBuffer();
+    explicit SharedMemoryBuffer(int fd);  // takes ownership
+    ~SharedMemoryBuffer();
+
+    SharedMemoryBuffer(const SharedMemoryBuffer&) = delete;
+    SharedMemoryBuffer& operator=(const SharedMemoryBuffer&) = delete;
+    SharedMemoryBuffer(SharedMemoryBuffer&& other) noexcept;
+    SharedMemoryBuffer& operator=(SharedMemoryBuffer&& other) noexcept;
+
+    bool create(const std::string& name);
+    bool write(const void* data, size_t size);  // replaces the content
+    // Replaces the content with a regular file's, copied in the kernel (copy_file_range, else
+    // sendfile) without passing through user space; bytes receives the size copied
+    bool write_file(const std::string& path, size_t* bytes = nullptr);
+    bool seal();
+    bool is_sealed() const;
+
+    // Read-only view of the whole content, valid until the next write/seal/map/close
+    bool map();
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    int fd() const { return fd_; }
+    bool valid() const { return fd_ >= 0; }
+    void close();
+
+    // Clears close-on-exec on fd; call between fork() and exec()
+    static bool inherit(int fd);
+
+    // Parses "fd:<n>" or "fd:<n>.<ext>" command-line specs; ext may be null
+    static bool parse_fd_spec(const std::string& spec, int& fd, std::string* ext);
+
+private:
+    void unmap();
+
+    int fd_;
+    uint8_t* data_;
+    size_t size_;
+};
+
+} // namespace utils
+} // namespace cppengine
+
+#endif // CPP_ENGINE_UTILS_SHARED_MEMORY_H
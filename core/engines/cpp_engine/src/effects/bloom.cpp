@@ -0,0 +1,75 @@
+#include "effects/bloom.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace cppengine {
+namespace effects {
+
+bool Bloom::parse_mode(const std::string& name, BloomMode& mode) {
+    if (name == "gaussian") {
+        mode = BloomMode::GAUSSIAN;
+    } else if (name == "pyramid") {
+        mode = BloomMode::PYRAMID;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int Bloom::pyramid_levels(int radius, int rows, int cols) {
+    // Level k blurs over roughly 2^(k+1) source pixels
+    const int wanted = std::max(1, static_cast<int>(std::ceil(std::log2(std::max(2, radius) / 2.0))));
+    int levels = 0;
+    for (int r = rows, c = cols; levels < wanted && std::min(r, c) >= 4; ++levels) {
+        r = (r + 1) / 2;
+        c = (c + 1) / 2;
+    }
+    return std::max(1, levels);
+}
+
+void Bloom::glow(const cv::Mat& image, float threshold, const BloomOptions& options, cv::Mat& glow) {
+    if (options.mode == BloomMode::GAUSSIAN) {
+        cv::Mat float_image, bright_areas;
+        image.convertTo(float_image, CV_32FC3, 1.0 / 255.0);
+        cv::threshold(float_image, bright_areas, threshold, 1.0, cv::THRESH_BINARY);
+        const int k = 2 * std::max(1, options.radius) + 1;
+        cv::GaussianBlur(bright_areas, glow, cv::Size(k, k), 0);
+        return;
+    }
+
+    // Same bright pass as the float threshold: v / 255 > t  <=>  v > 255 t
+    const int levels = pyramid_levels(options.radius, image.rows, image.cols);
+    std::vector<cv::Mat> mips(levels + 1);
+    cv::threshold(image, mips[0], threshold * 255.0, 255, cv::THRESH_BINARY);
+    for (int k = 1; k <= levels; ++k) cv::pyrDown(mips[k - 1], mips[k]);
+
+    // Each level contributes equally; the sum stays at half size until the last step
+    cv::Mat acc, up;
+    mips[levels].convertTo(acc, CV_32F);
+    for (int k = levels - 1; k >= 1; --k) {
+        cv::pyrUp(acc, up, mips[k].size());
+        cv::add(up, mips[k], acc, cv::noArray(), CV_32F);
+    }
+    cv::Mat half;
+    acc.convertTo(half, CV_8U, 1.0 / levels);
+    cv::pyrUp(half, glow, image.size());
+}
+
+void Bloom::combine(const cv::Mat& image, const cv::Mat& glow, float intensity, const BloomOptions& options,
+                    cv::Mat& output) {
+    if (options.mode == BloomMode::GAUSSIAN) {
+        cv::Mat float_image, combined;
+        image.convertTo(float_image, CV_32FC3, 1.0 / 255.0);
+        cv::addWeighted(float_image, 1.0, glow, intensity, 0.0, combined);
+        combined.convertTo(output, CV_8UC3, 255.0);
+        return;
+    }
+    cv::addWeighted(image, 1.0, glow, intensity, 0.0, output);
+}
+
+} // namespace effects
+} // namespace cppengine
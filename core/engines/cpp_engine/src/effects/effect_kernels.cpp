@@ -0,0 +1,249 @@
+#include "effects/effect_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace cppengine {
+namespace effects {
+namespace kernels {
+
+namespace {
+
+// cv::saturate_cast<uchar>(float): round half to even, then clamp
+inline uint8_t round_u8(float v) {
+    const long r = std::lrint(v);
+    return static_cast<uint8_t>(r < 0 ? 0 : (r > 255 ? 255 : r));
+}
+
+inline float lighting_intensity(float gx, float gy, const float light[3]) {
+    const float nx = gx / 255.0f, ny = gy / 255.0f;
+    const float norm = std::sqrt(nx * nx + ny * ny + 1.0f);
+    const float dot = (nx / norm) * light[0] + (ny / norm) * light[1] + (1.0f / norm) * light[2];
+    return std::max(0.3f, dot * 0.7f + 0.3f);
+}
+
+void expand_factors(const float* per_pixel, float* factors, int cols, int channels) {
+    if (channels == 3) {
+        for (int j = 0; j < cols; ++j) {
+            factors[3 * j] = factors[3 * j + 1] = factors[3 * j + 2] = per_pixel[j];
+        }
+        return;
+    }
+    for (int j = 0; j < cols; ++j) {
+        for (int c = 0; c < channels; ++c) factors[j * channels + c] = per_pixel[j];
+    }
+}
+
+// One output byte of chromatic_row, bounds-checked
+inline uint8_t chromatic_byte(const uint8_t* src, int cols, int i, const ShiftTap& blue_tap, const ShiftTap& red_tap) {
+    const int c = i % 3;
+    if (c == 1) return src[i];
+    const ShiftTap& tap = c == 0 ? blue_tap : red_tap;
+    const int xs = i / 3 + tap.offset;
+    const int s0 = (xs >= 0 && xs < cols) ? src[3 * xs + c] : 0;
+    const int s1 = (xs + 1 >= 0 && xs + 1 < cols) ? src[3 * (xs + 1) + c] : 0;
+    return static_cast<uint8_t>((s0 * (32 - tap.frac) + s1 * tap.frac + 16) >> 5);
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+// Byte masks selecting channel c of a BGR run that starts at channel phase p
+struct ChannelMasks {
+    alignas(32) uint8_t bytes[3][3][32];
+    ChannelMasks() {
+        for (int p = 0; p < 3; ++p)
+            for (int c = 0; c < 3; ++c)
+                for (int t = 0; t < 32; ++t) bytes[p][c][t] = (p + t) % 3 == c ? 0xFF : 0x00;
+    }
+};
+const ChannelMasks CHANNEL_MASKS;
+#endif
+
+} // namespace
+
+void multiply_row(const uint8_t* src, const float* factors, uint8_t* dst, int n) {
+    int i = 0;
+#if defined(__AVX2__)
+    for (; i + 16 <= n; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m256 lo = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)), _mm256_loadu_ps(factors + i));
+        const __m256 hi = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8))),
+                                        _mm256_loadu_ps(factors + i + 8));
+        const __m256i lo32 = _mm256_cvtps_epi32(lo), hi32 = _mm256_cvtps_epi32(hi);
+        const __m128i lo16 = _mm_packs_epi32(_mm256_castsi256_si128(lo32), _mm256_extracti128_si256(lo32, 1));
+        const __m128i hi16 = _mm_packs_epi32(_mm256_castsi256_si128(hi32), _mm256_extracti128_si256(hi32, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo16, hi16));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        const __m128i words = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)), zero);
+        const __m128 lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero)), _mm_loadu_ps(factors + i));
+        const __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(words, zero)), _mm_loadu_ps(factors + i + 4));
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(packed, packed));
+    }
+#endif
+    for (; i < n; ++i) dst[i] = round_u8(src[i] * factors[i]);
+}
+
+void lighting_row(const uint8_t* src, const float* grad_x, const float* grad_y, uint8_t* dst,
+                  int cols, int channels, bool flat_row, const float light[3], float* scratch) {
+    float* intensity = scratch;
+    float* factors = scratch + cols;
+    const float flat = std::max(0.3f, light[2] * 0.7f + 0.3f);
+
+    if (flat_row) {
+        std::fill(intensity, intensity + cols, flat);
+    } else if (cols > 0) {
+        intensity[0] = flat;
+        int j = 1;
+#if defined(__AVX2__)
+        {
+            const __m256 k255 = _mm256_set1_ps(255.0f), one = _mm256_set1_ps(1.0f);
+            const __m256 lx = _mm256_set1_ps(light[0]), ly = _mm256_set1_ps(light[1]), lz = _mm256_set1_ps(light[2]);
+            const __m256 k07 = _mm256_set1_ps(0.7f), k03 = _mm256_set1_ps(0.3f);
+            for (; j + 8 <= cols; j += 8) {
+                const __m256 nx = _mm256_div_ps(_mm256_loadu_ps(grad_x + j), k255);
+                const __m256 ny = _mm256_div_ps(_mm256_loadu_ps(grad_y + j), k255);
+                const __m256 norm = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, nx), _mm256_mul_ps(ny, ny)), one));
+                __m256 dot = _mm256_mul_ps(_mm256_div_ps(nx, norm), lx);
+                dot = _mm256_add_ps(dot, _mm256_mul_ps(_mm256_div_ps(ny, norm), ly));
+                dot = _mm256_add_ps(dot, _mm256_mul_ps(_mm256_div_ps(one, norm), lz));
+                _mm256_storeu_ps(intensity + j, _mm256_max_ps(k03, _mm256_add_ps(_mm256_mul_ps(dot, k07), k03)));
+            }
+        }
+#endif
+#if defined(__SSE2__)
+        {
+            const __m128 k255 = _mm_set1_ps(255.0f), one = _mm_set1_ps(1.0f);
+            const __m128 lx = _mm_set1_ps(light[0]), ly = _mm_set1_ps(light[1]), lz = _mm_set1_ps(light[2]);
+            const __m128 k07 = _mm_set1_ps(0.7f), k03 = _mm_set1_ps(0.3f);
+            for (; j + 4 <= cols; j += 4) {
+                const __m128 nx = _mm_div_ps(_mm_loadu_ps(grad_x + j), k255);
+                const __m128 ny = _mm_div_ps(_mm_loadu_ps(grad_y + j), k255);
+                const __m128 norm = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), one));
+                __m128 dot = _mm_mul_ps(_mm_div_ps(nx, norm), lx);
+                dot = _mm_add_ps(dot, _mm_mul_ps(_mm_div_ps(ny, norm), ly));
+                dot = _mm_add_ps(dot, _mm_mul_ps(_mm_div_ps(one, norm), lz));
+                _mm_storeu_ps(intensity + j, _mm_max_ps(k03, _mm_add_ps(_mm_mul_ps(dot, k07), k03)));
+            }
+        }
+#endif
+        for (; j < cols; ++j) intensity[j] = lighting_intensity(grad_x[j], grad_y[j], light);
+    }
+
+    expand_factors(intensity, factors, cols, channels);
+    multiply_row(src, factors, dst, cols * channels);
+}
+
+void shadow_row(const uint8_t* src, const uint8_t* mask, uint8_t* dst, int cols, int channels,
+                const float lut[256], float* scratch) {
+    if (channels == 3) {
+        for (int j = 0; j < cols; ++j) {
+            scratch[3 * j] = scratch[3 * j + 1] = scratch[3 * j + 2] = lut[mask[j]];
+        }
+    } else {
+        for (int j = 0; j < cols; ++j) {
+            for (int c = 0; c < channels; ++c) scratch[j * channels + c] = lut[mask[j]];
+        }
+    }
+    multiply_row(src, scratch, dst, cols * channels);
+}
+
+ShiftTap make_shift_tap(float source_offset) {
+    const long q = std::lround(static_cast<double>(source_offset) * 32.0);
+    ShiftTap tap;
+    tap.offset = static_cast<int>(q >= 0 ? q / 32 : -((-q + 31) / 32));
+    tap.frac = static_cast<int>(q - static_cast<long>(tap.offset) * 32);
+    return tap;
+}
+
+void chromatic_row(const uint8_t* src, uint8_t* dst, int cols, const ShiftTap& blue_tap, const ShiftTap& red_tap) {
+    const int bytes = cols * 3;
+    // Pixels whose taps (x + offset, x + offset + 1) are inside the row for both channels
+    const int kmin = std::min({0, blue_tap.offset, red_tap.offset});
+    const int kmax = std::max({0, blue_tap.offset, red_tap.offset});
+    const int x_lo = std::min(-kmin, cols);
+    const int x_hi = std::max(x_lo, cols - kmax - 1);
+    const int b_lo = 3 * x_lo;
+    [[maybe_unused]] const int b_hi = 3 * x_hi;
+
+    int i = 0;
+    for (; i < b_lo; ++i) dst[i] = chromatic_byte(src, cols, i, blue_tap, red_tap);
+
+#if defined(__AVX2__)
+    {
+        const __m256i zero = _mm256_setzero_si256(), round = _mm256_set1_epi16(16);
+        const __m256i bw0 = _mm256_set1_epi16(static_cast<short>(32 - blue_tap.frac));
+        const __m256i bw1 = _mm256_set1_epi16(static_cast<short>(blue_tap.frac));
+        const __m256i rw0 = _mm256_set1_epi16(static_cast<short>(32 - red_tap.frac));
+        const __m256i rw1 = _mm256_set1_epi16(static_cast<short>(red_tap.frac));
+        auto blend = [&](const uint8_t* p, __m256i w0, __m256i w1) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 3));
+            const __m256i lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), w0),
+                _mm256_mullo_epi16(_mm256_unpacklo_epi8(b, zero), w1)), round), 5);
+            const __m256i hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), w0),
+                _mm256_mullo_epi16(_mm256_unpackhi_epi8(b, zero), w1)), round), 5);
+            return _mm256_packus_epi16(lo, hi);  // per-lane unpack/pack keeps byte order
+        };
+        for (; i + 32 <= b_hi; i += 32) {
+            const int phase = i % 3;
+            const __m256i* m = reinterpret_cast<const __m256i*>(CHANNEL_MASKS.bytes[phase][0]);
+            const __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            const __m256i b = blend(src + i + 3 * blue_tap.offset, bw0, bw1);
+            const __m256i r = blend(src + i + 3 * red_tap.offset, rw0, rw1);
+            const __m256i out = _mm256_or_si256(_mm256_or_si256(
+                _mm256_and_si256(b, _mm256_load_si256(m)),
+                _mm256_and_si256(g, _mm256_load_si256(m + 1))),
+                _mm256_and_si256(r, _mm256_load_si256(m + 2)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128i zero = _mm_setzero_si128(), round = _mm_set1_epi16(16);
+        const __m128i bw0 = _mm_set1_epi16(static_cast<short>(32 - blue_tap.frac));
+        const __m128i bw1 = _mm_set1_epi16(static_cast<short>(blue_tap.frac));
+        const __m128i rw0 = _mm_set1_epi16(static_cast<short>(32 - red_tap.frac));
+        const __m128i rw1 = _mm_set1_epi16(static_cast<short>(red_tap.frac));
+        auto blend = [&](const uint8_t* p, __m128i w0, __m128i w1) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 3));
+            const __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(
+                _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), w0),
+                _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), w1)), round), 5);
+            const __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(
+                _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), w0),
+                _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), w1)), round), 5);
+            return _mm_packus_epi16(lo, hi);
+        };
+        for (; i + 16 <= b_hi; i += 16) {
+            const int phase = i % 3;
+            const __m128i* m0 = reinterpret_cast<const __m128i*>(CHANNEL_MASKS.bytes[phase][0]);
+            const __m128i* m1 = reinterpret_cast<const __m128i*>(CHANNEL_MASKS.bytes[phase][1]);
+            const __m128i* m2 = reinterpret_cast<const __m128i*>(CHANNEL_MASKS.bytes[phase][2]);
+            const __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i b = blend(src + i + 3 * blue_tap.offset, bw0, bw1);
+            const __m128i r = blend(src + i + 3 * red_tap.offset, rw0, rw1);
+            const __m128i out = _mm_or_si128(_mm_or_si128(
+                _mm_and_si128(b, _mm_load_si128(m0)), _mm_and_si128(g, _mm_load_si128(m1))),
+                _mm_and_si128(r, _mm_load_si128(m2)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+        }
+    }
+#endif
+    for (; i < bytes; ++i) dst[i] = chromatic_byte(src, cols, i, blue_tap, red_tap);
+}
+
+} // namespace kernels
+} // namespace effects
+} // namespace cppengine
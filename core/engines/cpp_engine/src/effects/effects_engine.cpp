@@ -1,90 +1,234 @@
 #include "effects/effects_engine.h"
+#include "effects/bloom.h"
+#include "effects/effect_kernels.h"
+#include "effects/particle_system.h"
+#include "effects/remap_cache.h"
+#include "generators/video_encoder.h"
 #include "utils/logger.h"
+#include "optimization/frame_pool.h"
+#include "optimization/image_encoder.h"
+#include "optimization/video_pipeline.h"
 #include <opencv2/opencv.hpp>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/highgui.hpp>
 #include <cmath>
-#include <random>
+#include <algorithm>
 
 namespace cppengine {
 namespace effects {
 
+namespace {
+
+bool load_image(const std::string& input_file, cv::Mat& image) {
+    try {
+        image = cv::imread(input_file);
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error loading " + input_file + ": " + std::string(e.what()));
+        return false;
+    }
+    if (image.empty()) {
+        cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
+        return false;
+    }
+    return true;
+}
+
+bool save_image(const std::string& output_file, const cv::Mat& image, const std::string& what,
+                const optimization::EncodeOptions& options, optimization::EncodeResult& encoded) {
+    encoded = optimization::ImageEncoder::write(output_file, image, options);
+    if (!encoded.success) {
+        cpp_engine::utils::Logger::instance().error("Failed to save " + what + " image: " + output_file);
+        return false;
+    }
+    return true;
+}
+
+// One gather pass over row bands; tables index continuous 8-bit images
+bool apply_remap(const RemapTable& table, const cv::Mat& image, cv::Mat& result, const std::string& what) {
+    if (image.depth() != CV_8U) {
+        cpp_engine::utils::Logger::instance().error(what + " requires an 8-bit image");
+        return false;
+    }
+    const cv::Mat src = image.isContinuous() ? image : image.clone();
+    result.create(image.size(), image.type());
+    cv::parallel_for_(cv::Range(0, image.rows), [&](const cv::Range& range) {
+        table.apply(src.data, result.data, src.channels(), range.start, range.end);
+    });
+    return true;
+}
+
+} // namespace
+
 EffectsEngine::EffectsEngine() : effect_quality_(5) {
     cpp_engine::utils::Logger::instance().info("EffectsEngine initialized with OpenCV");
 }
 
 EffectsEngine::~EffectsEngine() {}
 
+// ============================================================================
+// File variants: decode, run the in-memory effect, encode
+// ============================================================================
+
 bool EffectsEngine::apply_lighting(const std::string& input_file, const std::string& output_file,
                                   float light_x, float light_y, float light_z) {
+    cv::Mat image, result;
+    return load_image(input_file, image) && apply_lighting(image, result, light_x, light_y, light_z) &&
+           save_image(output_file, result, "lit", encode_options_, last_encode_);
+}
+
+bool EffectsEngine::apply_shadows(const std::string& input_file, const std::string& output_file,
+                                 float shadow_intensity) {
+    cv::Mat image, result;
+    return load_image(input_file, image) && apply_shadows(image, result, shadow_intensity) &&
+           save_image(output_file, result, "shadowed", encode_options_, last_encode_);
+}
+
+bool EffectsEngine::add_particles(const std::string& input_file, const std::string& output_file,
+                                 int particle_count, const std::string& particle_type) {
+    cv::Mat image, result;
+    return load_image(input_file, image) && add_particles(image, result, particle_count, particle_type) &&
+           save_image(output_file, result, "particle", encode_options_, last_encode_);
+}
+
+bool EffectsEngine::add_particles_video(const std::string& input_file, const std::string& output_file,
+                                        int particle_count, const std::string& particle_type) {
+    try {
+        cv::VideoCapture capture(input_file);
+        if (!capture.isOpened()) {
+            cpp_engine::utils::Logger::instance().error("Failed to open video: " + input_file);
+            return false;
+        }
+        const int width = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH));
+        const int height = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+        double fps = capture.get(cv::CAP_PROP_FPS);
+        if (!(fps > 0.0)) fps = 30.0;
+
+        // Same MPEG-4 Part 2 output as before; with libavcodec it is slice-threaded off this thread
+        cpp_engine::generators::VideoEncoderOptions video;
+        video.codec = "mp4v";
+        cpp_engine::generators::VideoEncoder writer;
+        if (!writer.open(output_file, width, height, fps, video)) {
+            cpp_engine::utils::Logger::instance().error("Failed to create video: " + output_file);
+            return false;
+        }
+
+        const ParticleStyle style = ParticleStyle::for_type(particle_type);
+        ParticleSystem system(style, width, height, particle_seed_);
+        system.set_population(static_cast<size_t>(std::max(0, particle_count)));
+        // Pre-roll one lifetime so the first frame is already at steady state
+        const float dt = static_cast<float>(1.0 / fps);
+        for (float t = 0.0f; t < style.life_max; t += dt) system.step(dt);
+
+        cpp_engine::utils::Logger::instance().info("Adding " + particle_type + " particles to " + input_file +
+                                                  ", ~" + std::to_string(particle_count) + " alive");
+        // The simulation steps in frame order on the decode thread; each frame carries its own
+        // snapshot, so frames render concurrently while earlier ones encode
+        using Frame = optimization::VideoPipeline::Frame;
+        optimization::VideoPipeline pipeline;
+        const auto stats = pipeline.run(
+            [&](Frame& frame) {
+                frame.image = optimization::FramePool::instance().mat(height, width, CV_8UC3);
+                if (!capture.read(frame.image)) return false;
+                system.step(dt);
+                frame.context = system;
+                return true;
+            },
+            []() -> optimization::VideoPipeline::Transform {
+                return [](Frame& frame, cv::Mat& out) {
+                    return render_particles(*std::any_cast<ParticleSystem>(&frame.context), frame.image, out);
+                };
+            },
+            [&writer](int64_t, const cv::Mat& frame) { return writer.write(frame); });
+        if (!writer.close() || !stats.ok) return false;
+        cpp_engine::utils::Logger::instance().info("Particle video written: " + stats.summary());
+        return stats.frames > 0;
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error in particle video: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool EffectsEngine::apply_wave_distortion(const std::string& input_file, const std::string& output_file,
+                                         float amplitude, float frequency) {
+    cv::Mat image, result;
+    return load_image(input_file, image) && apply_wave_distortion(image, result, amplitude, frequency) &&
+           save_image(output_file, result, "distorted", encode_options_, last_encode_);
+}
+
+bool EffectsEngine::apply_radial_distortion(const std::string& input_file, const std::string& output_file,
+                                           float distortion_factor) {
+    cv::Mat image, result;
+    return load_image(input_file, image) && apply_radial_distortion(image, result, distortion_factor) &&
+           save_image(output_file, result, "distorted", encode_options_, last_encode_);
+}
+
+bool EffectsEngine::apply_chromatic_aberration(const std::string& input_file, const std::string& output_file,
+                                              float red_shift, float blue_shift) {
+    cv::Mat image, result;
+    return load_image(input_file, image) && apply_chromatic_aberration(image, result, red_shift, blue_shift) &&
+           save_image(output_file, result, "aberrated", encode_options_, last_encode_);
+}
+
+bool EffectsEngine::apply_bloom(const std::string& input_file, const std::string& output_file,
+                               float threshold, float intensity) {
+    cv::Mat image, result;
+    return load_image(input_file, image) && apply_bloom(image, result, threshold, intensity) &&
+           save_image(output_file, result, "bloom", encode_options_, last_encode_);
+}
+
+// ============================================================================
+// In-memory variants
+// ============================================================================
+
+bool EffectsEngine::apply_lighting(const cv::Mat& image, cv::Mat& output,
+                                  float light_x, float light_y, float light_z) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying 3D lighting effects");
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
+        if (image.type() != CV_8UC3) {
+            cpp_engine::utils::Logger::instance().error("Lighting requires an 8-bit BGR image");
             return false;
         }
 
-        cv::Mat result = image.clone();
-
         // Simuler un éclairage directionnel 3D
         cv::Vec3f light_dir(light_x, light_y, light_z);
         cv::normalize(light_dir, light_dir);
+        const float light[3] = {light_dir[0], light_dir[1], light_dir[2]};
 
         // Calculer les normales de surface approximatives
-        cv::Mat gray, grad_x, grad_y, normal_map;
+        cv::Mat gray, grad_x, grad_y;
         cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
         cv::Sobel(gray, grad_x, CV_32F, 1, 0, 3);
         cv::Sobel(gray, grad_y, CV_32F, 0, 1, 3);
 
-        // Appliquer l'éclairage
-        for (int i = 0; i < result.rows; ++i) {
-            for (int j = 0; j < result.cols; ++j) {
-                cv::Vec3f normal(0, 0, 1);
-                if (i > 0 && i < grad_x.rows && j > 0 && j < grad_x.cols) {
-                    normal[0] = grad_x.at<float>(i, j) / 255.0f;
-                    normal[1] = grad_y.at<float>(i, j) / 255.0f;
-                }
-                cv::normalize(normal, normal);
-
-                float dot_product = normal.dot(light_dir);
-                float intensity = std::max(0.3f, dot_product * 0.7f + 0.3f);
-
-                cv::Vec3b pixel = result.at<cv::Vec3b>(i, j);
-                pixel[0] = cv::saturate_cast<uchar>(pixel[0] * intensity);
-                pixel[1] = cv::saturate_cast<uchar>(pixel[1] * intensity);
-                pixel[2] = cv::saturate_cast<uchar>(pixel[2] * intensity);
-                result.at<cv::Vec3b>(i, j) = pixel;
+        // Appliquer l'éclairage par bandes de lignes
+        cv::Mat result(image.size(), image.type());
+        cv::parallel_for_(cv::Range(0, image.rows), [&](const cv::Range& range) {
+            std::vector<float> scratch(static_cast<size_t>(image.cols) * 4);
+            for (int i = range.start; i < range.end; ++i) {
+                kernels::lighting_row(image.ptr<uint8_t>(i), grad_x.ptr<float>(i), grad_y.ptr<float>(i),
+                                      result.ptr<uint8_t>(i), image.cols, 3, i == 0, light, scratch.data());
             }
-        }
+        });
 
-        if (cv::imwrite(output_file, result)) {
-            cpp_engine::utils::Logger::instance().info("3D lighting applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save lit image: " + output_file);
-            return false;
-        }
+        output = result;
+        cpp_engine::utils::Logger::instance().info("3D lighting applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in lighting: " + std::string(e.what()));
         return false;
     }
 }
 
-bool EffectsEngine::apply_shadows(const std::string& input_file, const std::string& output_file,
-                                 float shadow_intensity) {
+bool EffectsEngine::apply_shadows(const cv::Mat& image, cv::Mat& output, float shadow_intensity) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying shadow effects, intensity=" + std::to_string(shadow_intensity));
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
+        if (image.type() != CV_8UC3) {
+            cpp_engine::utils::Logger::instance().error("Shadow effect requires an 8-bit BGR image");
             return false;
         }
 
-        cv::Mat result = image.clone();
-
         // Créer une ombre directionnelle
         cv::Mat shadow_mask = cv::Mat::zeros(image.size(), CV_8UC1);
         cv::rectangle(shadow_mask, cv::Rect(image.cols/4, image.rows/4, image.cols/2, image.rows/2),
@@ -93,258 +237,150 @@ bool EffectsEngine::apply_shadows(const std::string& input_file, const std::stri
         // Appliquer un flou gaussien pour adoucir l'ombre
         cv::GaussianBlur(shadow_mask, shadow_mask, cv::Size(21, 21), 0);
 
-        // Appliquer l'ombre
-        for (int i = 0; i < result.rows; ++i) {
-            for (int j = 0; j < result.cols; ++j) {
-                float shadow_factor = shadow_mask.at<uchar>(i, j) / 255.0f * shadow_intensity;
-                cv::Vec3b pixel = result.at<cv::Vec3b>(i, j);
-                pixel[0] = cv::saturate_cast<uchar>(pixel[0] * (1.0f - shadow_factor * 0.5f));
-                pixel[1] = cv::saturate_cast<uchar>(pixel[1] * (1.0f - shadow_factor * 0.5f));
-                pixel[2] = cv::saturate_cast<uchar>(pixel[2] * (1.0f - shadow_factor * 0.5f));
-                result.at<cv::Vec3b>(i, j) = pixel;
-            }
+        // Facteur d'assombrissement par valeur de masque
+        float lut[256];
+        for (int m = 0; m < 256; ++m) {
+            const float shadow_factor = m / 255.0f * shadow_intensity;
+            lut[m] = 1.0f - shadow_factor * 0.5f;
         }
 
-        if (cv::imwrite(output_file, result)) {
-            cpp_engine::utils::Logger::instance().info("Shadow effects applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save shadowed image: " + output_file);
-            return false;
-        }
+        // Appliquer l'ombre par bandes de lignes
+        cv::Mat result(image.size(), image.type());
+        cv::parallel_for_(cv::Range(0, image.rows), [&](const cv::Range& range) {
+            std::vector<float> scratch(static_cast<size_t>(image.cols) * 3);
+            for (int i = range.start; i < range.end; ++i) {
+                kernels::shadow_row(image.ptr<uint8_t>(i), shadow_mask.ptr<uint8_t>(i), result.ptr<uint8_t>(i),
+                                    image.cols, 3, lut, scratch.data());
+            }
+        });
+
+        output = result;
+        cpp_engine::utils::Logger::instance().info("Shadow effects applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in shadows: " + std::string(e.what()));
         return false;
     }
 }
 
-bool EffectsEngine::add_particles(const std::string& input_file, const std::string& output_file,
+bool EffectsEngine::add_particles(const cv::Mat& image, cv::Mat& output,
                                  int particle_count, const std::string& particle_type) {
     try {
         cpp_engine::utils::Logger::instance().info("Adding " + std::to_string(particle_count) + " " + particle_type + " particles");
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        cv::Mat result = image.clone();
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> x_dist(0, image.cols - 1);
-        std::uniform_int_distribution<> y_dist(0, image.rows - 1);
-
-        // Générer des particules selon le type
-        cv::Scalar particle_color;
-        int particle_size = 2;
-
-        if (particle_type == "fire") {
-            particle_color = cv::Scalar(0, 69, 255); // Rouge-orange
-        } else if (particle_type == "water") {
-            particle_color = cv::Scalar(255, 191, 0); // Bleu
-        } else if (particle_type == "spark") {
-            particle_color = cv::Scalar(0, 255, 255); // Jaune
-            particle_size = 1;
-        } else {
-            particle_color = cv::Scalar(255, 255, 255); // Blanc par défaut
-        }
-
-        for (int i = 0; i < particle_count; ++i) {
-            int x = x_dist(gen);
-            int y = y_dist(gen);
-            cv::circle(result, cv::Point(x, y), particle_size, particle_color, -1);
-        }
-
-        if (cv::imwrite(output_file, result)) {
-            cpp_engine::utils::Logger::instance().info("Particles added successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save particle image: " + output_file);
-            return false;
-        }
+        // Une rafale de particules immobiles, opaques au premier instant. Les zones d'émission
+        // des styles sont faites pour l'animation (la pluie naît hors cadre) : ici, tout le cadre
+        ParticleStyle style = ParticleStyle::for_type(particle_type);
+        style.spawn_x0 = 0.0f; style.spawn_x1 = 1.0f;
+        style.spawn_y0 = 0.0f; style.spawn_y1 = 1.0f;
+        ParticleSystem system(style, image.cols, image.rows, particle_seed_);
+        system.burst(static_cast<size_t>(std::max(0, particle_count)));
+        if (!render_particles(system, image, output)) return false;
+
+        cpp_engine::utils::Logger::instance().info("Particles added successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in particles: " + std::string(e.what()));
         return false;
     }
 }
 
-bool EffectsEngine::apply_wave_distortion(const std::string& input_file, const std::string& output_file,
+bool EffectsEngine::render_particles(ParticleSystem& system, const cv::Mat& frame, cv::Mat& result) {
+    if (frame.type() != CV_8UC3 || frame.cols != system.width() || frame.rows != system.height()) {
+        cpp_engine::utils::Logger::instance().error("Particles require an 8-bit BGR frame of the simulation size");
+        return false;
+    }
+    system.bin();
+    cv::Mat out = frame.clone();
+    // Tiles are disjoint, so bands of tiles render without locking
+    cv::parallel_for_(cv::Range(0, system.tile_count()), [&](const cv::Range& range) {
+        system.render_tiles(out.data, out.step, out.channels(), range.start, range.end);
+    });
+    result = out;
+    return true;
+}
+
+bool EffectsEngine::apply_wave_distortion(const cv::Mat& image, cv::Mat& output,
                                          float amplitude, float frequency) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying wave distortion, amp=" + std::to_string(amplitude) +
                                                   ", freq=" + std::to_string(frequency));
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        cv::Mat result = cv::Mat::zeros(image.size(), image.type());
-
-        // Appliquer une distorsion sinusoïdale
-        for (int i = 0; i < image.rows; ++i) {
-            for (int j = 0; j < image.cols; ++j) {
-                int offset_x = static_cast<int>(amplitude * sin(2 * M_PI * frequency * i / image.rows));
-                int offset_y = static_cast<int>(amplitude * cos(2 * M_PI * frequency * j / image.cols));
-
-                int src_x = j + offset_x;
-                int src_y = i + offset_y;
-
-                if (src_x >= 0 && src_x < image.cols && src_y >= 0 && src_y < image.rows) {
-                    result.at<cv::Vec3b>(i, j) = image.at<cv::Vec3b>(src_y, src_x);
-                } else {
-                    result.at<cv::Vec3b>(i, j) = cv::Vec3b(0, 0, 0);
-                }
-            }
-        }
+        // Table des coordonnées source, partagée entre les images de même taille
+        auto table = RemapCache::instance().wave(image.rows, image.cols, amplitude, frequency, remap_interpolation_);
+        cv::Mat result;
+        if (!apply_remap(*table, image, result, "Wave distortion")) return false;
 
-        if (cv::imwrite(output_file, result)) {
-            cpp_engine::utils::Logger::instance().info("Wave distortion applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save distorted image: " + output_file);
-            return false;
-        }
+        output = result;
+        cpp_engine::utils::Logger::instance().info("Wave distortion applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in wave distortion: " + std::string(e.what()));
         return false;
     }
 }
 
-bool EffectsEngine::apply_radial_distortion(const std::string& input_file, const std::string& output_file,
-                                           float distortion_factor) {
+bool EffectsEngine::apply_radial_distortion(const cv::Mat& image, cv::Mat& output, float distortion_factor) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying radial distortion, factor=" + std::to_string(distortion_factor));
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        cv::Mat result = cv::Mat::zeros(image.size(), image.type());
-        cv::Point2f center(image.cols / 2.0f, image.rows / 2.0f);
-        float max_radius = std::sqrt(center.x * center.x + center.y * center.y);
-
-        for (int i = 0; i < image.rows; ++i) {
-            for (int j = 0; j < image.cols; ++j) {
-                cv::Point2f point(j, i);
-                cv::Point2f vec = point - center;
-                float radius = cv::norm(vec);
-
-                if (radius > 0) {
-                    float distortion = 1.0f + distortion_factor * (radius / max_radius) * (radius / max_radius);
-                    cv::Point2f src_point = center + vec / distortion;
-
-                    if (src_point.x >= 0 && src_point.x < image.cols - 1 &&
-                        src_point.y >= 0 && src_point.y < image.rows - 1) {
-                        result.at<cv::Vec3b>(i, j) = image.at<cv::Vec3b>(cv::saturate_cast<int>(src_point.y),
-                                                                       cv::saturate_cast<int>(src_point.x));
-                    }
-                }
-            }
-        }
+        auto table = RemapCache::instance().radial(image.rows, image.cols, distortion_factor, remap_interpolation_);
+        cv::Mat result;
+        if (!apply_remap(*table, image, result, "Radial distortion")) return false;
 
-        if (cv::imwrite(output_file, result)) {
-            cpp_engine::utils::Logger::instance().info("Radial distortion applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save distorted image: " + output_file);
-            return false;
-        }
+        output = result;
+        cpp_engine::utils::Logger::instance().info("Radial distortion applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in radial distortion: " + std::string(e.what()));
         return false;
     }
 }
 
-bool EffectsEngine::apply_chromatic_aberration(const std::string& input_file, const std::string& output_file,
+bool EffectsEngine::apply_chromatic_aberration(const cv::Mat& image, cv::Mat& output,
                                               float red_shift, float blue_shift) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying chromatic aberration, red_shift=" + std::to_string(red_shift) +
                                                   ", blue_shift=" + std::to_string(blue_shift));
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
+        if (image.type() != CV_8UC3) {
+            cpp_engine::utils::Logger::instance().error("Chromatic aberration requires an 8-bit BGR image");
             return false;
         }
 
-        std::vector<cv::Mat> channels;
-        cv::split(image, channels);
+        // Décaler les canaux rouge et bleu : translation horizontale, interpolation linéaire
+        // au 1/32 de pixel et bord à zéro, comme warpAffine(INTER_LINEAR, BORDER_CONSTANT)
+        const kernels::ShiftTap red_tap = kernels::make_shift_tap(-red_shift);
+        const kernels::ShiftTap blue_tap = kernels::make_shift_tap(blue_shift);
 
-        // Décaler les canaux rouge et bleu
-        cv::Mat red_shifted, blue_shifted;
-        cv::warpAffine(channels[2], red_shifted, cv::Mat::eye(2, 3, CV_32F), image.size(),
-                      cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0));
-        cv::warpAffine(channels[0], blue_shifted, cv::Mat::eye(2, 3, CV_32F), image.size(),
-                      cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0));
-
-        // Translation pour l'aberration chromatique
-        cv::Mat translation_red = (cv::Mat_<float>(2, 3) << 1, 0, red_shift, 0, 1, 0);
-        cv::Mat translation_blue = (cv::Mat_<float>(2, 3) << 1, 0, -blue_shift, 0, 1, 0);
-
-        cv::warpAffine(channels[2], red_shifted, translation_red, image.size());
-        cv::warpAffine(channels[0], blue_shifted, translation_blue, image.size());
-
-        // Recombinaison
-        std::vector<cv::Mat> aberrated_channels = {blue_shifted, channels[1], red_shifted};
-        cv::Mat result;
-        cv::merge(aberrated_channels, result);
+        cv::Mat result(image.size(), image.type());
+        cv::parallel_for_(cv::Range(0, image.rows), [&](const cv::Range& range) {
+            for (int i = range.start; i < range.end; ++i) {
+                kernels::chromatic_row(image.ptr<uint8_t>(i), result.ptr<uint8_t>(i), image.cols, blue_tap, red_tap);
+            }
+        });
+        output = result;
 
-        if (cv::imwrite(output_file, result)) {
-            cpp_engine::utils::Logger::instance().info("Chromatic aberration applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save aberrated image: " + output_file);
-            return false;
-        }
+        cpp_engine::utils::Logger::instance().info("Chromatic aberration applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in chromatic aberration: " + std::string(e.what()));
         return false;
     }
 }
 
-bool EffectsEngine::apply_bloom(const std::string& input_file, const std::string& output_file,
-                               float threshold, float intensity) {
+bool EffectsEngine::apply_bloom(const cv::Mat& image, cv::Mat& output, float threshold, float intensity) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying bloom effect, threshold=" + std::to_string(threshold) +
                                                   ", intensity=" + std::to_string(intensity));
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        // Convertir en float pour les calculs
-        cv::Mat float_image;
-        image.convertTo(float_image, CV_32FC3, 1.0/255.0);
+        // Zones lumineuses floutées (pleine résolution ou pyramide), puis ajoutées à l'image
+        cv::Mat glow;
+        Bloom::glow(image, threshold, bloom_options_, glow);
+        Bloom::combine(image, glow, intensity, bloom_options_, output);
 
-        // Extraire les zones lumineuses
-        cv::Mat bright_areas;
-        cv::threshold(float_image, bright_areas, threshold, 1.0, cv::THRESH_BINARY);
-
-        // Appliquer un flou gaussien pour créer l'effet de bloom
-        cv::Mat bloom;
-        cv::GaussianBlur(bright_areas, bloom, cv::Size(21, 21), 0);
-
-        // Combiner l'image originale avec l'effet bloom
-        cv::Mat result;
-        cv::addWeighted(float_image, 1.0, bloom, intensity, 0.0, result);
-
-        // Reconvertir en 8-bit
-        result.convertTo(result, CV_8UC3, 255.0);
-
-        if (cv::imwrite(output_file, result)) {
-            cpp_engine::utils::Logger::instance().info("Bloom effect applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save bloom image: " + output_file);
-            return false;
-        }
+        cpp_engine::utils::Logger::instance().info("Bloom effect applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in bloom: " + std::string(e.what()));
         return false;
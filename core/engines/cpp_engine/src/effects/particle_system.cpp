@@ -0,0 +1,237 @@
+#include "effects/particle_system.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace cppengine {
+namespace effects {
+
+namespace {
+
+constexpr size_t MAX_PARTICLES = size_t(1) << 22;
+constexpr float REFERENCE_HEIGHT = 720.0f;
+
+} // namespace
+
+ParticleStyle ParticleStyle::for_type(const std::string& type) {
+    ParticleStyle s;
+    if (type == "fire") {
+        // Rising from the bottom edge, buoyant, short-lived
+        s.spawn_y0 = 0.92f; s.spawn_y1 = 1.0f;
+        s.direction = -1.5707963f; s.spread = 0.5f;
+        s.speed_min = 80.0f; s.speed_max = 180.0f;
+        s.gravity_y = -60.0f; s.drag = 0.8f;
+        s.life_min = 0.6f; s.life_max = 1.4f;
+        s.radius = 2;
+        s.color[0] = 0; s.color[1] = 69; s.color[2] = 255;
+    } else if (type == "water") {
+        // Rain entering from above the frame
+        s.spawn_y0 = -0.05f; s.spawn_y1 = 0.0f;
+        s.direction = 1.5707963f; s.spread = 0.08f;
+        s.speed_min = 350.0f; s.speed_max = 500.0f;
+        s.gravity_y = 400.0f; s.drag = 0.2f;
+        s.life_min = 1.5f; s.life_max = 2.5f;
+        s.radius = 2;
+        s.color[0] = 255; s.color[1] = 191; s.color[2] = 0;
+    } else if (type == "spark") {
+        // Bursts from the centre in every direction, pulled down
+        s.spawn_x0 = 0.4f; s.spawn_x1 = 0.6f;
+        s.spawn_y0 = 0.4f; s.spawn_y1 = 0.6f;
+        s.spread = 3.1415927f;
+        s.speed_min = 150.0f; s.speed_max = 450.0f;
+        s.gravity_y = 300.0f; s.drag = 1.5f;
+        s.life_min = 0.3f; s.life_max = 0.9f;
+        s.radius = 1;
+        s.color[0] = 0; s.color[1] = 255; s.color[2] = 255;
+    } else {
+        s.speed_min = 10.0f; s.speed_max = 40.0f;
+        s.life_min = 3.0f; s.life_max = 6.0f;
+    }
+    return s;
+}
+
+ParticleSystem::ParticleSystem(const ParticleStyle& style, int width, int height, uint64_t seed)
+    : style_(style), width_(width), height_(height), scale_(height / REFERENCE_HEIGHT),
+      rng_state_(seed) {}
+
+float ParticleSystem::next_uniform() {
+    // splitmix64: same sequence on every platform, unlike std:: distributions
+    uint64_t z = (rng_state_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::set_population(size_t target) {
+    emission_rate_ = target / (0.5f * (style_.life_min + style_.life_max));
+}
+
+void ParticleSystem::burst(size_t count) {
+    emit(count);
+}
+
+void ParticleSystem::emit(size_t count) {
+    count = std::min(count, MAX_PARTICLES - std::min(MAX_PARTICLES, x_.size()));
+    for (size_t i = 0; i < count; ++i) {
+        const float px = (style_.spawn_x0 + (style_.spawn_x1 - style_.spawn_x0) * next_uniform()) * width_;
+        const float py = (style_.spawn_y0 + (style_.spawn_y1 - style_.spawn_y0) * next_uniform()) * height_;
+        const float angle = style_.direction + style_.spread * (2.0f * next_uniform() - 1.0f);
+        const float speed = (style_.speed_min + (style_.speed_max - style_.speed_min) * next_uniform()) * scale_;
+        const float life = style_.life_min + (style_.life_max - style_.life_min) * next_uniform();
+        x_.push_back(px);
+        y_.push_back(py);
+        vx_.push_back(std::cos(angle) * speed);
+        vy_.push_back(std::sin(angle) * speed);
+        age_.push_back(0.0f);
+        life_.push_back(life);
+    }
+}
+
+void ParticleSystem::integrate(float dt) {
+    // v' = v * (1 - drag dt) + g dt, p' = p + v' dt
+    const float damp = std::max(0.0f, 1.0f - style_.drag * dt);
+    const float ax = style_.gravity_x * scale_ * dt, ay = style_.gravity_y * scale_ * dt;
+    const size_t n = x_.size();
+    float* x = x_.data();
+    float* y = y_.data();
+    float* vx = vx_.data();
+    float* vy = vy_.data();
+    float* age = age_.data();
+    size_t i = 0;
+#if defined(__AVX2__)
+    {
+        const __m256 vdamp = _mm256_set1_ps(damp), vax = _mm256_set1_ps(ax), vay = _mm256_set1_ps(ay);
+        const __m256 vdt = _mm256_set1_ps(dt);
+        for (; i + 8 <= n; i += 8) {
+            const __m256 nvx = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(vx + i), vdamp), vax);
+            const __m256 nvy = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(vy + i), vdamp), vay);
+            _mm256_storeu_ps(vx + i, nvx);
+            _mm256_storeu_ps(vy + i, nvy);
+            _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(nvx, vdt)));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(nvy, vdt)));
+            _mm256_storeu_ps(age + i, _mm256_add_ps(_mm256_loadu_ps(age + i), vdt));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128 vdamp = _mm_set1_ps(damp), vax = _mm_set1_ps(ax), vay = _mm_set1_ps(ay);
+        const __m128 vdt = _mm_set1_ps(dt);
+        for (; i + 4 <= n; i += 4) {
+            const __m128 nvx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), vdamp), vax);
+            const __m128 nvy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), vdamp), vay);
+            _mm_storeu_ps(vx + i, nvx);
+            _mm_storeu_ps(vy + i, nvy);
+            _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(nvx, vdt)));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(nvy, vdt)));
+            _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), vdt));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        vx[i] = vx[i] * damp + ax;
+        vy[i] = vy[i] * damp + ay;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        age[i] += dt;
+    }
+}
+
+void ParticleSystem::compact() {
+    // Stable: survivors keep their relative order, so rendering order is reproducible
+    const float margin_x = 0.25f * width_, margin_y = 0.25f * height_;
+    size_t w = 0;
+    for (size_t i = 0; i < x_.size(); ++i) {
+        const bool alive = age_[i] < life_[i] &&
+                           x_[i] > -margin_x && x_[i] < width_ + margin_x &&
+                           y_[i] > -margin_y && y_[i] < height_ + margin_y;
+        if (!alive) continue;
+        if (w != i) {
+            x_[w] = x_[i]; y_[w] = y_[i];
+            vx_[w] = vx_[i]; vy_[w] = vy_[i];
+            age_[w] = age_[i]; life_[w] = life_[i];
+        }
+        ++w;
+    }
+    for (auto* v : {&x_, &y_, &vx_, &vy_, &age_, &life_}) v->resize(w);
+}
+
+void ParticleSystem::step(float dt) {
+    integrate(dt);
+    compact();
+    emission_carry_ += emission_rate_ * dt;
+    const float whole = std::floor(emission_carry_);
+    emission_carry_ -= whole;
+    emit(static_cast<size_t>(whole));
+}
+
+void ParticleSystem::bin(int tile_size) {
+    tile_size_ = std::max(8, tile_size);
+    tiles_x_ = (width_ + tile_size_ - 1) / tile_size_;
+    tiles_y_ = (height_ + tile_size_ - 1) / tile_size_;
+    const int tiles = tile_count();
+    const int r = style_.radius;
+
+    // Counting sort of (tile, particle) pairs; a disc touches up to four tiles
+    auto tile_span = [&](size_t i, int& tx0, int& tx1, int& ty0, int& ty1) {
+        const int cx = static_cast<int>(std::floor(x_[i] + 0.5f)), cy = static_cast<int>(std::floor(y_[i] + 0.5f));
+        if (cx + r < 0 || cy + r < 0 || cx - r >= width_ || cy - r >= height_) return false;
+        tx0 = std::max(0, cx - r) / tile_size_;
+        tx1 = std::min(width_ - 1, cx + r) / tile_size_;
+        ty0 = std::max(0, cy - r) / tile_size_;
+        ty1 = std::min(height_ - 1, cy + r) / tile_size_;
+        return true;
+    };
+    bin_offsets_.assign(tiles + 1, 0);
+    for (size_t i = 0; i < x_.size(); ++i) {
+        int tx0, tx1, ty0, ty1;
+        if (!tile_span(i, tx0, tx1, ty0, ty1)) continue;
+        for (int ty = ty0; ty <= ty1; ++ty)
+            for (int tx = tx0; tx <= tx1; ++tx) ++bin_offsets_[ty * tiles_x_ + tx + 1];
+    }
+    for (int t = 0; t < tiles; ++t) bin_offsets_[t + 1] += bin_offsets_[t];
+    bin_items_.resize(bin_offsets_[tiles]);
+    std::vector<uint32_t> fill(bin_offsets_.begin(), bin_offsets_.end() - 1);
+    for (size_t i = 0; i < x_.size(); ++i) {
+        int tx0, tx1, ty0, ty1;
+        if (!tile_span(i, tx0, tx1, ty0, ty1)) continue;
+        for (int ty = ty0; ty <= ty1; ++ty)
+            for (int tx = tx0; tx <= tx1; ++tx) bin_items_[fill[ty * tiles_x_ + tx]++] = static_cast<uint32_t>(i);
+    }
+}
+
+void ParticleSystem::render_tiles(uint8_t* data, size_t step, int channels, int tile_begin, int tile_end) const {
+    const int r = style_.radius;
+    const int r2 = r * r + r;  // rounder small discs than r * r
+    const int ncolor = std::min(channels, 3);
+    for (int t = tile_begin; t < tile_end && t < tile_count(); ++t) {
+        const int x0 = (t % tiles_x_) * tile_size_, y0 = (t / tiles_x_) * tile_size_;
+        const int x1 = std::min(width_, x0 + tile_size_), y1 = std::min(height_, y0 + tile_size_);
+        for (uint32_t k = bin_offsets_[t]; k < bin_offsets_[t + 1]; ++k) {
+            const uint32_t i = bin_items_[k];
+            const int cx = static_cast<int>(std::floor(x_[i] + 0.5f)), cy = static_cast<int>(std::floor(y_[i] + 0.5f));
+            // Fades out over the lifetime; 256 = opaque
+            const int alpha = static_cast<int>(256.0f * std::max(0.0f, 1.0f - age_[i] / life_[i]));
+            for (int py = std::max(y0, cy - r); py < std::min(y1, cy + r + 1); ++py) {
+                uint8_t* row = data + static_cast<size_t>(py) * step;
+                const int dy = py - cy;
+                for (int px = std::max(x0, cx - r); px < std::min(x1, cx + r + 1); ++px) {
+                    const int dx = px - cx;
+                    if (dx * dx + dy * dy > r2) continue;
+                    uint8_t* p = row + static_cast<size_t>(px) * channels;
+                    for (int c = 0; c < ncolor; ++c) {
+                        p[c] = static_cast<uint8_t>(p[c] + (((style_.color[c] - p[c]) * alpha + 128) >> 8));
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace effects
+} // namespace cppengine
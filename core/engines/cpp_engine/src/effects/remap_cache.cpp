@@ -0,0 +1,306 @@
+#include "effects/remap_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace cppengine {
+namespace effects {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr int WEIGHT_ONE = 32;
+
+// Source position -> top-left tap and 1/32 weights; false when outside [0, size - 1]
+bool bilinear_tap(float pos, int size, int& base, int& frac) {
+    if (!(pos >= 0.0f) || pos > static_cast<float>(size - 1)) return false;
+    const int q = static_cast<int>(std::lround(pos * WEIGHT_ONE));
+    base = q / WEIGHT_ONE;
+    frac = q % WEIGHT_ONE;
+    if (base >= size - 1) {  // right/bottom edge: last pair with full weight on the far tap
+        base = size - 2;
+        frac = WEIGHT_ONE;
+    }
+    return true;
+}
+
+void set_bilinear(RemapTable& table, size_t i, float sx, float sy) {
+    int x0, fx, y0, fy;
+    if (bilinear_tap(sx, table.cols, x0, fx) && bilinear_tap(sy, table.rows, y0, fy)) {
+        table.index[i] = y0 * table.cols + x0;
+        table.weights[i] = static_cast<uint16_t>(fx | (fy << 8));
+    }
+}
+
+std::shared_ptr<RemapTable> make_table(int rows, int cols, RemapInterpolation interpolation) {
+    auto table = std::make_shared<RemapTable>();
+    table->rows = rows;
+    table->cols = cols;
+    // Bilinear needs a 2x2 neighbourhood
+    table->bilinear = interpolation == RemapInterpolation::BILINEAR && rows > 1 && cols > 1;
+    table->index.assign(static_cast<size_t>(rows) * cols, -1);
+    if (table->bilinear) table->weights.assign(table->index.size(), 0);
+    return table;
+}
+
+void finish_table(RemapTable& table) {
+    // A 32-bit gather at the last pixel of a 3-channel image would read one byte past the end
+    const int64_t last = static_cast<int64_t>(table.rows) * table.cols - 1;
+    const int64_t reach = table.bilinear ? table.cols + 1 : 0;
+    table.gather_safe.assign(table.rows, 1);
+    for (int y = 0; y < table.rows; ++y) {
+        const int32_t* row = &table.index[static_cast<size_t>(y) * table.cols];
+        for (int x = 0; x < table.cols; ++x) {
+            if (row[x] >= 0 && row[x] + reach >= last) {
+                table.gather_safe[y] = 0;
+                break;
+            }
+        }
+    }
+}
+
+void apply_scalar(const RemapTable& table, const uint8_t* src, uint8_t* dst, int cn, size_t begin, size_t end) {
+    const size_t below = static_cast<size_t>(table.cols) * cn;
+    for (size_t i = begin; i < end; ++i) {
+        uint8_t* out = dst + i * cn;
+        const int32_t idx = table.index[i];
+        if (idx < 0) {
+            std::memset(out, 0, cn);
+            continue;
+        }
+        const uint8_t* p = src + static_cast<size_t>(idx) * cn;
+        if (!table.bilinear) {
+            std::memcpy(out, p, cn);
+            continue;
+        }
+        const int fx = table.weights[i] & 0xFF, fy = table.weights[i] >> 8;
+        const int w00 = (WEIGHT_ONE - fx) * (WEIGHT_ONE - fy), w01 = fx * (WEIGHT_ONE - fy);
+        const int w10 = (WEIGHT_ONE - fx) * fy, w11 = fx * fy;
+        for (int c = 0; c < cn; ++c) {
+            const int v = p[c] * w00 + p[c + cn] * w01 + p[c + below] * w10 + p[c + below + cn] * w11;
+            out[c] = static_cast<uint8_t>((v + 512) >> 10);
+        }
+    }
+}
+
+#if defined(__AVX2__)
+// Eight gathered 32-bit pixels -> 8 x cn bytes; the 3-channel store writes 4 bytes past the last pixel
+inline void store_pixels(uint8_t* dst, __m256i pixels, int cn) {
+    if (cn == 4) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), pixels);
+        return;
+    }
+    const __m256i pack3 = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                           0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i packed = _mm256_shuffle_epi8(pixels, pack3);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(packed));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12), _mm256_extracti128_si256(packed, 1));
+}
+
+// Pixels [begin, end) of one output row, 3 or 4 channels; returns the first pixel left for the scalar tail
+size_t apply_avx2(const RemapTable& table, const uint8_t* src, uint8_t* dst, int cn, size_t begin, size_t end) {
+    const int* base = reinterpret_cast<const int*>(src);
+    const __m256i zero = _mm256_setzero_si256(), none = _mm256_set1_epi32(-1);
+    const __m256i vcn = _mm256_set1_epi32(cn), below = _mm256_set1_epi32(table.cols * cn);
+    // Leave two pixels for the scalar tail so the 3-channel store stays inside the row
+    const size_t reserve = cn == 3 ? 2 : 0;
+    size_t i = begin;
+    for (; i + 8 + reserve <= end; i += 8) {
+        const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&table.index[i]));
+        const __m256i valid = _mm256_cmpgt_epi32(idx, none);
+        const __m256i off = _mm256_mullo_epi32(idx, vcn);
+        const __m256i tl = _mm256_mask_i32gather_epi32(zero, base, off, valid, 1);
+        if (!table.bilinear) {
+            store_pixels(dst + i * cn, tl, cn);
+            continue;
+        }
+        const __m256i tr = _mm256_mask_i32gather_epi32(zero, base, _mm256_add_epi32(off, vcn), valid, 1);
+        const __m256i bl = _mm256_mask_i32gather_epi32(zero, base, _mm256_add_epi32(off, below), valid, 1);
+        const __m256i br = _mm256_mask_i32gather_epi32(zero, base, _mm256_add_epi32(_mm256_add_epi32(off, below), vcn), valid, 1);
+
+        const __m256i w = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&table.weights[i])));
+        const __m256i one = _mm256_set1_epi32(WEIGHT_ONE);
+        const __m256i fx = _mm256_and_si256(w, _mm256_set1_epi32(0xFF)), fy = _mm256_srli_epi32(w, 8);
+        const __m256i gx = _mm256_sub_epi32(one, fx), gy = _mm256_sub_epi32(one, fy);
+        // (w00, w01) and (w10, w11) as 16-bit pairs, matching the tl/tr and bl/br byte interleave
+        const __m256i wtop = _mm256_or_si256(_mm256_mullo_epi32(gx, gy), _mm256_slli_epi32(_mm256_mullo_epi32(fx, gy), 16));
+        const __m256i wbot = _mm256_or_si256(_mm256_mullo_epi32(gx, fy), _mm256_slli_epi32(_mm256_mullo_epi32(fx, fy), 16));
+
+        const __m256i top_lo = _mm256_unpacklo_epi8(tl, tr), top_hi = _mm256_unpackhi_epi8(tl, tr);
+        const __m256i bot_lo = _mm256_unpacklo_epi8(bl, br), bot_hi = _mm256_unpackhi_epi8(bl, br);
+        const __m256i round = _mm256_set1_epi32(512);
+        auto blend = [&](__m256i top, __m256i bot, __m256i wt, __m256i wb) {
+            const __m256i sum = _mm256_add_epi32(_mm256_madd_epi16(top, wt), _mm256_madd_epi16(bot, wb));
+            return _mm256_srai_epi32(_mm256_add_epi32(sum, round), 10);
+        };
+        // Per 128-bit lane: pixels 0..3 (and 4..7), one madd pair per channel
+        const __m256i p0 = blend(_mm256_unpacklo_epi8(top_lo, zero), _mm256_unpacklo_epi8(bot_lo, zero),
+                                 _mm256_shuffle_epi32(wtop, 0x00), _mm256_shuffle_epi32(wbot, 0x00));
+        const __m256i p1 = blend(_mm256_unpackhi_epi8(top_lo, zero), _mm256_unpackhi_epi8(bot_lo, zero),
+                                 _mm256_shuffle_epi32(wtop, 0x55), _mm256_shuffle_epi32(wbot, 0x55));
+        const __m256i p2 = blend(_mm256_unpacklo_epi8(top_hi, zero), _mm256_unpacklo_epi8(bot_hi, zero),
+                                 _mm256_shuffle_epi32(wtop, 0xAA), _mm256_shuffle_epi32(wbot, 0xAA));
+        const __m256i p3 = blend(_mm256_unpackhi_epi8(top_hi, zero), _mm256_unpackhi_epi8(bot_hi, zero),
+                                 _mm256_shuffle_epi32(wtop, 0xFF), _mm256_shuffle_epi32(wbot, 0xFF));
+        const __m256i pixels = _mm256_packus_epi16(_mm256_packs_epi32(p0, p1), _mm256_packs_epi32(p2, p3));
+        store_pixels(dst + i * cn, pixels, cn);
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+size_t RemapTable::bytes() const {
+    return index.size() * sizeof(int32_t) + weights.size() * sizeof(uint16_t) + gather_safe.size();
+}
+
+std::shared_ptr<RemapTable> RemapTable::wave(int rows, int cols, float amplitude, float frequency,
+                                             RemapInterpolation interpolation) {
+    auto table = make_table(rows, cols, interpolation);
+    // Horizontal offset depends on the row only, vertical on the column only
+    std::vector<double> offset_x(rows), offset_y(cols);
+    for (int i = 0; i < rows; ++i) offset_x[i] = amplitude * std::sin(2 * PI * frequency * i / rows);
+    for (int j = 0; j < cols; ++j) offset_y[j] = amplitude * std::cos(2 * PI * frequency * j / cols);
+
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            const size_t out = static_cast<size_t>(i) * cols + j;
+            if (table->bilinear) {
+                set_bilinear(*table, out, static_cast<float>(j + offset_x[i]), static_cast<float>(i + offset_y[j]));
+                continue;
+            }
+            const int src_x = j + static_cast<int>(offset_x[i]);
+            const int src_y = i + static_cast<int>(offset_y[j]);
+            if (src_x >= 0 && src_x < cols && src_y >= 0 && src_y < rows) table->index[out] = src_y * cols + src_x;
+        }
+    }
+    finish_table(*table);
+    return table;
+}
+
+std::shared_ptr<RemapTable> RemapTable::radial(int rows, int cols, float distortion_factor,
+                                               RemapInterpolation interpolation) {
+    auto table = make_table(rows, cols, interpolation);
+    const float cx = cols / 2.0f, cy = rows / 2.0f;
+    const float max_radius = std::sqrt(cx * cx + cy * cy);
+
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            const size_t out = static_cast<size_t>(i) * cols + j;
+            const float vx = j - cx, vy = i - cy;
+            // cv::norm(Point2f) accumulates in double
+            const float radius = static_cast<float>(std::sqrt(static_cast<double>(vx) * vx + static_cast<double>(vy) * vy));
+            if (table->bilinear) {
+                const float distortion = 1.0f + distortion_factor * (radius / max_radius) * (radius / max_radius);
+                set_bilinear(*table, out, cx + vx / distortion, cy + vy / distortion);
+                continue;
+            }
+            if (!(radius > 0)) continue;  // the centre pixel stays black, as before
+            const float distortion = 1.0f + distortion_factor * (radius / max_radius) * (radius / max_radius);
+            const float sx = cx + vx / distortion, sy = cy + vy / distortion;
+            if (sx >= 0 && sx < cols - 1 && sy >= 0 && sy < rows - 1) {
+                table->index[out] = static_cast<int32_t>(std::lrint(sy)) * cols + static_cast<int32_t>(std::lrint(sx));
+            }
+        }
+    }
+    finish_table(*table);
+    return table;
+}
+
+void RemapTable::apply(const uint8_t* src, uint8_t* dst, int channels, int row_begin, int row_end) const {
+    for (int y = row_begin; y < row_end; ++y) {
+        const size_t begin = static_cast<size_t>(y) * cols, end = begin + cols;
+        size_t i = begin;
+#if defined(__AVX2__)
+        if ((channels == 3 && gather_safe[y]) || channels == 4) i = apply_avx2(*this, src, dst, channels, begin, end);
+#endif
+        apply_scalar(*this, src, dst, channels, i, end);
+    }
+}
+
+bool RemapCache::Key::operator==(const Key& other) const {
+    return kind == other.kind && rows == other.rows && cols == other.cols &&
+           p0 == other.p0 && p1 == other.p1 && interpolation == other.interpolation;
+}
+
+RemapCache::RemapCache(size_t capacity_bytes) : capacity_bytes_(capacity_bytes) {}
+
+RemapCache& RemapCache::instance() {
+    static RemapCache cache;
+    return cache;
+}
+
+std::shared_ptr<const RemapTable> RemapCache::wave(int rows, int cols, float amplitude, float frequency,
+                                                   RemapInterpolation interpolation) {
+    return lookup({Kind::WAVE, rows, cols, amplitude, frequency, interpolation},
+                  [&] { return RemapTable::wave(rows, cols, amplitude, frequency, interpolation); });
+}
+
+std::shared_ptr<const RemapTable> RemapCache::radial(int rows, int cols, float distortion_factor,
+                                                     RemapInterpolation interpolation) {
+    return lookup({Kind::RADIAL, rows, cols, distortion_factor, 0.0f, interpolation},
+                  [&] { return RemapTable::radial(rows, cols, distortion_factor, interpolation); });
+}
+
+std::shared_ptr<const RemapTable> RemapCache::lookup(const Key& key,
+                                                     const std::function<std::shared_ptr<RemapTable>()>& build) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->key == key) {
+                entries_.splice(entries_.begin(), entries_, it);
+                ++stats_.hits;
+                return it->table;
+            }
+        }
+        ++stats_.misses;
+    }
+
+    // Built outside the lock; a concurrent miss on the same key keeps the first insert
+    std::shared_ptr<const RemapTable> table = build();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : entries_) {
+        if (entry.key == key) return entry.table;
+    }
+    entries_.push_front({key, table});
+    stats_.bytes += table->bytes();
+    evict_locked();
+    return table;
+}
+
+void RemapCache::evict_locked() {
+    // The newest entry stays even when it alone exceeds the budget
+    while (entries_.size() > 1 && stats_.bytes > capacity_bytes_) {
+        stats_.bytes -= entries_.back().table->bytes();
+        entries_.pop_back();
+        ++stats_.evictions;
+    }
+}
+
+void RemapCache::set_capacity_bytes(size_t capacity_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_bytes_ = capacity_bytes;
+    evict_locked();
+}
+
+void RemapCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    stats_ = Stats();
+}
+
+RemapCache::Stats RemapCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s = stats_;
+    s.entries = entries_.size();
+    return s;
+}
+
+} // namespace effects
+} // namespace cppengine
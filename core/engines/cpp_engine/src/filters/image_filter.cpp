@@ -1,161 +1,275 @@
 #include "filters/image_filter.h"
 #include "utils/logger.h"
+#include "optimization/image_encoder.h"
 #include <opencv2/opencv.hpp>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/highgui.hpp>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
 namespace cppengine {
 namespace filters {
 
+namespace {
+
+using MorphFn = void (Morphology::*)(const uint8_t*, size_t, uint8_t*, size_t, int, int, int, int, int);
+
+// 8-bit images go through the van Herk/Gil-Werman passes, other depths keep OpenCV's path
+void run_morphology(Morphology& morphology, MorphFn fn, int cv_op,
+                    const cv::Mat& image, cv::Mat& out, int kernel_size) {
+    if (image.depth() == CV_8U) {
+        out.create(image.size(), image.type());
+        (morphology.*fn)(image.data, image.step, out.data, out.step,
+                         image.rows, image.cols, image.channels(), kernel_size, kernel_size);
+    } else {
+        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(kernel_size, kernel_size));
+        cv::morphologyEx(image, out, cv_op, kernel);
+    }
+}
+
+bool load_image(const std::string& input_file, cv::Mat& image) {
+    try {
+        image = cv::imread(input_file);
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error loading " + input_file + ": " + std::string(e.what()));
+        return false;
+    }
+    if (image.empty()) {
+        cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
+        return false;
+    }
+    return true;
+}
+
+bool save_image(const std::string& output_file, const cv::Mat& image, const std::string& what,
+                const optimization::EncodeOptions& options, optimization::EncodeResult& encoded) {
+    encoded = optimization::ImageEncoder::write(output_file, image, options);
+    if (!encoded.success) {
+        cpp_engine::utils::Logger::instance().error("Failed to save " + what + " image: " + output_file);
+        return false;
+    }
+    return true;
+}
+
+bool read_file(const std::string& path, std::vector<unsigned char>& bytes) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !bytes.empty();
+}
+
+// Fills a 0 dimension from the aspect ratio
+cv::Size target_size(int src_width, int src_height, int width, int height) {
+    if (width <= 0 && height <= 0) return cv::Size(src_width, src_height);
+    if (width <= 0) width = std::max(1, static_cast<int>(static_cast<int64_t>(src_width) * height / src_height));
+    if (height <= 0) height = std::max(1, static_cast<int>(static_cast<int64_t>(src_height) * width / src_width));
+    return cv::Size(width, height);
+}
+
+bool load_image_for_size(const std::string& input_file, int width, int height, cv::Mat& image) {
+    std::vector<unsigned char> bytes;
+    if (!read_file(input_file, bytes)) {
+        cpp_engine::utils::Logger::instance().error("Failed to read image: " + input_file);
+        return false;
+    }
+    if (!ImageFilter::decode_for_size(bytes, width, height, image)) {
+        cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 ImageFilter::ImageFilter() : thread_count_(4) {
     cpp_engine::utils::Logger::instance().info("ImageFilter initialized with OpenCV");
 }
 
 ImageFilter::~ImageFilter() {}
 
+// ============================================================================
+// File variants: decode, run the in-memory filter, encode
+// ============================================================================
+
 bool ImageFilter::apply_blur(const std::string& input_file, const std::string& output_file, int radius) {
-    try {
-        cpp_engine::utils::Logger::instance().info("Applying blur filter, radius=" + std::to_string(radius));
+    cv::Mat image, blurred;
+    return load_image(input_file, image) && apply_blur(image, blurred, radius) &&
+           save_image(output_file, blurred, "blurred", encode_options_, last_encode_);
+}
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
+bool ImageFilter::apply_sharpen(const std::string& input_file, const std::string& output_file, float strength) {
+    cv::Mat image, sharpened;
+    return load_image(input_file, image) && apply_sharpen(image, sharpened, strength) &&
+           save_image(output_file, sharpened, "sharpened", encode_options_, last_encode_);
+}
 
-        cv::Mat blurred;
-        cv::blur(image, blurred, cv::Size(radius, radius));
+bool ImageFilter::apply_gaussian_blur(const std::string& input_file, const std::string& output_file, int kernel_size) {
+    cv::Mat image, gaussian_blurred;
+    return load_image(input_file, image) && apply_gaussian_blur(image, gaussian_blurred, kernel_size) &&
+           save_image(output_file, gaussian_blurred, "Gaussian blurred", encode_options_, last_encode_);
+}
 
-        if (cv::imwrite(output_file, blurred)) {
-            cpp_engine::utils::Logger::instance().info("Blur filter applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save blurred image: " + output_file);
-            return false;
-        }
+bool ImageFilter::adjust_brightness(const std::string& input_file, const std::string& output_file, float factor) {
+    cv::Mat image, brightness_adjusted;
+    return load_image(input_file, image) && adjust_brightness(image, brightness_adjusted, factor) &&
+           save_image(output_file, brightness_adjusted, "brightness adjusted", encode_options_, last_encode_);
+}
+
+bool ImageFilter::adjust_contrast(const std::string& input_file, const std::string& output_file, float factor) {
+    cv::Mat image, contrast_adjusted;
+    return load_image(input_file, image) && adjust_contrast(image, contrast_adjusted, factor) &&
+           save_image(output_file, contrast_adjusted, "contrast adjusted", encode_options_, last_encode_);
+}
+
+bool ImageFilter::adjust_saturation(const std::string& input_file, const std::string& output_file, float factor) {
+    cv::Mat image, saturation_adjusted;
+    return load_image(input_file, image) && adjust_saturation(image, saturation_adjusted, factor) &&
+           save_image(output_file, saturation_adjusted, "saturation adjusted", encode_options_, last_encode_);
+}
+
+bool ImageFilter::detect_edges(const std::string& input_file, const std::string& output_file) {
+    cv::Mat image, edges;
+    return load_image(input_file, image) && detect_edges(image, edges) &&
+           save_image(output_file, edges, "edges", encode_options_, last_encode_);
+}
+
+bool ImageFilter::dilate(const std::string& input_file, const std::string& output_file, int kernel_size) {
+    cv::Mat image, dilated;
+    return load_image(input_file, image) && dilate(image, dilated, kernel_size) &&
+           save_image(output_file, dilated, "dilated", encode_options_, last_encode_);
+}
+
+bool ImageFilter::erode(const std::string& input_file, const std::string& output_file, int kernel_size) {
+    cv::Mat image, eroded;
+    return load_image(input_file, image) && erode(image, eroded, kernel_size) &&
+           save_image(output_file, eroded, "eroded", encode_options_, last_encode_);
+}
+
+bool ImageFilter::morph_open(const std::string& input_file, const std::string& output_file, int kernel_size) {
+    cv::Mat image, opened;
+    return load_image(input_file, image) && morph_open(image, opened, kernel_size) &&
+           save_image(output_file, opened, "opened", encode_options_, last_encode_);
+}
+
+bool ImageFilter::morph_close(const std::string& input_file, const std::string& output_file, int kernel_size) {
+    cv::Mat image, closed;
+    return load_image(input_file, image) && morph_close(image, closed, kernel_size) &&
+           save_image(output_file, closed, "closed", encode_options_, last_encode_);
+}
+
+bool ImageFilter::morph_gradient(const std::string& input_file, const std::string& output_file, int kernel_size) {
+    cv::Mat image, gradient;
+    return load_image(input_file, image) && morph_gradient(image, gradient, kernel_size) &&
+           save_image(output_file, gradient, "gradient", encode_options_, last_encode_);
+}
+
+bool ImageFilter::resize(const std::string& input_file, const std::string& output_file,
+                         int width, int height, ResizeKernel kernel) {
+    cv::Mat image, resized;
+    return load_image_for_size(input_file, width, height, image) && resize(image, resized, width, height, kernel) &&
+           save_image(output_file, resized, "resized", encode_options_, last_encode_);
+}
+
+bool ImageFilter::pyramid(const std::string& input_file, const std::string& output_file,
+                          const std::vector<int>& widths, ResizeKernel kernel) {
+    if (widths.empty()) return false;
+    cv::Mat image;
+    std::vector<cv::Mat> levels;
+    const int largest = *std::max_element(widths.begin(), widths.end());
+    if (!load_image_for_size(input_file, largest, 0, image) || !pyramid(image, levels, widths, kernel)) {
+        return false;
+    }
+
+    // last_encode_ sums every level so callers see the whole request
+    const std::filesystem::path out(output_file);
+    optimization::EncodeResult total;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const std::string level_file = (out.parent_path() / (out.stem().string() + "_" + std::to_string(widths[i]) +
+                                                              out.extension().string())).string();
+        if (!save_image(level_file, levels[i], "pyramid level", encode_options_, last_encode_)) return false;
+        total.format = last_encode_.format;
+        total.profile = last_encode_.profile;
+        total.bytes += last_encode_.bytes;
+        total.encode_ms += last_encode_.encode_ms;
+    }
+    total.success = true;
+    last_encode_ = total;
+    return true;
+}
+
+// ============================================================================
+// In-memory variants
+// ============================================================================
+
+bool ImageFilter::apply_blur(const cv::Mat& image, cv::Mat& result, int radius) {
+    try {
+        cpp_engine::utils::Logger::instance().info("Applying blur filter, radius=" + std::to_string(radius));
+        cv::blur(image, result, cv::Size(radius, radius));
+        cpp_engine::utils::Logger::instance().info("Blur filter applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in blur: " + std::string(e.what()));
         return false;
     }
 }
 
-bool ImageFilter::apply_sharpen(const std::string& input_file, const std::string& output_file, float strength) {
+bool ImageFilter::apply_sharpen(const cv::Mat& image, cv::Mat& result, float strength) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying sharpen filter, strength=" + std::to_string(strength));
-
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        cv::Mat sharpened;
         cv::Mat kernel = (cv::Mat_<float>(3,3) << 0, -strength, 0,
                                                 -strength, 1+4*strength, -strength,
                                                 0, -strength, 0);
-        cv::filter2D(image, sharpened, image.depth(), kernel);
-
-        if (cv::imwrite(output_file, sharpened)) {
-            cpp_engine::utils::Logger::instance().info("Sharpen filter applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save sharpened image: " + output_file);
-            return false;
-        }
+        cv::filter2D(image, result, image.depth(), kernel);
+        cpp_engine::utils::Logger::instance().info("Sharpen filter applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in sharpen: " + std::string(e.what()));
         return false;
     }
 }
 
-bool ImageFilter::apply_gaussian_blur(const std::string& input_file, const std::string& output_file, int kernel_size) {
+bool ImageFilter::apply_gaussian_blur(const cv::Mat& image, cv::Mat& result, int kernel_size) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying Gaussian blur, kernel=" + std::to_string(kernel_size));
-
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        cv::Mat gaussian_blurred;
-        cv::GaussianBlur(image, gaussian_blurred, cv::Size(kernel_size, kernel_size), 0);
-
-        if (cv::imwrite(output_file, gaussian_blurred)) {
-            cpp_engine::utils::Logger::instance().info("Gaussian blur applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save Gaussian blurred image: " + output_file);
-            return false;
-        }
+        cv::GaussianBlur(image, result, cv::Size(kernel_size, kernel_size), 0);
+        cpp_engine::utils::Logger::instance().info("Gaussian blur applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in Gaussian blur: " + std::string(e.what()));
         return false;
     }
 }
 
-bool ImageFilter::adjust_brightness(const std::string& input_file, const std::string& output_file, float factor) {
+bool ImageFilter::adjust_brightness(const cv::Mat& image, cv::Mat& result, float factor) {
     try {
         cpp_engine::utils::Logger::instance().info("Adjusting brightness, factor=" + std::to_string(factor));
-
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        cv::Mat brightness_adjusted;
-        image.convertTo(brightness_adjusted, -1, 1.0, factor * 50); // factor * 50 pour un effet visible
-
-        if (cv::imwrite(output_file, brightness_adjusted)) {
-            cpp_engine::utils::Logger::instance().info("Brightness adjusted successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save brightness adjusted image: " + output_file);
-            return false;
-        }
+        image.convertTo(result, -1, 1.0, factor * 50); // factor * 50 pour un effet visible
+        cpp_engine::utils::Logger::instance().info("Brightness adjusted successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in brightness: " + std::string(e.what()));
         return false;
     }
 }
 
-bool ImageFilter::adjust_contrast(const std::string& input_file, const std::string& output_file, float factor) {
+bool ImageFilter::adjust_contrast(const cv::Mat& image, cv::Mat& result, float factor) {
     try {
         cpp_engine::utils::Logger::instance().info("Adjusting contrast, factor=" + std::to_string(factor));
-
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        cv::Mat contrast_adjusted;
-        image.convertTo(contrast_adjusted, -1, factor, 0);
-
-        if (cv::imwrite(output_file, contrast_adjusted)) {
-            cpp_engine::utils::Logger::instance().info("Contrast adjusted successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save contrast adjusted image: " + output_file);
-            return false;
-        }
+        image.convertTo(result, -1, factor, 0);
+        cpp_engine::utils::Logger::instance().info("Contrast adjusted successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in contrast: " + std::string(e.what()));
         return false;
     }
 }
 
-bool ImageFilter::adjust_saturation(const std::string& input_file, const std::string& output_file, float factor) {
+bool ImageFilter::adjust_saturation(const cv::Mat& image, cv::Mat& result, float factor) {
     try {
         cpp_engine::utils::Logger::instance().info("Adjusting saturation, factor=" + std::to_string(factor));
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
         cv::Mat hsv_image;
         cv::cvtColor(image, hsv_image, cv::COLOR_BGR2HSV);
 
@@ -168,101 +282,150 @@ bool ImageFilter::adjust_saturation(const std::string& input_file, const std::st
             }
         }
 
-        cv::Mat saturation_adjusted;
-        cv::cvtColor(hsv_image, saturation_adjusted, cv::COLOR_HSV2BGR);
-
-        if (cv::imwrite(output_file, saturation_adjusted)) {
-            cpp_engine::utils::Logger::instance().info("Saturation adjusted successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save saturation adjusted image: " + output_file);
-            return false;
-        }
+        cv::cvtColor(hsv_image, result, cv::COLOR_HSV2BGR);
+        cpp_engine::utils::Logger::instance().info("Saturation adjusted successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in saturation: " + std::string(e.what()));
         return false;
     }
 }
 
-bool ImageFilter::detect_edges(const std::string& input_file, const std::string& output_file) {
+bool ImageFilter::detect_edges(const cv::Mat& image, cv::Mat& result) {
     try {
         cpp_engine::utils::Logger::instance().info("Detecting edges with Canny");
-
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
-
-        cv::Mat gray, edges;
+        cv::Mat gray;
         cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
-        cv::Canny(gray, edges, 100, 200);
-
-        if (cv::imwrite(output_file, edges)) {
-            cpp_engine::utils::Logger::instance().info("Edges detected successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save edges image: " + output_file);
-            return false;
-        }
+        cv::Canny(gray, result, 100, 200);
+        cpp_engine::utils::Logger::instance().info("Edges detected successfully");
+        return true;
     } catch (const cv::Exception& e) {
         cpp_engine::utils::Logger::instance().error("OpenCV error in edge detection: " + std::string(e.what()));
         return false;
     }
 }
 
-bool ImageFilter::dilate(const std::string& input_file, const std::string& output_file, int kernel_size) {
+bool ImageFilter::dilate(const cv::Mat& image, cv::Mat& result, int kernel_size) {
     try {
         cpp_engine::utils::Logger::instance().info("Applying dilation, kernel=" + std::to_string(kernel_size));
+        run_morphology(morphology_, &Morphology::dilate, cv::MORPH_DILATE, image, result, kernel_size);
+        cpp_engine::utils::Logger::instance().info("Dilation applied successfully");
+        return true;
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error in dilation: " + std::string(e.what()));
+        return false;
+    }
+}
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
-        }
+bool ImageFilter::erode(const cv::Mat& image, cv::Mat& result, int kernel_size) {
+    try {
+        cpp_engine::utils::Logger::instance().info("Applying erosion, kernel=" + std::to_string(kernel_size));
+        run_morphology(morphology_, &Morphology::erode, cv::MORPH_ERODE, image, result, kernel_size);
+        cpp_engine::utils::Logger::instance().info("Erosion applied successfully");
+        return true;
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error in erosion: " + std::string(e.what()));
+        return false;
+    }
+}
 
-        cv::Mat dilated;
-        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(kernel_size, kernel_size));
-        cv::dilate(image, dilated, kernel);
+bool ImageFilter::morph_open(const cv::Mat& image, cv::Mat& result, int kernel_size) {
+    try {
+        cpp_engine::utils::Logger::instance().info("Applying morphological opening, kernel=" + std::to_string(kernel_size));
+        run_morphology(morphology_, &Morphology::open, cv::MORPH_OPEN, image, result, kernel_size);
+        cpp_engine::utils::Logger::instance().info("Morphological opening applied successfully");
+        return true;
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error in morphological opening: " + std::string(e.what()));
+        return false;
+    }
+}
 
-        if (cv::imwrite(output_file, dilated)) {
-            cpp_engine::utils::Logger::instance().info("Dilation applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save dilated image: " + output_file);
-            return false;
-        }
+bool ImageFilter::morph_close(const cv::Mat& image, cv::Mat& result, int kernel_size) {
+    try {
+        cpp_engine::utils::Logger::instance().info("Applying morphological closing, kernel=" + std::to_string(kernel_size));
+        run_morphology(morphology_, &Morphology::close, cv::MORPH_CLOSE, image, result, kernel_size);
+        cpp_engine::utils::Logger::instance().info("Morphological closing applied successfully");
+        return true;
     } catch (const cv::Exception& e) {
-        cpp_engine::utils::Logger::instance().error("OpenCV error in dilation: " + std::string(e.what()));
+        cpp_engine::utils::Logger::instance().error("OpenCV error in morphological closing: " + std::string(e.what()));
         return false;
     }
 }
 
-bool ImageFilter::erode(const std::string& input_file, const std::string& output_file, int kernel_size) {
+bool ImageFilter::morph_gradient(const cv::Mat& image, cv::Mat& result, int kernel_size) {
     try {
-        cpp_engine::utils::Logger::instance().info("Applying erosion, kernel=" + std::to_string(kernel_size));
+        cpp_engine::utils::Logger::instance().info("Applying morphological gradient, kernel=" + std::to_string(kernel_size));
+        run_morphology(morphology_, &Morphology::gradient, cv::MORPH_GRADIENT, image, result, kernel_size);
+        cpp_engine::utils::Logger::instance().info("Morphological gradient applied successfully");
+        return true;
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error in morphological gradient: " + std::string(e.what()));
+        return false;
+    }
+}
 
-        cv::Mat image = cv::imread(input_file);
-        if (image.empty()) {
-            cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
-            return false;
+bool ImageFilter::resize(const cv::Mat& image, cv::Mat& result, int width, int height, ResizeKernel kernel) {
+    try {
+        const cv::Size size = target_size(image.cols, image.rows, width, height);
+        cpp_engine::utils::Logger::instance().info("Resizing " + std::to_string(image.cols) + "x" + std::to_string(image.rows) +
+                                                   " to " + std::to_string(size.width) + "x" + std::to_string(size.height));
+        if (image.depth() == CV_8U) {
+            result.create(size, image.type());
+            resampler_.resize(image.data, image.step, image.rows, image.cols,
+                              result.data, result.step, result.rows, result.cols, image.channels(), kernel);
+        } else {
+            cv::resize(image, result, size, 0, 0, kernel == ResizeKernel::AREA ? cv::INTER_AREA : cv::INTER_LANCZOS4);
         }
+        return true;
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error in resize: " + std::string(e.what()));
+        return false;
+    }
+}
 
-        cv::Mat eroded;
-        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(kernel_size, kernel_size));
-        cv::erode(image, eroded, kernel);
+bool ImageFilter::pyramid(const cv::Mat& image, std::vector<cv::Mat>& results, const std::vector<int>& widths,
+                          ResizeKernel kernel) {
+    std::vector<size_t> order(widths.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&widths](size_t a, size_t b) { return widths[a] > widths[b]; });
+
+    results.assign(widths.size(), cv::Mat());
+    std::vector<const cv::Mat*> done;  // decreasing widths
+    for (size_t i : order) {
+        if (widths[i] <= 0) return false;
+        const cv::Mat* source = &image;
+        for (const cv::Mat* level : done) {
+            if (level->cols >= 2 * widths[i]) source = level;
+        }
+        const int height = std::max(1, static_cast<int>(static_cast<int64_t>(image.rows) * widths[i] / image.cols));
+        if (!resize(*source, results[i], widths[i], height, kernel)) return false;
+        done.push_back(&results[i]);
+    }
+    return true;
+}
 
-        if (cv::imwrite(output_file, eroded)) {
-            cpp_engine::utils::Logger::instance().info("Erosion applied successfully");
-            return true;
-        } else {
-            cpp_engine::utils::Logger::instance().error("Failed to save eroded image: " + output_file);
-            return false;
+bool ImageFilter::decode_for_size(const std::vector<unsigned char>& bytes, int width, int height, cv::Mat& image) {
+    int flags = cv::IMREAD_COLOR;
+    int src_width = 0, src_height = 0;
+    if ((width > 0 || height > 0) && read_jpeg_size(bytes.data(), bytes.size(), src_width, src_height)) {
+        // imdecode applies the EXIF orientation: transposed ones decode with width and height swapped
+        if (read_jpeg_orientation(bytes.data(), bytes.size()) >= 5) std::swap(src_width, src_height);
+        const cv::Size size = target_size(src_width, src_height, width, height);
+        switch (reduced_decode_factor(src_width, src_height, size.width, size.height)) {
+            case 8: flags = cv::IMREAD_REDUCED_COLOR_8; break;
+            case 4: flags = cv::IMREAD_REDUCED_COLOR_4; break;
+            case 2: flags = cv::IMREAD_REDUCED_COLOR_2; break;
+            default: break;
         }
+    }
+    try {
+        image = cv::imdecode(bytes, flags);
     } catch (const cv::Exception& e) {
-        cpp_engine::utils::Logger::instance().error("OpenCV error in erosion: " + std::string(e.what()));
+        cpp_engine::utils::Logger::instance().error("OpenCV error decoding image: " + std::string(e.what()));
         return false;
     }
+    return !image.empty();
 }
 
 } // namespace filters
@@ -0,0 +1,200 @@
+#include "filters/morphology.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace cppengine {
+namespace filters {
+
+namespace {
+
+// Byte columns processed per strip; keeps the g/h buffers of a strip in L2
+constexpr int STRIP_BYTES = 256;
+constexpr int TRANSPOSE_BLOCK = 16;
+
+inline void combine_rows(const uint8_t* a, const uint8_t* b, uint8_t* out, int n, MorphOp op) {
+    int i = 0;
+#if defined(__AVX2__)
+    if (op == MorphOp::ERODE) {
+        for (; i + 32 <= n; i += 32) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_min_epu8(va, vb));
+        }
+    } else {
+        for (; i + 32 <= n; i += 32) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_max_epu8(va, vb));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    if (op == MorphOp::ERODE) {
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_min_epu8(va, vb));
+        }
+    } else {
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_max_epu8(va, vb));
+        }
+    }
+#endif
+    if (op == MorphOp::ERODE) {
+        for (; i < n; ++i) out[i] = std::min(a[i], b[i]);
+    } else {
+        for (; i < n; ++i) out[i] = std::max(a[i], b[i]);
+    }
+}
+
+template <int CN>
+void transpose_fixed(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                     int rows, int cols) {
+    for (int by = 0; by < rows; by += TRANSPOSE_BLOCK) {
+        const int ey = std::min(by + TRANSPOSE_BLOCK, rows);
+        for (int bx = 0; bx < cols; bx += TRANSPOSE_BLOCK) {
+            const int ex = std::min(bx + TRANSPOSE_BLOCK, cols);
+            for (int y = by; y < ey; ++y) {
+                const uint8_t* s = src + y * src_step + bx * CN;
+                for (int x = bx; x < ex; ++x, s += CN) {
+                    uint8_t* d = dst + x * dst_step + y * CN;
+                    for (int c = 0; c < CN; ++c) d[c] = s[c];
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+Morphology::Morphology() {}
+
+Morphology::~Morphology() {}
+
+void Morphology::vertical_pass(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                               int rows, int row_bytes, int ksize, MorphOp op,
+                               std::vector<uint8_t>& scratch) {
+    if (rows <= 0 || row_bytes <= 0) return;
+    if (ksize <= 1) {
+        if (src != dst) {
+            for (int y = 0; y < rows; ++y) std::memmove(dst + y * dst_step, src + y * src_step, row_bytes);
+        }
+        return;
+    }
+
+    const int anchor = ksize / 2;
+    const int ext_rows = rows + ksize - 1;
+    const int strip = std::min(STRIP_BYTES, row_bytes);
+    const size_t plane = static_cast<size_t>(ext_rows) * strip;
+    scratch.resize(2 * plane + strip);
+    uint8_t* g = scratch.data();
+    uint8_t* h = g + plane;
+    uint8_t* identity = h + plane;
+    std::memset(identity, op == MorphOp::ERODE ? 0xFF : 0x00, strip);
+
+    for (int c0 = 0; c0 < row_bytes; c0 += strip) {
+        const int w = std::min(strip, row_bytes - c0);
+        auto ext_row = [&](int i) -> const uint8_t* {
+            const int y = i - anchor;
+            return (y >= 0 && y < rows) ? src + y * src_step + c0 : identity;
+        };
+
+        // Forward running op, restarting at every block of ksize rows
+        for (int i = 0; i < ext_rows; ++i) {
+            uint8_t* gi = g + static_cast<size_t>(i) * strip;
+            if (i % ksize == 0) std::memcpy(gi, ext_row(i), w);
+            else combine_rows(gi - strip, ext_row(i), gi, w, op);
+        }
+        // Backward running op over the same blocks
+        for (int i = ext_rows - 1; i >= 0; --i) {
+            uint8_t* hi = h + static_cast<size_t>(i) * strip;
+            if (i == ext_rows - 1 || (i + 1) % ksize == 0) std::memcpy(hi, ext_row(i), w);
+            else combine_rows(hi + strip, ext_row(i), hi, w, op);
+        }
+        // Any window of ksize rows spans at most two blocks: op(suffix, prefix)
+        for (int y = 0; y < rows; ++y) {
+            combine_rows(h + static_cast<size_t>(y) * strip,
+                         g + static_cast<size_t>(y + ksize - 1) * strip,
+                         dst + y * dst_step + c0, w, op);
+        }
+    }
+}
+
+void Morphology::transpose(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                           int rows, int cols, int channels) {
+    switch (channels) {
+        case 1: transpose_fixed<1>(src, src_step, dst, dst_step, rows, cols); break;
+        case 3: transpose_fixed<3>(src, src_step, dst, dst_step, rows, cols); break;
+        case 4: transpose_fixed<4>(src, src_step, dst, dst_step, rows, cols); break;
+        default:
+            for (int y = 0; y < rows; ++y) {
+                for (int x = 0; x < cols; ++x) {
+                    std::memcpy(dst + x * dst_step + y * channels, src + y * src_step + x * channels, channels);
+                }
+            }
+            break;
+    }
+}
+
+void Morphology::apply(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                       int rows, int cols, int channels, int kernel_w, int kernel_h, MorphOp op) {
+    const int row_bytes = cols * channels;
+    vertical_pass(src, src_step, dst, dst_step, rows, row_bytes, kernel_h, op, strip_scratch_);
+
+    if (kernel_w > 1) {
+        // Horizontal pass = vertical pass on the transposed image
+        const size_t t_step = static_cast<size_t>(rows) * channels;
+        transposed_.resize(t_step * cols);
+        transpose(dst, dst_step, transposed_.data(), t_step, rows, cols, channels);
+        vertical_pass(transposed_.data(), t_step, transposed_.data(), t_step,
+                      cols, static_cast<int>(t_step), kernel_w, op, strip_scratch_);
+        transpose(transposed_.data(), t_step, dst, dst_step, cols, rows, channels);
+    }
+}
+
+void Morphology::erode(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                       int rows, int cols, int channels, int kernel_w, int kernel_h) {
+    apply(src, src_step, dst, dst_step, rows, cols, channels, kernel_w, kernel_h, MorphOp::ERODE);
+}
+
+void Morphology::dilate(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                        int rows, int cols, int channels, int kernel_w, int kernel_h) {
+    apply(src, src_step, dst, dst_step, rows, cols, channels, kernel_w, kernel_h, MorphOp::DILATE);
+}
+
+void Morphology::open(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                      int rows, int cols, int channels, int kernel_w, int kernel_h) {
+    apply(src, src_step, dst, dst_step, rows, cols, channels, kernel_w, kernel_h, MorphOp::ERODE);
+    apply(dst, dst_step, dst, dst_step, rows, cols, channels, kernel_w, kernel_h, MorphOp::DILATE);
+}
+
+void Morphology::close(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                       int rows, int cols, int channels, int kernel_w, int kernel_h) {
+    apply(src, src_step, dst, dst_step, rows, cols, channels, kernel_w, kernel_h, MorphOp::DILATE);
+    apply(dst, dst_step, dst, dst_step, rows, cols, channels, kernel_w, kernel_h, MorphOp::ERODE);
+}
+
+void Morphology::gradient(const uint8_t* src, size_t src_step, uint8_t* dst, size_t dst_step,
+                          int rows, int cols, int channels, int kernel_w, int kernel_h) {
+    const size_t row_bytes = static_cast<size_t>(cols) * channels;
+    intermediate_.resize(row_bytes * rows);
+    apply(src, src_step, intermediate_.data(), row_bytes, rows, cols, channels, kernel_w, kernel_h, MorphOp::ERODE);
+    apply(src, src_step, dst, dst_step, rows, cols, channels, kernel_w, kernel_h, MorphOp::DILATE);
+    // dilate >= erode everywhere, so a plain byte subtraction cannot wrap
+    for (int y = 0; y < rows; ++y) {
+        uint8_t* d = dst + y * dst_step;
+        const uint8_t* e = intermediate_.data() + y * row_bytes;
+        for (size_t i = 0; i < row_bytes; ++i) d[i] = static_cast<uint8_t>(d[i] - e[i]);
+    }
+}
+
+} // namespace filters
+} // namespace cppengine
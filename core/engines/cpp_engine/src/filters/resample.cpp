@@ -0,0 +1,399 @@
+#include "filters/resample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace cppengine {
+namespace filters {
+
+namespace {
+
+constexpr int PRECISION_BITS = 14;
+constexpr int ONE = 1 << PRECISION_BITS;
+constexpr int ROUND = 1 << (PRECISION_BITS - 1);
+constexpr double PI = 3.14159265358979323846;
+constexpr size_t ROW_PADDING = 16;
+
+inline uint8_t clamp_u8(int v) {
+    return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+double sinc(double x) {
+    if (x == 0.0) return 1.0;
+    x *= PI;
+    return std::sin(x) / x;
+}
+
+double lanczos3(double x) {
+    return (x > -3.0 && x < 3.0) ? sinc(x) * sinc(x / 3.0) : 0.0;
+}
+
+double triangle(double x) {
+    x = std::fabs(x);
+    return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+template <int CN>
+void horizontal_row(const uint8_t* src, uint8_t* dst, int dst_cols,
+                    const int* start, const int16_t* weights, int taps) {
+    for (int x = 0; x < dst_cols; ++x) {
+        const uint8_t* s = src + start[x] * CN;
+        const int16_t* w = weights + static_cast<size_t>(x) * taps;
+        int acc[CN];
+        for (int c = 0; c < CN; ++c) acc[c] = ROUND;
+        for (int k = 0; k < taps; ++k) {
+            for (int c = 0; c < CN; ++c) acc[c] += w[k] * s[k * CN + c];
+        }
+        for (int c = 0; c < CN; ++c) dst[x * CN + c] = clamp_u8(acc[c] >> PRECISION_BITS);
+    }
+}
+
+void horizontal_row_generic(const uint8_t* src, uint8_t* dst, int dst_cols, int cn,
+                            const int* start, const int16_t* weights, int taps) {
+    for (int x = 0; x < dst_cols; ++x) {
+        const uint8_t* s = src + start[x] * cn;
+        const int16_t* w = weights + static_cast<size_t>(x) * taps;
+        for (int c = 0; c < cn; ++c) {
+            int acc = ROUND;
+            for (int k = 0; k < taps; ++k) acc += w[k] * s[k * cn + c];
+            dst[x * cn + c] = clamp_u8(acc >> PRECISION_BITS);
+        }
+    }
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+inline int pack_weights(int16_t a, int16_t b) {
+    return static_cast<int>(static_cast<uint32_t>(static_cast<uint16_t>(a)) |
+                            (static_cast<uint32_t>(static_cast<uint16_t>(b)) << 16));
+}
+#endif
+
+#if defined(__SSE2__)
+// 3 or 4 channels, one output pixel per iteration: taps k and k+1 are interleaved channel by channel
+// so one madd adds both into per-channel sums. A 3-channel load reads one byte past the pixel (the
+// caller pads the row) into lane 3, which is never stored
+template <int CN>
+void horizontal_row_simd(const uint8_t* src, uint8_t* dst, int dst_cols,
+                         const int* start, const int16_t* weights, int taps) {
+    static_assert(CN == 3 || CN == 4, "3 or 4 channels");
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(ROUND);
+    auto load = [](const uint8_t* p) {
+        int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return _mm_cvtsi32_si128(v);
+    };
+    for (int x = 0; x < dst_cols; ++x) {
+        const uint8_t* s = src + start[x] * CN;
+        const int16_t* w = weights + static_cast<size_t>(x) * taps;
+        __m128i acc = round;
+        for (int k = 0; k < taps; k += 2) {
+            const bool pair = k + 1 < taps;
+            const __m128i wab = _mm_set1_epi32(pack_weights(w[k], pair ? w[k + 1] : 0));
+            const __m128i a = load(s + k * CN);
+            const __m128i b = pair ? load(s + (k + 1) * CN) : zero;
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(a, b), zero), wab));
+        }
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(_mm_srai_epi32(acc, PRECISION_BITS), zero), zero);
+        const int32_t out = _mm_cvtsi128_si32(packed);
+        std::memcpy(dst + x * CN, &out, CN);
+    }
+}
+
+// One channel: the taps are contiguous, so eight of them go through one madd with the weights;
+// shorter filters stay scalar, where the horizontal sum would cost more than it saves
+void horizontal_row_gray(const uint8_t* src, uint8_t* dst, int dst_cols,
+                         const int* start, const int16_t* weights, int taps) {
+    if (taps < 8) {
+        horizontal_row<1>(src, dst, dst_cols, start, weights, taps);
+        return;
+    }
+    const __m128i zero = _mm_setzero_si128();
+    for (int x = 0; x < dst_cols; ++x) {
+        const uint8_t* s = src + start[x];
+        const int16_t* w = weights + static_cast<size_t>(x) * taps;
+        int k = 0;
+        __m128i sums = zero;
+        for (; k + 8 <= taps; k += 8) {
+            const __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + k)), zero);
+            sums = _mm_add_epi32(sums, _mm_madd_epi16(pixels, _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + k))));
+        }
+        sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+        sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+        int acc = ROUND + _mm_cvtsi128_si32(sums);
+        for (; k < taps; ++k) acc += w[k] * s[k];
+        dst[x] = clamp_u8(acc >> PRECISION_BITS);
+    }
+}
+#endif
+
+// out[i] = sum_k w[k] * rows[k][i]; rows are taken in pairs so one madd does two taps
+void vertical_row(const uint8_t* const* rows, const int16_t* w, int taps, uint8_t* out, int n) {
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256i zero256 = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        __m256i s0 = _mm256_set1_epi32(ROUND), s1 = s0, s2 = s0, s3 = s0;
+        for (int k = 0; k < taps; k += 2) {
+            const bool pair = k + 1 < taps;
+            const __m256i wab = _mm256_set1_epi32(pack_weights(w[k], pair ? w[k + 1] : 0));
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k] + i));
+            const __m256i b = pair ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[k + 1] + i)) : zero256;
+            const __m256i a_lo = _mm256_unpacklo_epi8(a, zero256), a_hi = _mm256_unpackhi_epi8(a, zero256);
+            const __m256i b_lo = _mm256_unpacklo_epi8(b, zero256), b_hi = _mm256_unpackhi_epi8(b, zero256);
+            s0 = _mm256_add_epi32(s0, _mm256_madd_epi16(_mm256_unpacklo_epi16(a_lo, b_lo), wab));
+            s1 = _mm256_add_epi32(s1, _mm256_madd_epi16(_mm256_unpackhi_epi16(a_lo, b_lo), wab));
+            s2 = _mm256_add_epi32(s2, _mm256_madd_epi16(_mm256_unpacklo_epi16(a_hi, b_hi), wab));
+            s3 = _mm256_add_epi32(s3, _mm256_madd_epi16(_mm256_unpackhi_epi16(a_hi, b_hi), wab));
+        }
+        // The packs undo the per-lane unpacks, so bytes come back in source order
+        const __m256i p01 = _mm256_packs_epi32(_mm256_srai_epi32(s0, PRECISION_BITS), _mm256_srai_epi32(s1, PRECISION_BITS));
+        const __m256i p23 = _mm256_packs_epi32(_mm256_srai_epi32(s2, PRECISION_BITS), _mm256_srai_epi32(s3, PRECISION_BITS));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_packus_epi16(p01, p23));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i s0 = _mm_set1_epi32(ROUND), s1 = s0, s2 = s0, s3 = s0;
+        for (int k = 0; k < taps; k += 2) {
+            const bool pair = k + 1 < taps;
+            const __m128i wab = _mm_set1_epi32(pack_weights(w[k], pair ? w[k + 1] : 0));
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + i));
+            const __m128i b = pair ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k + 1] + i)) : zero;
+            const __m128i a_lo = _mm_unpacklo_epi8(a, zero), a_hi = _mm_unpackhi_epi8(a, zero);
+            const __m128i b_lo = _mm_unpacklo_epi8(b, zero), b_hi = _mm_unpackhi_epi8(b, zero);
+            s0 = _mm_add_epi32(s0, _mm_madd_epi16(_mm_unpacklo_epi16(a_lo, b_lo), wab));
+            s1 = _mm_add_epi32(s1, _mm_madd_epi16(_mm_unpackhi_epi16(a_lo, b_lo), wab));
+            s2 = _mm_add_epi32(s2, _mm_madd_epi16(_mm_unpacklo_epi16(a_hi, b_hi), wab));
+            s3 = _mm_add_epi32(s3, _mm_madd_epi16(_mm_unpackhi_epi16(a_hi, b_hi), wab));
+        }
+        const __m128i p01 = _mm_packs_epi32(_mm_srai_epi32(s0, PRECISION_BITS), _mm_srai_epi32(s1, PRECISION_BITS));
+        const __m128i p23 = _mm_packs_epi32(_mm_srai_epi32(s2, PRECISION_BITS), _mm_srai_epi32(s3, PRECISION_BITS));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(p01, p23));
+    }
+#endif
+    for (; i < n; ++i) {
+        int acc = ROUND;
+        for (int k = 0; k < taps; ++k) acc += w[k] * rows[k][i];
+        out[i] = clamp_u8(acc >> PRECISION_BITS);
+    }
+}
+
+} // namespace
+
+Resampler::Resampler() {}
+
+Resampler::~Resampler() {}
+
+void Resampler::build_taps(int in_size, int out_size, ResizeKernel kernel, Taps& taps) {
+    const double scale = static_cast<double>(in_size) / out_size;
+    const double filter_scale = std::max(scale, 1.0);
+    const bool area = kernel == ResizeKernel::AREA && scale >= 1.0;
+    const double support = area ? scale * 0.5 : (kernel == ResizeKernel::LANCZOS3 ? 3.0 : 1.0) * filter_scale;
+
+    std::vector<int> first(out_size), count(out_size);
+    std::vector<std::vector<double>> raw(out_size);
+    taps.max_taps = 0;
+    for (int i = 0; i < out_size; ++i) {
+        const double center = (i + 0.5) * scale;
+        const int lo = std::max(0, static_cast<int>(std::floor(center - support)));
+        const int hi = std::min(in_size, static_cast<int>(std::ceil(center + support)));
+        std::vector<double>& w = raw[i];
+        for (int x = lo; x < hi; ++x) {
+            double v;
+            if (area) {
+                // Overlap of source pixel [x, x+1) with the output footprint
+                v = std::max(0.0, std::min(x + 1.0, center + support) - std::max(static_cast<double>(x), center - support));
+            } else if (kernel == ResizeKernel::LANCZOS3) {
+                v = lanczos3((x + 0.5 - center) / filter_scale);
+            } else {
+                v = triangle((x + 0.5 - center) / filter_scale);
+            }
+            w.push_back(v);
+        }
+        // Trim zero-weight ends so the tap count stays tight
+        int begin = 0, end = static_cast<int>(w.size());
+        while (begin < end && w[begin] == 0.0) ++begin;
+        while (end > begin && w[end - 1] == 0.0) --end;
+        w = std::vector<double>(w.begin() + begin, w.begin() + end);
+        first[i] = lo + begin;
+        count[i] = static_cast<int>(w.size());
+        taps.max_taps = std::max(taps.max_taps, count[i]);
+    }
+
+    taps.start.assign(out_size, 0);
+    taps.weights.assign(static_cast<size_t>(out_size) * taps.max_taps, 0);
+    for (int i = 0; i < out_size; ++i) {
+        const std::vector<double>& w = raw[i];
+        double sum = 0.0;
+        for (double v : w) sum += v;
+        if (w.empty() || sum == 0.0) {
+            // Degenerate footprint: nearest source sample
+            taps.start[i] = std::min(in_size - taps.max_taps, std::max(0, static_cast<int>((i + 0.5) * scale)));
+            taps.weights[static_cast<size_t>(i) * taps.max_taps] = ONE;
+            continue;
+        }
+        // Every row reads max_taps samples; shift the window left at the right edge
+        const int start = std::min(first[i], in_size - taps.max_taps);
+        const int offset = first[i] - start;
+        int16_t* dst = &taps.weights[static_cast<size_t>(i) * taps.max_taps];
+        int total = 0, largest = 0;
+        for (int k = 0; k < count[i]; ++k) {
+            dst[offset + k] = static_cast<int16_t>(std::lround(w[k] / sum * ONE));
+            total += dst[offset + k];
+            if (dst[offset + k] > dst[offset + largest]) largest = k;
+        }
+        dst[offset + largest] = static_cast<int16_t>(dst[offset + largest] + ONE - total);
+        taps.start[i] = start;
+    }
+}
+
+void Resampler::resize(const uint8_t* src, size_t src_step, int src_rows, int src_cols,
+                       uint8_t* dst, size_t dst_step, int dst_rows, int dst_cols,
+                       int channels, ResizeKernel kernel) {
+    if (src_rows <= 0 || src_cols <= 0 || dst_rows <= 0 || dst_cols <= 0) return;
+
+    build_taps(src_cols, dst_cols, kernel, horizontal_taps_);
+    build_taps(src_rows, dst_rows, kernel, vertical_taps_);
+
+    // Vertical pass first: it is SIMD across the full source row, and leaves only dst_rows
+    // rows for the horizontal pass, SIMD per output pixel. The padding covers the 4-byte loads of
+    // 3-channel pixels at the end of the last row
+    const int src_row_bytes = src_cols * channels;
+    intermediate_.resize(static_cast<size_t>(dst_rows) * src_row_bytes + ROW_PADDING);
+    const int vtaps = vertical_taps_.max_taps;
+    std::vector<const uint8_t*> rows(vtaps);
+    for (int y = 0; y < dst_rows; ++y) {
+        const int start = vertical_taps_.start[y];
+        for (int k = 0; k < vtaps; ++k) rows[k] = src + static_cast<size_t>(start + k) * src_step;
+        vertical_row(rows.data(), &vertical_taps_.weights[static_cast<size_t>(y) * vtaps], vtaps,
+                     &intermediate_[static_cast<size_t>(y) * src_row_bytes], src_row_bytes);
+    }
+
+    const int* hstart = horizontal_taps_.start.data();
+    const int16_t* hweights = horizontal_taps_.weights.data();
+    const int htaps = horizontal_taps_.max_taps;
+    for (int y = 0; y < dst_rows; ++y) {
+        const uint8_t* s = &intermediate_[static_cast<size_t>(y) * src_row_bytes];
+        uint8_t* d = dst + static_cast<size_t>(y) * dst_step;
+        switch (channels) {
+#if defined(__SSE2__)
+            case 1: horizontal_row_gray(s, d, dst_cols, hstart, hweights, htaps); break;
+            case 3: horizontal_row_simd<3>(s, d, dst_cols, hstart, hweights, htaps); break;
+            case 4: horizontal_row_simd<4>(s, d, dst_cols, hstart, hweights, htaps); break;
+#else
+            case 1: horizontal_row<1>(s, d, dst_cols, hstart, hweights, htaps); break;
+            case 3: horizontal_row<3>(s, d, dst_cols, hstart, hweights, htaps); break;
+            case 4: horizontal_row<4>(s, d, dst_cols, hstart, hweights, htaps); break;
+#endif
+            default: horizontal_row_generic(s, d, dst_cols, channels, hstart, hweights, htaps); break;
+        }
+    }
+}
+
+namespace {
+
+// Calls visit(marker, payload, length) for each segment before the image data until it returns true;
+// false if none did or the stream is not a JPEG
+template <typename Visit>
+bool visit_jpeg_segments(const uint8_t* data, size_t size, Visit visit) {
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) return false;
+    size_t pos = 2;
+    while (pos + 4 <= size) {
+        if (data[pos] != 0xFF) return false;
+        while (pos < size && data[pos] == 0xFF) ++pos;  // fill bytes
+        if (pos >= size) return false;
+        const uint8_t marker = data[pos++];
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) continue;  // no length field
+        if (marker == 0xD9 || marker == 0xDA || pos + 2 > size) return false;  // EOI/SOS
+        const size_t length = (static_cast<size_t>(data[pos]) << 8) | data[pos + 1];
+        if (length < 2) return false;
+        if (visit(marker, data + pos + 2, std::min(length - 2, size - pos - 2))) return true;
+        pos += length;
+    }
+    return false;
+}
+
+// Orientation tag of an APP1 Exif payload's first IFD; 0 if absent
+int exif_orientation(const uint8_t* payload, size_t length) {
+    static const uint8_t header[6] = {'E', 'x', 'i', 'f', 0, 0};
+    if (length < 14 || std::memcmp(payload, header, sizeof(header)) != 0) return 0;
+    const uint8_t* tiff = payload + 6;
+    const size_t size = length - 6;
+    const bool little = tiff[0] == 'I' && tiff[1] == 'I';
+    if (!little && !(tiff[0] == 'M' && tiff[1] == 'M')) return 0;
+    auto u16 = [&](size_t at) {
+        return little ? static_cast<uint32_t>(tiff[at] | tiff[at + 1] << 8) : static_cast<uint32_t>(tiff[at] << 8 | tiff[at + 1]);
+    };
+    auto u32 = [&](size_t at) { return little ? u16(at) | u16(at + 2) << 16 : u16(at) << 16 | u16(at + 2); };
+    const size_t ifd = u32(4);
+    if (u16(2) != 42 || ifd > size - 2) return 0;
+    const uint32_t entries = u16(ifd);
+    for (uint32_t i = 0; i < entries; ++i) {
+        const size_t entry = ifd + 2 + static_cast<size_t>(i) * 12;
+        if (entry + 12 > size) return 0;
+        if (u16(entry) == 0x0112 && u16(entry + 2) == 3) {  // Orientation, SHORT
+            const uint32_t value = u16(entry + 8);
+            return value >= 1 && value <= 8 ? static_cast<int>(value) : 0;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+bool read_jpeg_size(const uint8_t* data, size_t size, int& width, int& height) {
+    return visit_jpeg_segments(data, size, [&](uint8_t marker, const uint8_t* payload, size_t length) {
+        const bool sof = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+        if (!sof) return false;
+        if (length < 5) {
+            width = height = 0;
+            return true;
+        }
+        height = (payload[1] << 8) | payload[2];
+        width = (payload[3] << 8) | payload[4];
+        return true;
+    }) && width > 0 && height > 0;
+}
+
+int read_jpeg_orientation(const uint8_t* data, size_t size) {
+    int orientation = 1;
+    visit_jpeg_segments(data, size, [&](uint8_t marker, const uint8_t* payload, size_t length) {
+        if (marker != 0xE1) return false;
+        const int found = exif_orientation(payload, length);
+        if (found) orientation = found;
+        return found != 0;
+    });
+    return orientation;
+}
+
+bool read_png_size(const uint8_t* data, size_t size, int& width, int& height) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (size < 24 || std::memcmp(data, signature, sizeof(signature)) != 0) return false;
+    auto be32 = [&](size_t at) {
+        return static_cast<int>(static_cast<uint32_t>(data[at]) << 24 | static_cast<uint32_t>(data[at + 1]) << 16 |
+                                static_cast<uint32_t>(data[at + 2]) << 8 | data[at + 3]);
+    };
+    width = be32(16);  // IHDR is always the first chunk
+    height = be32(20);
+    return width > 0 && height > 0;
+}
+
+int reduced_decode_factor(int src_width, int src_height, int dst_width, int dst_height) {
+    for (int factor : {8, 4, 2}) {
+        // libjpeg rounds scaled dimensions up
+        if ((src_width + factor - 1) / factor >= dst_width && (src_height + factor - 1) / factor >= dst_height) {
+            return factor;
+        }
+    }
+    return 1;
+}
+
+} // namespace filters
+} // namespace cppengine
@@ -1,11 +1,20 @@
 // generators/image_generator.cpp
 #include "generators/image_generator.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
 #include <iostream>
 
 namespace cpp_engine::generators {
 
+using cppengine::optimization::EncodeResult;
+using cppengine::optimization::ImageEncoder;
+
 ImageGenerator::ImageGenerator() : quality_(8) {}
 
+ImageGenerator::ImageGenerator(const ProceduralOptions& options) : quality_(8), options_(options) {}
+
 ImageGenerator::~ImageGenerator() {}
 
 void ImageGenerator::set_quality(int quality) {
@@ -13,10 +22,37 @@ void ImageGenerator::set_quality(int quality) {
     std::cout << "ImageGenerator: quality set to " << quality_ << std::endl;
 }
 
+bool ImageGenerator::render(const ImageRequest& request, cv::Mat& out) const {
+    ProceduralOptions options = options_;
+    options.noise = request.noise;
+    return ProceduralGenerator(options).generate(request.kind, request.width, request.height, request.seed, out);
+}
+
+bool ImageGenerator::encode(const ImageRequest& request, const std::string& format, std::vector<unsigned char>& bytes,
+                            EncodeResult* result) const {
+    cv::Mat image;
+    if (!render(request, image)) return false;
+    const EncodeResult encoded = ImageEncoder::encode(image, format, encode_options_, bytes);
+    if (result) *result = encoded;
+    if (!encoded.success) {
+        utils::Logger::instance().error(std::string("ImageGenerator: cannot encode ") +
+                                        ProceduralGenerator::kind_name(request.kind) + " image as " + format);
+    }
+    return encoded.success;
+}
+
 bool ImageGenerator::generate_perlin(int width, int height, int seed, const std::string& output_path) {
-    (void)width; (void)height; (void)seed; (void)output_path;
-    std::cout << "ImageGenerator: generate_perlin stub - " << width << "x" << height << ", seed: " << seed << std::endl;
-    return true; // Stub implementation
+    ImageRequest request;
+    request.width = width;
+    request.height = height;
+    request.seed = static_cast<unsigned int>(seed);
+    cv::Mat image;
+    if (!render(request, image)) return false;
+    if (!ImageEncoder::write(output_path, image, encode_options_).success) {
+        utils::Logger::instance().error("ImageGenerator: cannot write " + output_path);
+        return false;
+    }
+    return true;
 }
 
 bool ImageGenerator::generate_image(const std::string& prompt, const std::string& output_path, int width, int height) {
@@ -35,4 +71,4 @@ std::vector<std::string> ImageGenerator::get_available_models() {
     return {"stub_model_v1", "stub_model_v2"};
 }
 
-} // namespace cpp_engine::generators
\ No newline at end of file
+} // namespace cpp_engine::generators
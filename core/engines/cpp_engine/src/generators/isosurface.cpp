@@ -0,0 +1,342 @@
+// generators/isosurface.cpp
+#include "generators/isosurface.h"
+#include "generators/simplex_noise.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cpp_engine::generators {
+
+namespace {
+
+constexpr int MAX_RESOLUTION = 2048;
+constexpr int MAX_CASE_TRIANGLES = 12;
+constexpr uint64_t EMPTY_KEY = std::numeric_limits<uint64_t>::max();
+constexpr uint32_t UNMAPPED = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Marching-cubes cases. Corner c sits at (c & 1, c >> 1 & 1, c >> 2 & 1); edge e runs along
+ * axis e / 4 from its lower corner. Bit c of a case is set when corner c is inside.
+ */
+struct CaseTable {
+    int edge_lower[12];
+    int edge_axis[12];
+    int triangle_count[256];
+    signed char triangles[256][MAX_CASE_TRIANGLES * 3];
+
+    CaseTable() {
+        int edge_of[8][8];
+        for (int axis = 0, e = 0; axis < 3; ++axis) {
+            for (int c = 0; c < 8; ++c) {
+                if (c & (1 << axis)) continue;
+                edge_lower[e] = c;
+                edge_axis[e] = axis;
+                edge_of[c][c | (1 << axis)] = edge_of[c | (1 << axis)][c] = e;
+                ++e;
+            }
+        }
+
+        // Each face's corners counter-clockwise seen from outside the cube
+        int faces[6][4];
+        for (int axis = 0; axis < 3; ++axis) {
+            for (int side = 0; side < 2; ++side) {
+                const int u = 1 << ((axis + 1) % 3), v = 1 << ((axis + 2) % 3), base = side << axis;
+                int* face = faces[axis * 2 + side];
+                face[0] = base;
+                face[1] = base | u;
+                face[2] = base | u | v;
+                face[3] = base | v;
+                if (side == 0) std::swap(face[1], face[3]);
+            }
+        }
+
+        for (int config = 0; config < 256; ++config) {
+            auto inside = [config](int corner) { return (config >> corner & 1) != 0; };
+            // Contour segments from the edge where a run of inside corners starts to where it ends,
+            // walking each face counter-clockwise; every crossed edge starts one segment and ends one
+            int next[12];
+            std::fill(next, next + 12, -1);
+            for (const int* face : faces) {
+                for (int k = 0; k < 4; ++k) {
+                    const int previous = face[(k + 3) % 4];
+                    if (!inside(face[k]) || inside(previous)) continue;
+                    int m = k;
+                    while (inside(face[(m + 1) % 4])) m = (m + 1) % 4;
+                    next[edge_of[previous][face[k]]] = edge_of[face[m]][face[(m + 1) % 4]];
+                }
+            }
+            int count = 0;
+            bool used[12] = {};
+            for (int start = 0; start < 12; ++start) {
+                if (next[start] < 0 || used[start]) continue;
+                int loop[12], length = 0;
+                for (int e = start; !used[e]; e = next[e]) {
+                    used[e] = true;
+                    loop[length++] = e;
+                }
+                for (int k = 1; k + 1 < length; ++k, ++count) {
+                    triangles[config][count * 3] = static_cast<signed char>(loop[0]);
+                    triangles[config][count * 3 + 1] = static_cast<signed char>(loop[k]);
+                    triangles[config][count * 3 + 2] = static_cast<signed char>(loop[k + 1]);
+                }
+            }
+            triangle_count[config] = count;
+        }
+    }
+};
+
+const CaseTable& case_table() {
+    static const CaseTable table;
+    return table;
+}
+
+// Open addressing with linear probing from global lattice edge keys to slab vertex indices
+class EdgeTable {
+public:
+    EdgeTable() { rehash(1 << 12); }
+
+    // The vertex for key, or UNMAPPED after reserving its slot for value
+    uint32_t find_or_insert(uint64_t key, uint32_t value) {
+        if ((size_ + 1) * 2 > keys_.size()) rehash(keys_.size() * 2);
+        size_t slot = slot_for(key);
+        while (keys_[slot] != EMPTY_KEY) {
+            if (keys_[slot] == key) return values_[slot];
+            slot = (slot + 1) & mask_;
+        }
+        keys_[slot] = key;
+        values_[slot] = value;
+        ++size_;
+        return UNMAPPED;
+    }
+
+    size_t bytes() const { return keys_.size() * (sizeof(uint64_t) + sizeof(uint32_t)); }
+
+private:
+    size_t slot_for(uint64_t key) const { return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask_; }
+
+    void rehash(size_t capacity) {
+        std::vector<uint64_t> keys(capacity, EMPTY_KEY);
+        std::vector<uint32_t> values(capacity);
+        keys.swap(keys_);
+        values.swap(values_);
+        mask_ = capacity - 1;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == EMPTY_KEY) continue;
+            size_t slot = slot_for(keys[i]);
+            while (keys_[slot] != EMPTY_KEY) slot = (slot + 1) & mask_;
+            keys_[slot] = keys[i];
+            values_[slot] = values[i];
+        }
+    }
+
+    std::vector<uint64_t> keys_;
+    std::vector<uint32_t> values_;
+    size_t size_ = 0;
+    size_t mask_ = 0;
+};
+
+using PlaneVertices = std::vector<std::pair<uint64_t, uint32_t>>;  // edge key, vertex; sorted by key
+
+struct SlabMesh {
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    PlaneVertices bottom;  // vertices on x/y edges of the slab's first lattice layer
+    PlaneVertices top;     // and of its last, shared with the slab above
+    size_t working_bytes = 0;
+};
+
+// One lattice layer of samples, and a byte per sample that is 1 inside
+void sample_layer(const FieldRow& field, int z, int samples, float origin, float step, float iso, float* out,
+                  uint8_t* inside) {
+    const float wz = origin + z * step;
+    for (int y = 0; y < samples; ++y) {
+        field(origin, origin + y * step, wz, step, samples, out + static_cast<size_t>(y) * samples);
+    }
+    const size_t size = static_cast<size_t>(samples) * samples;
+    for (size_t i = 0; i < size; ++i) inside[i] = out[i] < iso;
+}
+
+void extract_slab(const FieldRow& field, const IsosurfaceOptions& options, int z0, int z1, SlabMesh& slab) {
+    const CaseTable& table = case_table();
+    const int n = options.resolution;
+    const int samples = n + 1;
+    const size_t layer_size = static_cast<size_t>(samples) * samples;
+    const float step = 2.0f * options.extent / n;
+    const float origin = -options.extent;
+    const float iso = options.iso;
+    std::vector<float> lo(layer_size), hi(layer_size);
+    std::vector<uint8_t> lo_inside(layer_size), hi_inside(layer_size);
+    std::vector<uint8_t> configs(static_cast<size_t>(n) + 8, 0);
+    EdgeTable edges;
+
+    sample_layer(field, z0, samples, origin, step, iso, lo.data(), lo_inside.data());
+    for (int z = z0; z < z1; ++z) {
+        sample_layer(field, z + 1, samples, origin, step, iso, hi.data(), hi_inside.data());
+        const float* layers[2] = {lo.data(), hi.data()};
+        for (int y = 0; y < n; ++y) {
+            // The case of every cell in the row from the corner bytes, bit c for corner c
+            const uint8_t* r0 = lo_inside.data() + static_cast<size_t>(y) * samples;
+            const uint8_t* r1 = r0 + samples;
+            const uint8_t* r2 = hi_inside.data() + static_cast<size_t>(y) * samples;
+            const uint8_t* r3 = r2 + samples;
+            uint8_t* row_configs = configs.data();
+            for (int x = 0; x < n; ++x) {
+                row_configs[x] = static_cast<uint8_t>(r0[x] | r0[x + 1] << 1 | r1[x] << 2 | r1[x + 1] << 3 |
+                                                      r2[x] << 4 | r2[x + 1] << 5 | r3[x] << 6 | r3[x + 1] << 7);
+            }
+            for (int x = 0; x < n; ++x) {
+                // Eight cells at a time while they are all outside or all inside
+                if (x + 8 <= n) {
+                    uint64_t run;
+                    std::memcpy(&run, row_configs + x, sizeof(run));
+                    if (run == 0 || run == ~0ull) {
+                        x += 7;
+                        continue;
+                    }
+                }
+                const int config = row_configs[x];
+                const int count = table.triangle_count[config];
+                if (count == 0) continue;
+
+                float value[8];
+                for (int c = 0; c < 8; ++c) {
+                    value[c] = layers[c >> 2][static_cast<size_t>(y + (c >> 1 & 1)) * samples + x + (c & 1)];
+                }
+                uint32_t cell_vertex[12];
+                std::fill(cell_vertex, cell_vertex + 12, UNMAPPED);
+                for (int t = 0; t < count * 3; ++t) {
+                    const int e = table.triangles[config][t];
+                    if (cell_vertex[e] == UNMAPPED) {
+                        const int a = table.edge_lower[e], axis = table.edge_axis[e];
+                        const int ex = x + (a & 1), ey = y + (a >> 1 & 1), ez = z + (a >> 2 & 1);
+                        const uint64_t key =
+                            ((static_cast<uint64_t>(ez) * samples + ey) * samples + ex) * 3 + static_cast<uint64_t>(axis);
+                        const uint32_t fresh = static_cast<uint32_t>(slab.positions.size() / 3);
+                        const uint32_t found = edges.find_or_insert(key, fresh);
+                        if (found != UNMAPPED) {
+                            cell_vertex[e] = found;
+                        } else {
+                            const float f0 = value[a], f1 = value[a | (1 << axis)];
+                            const float along = (iso - f0) / (f1 - f0);
+                            float p[3] = {origin + ex * step, origin + ey * step, origin + ez * step};
+                            p[axis] += along * step;
+                            slab.positions.insert(slab.positions.end(), p, p + 3);
+                            if (axis != 2 && ez == z0) slab.bottom.emplace_back(key, fresh);
+                            if (axis != 2 && ez == z1) slab.top.emplace_back(key, fresh);
+                            cell_vertex[e] = fresh;
+                        }
+                    }
+                    slab.indices.push_back(cell_vertex[e]);
+                }
+            }
+        }
+        lo.swap(hi);
+        lo_inside.swap(hi_inside);
+    }
+    std::sort(slab.bottom.begin(), slab.bottom.end());
+    std::sort(slab.top.begin(), slab.top.end());
+    slab.working_bytes = 2 * layer_size * (sizeof(float) + 1) + edges.bytes() + slab.positions.capacity() * sizeof(float) +
+                         slab.indices.capacity() * sizeof(uint32_t) +
+                         (slab.bottom.capacity() + slab.top.capacity()) * sizeof(PlaneVertices::value_type);
+}
+
+// Appends a slab in order; its bottom-plane vertices resolve to the previous slab's top plane
+bool merge_slab(SlabMesh& slab, PlaneVertices& previous_top, Mesh& out, size_t& seam_vertices) {
+    const size_t local_count = slab.positions.size() / 3;
+    std::vector<uint32_t> remap(local_count, UNMAPPED);
+    size_t match = 0;
+    for (const auto& [key, local] : slab.bottom) {
+        while (match < previous_top.size() && previous_top[match].first < key) ++match;
+        if (match < previous_top.size() && previous_top[match].first == key) {
+            remap[local] = previous_top[match].second;
+            ++seam_vertices;
+        }
+    }
+    size_t next = out.vertex_count();
+    if (next + local_count > UNMAPPED) {
+        utils::Logger::instance().error("IsosurfaceExtractor: mesh exceeds 32-bit indices");
+        return false;
+    }
+    out.positions.reserve(out.positions.size() + slab.positions.size());
+    for (size_t v = 0; v < local_count; ++v) {
+        if (remap[v] != UNMAPPED) continue;
+        remap[v] = static_cast<uint32_t>(next++);
+        out.positions.insert(out.positions.end(), slab.positions.begin() + v * 3, slab.positions.begin() + v * 3 + 3);
+    }
+    out.indices.reserve(out.indices.size() + slab.indices.size());
+    for (uint32_t index : slab.indices) out.indices.push_back(remap[index]);
+    previous_top.swap(slab.top);
+    for (auto& entry : previous_top) entry.second = remap[entry.second];
+    slab = SlabMesh();
+    return true;
+}
+
+} // namespace
+
+bool IsosurfaceExtractor::extract(const FieldRow& field, const IsosurfaceOptions& options, Mesh& out, Stats* stats) {
+    if (!field || options.resolution < 1 || options.resolution > MAX_RESOLUTION || !(options.extent > 0.0f) ||
+        !std::isfinite(options.extent) || options.slab_cells < 1) {
+        utils::Logger::instance().error("IsosurfaceExtractor: invalid options, resolution " +
+                                        std::to_string(options.resolution) + ", slab " +
+                                        std::to_string(options.slab_cells));
+        return false;
+    }
+    const int n = options.resolution;
+    const int slab_count = (n + options.slab_cells - 1) / options.slab_cells;
+    const int wave = std::max(1, cv::getNumThreads());
+    Stats result;
+    result.slabs = slab_count;
+    out = Mesh();
+    PlaneVertices previous_top;
+    std::vector<SlabMesh> slabs(static_cast<size_t>(std::min(wave, slab_count)));
+
+    for (int first = 0; first < slab_count; first += wave) {
+        const int count = std::min(wave, slab_count - first);
+        cv::parallel_for_(cv::Range(0, count), [&](const cv::Range& range) {
+            for (int s = range.start; s < range.end; ++s) {
+                const int z0 = (first + s) * options.slab_cells;
+                extract_slab(field, options, z0, std::min(n, z0 + options.slab_cells), slabs[s]);
+            }
+        });
+        size_t wave_bytes = 0;
+        for (int s = 0; s < count; ++s) wave_bytes += slabs[s].working_bytes;
+        result.peak_working_bytes = std::max(result.peak_working_bytes, wave_bytes);
+        for (int s = 0; s < count; ++s) {
+            if (!merge_slab(slabs[s], previous_top, out, result.seam_vertices)) return false;
+        }
+    }
+    if (options.normals) out.compute_normals();
+    if (stats) *stats = result;
+    return true;
+}
+
+FieldRow IsosurfaceExtractor::displaced_sphere(float radius, float amplitude, float noise_scale, unsigned int seed,
+                                               const FractalParams& fractal) {
+    auto noise = std::make_shared<const SimplexNoise>(seed);
+    return [=](float x0, float y, float z, float step, int count, float* out) {
+        // fractal_row_3d scales x and y per sample and takes z as is
+        noise->fractal_row_3d(x0 / step, y / step, z * noise_scale, count, step * noise_scale, fractal, out);
+        for (int i = 0; i < count; ++i) {
+            const float x = x0 + i * step;
+            out[i] = std::sqrt(x * x + y * y + z * z) - radius + amplitude * out[i];
+        }
+    };
+}
+
+FieldRow IsosurfaceExtractor::noise_volume(float noise_scale, unsigned int seed, const FractalParams& fractal) {
+    auto noise = std::make_shared<const SimplexNoise>(seed);
+    return [=](float x0, float y, float z, float step, int count, float* out) {
+        noise->fractal_row_3d(x0 / step, y / step, z * noise_scale, count, step * noise_scale, fractal, out);
+    };
+}
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,183 @@
+// generators/mesh.cpp
+#include "generators/mesh.h"
+#include "generators/simplex_noise.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace cpp_engine::generators {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr size_t MAX_VERTICES = std::numeric_limits<uint32_t>::max();
+
+// Outward normal at ring i, column j of a displaced sphere from its grid neighbours (wrapping in
+// longitude, clamped at the poles); the radial direction where the tangents degenerate
+void grid_normal(const float* positions, int rings, int columns, int i, int j, const float dir[3], float out[3]) {
+    auto at = [&](int r, int c) { return positions + (static_cast<size_t>(r) * columns + c) * 3; };
+    const float* east = at(i, (j + 1) % columns);
+    const float* west = at(i, (j + columns - 1) % columns);
+    const float* south = at(std::min(i + 1, rings - 1), j);
+    const float* north = at(std::max(i - 1, 0), j);
+    const float tu[3] = {east[0] - west[0], east[1] - west[1], east[2] - west[2]};
+    const float tv[3] = {south[0] - north[0], south[1] - north[1], south[2] - north[2]};
+    float n[3] = {tu[1] * tv[2] - tu[2] * tv[1], tu[2] * tv[0] - tu[0] * tv[2], tu[0] * tv[1] - tu[1] * tv[0]};
+    const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length < 1e-12f) {
+        out[0] = dir[0]; out[1] = dir[1]; out[2] = dir[2];
+        return;
+    }
+    const float sign = (n[0] * dir[0] + n[1] * dir[1] + n[2] * dir[2]) < 0.0f ? -1.0f : 1.0f;
+    for (int k = 0; k < 3; ++k) out[k] = sign * n[k] / length;
+}
+
+} // namespace
+
+bool Mesh::bounds(float min_out[3], float max_out[3]) const {
+    const size_t count = vertex_count();
+    if (count == 0) return false;
+    float lo[3] = {positions[0], positions[1], positions[2]};
+    float hi[3] = {lo[0], lo[1], lo[2]};
+    for (size_t v = 1; v < count; ++v) {
+        const float* p = positions.data() + v * 3;
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], p[k]);
+            hi[k] = std::max(hi[k], p[k]);
+        }
+    }
+    for (int k = 0; k < 3; ++k) {
+        min_out[k] = lo[k];
+        max_out[k] = hi[k];
+    }
+    return true;
+}
+
+bool Mesh::valid() const {
+    if (positions.size() % 3 != 0 || indices.size() % 3 != 0) return false;
+    if (!normals.empty() && normals.size() != positions.size()) return false;
+    const size_t count = vertex_count();
+    return std::all_of(indices.begin(), indices.end(), [count](uint32_t index) { return index < count; });
+}
+
+void Mesh::compute_normals() {
+    const size_t count = vertex_count();
+    normals.assign(count * 3, 0.0f);
+    // The unnormalized cross product is twice the triangle area, which weights each face
+    for (size_t t = 0; t < triangle_count(); ++t) {
+        const uint32_t* f = indices.data() + t * 3;
+        const float* a = positions.data() + static_cast<size_t>(f[0]) * 3;
+        const float* b = positions.data() + static_cast<size_t>(f[1]) * 3;
+        const float* c = positions.data() + static_cast<size_t>(f[2]) * 3;
+        const float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        const float n[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+        for (int k = 0; k < 3; ++k) {
+            float* target = normals.data() + static_cast<size_t>(f[k]) * 3;
+            target[0] += n[0];
+            target[1] += n[1];
+            target[2] += n[2];
+        }
+    }
+    cv::parallel_for_(cv::Range(0, static_cast<int>((count + 4095) / 4096)), [&](const cv::Range& range) {
+        const size_t end = std::min(count, static_cast<size_t>(range.end) * 4096);
+        for (size_t v = static_cast<size_t>(range.start) * 4096; v < end; ++v) {
+            float* n = normals.data() + v * 3;
+            const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length > 0.0f) {
+                n[0] /= length;
+                n[1] /= length;
+                n[2] /= length;
+            }
+        }
+    });
+}
+
+bool MeshTessellator::sphere(const SphereOptions& options, Mesh& out) {
+    const int rings = options.latitude + 1;
+    const int columns = options.longitude;
+    if (options.latitude < 1 || columns < 3 || !(options.radius > 0.0f) || !std::isfinite(options.radius) ||
+        !std::isfinite(options.displacement)) {
+        utils::Logger::instance().error("MeshTessellator: invalid sphere " + std::to_string(options.latitude) + "x" +
+                                        std::to_string(columns) + " radius " + std::to_string(options.radius));
+        return false;
+    }
+    const size_t vertices = static_cast<size_t>(rings) * columns;
+    if (vertices > MAX_VERTICES / 6) {
+        utils::Logger::instance().error("MeshTessellator: sphere of " + std::to_string(vertices) +
+                                        " vertices exceeds 32-bit indices");
+        return false;
+    }
+
+    out.positions.resize(vertices * 3);
+    out.normals.resize(options.normals ? vertices * 3 : 0);
+    out.indices.resize(static_cast<size_t>(options.latitude) * columns * 6);
+
+    const bool displaced = options.displacement != 0.0f;
+    const SimplexNoise noise(options.seed);
+    float* positions = out.positions.data();
+    float* normals = out.normals.data();
+    uint32_t* indices = out.indices.data();
+
+    cv::parallel_for_(cv::Range(0, rings), [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; ++i) {
+            // Float angles and products in the original exporter's order, so its OBJ output is unchanged
+            const float theta = static_cast<float>(static_cast<float>(i) / options.latitude * PI);
+            const float sin_theta = std::sin(theta);
+            const float cos_theta = std::cos(theta);
+            for (int j = 0; j < columns; ++j) {
+                const float phi = static_cast<float>(static_cast<float>(j) / columns * 2.0f * PI);
+                const float cos_phi = std::cos(phi);
+                const float sin_phi = std::sin(phi);
+                const float dir[3] = {sin_theta * cos_phi, cos_theta, sin_theta * sin_phi};
+                float radius = options.radius;
+                if (displaced) {
+                    const float s = options.noise_scale;
+                    radius *= 1.0f + options.displacement *
+                                         noise.fractal3(dir[0] * s, dir[1] * s, dir[2] * s, options.fractal);
+                }
+                float* p = positions + (static_cast<size_t>(i) * columns + j) * 3;
+                p[0] = radius * sin_theta * cos_phi;
+                p[1] = radius * cos_theta;
+                p[2] = radius * sin_theta * sin_phi;
+                if (options.normals) {
+                    float* n = normals + (static_cast<size_t>(i) * columns + j) * 3;
+                    n[0] = dir[0]; n[1] = dir[1]; n[2] = dir[2];
+                }
+            }
+            if (i == options.latitude) continue;
+            uint32_t* face = indices + static_cast<size_t>(i) * columns * 6;
+            const uint32_t row = static_cast<uint32_t>(i) * columns;
+            for (int j = 0; j < columns; ++j, face += 6) {
+                const uint32_t a = row + j;
+                const uint32_t b = row + (j + 1) % columns;
+                const uint32_t c = b + columns;
+                const uint32_t d = a + columns;
+                face[0] = a; face[1] = b; face[2] = c;
+                face[3] = a; face[4] = c; face[5] = d;
+            }
+        }
+    });
+
+    // Displaced normals need the neighbouring rings, so they replace the radial directions stored
+    // above once every position is in place
+    if (options.normals && displaced) {
+        cv::parallel_for_(cv::Range(0, rings), [&](const cv::Range& range) {
+            for (int i = range.start; i < range.end; ++i) {
+                for (int j = 0; j < columns; ++j) {
+                    float* n = normals + (static_cast<size_t>(i) * columns + j) * 3;
+                    const float dir[3] = {n[0], n[1], n[2]};
+                    grid_normal(positions, rings, columns, i, j, dir, n);
+                }
+            }
+        });
+    }
+    return true;
+}
+
+} // namespace cpp_engine::generators
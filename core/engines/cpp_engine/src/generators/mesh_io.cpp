@@ -0,0 +1,595 @@
+// generators/mesh_io.cpp
+#include "generators/mesh_io.h"
+#include "utils/logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+namespace cpp_engine::generators {
+
+namespace {
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67;       // "glTF"
+constexpr uint32_t GLB_VERSION = 2;
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;  // "JSON"
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;   // "BIN\0"
+constexpr int GL_UNSIGNED_BYTE = 5121;
+constexpr int GL_UNSIGNED_SHORT = 5123;
+constexpr int GL_UNSIGNED_INT = 5125;
+constexpr int GL_FLOAT = 5126;
+constexpr int GL_ARRAY_BUFFER = 34962;
+constexpr int GL_ELEMENT_ARRAY_BUFFER = 34963;
+constexpr int GL_TRIANGLES = 4;
+constexpr size_t PLY_FACE_RECORD = 1 + 3 * sizeof(uint32_t);
+// Longest "%g" float at 6 digits ("-1.23457e-38") and uint32 in decimal
+constexpr size_t OBJ_FLOAT_CHARS = 12;
+constexpr size_t OBJ_INDEX_CHARS = 10;
+
+void put_u32(unsigned char* at, uint32_t value) { std::memcpy(at, &value, sizeof(value)); }
+
+uint32_t get_u32(const unsigned char* at) {
+    uint32_t value;
+    std::memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+size_t align4(size_t size) { return (size + 3) & ~static_cast<size_t>(3); }
+
+bool fail(const std::string& message) {
+    utils::Logger::instance().error("MeshIO: " + message);
+    return false;
+}
+
+// ---- OBJ ----
+
+char* put_float(char* at, char* end, float value) {
+    return std::to_chars(at, end, value, std::chars_format::general, 6).ptr;
+}
+
+char* put_index(char* at, char* end, uint32_t value) { return std::to_chars(at, end, value).ptr; }
+
+void encode_obj(const Mesh& mesh, std::vector<unsigned char>& bytes) {
+    const size_t vertices = mesh.vertex_count();
+    const bool normals = mesh.has_normals();
+    const size_t vertex_line = 2 + 3 * (OBJ_FLOAT_CHARS + 1);
+    const size_t face_line = 2 + 3 * ((normals ? 2 * OBJ_INDEX_CHARS + 2 : OBJ_INDEX_CHARS) + 1);
+    bytes.resize(vertices * vertex_line * (normals ? 2 : 1) + mesh.triangle_count() * face_line);
+
+    char* at = reinterpret_cast<char*>(bytes.data());
+    char* const end = at + bytes.size();
+    auto put_vec3 = [&](const char* tag, const float* v) {
+        for (; *tag; ++tag) *at++ = *tag;
+        for (int k = 0; k < 3; ++k) {
+            *at++ = ' ';
+            at = put_float(at, end, v[k]);
+        }
+        *at++ = '\n';
+    };
+    for (size_t v = 0; v < vertices; ++v) put_vec3("v", mesh.positions.data() + v * 3);
+    if (normals) {
+        for (size_t v = 0; v < vertices; ++v) put_vec3("vn", mesh.normals.data() + v * 3);
+    }
+    for (size_t t = 0; t < mesh.triangle_count(); ++t) {
+        *at++ = 'f';
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t index = mesh.indices[t * 3 + k] + 1;
+            *at++ = ' ';
+            at = put_index(at, end, index);
+            if (normals) {
+                *at++ = '/';
+                *at++ = '/';
+                at = put_index(at, end, index);
+            }
+        }
+        *at++ = '\n';
+    }
+    bytes.resize(static_cast<size_t>(at - reinterpret_cast<char*>(bytes.data())));
+}
+
+const char* skip_blanks(const char* at, const char* end) {
+    while (at < end && (*at == ' ' || *at == '\t')) ++at;
+    return at;
+}
+
+bool decode_obj(const unsigned char* data, size_t size, Mesh& out) {
+    const char* at = reinterpret_cast<const char*>(data);
+    const char* const end = at + size;
+    std::vector<float> normals;
+    std::vector<long> polygon;
+    out.positions.clear();
+    out.indices.clear();
+    size_t line_number = 0;
+    while (at < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(at, '\n', static_cast<size_t>(end - at)));
+        if (!line_end) line_end = end;
+        ++line_number;
+        const char* p = skip_blanks(at, line_end);
+        const bool vertex = line_end - p > 1 && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t');
+        const bool normal = line_end - p > 2 && p[0] == 'v' && p[1] == 'n' && (p[2] == ' ' || p[2] == '\t');
+        if (vertex || normal) {
+            std::vector<float>& target = vertex ? out.positions : normals;
+            p += vertex ? 1 : 2;
+            for (int k = 0; k < 3; ++k) {
+                float value = 0.0f;
+                p = skip_blanks(p, line_end);
+                const auto parsed = std::from_chars(p, line_end, value);
+                if (parsed.ec != std::errc()) return fail("OBJ line " + std::to_string(line_number) + ": bad vector");
+                target.push_back(value);
+                p = parsed.ptr;
+            }
+        } else if (line_end - p > 1 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            polygon.clear();
+            p = skip_blanks(p + 1, line_end);
+            while (p < line_end && *p != '\r') {
+                long index = 0;
+                const auto parsed = std::from_chars(p, line_end, index);
+                if (parsed.ec != std::errc()) return fail("OBJ line " + std::to_string(line_number) + ": bad face");
+                const long count = static_cast<long>(out.positions.size() / 3);
+                index = index < 0 ? count + index : index - 1;  // negative indices count back from the last vertex
+                if (index < 0 || index >= count) {
+                    return fail("OBJ line " + std::to_string(line_number) + ": index out of range");
+                }
+                polygon.push_back(index);
+                p = parsed.ptr;
+                while (p < line_end && *p != ' ' && *p != '\t') ++p;  // texture/normal references
+                p = skip_blanks(p, line_end);
+            }
+            if (polygon.size() < 3) return fail("OBJ line " + std::to_string(line_number) + ": face under 3 vertices");
+            for (size_t k = 1; k + 1 < polygon.size(); ++k) {
+                out.indices.push_back(static_cast<uint32_t>(polygon[0]));
+                out.indices.push_back(static_cast<uint32_t>(polygon[k]));
+                out.indices.push_back(static_cast<uint32_t>(polygon[k + 1]));
+            }
+        }
+        at = line_end + 1;
+    }
+    // Normals survive only when they pair one to one with the vertices, as the writer emits them
+    out.normals = normals.size() == out.positions.size() ? std::move(normals) : std::vector<float>();
+    return true;
+}
+
+// ---- PLY ----
+
+void encode_ply(const Mesh& mesh, std::vector<unsigned char>& bytes) {
+    const size_t vertices = mesh.vertex_count();
+    const size_t triangles = mesh.triangle_count();
+    const bool normals = mesh.has_normals();
+    std::string header = "ply\nformat binary_little_endian 1.0\ncomment cpp_engine\nelement vertex " +
+                         std::to_string(vertices) + "\nproperty float x\nproperty float y\nproperty float z\n";
+    if (normals) header += "property float nx\nproperty float ny\nproperty float nz\n";
+    header += "element face " + std::to_string(triangles) + "\nproperty list uchar uint vertex_indices\nend_header\n";
+
+    const size_t record = (normals ? 6 : 3) * sizeof(float);
+    bytes.resize(header.size() + vertices * record + triangles * PLY_FACE_RECORD);
+    unsigned char* at = bytes.data();
+    std::memcpy(at, header.data(), header.size());
+    at += header.size();
+    if (normals) {
+        for (size_t v = 0; v < vertices; ++v, at += record) {
+            std::memcpy(at, mesh.positions.data() + v * 3, 3 * sizeof(float));
+            std::memcpy(at + 3 * sizeof(float), mesh.normals.data() + v * 3, 3 * sizeof(float));
+        }
+    } else {
+        std::memcpy(at, mesh.positions.data(), vertices * record);
+        at += vertices * record;
+    }
+    for (size_t t = 0; t < triangles; ++t, at += PLY_FACE_RECORD) {
+        at[0] = 3;
+        std::memcpy(at + 1, mesh.indices.data() + t * 3, 3 * sizeof(uint32_t));
+    }
+}
+
+bool decode_ply(const unsigned char* data, size_t size, Mesh& out) {
+    const std::string_view text(reinterpret_cast<const char*>(data), size);
+    const size_t header_end = text.find("end_header\n");
+    if (text.compare(0, 4, "ply\n") != 0 || header_end == std::string_view::npos) return fail("not a PLY file");
+
+    std::istringstream header(std::string(text.substr(0, header_end)));
+    std::string line, element;
+    size_t vertices = 0, faces = 0;
+    std::vector<std::string> vertex_properties;
+    bool binary = false, face_list = false;
+    while (std::getline(header, line)) {
+        std::istringstream words(line);
+        std::string word;
+        words >> word;
+        if (word == "format") {
+            std::string kind;
+            words >> kind;
+            binary = kind == "binary_little_endian";
+        } else if (word == "element") {
+            size_t count = 0;
+            words >> element >> count;
+            if (element == "vertex") vertices = count;
+            else if (element == "face") faces = count;
+            else if (count > 0) return fail("PLY element '" + element + "' is not supported");
+        } else if (word == "property") {
+            std::string type, name;
+            words >> type;
+            if (element == "vertex") {
+                words >> name;
+                if (type != "float" && type != "float32") return fail("PLY vertex property '" + name + "' is not float");
+                vertex_properties.push_back(name);
+            } else if (element == "face") {
+                std::string count_type, index_type;
+                words >> count_type >> index_type;
+                face_list = type == "list" && (count_type == "uchar" || count_type == "uint8") &&
+                            (index_type == "uint" || index_type == "int" || index_type == "uint32" ||
+                             index_type == "int32");
+                if (!face_list) return fail("PLY face property is not a uchar-counted 32-bit index list");
+            }
+        }
+    }
+    if (!binary) return fail("only binary_little_endian PLY is supported");
+
+    auto column = [&](const char* name) {
+        const auto it = std::find(vertex_properties.begin(), vertex_properties.end(), name);
+        return it == vertex_properties.end() ? -1 : static_cast<int>(it - vertex_properties.begin());
+    };
+    const int xyz[3] = {column("x"), column("y"), column("z")};
+    const int nxyz[3] = {column("nx"), column("ny"), column("nz")};
+    if (xyz[0] < 0 || xyz[1] < 0 || xyz[2] < 0) return fail("PLY vertices lack x, y or z");
+    const bool normals = nxyz[0] >= 0 && nxyz[1] >= 0 && nxyz[2] >= 0;
+    if (faces > 0 && !face_list) return fail("PLY faces lack vertex indices");
+
+    const size_t stride = vertex_properties.size() * sizeof(float);
+    const unsigned char* at = data + header_end + std::strlen("end_header\n");
+    const unsigned char* const end = data + size;
+    if (vertices > static_cast<size_t>(end - at) / std::max<size_t>(stride, 1)) return fail("PLY vertex data truncated");
+
+    out.positions.resize(vertices * 3);
+    out.normals.resize(normals ? vertices * 3 : 0);
+    if (stride == 3 * sizeof(float) && xyz[0] == 0 && xyz[1] == 1 && xyz[2] == 2) {
+        std::memcpy(out.positions.data(), at, vertices * stride);
+    } else {
+        for (size_t v = 0; v < vertices; ++v) {
+            const unsigned char* record = at + v * stride;
+            for (int k = 0; k < 3; ++k) {
+                std::memcpy(&out.positions[v * 3 + k], record + xyz[k] * sizeof(float), sizeof(float));
+                if (normals) std::memcpy(&out.normals[v * 3 + k], record + nxyz[k] * sizeof(float), sizeof(float));
+            }
+        }
+    }
+    at += vertices * stride;
+
+    // Sized for triangles and filled in place; larger polygons grow it as their fans need
+    out.indices.resize(faces * 3);
+    size_t filled = 0;
+    uint32_t polygon[255];
+    for (size_t f = 0; f < faces; ++f) {
+        if (at >= end) return fail("PLY face data truncated");
+        const int count = *at++;
+        if (count < 3 || static_cast<size_t>(end - at) < count * sizeof(uint32_t)) return fail("PLY face data truncated");
+        if (count == 3) {
+            std::memcpy(out.indices.data() + filled, at, 3 * sizeof(uint32_t));
+            filled += 3;
+        } else {
+            std::memcpy(polygon, at, count * sizeof(uint32_t));
+            out.indices.resize(out.indices.size() + (count - 3) * 3);
+            for (int k = 1; k + 1 < count; ++k, filled += 3) {
+                out.indices[filled] = polygon[0];
+                out.indices[filled + 1] = polygon[k];
+                out.indices[filled + 2] = polygon[k + 1];
+            }
+        }
+        at += count * sizeof(uint32_t);
+    }
+    return out.valid() || fail("PLY face index out of range");
+}
+
+// ---- GLB ----
+
+std::string json_vec3(const float v[3]) {
+    char text[64];
+    std::snprintf(text, sizeof(text), "[%.9g,%.9g,%.9g]", v[0], v[1], v[2]);
+    return text;
+}
+
+void encode_glb(const Mesh& mesh, std::vector<unsigned char>& bytes) {
+    const size_t vertices = mesh.vertex_count();
+    const bool normals = mesh.has_normals();
+    const size_t position_bytes = vertices * 3 * sizeof(float);
+    const size_t normal_bytes = normals ? position_bytes : 0;
+    const size_t index_bytes = mesh.indices.size() * sizeof(uint32_t);
+    const size_t bin_bytes = position_bytes + normal_bytes + index_bytes;  // every view is a multiple of 4
+    float lo[3], hi[3];
+    mesh.bounds(lo, hi);
+
+    auto view = [](size_t offset, size_t length, int target) {
+        return "{\"buffer\":0,\"byteOffset\":" + std::to_string(offset) + ",\"byteLength\":" + std::to_string(length) +
+               ",\"target\":" + std::to_string(target) + "}";
+    };
+    const std::string count = std::to_string(vertices);
+    const int index_accessor = normals ? 2 : 1;
+    std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"cpp_engine\"},\"scene\":0,"
+                       "\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],"
+                       "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0";
+    if (normals) json += ",\"NORMAL\":1";
+    json += "},\"indices\":" + std::to_string(index_accessor) + ",\"mode\":" + std::to_string(GL_TRIANGLES) + "}]}],";
+    json += "\"accessors\":[{\"bufferView\":0,\"componentType\":" + std::to_string(GL_FLOAT) + ",\"count\":" + count +
+            ",\"type\":\"VEC3\",\"min\":" + json_vec3(lo) + ",\"max\":" + json_vec3(hi) + "}";
+    if (normals) {
+        json += ",{\"bufferView\":1,\"componentType\":" + std::to_string(GL_FLOAT) + ",\"count\":" + count +
+                ",\"type\":\"VEC3\"}";
+    }
+    json += ",{\"bufferView\":" + std::to_string(index_accessor) + ",\"componentType\":" +
+            std::to_string(GL_UNSIGNED_INT) + ",\"count\":" + std::to_string(mesh.indices.size()) +
+            ",\"type\":\"SCALAR\"}],";
+    json += "\"bufferViews\":[" + view(0, position_bytes, GL_ARRAY_BUFFER);
+    if (normals) json += "," + view(position_bytes, normal_bytes, GL_ARRAY_BUFFER);
+    json += "," + view(position_bytes + normal_bytes, index_bytes, GL_ELEMENT_ARRAY_BUFFER) + "],";
+    json += "\"buffers\":[{\"byteLength\":" + std::to_string(bin_bytes) + "}]}";
+    json.resize(align4(json.size()), ' ');  // the JSON chunk is padded with spaces
+
+    bytes.resize(12 + 8 + json.size() + 8 + bin_bytes);
+    unsigned char* at = bytes.data();
+    put_u32(at, GLB_MAGIC);
+    put_u32(at + 4, GLB_VERSION);
+    put_u32(at + 8, static_cast<uint32_t>(bytes.size()));
+    put_u32(at + 12, static_cast<uint32_t>(json.size()));
+    put_u32(at + 16, GLB_CHUNK_JSON);
+    std::memcpy(at + 20, json.data(), json.size());
+    at += 20 + json.size();
+    put_u32(at, static_cast<uint32_t>(bin_bytes));
+    put_u32(at + 4, GLB_CHUNK_BIN);
+    at += 8;
+    std::memcpy(at, mesh.positions.data(), position_bytes);
+    if (normals) std::memcpy(at + position_bytes, mesh.normals.data(), normal_bytes);
+    std::memcpy(at + position_bytes + normal_bytes, mesh.indices.data(), index_bytes);
+}
+
+// Just enough JSON for the accessor tables of a glTF: the bracketed array after "key", its
+// top-level objects, and integer fields of an object
+std::string_view json_enclosed(std::string_view json, size_t open) {
+    const char open_char = json[open];
+    const char close_char = open_char == '[' ? ']' : '}';
+    int depth = 0;
+    bool in_string = false;
+    for (size_t i = open; i < json.size(); ++i) {
+        const char c = json[i];
+        if (in_string) {
+            if (c == '\\') ++i;
+            else if (c == '"') in_string = false;
+        } else if (c == '"') {
+            in_string = true;
+        } else if (c == open_char) {
+            ++depth;
+        } else if (c == close_char && --depth == 0) {
+            return json.substr(open, i - open + 1);
+        }
+    }
+    return {};
+}
+
+size_t json_value(std::string_view json, const std::string& key) {
+    const size_t at = json.find("\"" + key + "\"");
+    if (at == std::string_view::npos) return std::string_view::npos;
+    const size_t colon = json.find(':', at + key.size() + 2);
+    if (colon == std::string_view::npos) return std::string_view::npos;
+    return json.find_first_not_of(" \t\r\n", colon + 1);
+}
+
+std::vector<std::string_view> json_objects(std::string_view json, const std::string& key) {
+    std::vector<std::string_view> objects;
+    const size_t open = json_value(json, key);
+    if (open == std::string_view::npos || json[open] != '[') return objects;
+    const std::string_view array = json_enclosed(json, open);
+    for (size_t i = 1; i < array.size(); ++i) {
+        if (array[i] != '{') continue;
+        objects.push_back(json_enclosed(array, i));
+        i += objects.back().size() - 1;
+    }
+    return objects;
+}
+
+long long json_int(std::string_view object, const std::string& key, long long fallback) {
+    const size_t at = json_value(object, key);
+    long long value = fallback;
+    if (at != std::string_view::npos) std::from_chars(object.data() + at, object.data() + object.size(), value);
+    return value;
+}
+
+struct GlbAccessor {
+    const unsigned char* data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    size_t element = 0;  // bytes of one element: component size times components
+    int component = 0;
+};
+
+size_t component_bytes(long long component) {
+    switch (component) {
+        case GL_UNSIGNED_BYTE: return 1;
+        case GL_UNSIGNED_SHORT: return 2;
+        case GL_UNSIGNED_INT:
+        case GL_FLOAT: return 4;
+        default: return 0;
+    }
+}
+
+bool glb_accessor(const std::vector<std::string_view>& accessors, const std::vector<std::string_view>& views,
+                  long long index, const unsigned char* bin, size_t bin_size, GlbAccessor& out) {
+    if (index < 0 || static_cast<size_t>(index) >= accessors.size()) return fail("GLB accessor out of range");
+    const std::string_view accessor = accessors[static_cast<size_t>(index)];
+    if (accessor.find("\"sparse\"") != std::string_view::npos) return fail("sparse GLB accessors are not supported");
+    const long long view_index = json_int(accessor, "bufferView", -1);
+    if (view_index < 0 || static_cast<size_t>(view_index) >= views.size()) return fail("GLB buffer view out of range");
+    const std::string_view view = views[static_cast<size_t>(view_index)];
+    if (json_int(view, "buffer", 0) != 0) return fail("GLB data outside the BIN chunk");
+
+    out.component = static_cast<int>(json_int(accessor, "componentType", 0));
+    const bool vec3 = accessor.find("\"VEC3\"") != std::string_view::npos;
+    out.element = component_bytes(out.component) * (vec3 ? 3 : 1);
+    if (out.element == 0) return fail("GLB component type " + std::to_string(out.component));
+    out.count = static_cast<size_t>(std::max(0LL, json_int(accessor, "count", 0)));
+    out.stride = static_cast<size_t>(std::max(0LL, json_int(view, "byteStride", 0)));
+    if (out.stride == 0) out.stride = out.element;
+
+    const long long view_offset = json_int(view, "byteOffset", 0);
+    const long long view_length = json_int(view, "byteLength", 0);
+    const long long offset = json_int(accessor, "byteOffset", 0);
+    const size_t needed = out.count == 0 ? 0 : (out.count - 1) * out.stride + out.element;
+    if (view_offset < 0 || view_length < 0 || offset < 0 || offset > view_length ||
+        static_cast<size_t>(view_offset + view_length) > bin_size || needed > static_cast<size_t>(view_length - offset)) {
+        return fail("GLB accessor exceeds its buffer");
+    }
+    out.data = bin + view_offset + offset;
+    return true;
+}
+
+void copy_vec3(const GlbAccessor& accessor, std::vector<float>& out) {
+    out.resize(accessor.count * 3);
+    if (accessor.stride == 3 * sizeof(float)) {
+        std::memcpy(out.data(), accessor.data, out.size() * sizeof(float));
+        return;
+    }
+    for (size_t v = 0; v < accessor.count; ++v) {
+        std::memcpy(out.data() + v * 3, accessor.data + v * accessor.stride, 3 * sizeof(float));
+    }
+}
+
+bool decode_glb(const unsigned char* data, size_t size, Mesh& out) {
+    if (size < 20 || get_u32(data) != GLB_MAGIC) return fail("not a GLB file");
+    if (get_u32(data + 4) != GLB_VERSION) return fail("GLB version " + std::to_string(get_u32(data + 4)));
+    const size_t total = std::min<size_t>(get_u32(data + 8), size);
+    const size_t json_size = get_u32(data + 12);
+    if (get_u32(data + 16) != GLB_CHUNK_JSON || 20 + json_size > total) return fail("GLB JSON chunk missing");
+    const std::string_view json(reinterpret_cast<const char*>(data + 20), json_size);
+    const size_t bin_at = 20 + align4(json_size);
+    const unsigned char* bin = nullptr;
+    size_t bin_size = 0;
+    if (bin_at + 8 <= total && get_u32(data + bin_at + 4) == GLB_CHUNK_BIN) {
+        bin = data + bin_at + 8;
+        bin_size = std::min<size_t>(get_u32(data + bin_at), total - bin_at - 8);
+    }
+
+    const std::vector<std::string_view> meshes = json_objects(json, "meshes");
+    const std::vector<std::string_view> primitives =
+        meshes.empty() ? std::vector<std::string_view>() : json_objects(meshes[0], "primitives");
+    if (primitives.empty()) return fail("GLB has no mesh primitive");
+    const std::string_view primitive = primitives[0];
+    if (json_int(primitive, "mode", GL_TRIANGLES) != GL_TRIANGLES) return fail("GLB primitive is not a triangle list");
+    const std::vector<std::string_view> accessors = json_objects(json, "accessors");
+    const std::vector<std::string_view> views = json_objects(json, "bufferViews");
+
+    GlbAccessor position;
+    if (!glb_accessor(accessors, views, json_int(primitive, "POSITION", -1), bin, bin_size, position)) return false;
+    if (position.component != GL_FLOAT || position.element != 12) return fail("GLB positions are not float VEC3");
+    copy_vec3(position, out.positions);
+
+    out.normals.clear();
+    const long long normal_index = json_int(primitive, "NORMAL", -1);
+    if (normal_index >= 0) {
+        GlbAccessor normal;
+        if (!glb_accessor(accessors, views, normal_index, bin, bin_size, normal)) return false;
+        if (normal.element != 12 || normal.count != position.count) return fail("GLB normals do not match");
+        copy_vec3(normal, out.normals);
+    }
+
+    const long long index_index = json_int(primitive, "indices", -1);
+    if (index_index < 0) {
+        out.indices.resize(position.count - position.count % 3);
+        for (size_t i = 0; i < out.indices.size(); ++i) out.indices[i] = static_cast<uint32_t>(i);
+        return true;
+    }
+    GlbAccessor index;
+    if (!glb_accessor(accessors, views, index_index, bin, bin_size, index)) return false;
+    if (index.component == GL_FLOAT || index.element > 4) return fail("GLB indices are not unsigned scalars");
+    out.indices.resize(index.count - index.count % 3);
+    if (index.element == 4 && index.stride == 4) {
+        std::memcpy(out.indices.data(), index.data, out.indices.size() * sizeof(uint32_t));
+    } else {
+        for (size_t i = 0; i < out.indices.size(); ++i) {
+            const unsigned char* at = index.data + i * index.stride;
+            if (index.element == 1) out.indices[i] = at[0];
+            else if (index.element == 2) out.indices[i] = static_cast<uint32_t>(at[0] | (at[1] << 8));
+            else out.indices[i] = get_u32(at);
+        }
+    }
+    return out.valid() || fail("GLB index out of range");
+}
+
+} // namespace
+
+bool MeshIO::format_for(const std::string& path, MeshFormat& format) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".obj") format = MeshFormat::OBJ;
+    else if (extension == ".ply") format = MeshFormat::PLY;
+    else if (extension == ".glb") format = MeshFormat::GLB;
+    else return false;
+    return true;
+}
+
+const char* MeshIO::format_name(MeshFormat format) {
+    switch (format) {
+        case MeshFormat::OBJ: return "obj";
+        case MeshFormat::PLY: return "ply";
+        case MeshFormat::GLB: return "glb";
+    }
+    return "unknown";
+}
+
+bool MeshIO::encode(const Mesh& mesh, MeshFormat format, std::vector<unsigned char>& bytes) {
+    if (!mesh.valid()) return fail("inconsistent mesh");
+    if (format == MeshFormat::GLB && (mesh.vertex_count() == 0 || mesh.triangle_count() == 0)) {
+        return fail("GLB needs at least one triangle");
+    }
+    if (format == MeshFormat::GLB && mesh.positions.size() * sizeof(float) * 2 + mesh.indices.size() * 4 > 0xFFFFFF00u) {
+        return fail("mesh exceeds the 4 GiB GLB limit");
+    }
+    switch (format) {
+        case MeshFormat::OBJ: encode_obj(mesh, bytes); return true;
+        case MeshFormat::PLY: encode_ply(mesh, bytes); return true;
+        case MeshFormat::GLB: encode_glb(mesh, bytes); return true;
+    }
+    return false;
+}
+
+bool MeshIO::decode(const unsigned char* data, size_t size, MeshFormat format, Mesh& out) {
+    switch (format) {
+        case MeshFormat::OBJ: return decode_obj(data, size, out);
+        case MeshFormat::PLY: return decode_ply(data, size, out);
+        case MeshFormat::GLB: return decode_glb(data, size, out);
+    }
+    return false;
+}
+
+bool MeshIO::write(const std::string& path, const Mesh& mesh) {
+    MeshFormat format;
+    if (!format_for(path, format)) return fail("unknown mesh format for " + path);
+    std::vector<unsigned char> bytes;
+    if (!encode(mesh, format, bytes)) return false;
+
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    std::error_code ec;
+    if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        return fail("cannot write " + path);
+    }
+    return true;
+}
+
+bool MeshIO::read(const std::string& path, Mesh& out) {
+    MeshFormat format;
+    if (!format_for(path, format)) return fail("unknown mesh format for " + path);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return fail("cannot open " + path);
+    std::vector<unsigned char> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        return fail("cannot read " + path);
+    }
+    return decode(bytes.data(), bytes.size(), format, out);
+}
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,543 @@
+// generators/mesh_simplifier.cpp
+#include "generators/mesh_simplifier.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cpp_engine::generators {
+
+namespace {
+
+constexpr double BOUNDARY_WEIGHT = 100.0;
+constexpr double SINGULAR_DETERMINANT = 1e-12;
+constexpr int PARALLEL_CHUNK = 1 << 16;  // vertices, triangles or edges per parallel chunk
+constexpr uint32_t DEAD = std::numeric_limits<uint32_t>::max();
+
+// Symmetric 4x4 quadric of the squared distance to a set of planes
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+
+    static Quadric plane(double a, double b, double c, double d, double weight) {
+        Quadric q;
+        q.a2 = weight * a * a; q.ab = weight * a * b; q.ac = weight * a * c; q.ad = weight * a * d;
+        q.b2 = weight * b * b; q.bc = weight * b * c; q.bd = weight * b * d;
+        q.c2 = weight * c * c; q.cd = weight * c * d;
+        q.d2 = weight * d * d;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad; b2 += o.b2;
+        bc += o.bc; bd += o.bd; c2 += o.c2; cd += o.cd; d2 += o.d2;
+        return *this;
+    }
+
+    double error(double x, double y, double z) const {
+        return x * (a2 * x + 2 * ab * y + 2 * ac * z + 2 * ad) + y * (b2 * y + 2 * bc * z + 2 * bd) +
+               z * (c2 * z + 2 * cd) + d2;
+    }
+
+    // The point of least error, by Cramer's rule; false when the planes do not pin one down
+    bool minimum(double out[3]) const {
+        const double det = a2 * (b2 * c2 - bc * bc) - ab * (ab * c2 - bc * ac) + ac * (ab * bc - b2 * ac);
+        const double scale = std::max({a2, b2, c2, 1e-30});
+        if (std::abs(det) < SINGULAR_DETERMINANT * scale * scale * scale) return false;
+        out[0] = -(ad * (b2 * c2 - bc * bc) - ab * (bd * c2 - bc * cd) + ac * (bd * bc - b2 * cd)) / det;
+        out[1] = -(a2 * (bd * c2 - cd * bc) - ad * (ab * c2 - bc * ac) + ac * (ab * cd - bd * ac)) / det;
+        out[2] = -(a2 * (b2 * cd - bd * bc) - ab * (ab * cd - bd * ac) + ad * (ab * bc - b2 * ac)) / det;
+        return true;
+    }
+};
+
+// Unit normal and offset of a triangle's plane; false for a degenerate triangle
+bool face_plane(const float* a, const float* b, const float* c, double n[3], double& d) {
+    const double u[3] = {double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2]};
+    const double v[3] = {double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2]};
+    n[0] = u[1] * v[2] - u[2] * v[1];
+    n[1] = u[2] * v[0] - u[0] * v[2];
+    n[2] = u[0] * v[1] - u[1] * v[0];
+    const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length <= 0.0) return false;
+    n[0] /= length; n[1] /= length; n[2] /= length;
+    d = -(n[0] * a[0] + n[1] * a[1] + n[2] * a[2]);
+    return true;
+}
+
+struct Candidate {
+    double cost;
+    float position[3];
+};
+
+// A queued edge; the heap orders 64-bit keys of the cost (as float bits, which sort like the
+// non-negative floats) above the slot, so entries stay small and ties break deterministically
+struct Queued {
+    uint32_t v0, v1;
+    uint32_t version0, version1;
+};
+
+uint64_t queue_key(double cost, uint32_t slot) {
+    const float narrowed = static_cast<float>(cost);
+    uint32_t bits;
+    std::memcpy(&bits, &narrowed, sizeof(bits));
+    return static_cast<uint64_t>(bits) << 32 | slot;
+}
+
+// 4-ary min-heap of keys: half the levels of a binary heap, and the four children of a node
+// share a cache line, which matters once the queue holds tens of millions of entries
+class KeyHeap {
+public:
+    bool empty() const { return keys_.empty(); }
+    void clear() { keys_.clear(); }
+    void reserve(size_t n) { keys_.reserve(n); }
+
+    void assign(std::vector<uint64_t> keys) {
+        keys_ = std::move(keys);
+        for (size_t i = keys_.size() / ARITY + 1; i-- > 0;) sift_down(i);
+    }
+
+    void push(uint64_t key) {
+        size_t i = keys_.size();
+        keys_.push_back(key);
+        while (i > 0 && key < keys_[(i - 1) / ARITY]) {
+            keys_[i] = keys_[(i - 1) / ARITY];
+            i = (i - 1) / ARITY;
+        }
+        keys_[i] = key;
+    }
+
+    uint64_t pop() {
+        const uint64_t top = keys_[0];
+        keys_[0] = keys_.back();
+        keys_.pop_back();
+        if (!keys_.empty()) sift_down(0);
+        return top;
+    }
+
+private:
+    static constexpr size_t ARITY = 4;
+
+    void sift_down(size_t i) {
+        const size_t n = keys_.size();
+        if (i >= n) return;
+        const uint64_t key = keys_[i];
+        for (;;) {
+            const size_t first = i * ARITY + 1;
+            if (first >= n) break;
+            size_t best = first;
+            const size_t last = std::min(first + ARITY, n);
+            for (size_t c = first + 1; c < last; ++c) {
+                if (keys_[c] < keys_[best]) best = c;
+            }
+            if (keys_[best] >= key) break;
+            keys_[i] = keys_[best];
+            i = best;
+        }
+        keys_[i] = key;
+    }
+
+    std::vector<uint64_t> keys_;
+};
+
+class Decimator {
+public:
+    Decimator(std::vector<float> positions, std::vector<uint32_t> indices, bool preserve_boundary)
+        : positions_(std::move(positions)), indices_(std::move(indices)) {
+        const size_t vertices = positions_.size() / 3;
+        const size_t triangles = indices_.size() / 3;
+        quadrics_.resize(vertices);
+        version_.assign(vertices, 0);
+        boundary_.assign(vertices, 0);
+        triangles_of_.resize(vertices);
+        alive_triangles_ = triangles;
+
+        std::vector<uint32_t> degree(vertices, 0);
+        for (uint32_t index : indices_) ++degree[index];
+        for (size_t v = 0; v < vertices; ++v) triangles_of_[v].reserve(degree[v]);
+        for (size_t t = 0; t < triangles; ++t) {
+            const uint32_t* f = &indices_[t * 3];
+            if (f[0] == f[1] || f[1] == f[2] || f[0] == f[2]) {
+                kill_triangle(t);  // collapsed already; it would only block the link condition
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) triangles_of_[f[k]].push_back(static_cast<uint32_t>(t));
+            double n[3], d;
+            if (!face_plane(at(f[0]), at(f[1]), at(f[2]), n, d)) continue;
+            const Quadric q = Quadric::plane(n[0], n[1], n[2], d, 1.0);
+            for (int k = 0; k < 3; ++k) quadrics_[f[k]] += q;
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        edges.reserve(triangles * 3 / 2);
+        for (size_t t = 0; t < triangles; ++t) {
+            if (indices_[t * 3] == DEAD) continue;
+            const uint32_t* f = &indices_[t * 3];
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t a = f[k], b = f[(k + 1) % 3];
+                const bool boundary = !has_other_triangle(a, b, static_cast<uint32_t>(t));
+                if (boundary) boundary_[a] = boundary_[b] = 1;
+                if (boundary && preserve_boundary) add_boundary_plane(f, k);
+                // Interior edges are seen from both triangles; queue them once
+                if (boundary || a < b) edges.emplace_back(a, b);
+            }
+        }
+        // Costed once every quadric, boundary planes included, is complete; nothing is written
+        // meanwhile, so in parallel
+        std::vector<uint64_t> keys(edges.size());
+        cv::parallel_for_(cv::Range(0, static_cast<int>((edges.size() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK)),
+                          [&](const cv::Range& range) {
+            const size_t end = std::min(edges.size(), static_cast<size_t>(range.end) * PARALLEL_CHUNK);
+            for (size_t e = static_cast<size_t>(range.start) * PARALLEL_CHUNK; e < end; ++e) {
+                keys[e] = queue_key(candidate(edges[e].first, edges[e].second).cost, static_cast<uint32_t>(e));
+            }
+        });
+        queued_.reserve(edges.size());
+        for (const auto& [a, b] : edges) queued_.push_back({a, b, 0, 0});
+        heap_.assign(std::move(keys));
+    }
+
+    size_t alive_triangles() const { return alive_triangles_; }
+
+    // Pops until a valid collapse within max_cost is applied; false when none is left
+    bool collapse_next(double max_cost, double& cost) {
+        while (!heap_.empty()) {
+            const uint32_t slot = static_cast<uint32_t>(heap_.pop());
+            const Queued q = queued_[slot];
+            free_slots_.push_back(slot);
+            if (version_[q.v0] != q.version0 || version_[q.v1] != q.version1) continue;
+            // Unchanged endpoints give back the queued cost, now with the position
+            const Candidate c = candidate(q.v0, q.v1);
+            if (c.cost > max_cost) {
+                heap_.clear();
+                return false;
+            }
+            if (collapse(q.v0, q.v1, c)) {
+                cost = c.cost;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void extract(Mesh& out) const {
+        const size_t vertices = positions_.size() / 3;
+        std::vector<uint32_t> remap(vertices, DEAD);
+        out.positions.clear();
+        out.indices.clear();
+        out.indices.reserve(alive_triangles_ * 3);
+        for (size_t t = 0; t < indices_.size() / 3; ++t) {
+            if (indices_[t * 3] == DEAD) continue;
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = indices_[t * 3 + k];
+                if (remap[v] == DEAD) {
+                    remap[v] = static_cast<uint32_t>(out.positions.size() / 3);
+                    out.positions.insert(out.positions.end(), at(v), at(v) + 3);
+                }
+                out.indices.push_back(remap[v]);
+            }
+        }
+    }
+
+private:
+    const float* at(uint32_t v) const { return positions_.data() + static_cast<size_t>(v) * 3; }
+    float* at(uint32_t v) { return positions_.data() + static_cast<size_t>(v) * 3; }
+
+    void kill_triangle(size_t t) {
+        indices_[t * 3] = indices_[t * 3 + 1] = indices_[t * 3 + 2] = DEAD;
+        --alive_triangles_;
+    }
+
+    bool has_other_triangle(uint32_t a, uint32_t b, uint32_t except) const {
+        for (uint32_t t : triangles_of_[a]) {
+            if (t == except || indices_[t * 3] == DEAD) continue;
+            const uint32_t* f = &indices_[t * 3];
+            if (f[0] == b || f[1] == b || f[2] == b) return true;
+        }
+        return false;
+    }
+
+    // A plane through the edge f[k] -> f[k + 1], perpendicular to the face, resists moving the border
+    void add_boundary_plane(const uint32_t* f, int k) {
+        const float* a = at(f[k]);
+        const float* b = at(f[(k + 1) % 3]);
+        double face[3], d;
+        if (!face_plane(at(f[0]), at(f[1]), at(f[2]), face, d)) return;
+        const double e[3] = {double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2]};
+        double n[3] = {e[1] * face[2] - e[2] * face[1], e[2] * face[0] - e[0] * face[2], e[0] * face[1] - e[1] * face[0]};
+        const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length <= 0.0) return;
+        n[0] /= length; n[1] /= length; n[2] /= length;
+        const Quadric q = Quadric::plane(n[0], n[1], n[2], -(n[0] * a[0] + n[1] * a[1] + n[2] * a[2]), BOUNDARY_WEIGHT);
+        quadrics_[f[k]] += q;
+        quadrics_[f[(k + 1) % 3]] += q;
+    }
+
+    Candidate candidate(uint32_t v0, uint32_t v1) const {
+        Quadric q = quadrics_[v0];
+        q += quadrics_[v1];
+        Candidate c{0.0, {}};
+        const float* a = at(v0);
+        const float* b = at(v1);
+        double best[3];
+        // A nearly singular system can put the minimum far off; beyond one edge length from the
+        // midpoint it is not trusted
+        const double edge2 = double(b[0] - a[0]) * (b[0] - a[0]) + double(b[1] - a[1]) * (b[1] - a[1]) +
+                             double(b[2] - a[2]) * (b[2] - a[2]);
+        auto near_edge = [&](const double p[3]) {
+            double far2 = 0.0;
+            for (int k = 0; k < 3; ++k) far2 += (p[k] - 0.5 * (a[k] + b[k])) * (p[k] - 0.5 * (a[k] + b[k]));
+            return far2 <= edge2;
+        };
+        if (q.minimum(best) && near_edge(best)) {
+            c.cost = q.error(best[0], best[1], best[2]);
+        } else {
+            // Flat or linear neighbourhoods: the best of the endpoints and the midpoint
+            c.cost = std::numeric_limits<double>::max();
+            for (double s : {0.0, 0.5, 1.0}) {
+                const double p[3] = {a[0] + s * (b[0] - a[0]), a[1] + s * (b[1] - a[1]), a[2] + s * (b[2] - a[2])};
+                const double cost = q.error(p[0], p[1], p[2]);
+                if (cost < c.cost) {
+                    c.cost = cost;
+                    best[0] = p[0]; best[1] = p[1]; best[2] = p[2];
+                }
+            }
+        }
+        c.cost = std::max(c.cost, 0.0);
+        for (int k = 0; k < 3; ++k) c.position[k] = static_cast<float>(best[k]);
+        return c;
+    }
+
+    // Live triangles of v (pruning dead ones) and the other vertices they reach
+    void ring(uint32_t v, std::vector<uint32_t>& triangles, std::vector<uint32_t>& neighbours) {
+        std::vector<uint32_t>& list = triangles_of_[v];
+        list.erase(std::remove_if(list.begin(), list.end(), [&](uint32_t t) { return indices_[t * 3] == DEAD; }),
+                   list.end());
+        triangles = list;
+        neighbours.clear();
+        for (uint32_t t : list) {
+            for (int k = 0; k < 3; ++k) {
+                if (indices_[t * 3 + k] != v) neighbours.push_back(indices_[t * 3 + k]);
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    }
+
+    // Moving v to p keeps every triangle of v that does not also hold other facing the same way
+    bool keeps_orientation(uint32_t v, uint32_t other, const std::vector<uint32_t>& triangles, const float p[3]) const {
+        for (uint32_t t : triangles) {
+            const uint32_t* f = &indices_[t * 3];
+            if (f[0] == other || f[1] == other || f[2] == other) continue;
+            const float* corner[3] = {at(f[0]), at(f[1]), at(f[2])};
+            double before[3], d;
+            const bool had_area = face_plane(corner[0], corner[1], corner[2], before, d);
+            for (int k = 0; k < 3; ++k) {
+                if (f[k] == v) corner[k] = p;
+            }
+            double after[3];
+            if (!face_plane(corner[0], corner[1], corner[2], after, d)) return false;
+            if (had_area && before[0] * after[0] + before[1] * after[1] + before[2] * after[2] < 0.2) return false;
+        }
+        return true;
+    }
+
+    void push(uint32_t v0, uint32_t v1) {
+        uint32_t slot;
+        if (free_slots_.empty()) {
+            slot = static_cast<uint32_t>(queued_.size());
+            queued_.emplace_back();
+        } else {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        queued_[slot] = {v0, v1, version_[v0], version_[v1]};
+        heap_.push(queue_key(candidate(v0, v1).cost, slot));
+    }
+
+    bool collapse(uint32_t v0, uint32_t v1, const Candidate& c) {
+        ring(v0, triangles0_, neighbours0_);
+        ring(v1, triangles1_, neighbours1_);
+        size_t shared = 0;
+        for (uint32_t t : triangles0_) {
+            const uint32_t* f = &indices_[t * 3];
+            if (f[0] == v1 || f[1] == v1 || f[2] == v1) ++shared;
+        }
+        if (shared == 0) return false;
+        // An interior edge between two border vertices would pinch the surface into a bow tie
+        if (shared > 1 && boundary_[v0] && boundary_[v1]) return false;
+        // Link condition: the endpoints may only share the vertices opposite the edge
+        size_t common = 0;
+        for (size_t i = 0, j = 0; i < neighbours0_.size() && j < neighbours1_.size();) {
+            if (neighbours0_[i] < neighbours1_[j]) ++i;
+            else if (neighbours1_[j] < neighbours0_[i]) ++j;
+            else { ++common; ++i; ++j; }
+        }
+        if (common != shared) return false;
+        if (!keeps_orientation(v0, v1, triangles0_, c.position) ||
+            !keeps_orientation(v1, v0, triangles1_, c.position)) {
+            return false;
+        }
+
+        float* p = at(v0);
+        p[0] = c.position[0]; p[1] = c.position[1]; p[2] = c.position[2];
+        quadrics_[v0] += quadrics_[v1];
+        boundary_[v0] |= boundary_[v1];
+        std::vector<uint32_t>& merged = triangles_of_[v0];
+        for (uint32_t t : triangles1_) {
+            uint32_t* f = &indices_[t * 3];
+            if (f[0] == v0 || f[1] == v0 || f[2] == v0) {
+                kill_triangle(t);
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                if (f[k] == v1) f[k] = v0;
+            }
+            merged.push_back(t);
+        }
+        std::vector<uint32_t>().swap(triangles_of_[v1]);
+        ++version_[v0];
+        version_[v1] = DEAD;  // no queued version matches it again
+
+        ring(v0, triangles0_, neighbours0_);
+        for (uint32_t n : neighbours0_) push(v0, n);
+        return true;
+    }
+
+    std::vector<float> positions_;
+    std::vector<uint32_t> indices_;
+    std::vector<Quadric> quadrics_;
+    std::vector<uint32_t> version_;
+    std::vector<uint8_t> boundary_;  // on a border edge
+    std::vector<std::vector<uint32_t>> triangles_of_;
+    KeyHeap heap_;
+    std::vector<Queued> queued_;
+    std::vector<uint32_t> free_slots_;  // of popped queue entries
+    size_t alive_triangles_ = 0;
+    std::vector<uint32_t> triangles0_, triangles1_, neighbours0_, neighbours1_;  // scratch
+};
+
+// Vertex clustering to about goal_triangles: each vertex snaps to the mean of its grid cell,
+// collapsed triangles are dropped
+void cluster(std::vector<float>& positions, std::vector<uint32_t>& indices, size_t goal_triangles) {
+    const size_t vertices = positions.size() / 3;
+    const size_t triangles = indices.size() / 3;
+    float lo[3] = {positions[0], positions[1], positions[2]}, hi[3] = {lo[0], lo[1], lo[2]};
+    for (size_t v = 1; v < vertices; ++v) {
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], positions[v * 3 + k]);
+            hi[k] = std::max(hi[k], positions[v * 3 + k]);
+        }
+    }
+    // A grid of cell c merges about (c / mean edge)^2 surface vertices, and triangles are about
+    // twice the vertices; the mean edge comes from a sample of the triangles
+    const size_t sample_stride = std::max<size_t>(1, triangles / 4096);
+    double edge_sum = 0.0;
+    size_t edge_count = 0;
+    for (size_t t = 0; t < triangles; t += sample_stride, ++edge_count) {
+        const float* a = positions.data() + static_cast<size_t>(indices[t * 3]) * 3;
+        const float* b = positions.data() + static_cast<size_t>(indices[t * 3 + 1]) * 3;
+        edge_sum += std::sqrt(double(a[0] - b[0]) * (a[0] - b[0]) + double(a[1] - b[1]) * (a[1] - b[1]) +
+                              double(a[2] - b[2]) * (a[2] - b[2]));
+    }
+    const double mean_edge = edge_sum / std::max<size_t>(edge_count, 1);
+    const double cell = std::max(mean_edge * std::sqrt(double(triangles) / std::max<size_t>(goal_triangles, 1)),
+                                 1e-12);
+    if (cell <= mean_edge) return;
+
+    std::vector<uint64_t> keys(vertices);
+    cv::parallel_for_(cv::Range(0, static_cast<int>((vertices + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK)),
+                      [&](const cv::Range& range) {
+        const size_t end = std::min(vertices, static_cast<size_t>(range.end) * PARALLEL_CHUNK);
+        for (size_t v = static_cast<size_t>(range.start) * PARALLEL_CHUNK; v < end; ++v) {
+            uint64_t key = 0;
+            for (int k = 0; k < 3; ++k) {
+                const uint64_t cellk = static_cast<uint64_t>((positions[v * 3 + k] - lo[k]) / cell);
+                key = key << 21 | std::min<uint64_t>(cellk, (1u << 21) - 1);
+            }
+            keys[v] = key;
+        }
+    });
+    std::vector<uint32_t> order(vertices);
+    for (size_t v = 0; v < vertices; ++v) order[v] = static_cast<uint32_t>(v);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return keys[a] != keys[b] ? keys[a] < keys[b] : a < b;
+    });
+
+    std::vector<uint32_t> cluster_of(vertices);
+    std::vector<float> clustered;
+    for (size_t i = 0; i < vertices;) {
+        size_t j = i;
+        double sum[3] = {0, 0, 0};
+        for (; j < vertices && keys[order[j]] == keys[order[i]]; ++j) {
+            for (int k = 0; k < 3; ++k) sum[k] += positions[static_cast<size_t>(order[j]) * 3 + k];
+            cluster_of[order[j]] = static_cast<uint32_t>(clustered.size() / 3);
+        }
+        for (int k = 0; k < 3; ++k) clustered.push_back(static_cast<float>(sum[k] / double(j - i)));
+        i = j;
+    }
+
+    // Chunks remap and keep their surviving triangles, then are concatenated in order
+    const int chunks = static_cast<int>((triangles + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK);
+    std::vector<std::vector<uint32_t>> kept(static_cast<size_t>(chunks));
+    cv::parallel_for_(cv::Range(0, chunks), [&](const cv::Range& range) {
+        for (int chunk = range.start; chunk < range.end; ++chunk) {
+            const size_t end = std::min(triangles, static_cast<size_t>(chunk + 1) * PARALLEL_CHUNK);
+            for (size_t t = static_cast<size_t>(chunk) * PARALLEL_CHUNK; t < end; ++t) {
+                const uint32_t a = cluster_of[indices[t * 3]], b = cluster_of[indices[t * 3 + 1]],
+                               c = cluster_of[indices[t * 3 + 2]];
+                if (a == b || b == c || a == c) continue;
+                kept[chunk].insert(kept[chunk].end(), {a, b, c});
+            }
+        }
+    });
+    indices.clear();
+    for (const auto& chunk : kept) indices.insert(indices.end(), chunk.begin(), chunk.end());
+    positions.swap(clustered);
+}
+
+} // namespace
+
+bool MeshSimplifier::simplify(const Mesh& in, const SimplifyOptions& options, Mesh& out, Stats* stats) {
+    if (!in.valid() || !(options.max_error >= 0.0f)) {
+        utils::Logger::instance().error("MeshSimplifier: invalid mesh or error bound");
+        return false;
+    }
+    if (options.target_triangles == 0 && options.max_error == 0.0f) {
+        utils::Logger::instance().error("MeshSimplifier: neither target_triangles nor max_error is set");
+        return false;
+    }
+    Stats result;
+    result.input_triangles = in.triangle_count();
+    const bool normals = in.has_normals();
+    std::vector<float> positions = in.positions;
+    std::vector<uint32_t> indices = in.indices;
+
+    if (options.cluster_above > 0 && result.input_triangles > options.cluster_above && !positions.empty()) {
+        const size_t goal = options.target_triangles > 0 ? options.target_triangles * 4 : options.cluster_above;
+        if (goal < result.input_triangles) cluster(positions, indices, goal);
+    }
+    result.clustered_triangles = indices.size() / 3;
+
+    Decimator decimator(std::move(positions), std::move(indices), options.preserve_boundary);
+    const double max_cost = options.max_error > 0.0f ? double(options.max_error) * options.max_error
+                                                     : std::numeric_limits<double>::infinity();
+    double cost = 0.0;
+    while (decimator.alive_triangles() > options.target_triangles && decimator.collapse_next(max_cost, cost)) {
+        ++result.collapses;
+        result.max_error = std::max(result.max_error, static_cast<float>(std::sqrt(cost)));
+    }
+    decimator.extract(out);
+    out.normals.clear();
+    if (normals) out.compute_normals();
+    result.output_triangles = out.triangle_count();
+    if (stats) *stats = result;
+    return true;
+}
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,449 @@
+// generators/noise_atlas.cpp
+#include "generators/noise_atlas.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace cpp_engine::generators {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char ATLAS_MAGIC[4] = {'N', 'A', 'T', 'L'};
+constexpr uint32_t ATLAS_VERSION = 1;
+constexpr int MIN_ATLAS_SIZE = 16;
+constexpr int MAX_ATLAS_SIZE = 8192;
+constexpr int MAX_PERIOD_CELLS = 4096;  // times 2^(MAX_OCTAVES - 1) still fits an int
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t seed;
+    int32_t octaves;
+    float persistence;
+    float scale;
+    int32_t size;
+    int32_t period;
+};
+static_assert(sizeof(FileHeader) == 32, "texels start 32-byte aligned");
+
+uint32_t float_bits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// IEEE binary16, round to nearest even
+uint16_t float_to_half(float value) {
+    const uint32_t x = float_bits(value);
+    const uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000u);
+    const uint32_t magnitude = x & 0x7fffffffu;
+    if (magnitude >= 0x7f800000u) {  // inf, NaN stays NaN
+        return static_cast<uint16_t>(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u));
+    }
+    if (magnitude >= 0x477ff000u) return static_cast<uint16_t>(sign | 0x7c00u);  // rounds past 65504
+    if (magnitude < 0x38800000u) {  // half subnormal: a multiple of 2^-24
+        float m;
+        std::memcpy(&m, &magnitude, sizeof(m));
+        return static_cast<uint16_t>(sign | static_cast<uint16_t>(std::nearbyint(m * 16777216.0f)));
+    }
+    const uint32_t rounded = magnitude + 0xfffu + ((magnitude >> 13) & 1u);
+    return static_cast<uint16_t>(sign | ((rounded - 0x38000000u) >> 13));
+}
+
+float half_to_float(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    uint32_t exponent = (half >> 10) & 0x1fu, mantissa = half & 0x3ffu;
+    uint32_t bits;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            exponent = 113;
+            while (!(mantissa & 0x400u)) {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits = sign | exponent << 23 | (mantissa & 0x3ffu) << 13;
+        }
+    } else if (exponent == 31) {
+        bits = sign | 0x7f800000u | mantissa << 13;
+    } else {
+        bits = sign | (exponent + 112) << 23 | mantissa << 13;
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void halves_to_floats(const uint16_t* src, int count, float* dst) {
+    int i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    }
+#endif
+    for (; i < count; ++i) dst[i] = half_to_float(src[i]);
+}
+
+void floats_to_halves(const float* src, int count, uint16_t* dst) {
+    int i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for (; i < count; ++i) dst[i] = float_to_half(src[i]);
+}
+
+int wrap(double coordinate, int period) {
+    const long i = static_cast<long>(std::fmod(coordinate, static_cast<double>(period)));
+    return static_cast<int>(i < 0 ? i + period : i);
+}
+
+int lattice_period(const NoiseAtlasKey& key, int size) {
+    const long cells = std::lround(static_cast<double>(size) * key.scale);
+    return static_cast<int>(std::max(1L, std::min<long>(MAX_PERIOD_CELLS, cells)));
+}
+
+bool valid_key(const NoiseAtlasKey& key) {
+    return key.scale > 0.0f && std::isfinite(key.scale) && std::isfinite(key.persistence) && key.octaves >= 1 &&
+           key.octaves <= PerlinNoise::MAX_OCTAVES;
+}
+
+std::string temporary_name(const std::string& path) {
+    static std::atomic<unsigned> counter{0};
+    return path + ".tmp" + std::to_string(::getpid()) + "_" + std::to_string(counter++);
+}
+
+void touch(const fs::path& path) {
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+}
+
+bool is_atlas_file(const fs::directory_entry& entry) {
+    const std::string name = entry.path().filename().string();
+    return entry.is_regular_file() && name.rfind("atlas_", 0) == 0 && entry.path().extension() == ".f16";
+}
+
+} // namespace
+
+bool NoiseAtlasKey::operator<(const NoiseAtlasKey& other) const {
+    return std::tie(seed, octaves, persistence, scale) <
+           std::tie(other.seed, other.octaves, other.persistence, other.scale);
+}
+
+bool NoiseAtlasKey::operator==(const NoiseAtlasKey& other) const {
+    return seed == other.seed && octaves == other.octaves && persistence == other.persistence &&
+           scale == other.scale;
+}
+
+std::string NoiseAtlasKey::file_name(int size) const {
+    char name[96];
+    std::snprintf(name, sizeof(name), "atlas_%u_%d_%08x_%08x_%d.f16", seed, octaves,
+                  static_cast<unsigned>(float_bits(persistence)), static_cast<unsigned>(float_bits(scale)), size);
+    return name;
+}
+
+bool NoiseAtlasKey::matches(float s, const FractalParams& params) const {
+    return scale == s && octaves == params.octaves && persistence == params.persistence &&
+           params.lacunarity == 2.0f;
+}
+
+NoiseAtlas::~NoiseAtlas() {
+    if (mapping_) ::munmap(mapping_, mapped_bytes_);
+}
+
+int NoiseAtlas::fitted_size(const NoiseAtlasKey& key, int requested) {
+    if (!(key.scale > 0.0f)) return std::max(MIN_ATLAS_SIZE, requested);
+    const int cells = lattice_period(key, std::max(1, requested));
+    const long size = std::lround(cells / static_cast<double>(key.scale));
+    return static_cast<int>(std::max<long>(MIN_ATLAS_SIZE, std::min<long>(MAX_ATLAS_SIZE, size)));
+}
+
+bool NoiseAtlas::build(const NoiseAtlasKey& key, int size, const std::string& path) {
+    if (!valid_key(key) || size < 1 || size > MAX_ATLAS_SIZE) {
+        utils::Logger::instance().error("NoiseAtlas: invalid key or size for " + path);
+        return false;
+    }
+    const PerlinNoise noise(key.seed);
+    const int period = lattice_period(key, size);
+    const double cells_per_texel = static_cast<double>(period) / size;
+    float max_value = 0.0f, amplitude = 1.0f;
+    for (int o = 0; o < key.octaves; ++o, amplitude *= key.persistence) max_value += amplitude;
+    const float inv_max = max_value != 0.0f ? 1.0f / max_value : 0.0f;
+
+    std::vector<uint16_t> texels(static_cast<size_t>(size) * size);
+    cv::parallel_for_(cv::Range(0, size), [&](const cv::Range& range) {
+        std::vector<float> row(size);
+        for (int y = range.start; y < range.end; ++y) {
+            std::fill(row.begin(), row.end(), 0.0f);
+            float weight = 1.0f;
+            for (int o = 0; o < key.octaves; ++o, weight *= key.persistence) {
+                const double step = cells_per_texel * (1 << o);
+                const int octave_period = period << o;
+                const float ny = static_cast<float>(y * step);
+                for (int x = 0; x < size; ++x) {
+                    row[x] += weight * noise.noise_periodic(static_cast<float>(x * step), ny, octave_period);
+                }
+            }
+            for (float& v : row) v *= inv_max;
+            floats_to_halves(row.data(), size, &texels[static_cast<size_t>(y) * size]);
+        }
+    });
+
+    FileHeader header{};
+    std::memcpy(header.magic, ATLAS_MAGIC, sizeof(header.magic));
+    header.version = ATLAS_VERSION;
+    header.seed = key.seed;
+    header.octaves = key.octaves;
+    header.persistence = key.persistence;
+    header.scale = key.scale;
+    header.size = size;
+    header.period = period;
+
+    const std::string tmp = temporary_name(path);
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(texels.data()),
+                   static_cast<std::streamsize>(texels.size() * sizeof(uint16_t)));
+        if (!file) {
+            utils::Logger::instance().error("NoiseAtlas: cannot write " + tmp);
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    // Readers never see a partial file, and concurrent builders of one key just replace each other
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        utils::Logger::instance().error("NoiseAtlas: cannot rename " + tmp + " to " + path);
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const NoiseAtlas> NoiseAtlas::open(const std::string& path, const NoiseAtlasKey& key) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        utils::Logger::instance().error("NoiseAtlas: cannot open " + path);
+        return nullptr;
+    }
+    struct stat st;
+    void* mapping = MAP_FAILED;
+    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(FileHeader)) {
+        mapping = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);  // the mapping keeps the file
+    if (mapping == MAP_FAILED) {
+        utils::Logger::instance().error("NoiseAtlas: cannot map " + path);
+        return nullptr;
+    }
+
+    std::shared_ptr<NoiseAtlas> atlas(new NoiseAtlas());
+    atlas->mapping_ = mapping;
+    atlas->mapped_bytes_ = static_cast<size_t>(st.st_size);
+
+    FileHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    const NoiseAtlasKey stored{header.seed, header.octaves, header.persistence, header.scale};
+    const size_t expected = sizeof(header) + static_cast<size_t>(std::max(0, header.size)) *
+                                                 static_cast<size_t>(std::max(0, header.size)) * sizeof(uint16_t);
+    if (std::memcmp(header.magic, ATLAS_MAGIC, sizeof(header.magic)) != 0 || header.version != ATLAS_VERSION ||
+        !(stored == key) || header.size < 1 || header.period < 1 || atlas->mapped_bytes_ != expected) {
+        utils::Logger::instance().error("NoiseAtlas: " + path + " is not an atlas of the requested key");
+        return nullptr;
+    }
+
+    atlas->key_ = key;
+    atlas->size_ = header.size;
+    atlas->period_ = header.period;
+    atlas->texels_ = reinterpret_cast<const uint16_t*>(static_cast<const char*>(mapping) + sizeof(header));
+    const double texels_per_pixel = static_cast<double>(key.scale) * header.size / header.period;
+    // Snap the float rounding of scale so whole pixels land on whole texels
+    atlas->texels_per_pixel_ =
+        std::fabs(texels_per_pixel - 1.0) < 1e-6 ? 1.0f : static_cast<float>(texels_per_pixel);
+    return atlas;
+}
+
+float NoiseAtlas::texel(int x, int y) const {
+    return half_to_float(texels_[static_cast<size_t>(wrap(y, size_)) * size_ + wrap(x, size_)]);
+}
+
+float NoiseAtlas::sample(float x, float y) const {
+    const float fx = std::floor(x), fy = std::floor(y);
+    const float tx = x - fx, ty = y - fy;
+    const int x0 = wrap(fx, size_), y0 = wrap(fy, size_);
+    const int x1 = x0 + 1 < size_ ? x0 + 1 : 0, y1 = y0 + 1 < size_ ? y0 + 1 : 0;
+    const uint16_t* r0 = texels_ + static_cast<size_t>(y0) * size_;
+    const uint16_t* r1 = texels_ + static_cast<size_t>(y1) * size_;
+    const float a = half_to_float(r0[x0]) + tx * (half_to_float(r0[x1]) - half_to_float(r0[x0]));
+    const float b = half_to_float(r1[x0]) + tx * (half_to_float(r1[x1]) - half_to_float(r1[x0]));
+    return a + ty * (b - a);
+}
+
+void NoiseAtlas::sample_row(float x0, float y, int count, float* out) const {
+    if (count <= 0) return;
+    if (texels_per_pixel_ == 1.0f && x0 == std::floor(x0) && y == std::floor(y)) {
+        // One texel per pixel: convert runs of stored halves, wrapping at the tile edge
+        const uint16_t* row = texels_ + static_cast<size_t>(wrap(y, size_)) * size_;
+        int x = wrap(x0, size_);
+        for (int i = 0; i < count;) {
+            const int run = std::min(count - i, size_ - x);
+            halves_to_floats(row + x, run, out + i);
+            i += run;
+            x = 0;
+        }
+        return;
+    }
+    // Blend the two texel rows once over the span the pixels cover, then lerp along it
+    const float ty = y * texels_per_pixel_, fy = std::floor(ty), wy = ty - fy;
+    const int y0 = wrap(fy, size_), y1 = y0 + 1 < size_ ? y0 + 1 : 0;
+    const float t0 = x0 * texels_per_pixel_;
+    const long first = static_cast<long>(std::floor(t0));
+    const long last = static_cast<long>(std::floor(t0 + (count - 1) * texels_per_pixel_)) + 1;
+    const int span = static_cast<int>(last - first + 1);
+    thread_local std::vector<float> upper, lower;
+    upper.resize(span);
+    lower.resize(span);
+    const uint16_t* r0 = texels_ + static_cast<size_t>(y0) * size_;
+    const uint16_t* r1 = texels_ + static_cast<size_t>(y1) * size_;
+    for (int k = 0, x = wrap(static_cast<double>(first), size_); k < span;) {
+        const int run = std::min(span - k, size_ - x);
+        halves_to_floats(r0 + x, run, upper.data() + k);
+        halves_to_floats(r1 + x, run, lower.data() + k);
+        k += run;
+        x = 0;
+    }
+    for (int k = 0; k < span; ++k) upper[k] += wy * (lower[k] - upper[k]);
+    for (int i = 0; i < count; ++i) {
+        const float t = t0 + i * texels_per_pixel_, ft = std::floor(t);
+        const int k = static_cast<int>(static_cast<long>(ft) - first);
+        out[i] = upper[k] + (t - ft) * (upper[k + 1] - upper[k]);
+    }
+}
+
+NoiseAtlasStore::NoiseAtlasStore(const NoiseAtlasOptions& options) : options_(options) {
+    if (options_.directory.empty()) options_.directory = default_directory();
+    options_.size = std::max(MIN_ATLAS_SIZE, std::min(MAX_ATLAS_SIZE, options_.size));
+}
+
+std::string NoiseAtlasStore::default_directory() {
+    const char* cache = std::getenv("XDG_CACHE_HOME");
+    const char* home = std::getenv("HOME");
+    fs::path base;
+    if (cache && *cache) {
+        base = cache;
+    } else if (home && *home) {
+        base = fs::path(home) / ".cache";
+    } else {
+        base = fs::temp_directory_path();
+    }
+    return (base / "cpp_engine" / "noise_atlas").string();
+}
+
+std::shared_ptr<const NoiseAtlas> NoiseAtlasStore::get(const NoiseAtlasKey& key) {
+    if (!valid_key(key)) {
+        utils::Logger::instance().error("NoiseAtlasStore: invalid atlas key");
+        return nullptr;
+    }
+    const int size = NoiseAtlas::fitted_size(key, options_.size);
+    const fs::path path = fs::path(options_.directory) / key.file_name(size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = atlases_.find(key);
+    if (it != atlases_.end()) {
+        ++stats_.memory_hits;
+        touch(path);
+        return it->second;
+    }
+
+    std::error_code ec;
+    std::shared_ptr<const NoiseAtlas> atlas;
+    if (fs::exists(path, ec)) {
+        atlas = NoiseAtlas::open(path.string(), key);
+        if (atlas) {
+            ++stats_.disk_hits;
+            touch(path);
+        }
+    }
+    if (!atlas) {
+        fs::create_directories(options_.directory, ec);
+        if (!NoiseAtlas::build(key, size, path.string())) return nullptr;
+        atlas = NoiseAtlas::open(path.string(), key);
+        if (!atlas) return nullptr;
+        ++stats_.builds;
+        evict_locked(path.filename().string());
+    }
+    atlases_.emplace(key, atlas);
+    return atlas;
+}
+
+size_t NoiseAtlasStore::disk_bytes() const {
+    std::error_code ec;
+    size_t total = 0;
+    for (const auto& entry : fs::directory_iterator(options_.directory, ec)) {
+        if (is_atlas_file(entry)) total += static_cast<size_t>(entry.file_size(ec));
+    }
+    return total;
+}
+
+void NoiseAtlasStore::evict(const std::string& keep) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evict_locked(keep);
+}
+
+void NoiseAtlasStore::evict_locked(const std::string& keep) {
+    struct File {
+        fs::file_time_type used;
+        fs::path path;
+        size_t bytes;
+    };
+    std::error_code ec;
+    std::vector<File> files;
+    size_t total = 0;
+    for (const auto& entry : fs::directory_iterator(options_.directory, ec)) {
+        if (!is_atlas_file(entry)) continue;
+        File file{entry.last_write_time(ec), entry.path(), static_cast<size_t>(entry.file_size(ec))};
+        total += file.bytes;
+        files.push_back(file);
+    }
+    std::sort(files.begin(), files.end(), [](const File& a, const File& b) { return a.used < b.used; });
+    for (const File& file : files) {
+        if (total <= options_.max_disk_bytes) break;
+        if (file.path.filename() == keep) continue;
+        if (fs::remove(file.path, ec)) {
+            total -= file.bytes;
+            ++stats_.evictions;
+        }
+    }
+}
+
+NoiseAtlasStore::Stats NoiseAtlasStore::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,812 @@
+// generators/perlin_noise.cpp
+#include "generators/perlin_noise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX512F__) && defined(__GNUC__) && !defined(__clang__)
+// GCC 12 flags the _mm512_undefined_* passthrough of its own intrinsics
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace cpp_engine::generators {
+
+namespace {
+
+// Gradient of hash h is (sx, sy) with sx, sy = +-1; bit 0 set = sx negative, bit 1 = sy negative
+int gradient_signs(int hash) {
+    const int h = hash & 15;
+    const int first = h & 1, second = (h >> 1) & 1;
+    // h < 8: x * (+-1 by bit 0) + y * (+-1 by bit 1); otherwise the roles of x and y swap
+    return h < 8 ? (first | second << 1) : (second | first << 1);
+}
+
+float fade(float t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+float fade_derivative(float t) {
+    return 30.0f * t * t * (t * (t - 2.0f) + 1.0f);
+}
+
+float signed_by(float value, int negative) {
+    return negative ? -value : value;
+}
+
+/**
+ * Per-octave constants for one row
+ * codes[xi] packs the gradient signs of the four corners of cell (xi, yi):
+ * bits 0-1 (xi, yi), 4-5 (xi, yi + 1), 8-9 (xi + 1, yi), 12-13 (xi + 1, yi + 1).
+ */
+struct OctaveRow {
+    float step;       // lattice units per pixel
+    float amplitude;
+    float yf, v, dv;  // fractional y, its fade and the fade's derivative
+    int32_t codes[256];
+};
+
+void build_octave_row(const int* perm, double y, double frequency, float x_begin, float x_end, OctaveRow& row) {
+    const double ny = y * frequency;
+    const double fy = std::floor(ny);
+    const int yi = static_cast<int>(fy) & 255;
+    row.yf = static_cast<float>(ny - fy);
+    row.v = fade(row.yf);
+    row.dv = fade_derivative(row.yf);
+
+    // Only the cells the row crosses
+    int cell_signs[257];
+    const long first = static_cast<long>(std::floor(std::min(x_begin, x_end) * row.step));
+    const long last = static_cast<long>(std::floor(std::max(x_begin, x_end) * row.step)) + 1;
+    const long cells = std::min<long>(256, last - first + 1);
+    for (long c = 0; c <= cells; ++c) {
+        const int i = static_cast<int>((first + c) & 255);
+        const int p = perm[i];
+        cell_signs[c] = gradient_signs(perm[p + yi]) | gradient_signs(perm[p + yi + 1]) << 4;
+    }
+    for (long c = 0; c < cells; ++c) {
+        row.codes[(first + c) & 255] = cell_signs[c] | cell_signs[c + 1] << 8;
+    }
+}
+
+float octave_sample(const OctaveRow& row, float x) {
+    const float fx = std::floor(x);
+    const int code = row.codes[static_cast<int>(fx) & 255];
+    const float xf = x - fx, yf = row.yf;
+    const float n00 = signed_by(xf, code & 1) + signed_by(yf, code & 2);
+    const float n01 = signed_by(xf, code & 16) + signed_by(yf - 1.0f, code & 32);
+    const float n10 = signed_by(xf - 1.0f, code & 256) + signed_by(yf, code & 512);
+    const float n11 = signed_by(xf - 1.0f, code & 4096) + signed_by(yf - 1.0f, code & 8192);
+    const float u = fade(xf);
+    const float x1 = n00 + u * (n10 - n00);
+    const float x2 = n01 + u * (n11 - n01);
+    return x1 + row.v * (x2 - x1);
+}
+
+float octave_sample_gradient(const OctaveRow& row, float x, float& dx, float& dy) {
+    const float fx = std::floor(x);
+    const int code = row.codes[static_cast<int>(fx) & 255];
+    const float xf = x - fx, yf = row.yf;
+    const float gx00 = signed_by(1.0f, code & 1), gy00 = signed_by(1.0f, code & 2);
+    const float gx01 = signed_by(1.0f, code & 16), gy01 = signed_by(1.0f, code & 32);
+    const float gx10 = signed_by(1.0f, code & 256), gy10 = signed_by(1.0f, code & 512);
+    const float gx11 = signed_by(1.0f, code & 4096), gy11 = signed_by(1.0f, code & 8192);
+    const float n00 = signed_by(xf, code & 1) + signed_by(yf, code & 2);
+    const float n01 = signed_by(xf, code & 16) + signed_by(yf - 1.0f, code & 32);
+    const float n10 = signed_by(xf - 1.0f, code & 256) + signed_by(yf, code & 512);
+    const float n11 = signed_by(xf - 1.0f, code & 4096) + signed_by(yf - 1.0f, code & 8192);
+    const float u = fade(xf), du = fade_derivative(xf);
+    const float d0 = n10 - n00, d1 = n11 - n01;
+    const float x1 = n00 + u * d0;
+    const float x2 = n01 + u * d1;
+    const float dx1 = gx00 + u * (gx10 - gx00) + du * d0;
+    const float dx2 = gx01 + u * (gx11 - gx01) + du * d1;
+    const float dy1 = gy00 + u * (gy10 - gy00);
+    const float dy2 = gy01 + u * (gy11 - gy01);
+    dx = dx1 + row.v * (dx2 - dx1);
+    dy = dy1 + row.v * (dy2 - dy1) + row.dv * (x2 - x1);
+    return x1 + row.v * (x2 - x1);
+}
+
+// One OctaveRow per octave for pixels x0 .. x0 + count - 1 of row y; returns the octave count
+int prepare_rows(const int* perm, float x0, float y, int count, float scale, const FractalParams& params,
+                 OctaveRow* rows, float& inv_max) {
+    const int octaves = std::max(0, std::min(params.octaves, PerlinNoise::MAX_OCTAVES));
+    float amplitude = 1.0f, frequency = 1.0f, max_value = 0.0f;
+    for (int o = 0; o < octaves; ++o) {
+        rows[o].step = scale * frequency;
+        rows[o].amplitude = amplitude;
+        build_octave_row(perm, static_cast<double>(y) * scale, frequency, x0, x0 + (count - 1), rows[o]);
+        max_value += amplitude;
+        amplitude *= params.persistence;
+        frequency *= params.lacunarity;
+    }
+    inv_max = octaves > 0 ? 1.0f / max_value : 0.0f;
+    return octaves;
+}
+
+
+// 3D gradients are (+-1, +-1, +-1), sign of each axis from hash bits 0, 1, 2; the
+// blend peaks a little above 1.2, scaled to stay inside [-1, 1] like the 2D noise
+constexpr float NOISE3_SCALE = 2.0f / 3.0f;
+
+/**
+ * One octave of 3D noise along a row, at fixed y and z (time)
+ * With y and z fixed, the trilinear blend of a cell collapses onto its two
+ * lattice columns: n = lerp(u, p0 xf + q0, p1 (xf - 1) + q1), and dn/dy has
+ * the same form with dp/dq. Tables are indexed by cell & 255 like
+ * OctaveRow::codes; the d* tables are filled only for gradients.
+ */
+struct OctaveSlice {
+    float step;  // lattice units per pixel
+    float p0[256], q0[256], p1[256], q1[256];
+    float dp0[256], dq0[256], dp1[256], dq1[256];
+};
+
+void build_octave_slice(const int* perm, double y, double z, double frequency, float x_begin, float x_end,
+                        bool gradient, OctaveSlice& slice) {
+    const double ny = y * frequency, nz = z * frequency;
+    const double fy = std::floor(ny), fz = std::floor(nz);
+    const int yi = static_cast<int>(fy) & 255, zi = static_cast<int>(fz) & 255;
+    const float yf = static_cast<float>(ny - fy), zf = static_cast<float>(nz - fz);
+    const float v = fade(yf), dv = fade_derivative(yf), w = fade(zf);
+
+    // Per lattice column: a, b, c of the two (y, z) edges blended over z, then over y
+    struct Column { float p, q, dp, dq; };
+    auto column = [&](int xc) {
+        float a[2], b[2], k[2];
+        const int base = perm[xc];
+        for (int j = 0; j < 2; ++j) {
+            const int row = perm[base + yi + j];
+            const int h0 = perm[row + zi], h1 = perm[row + zi + 1];
+            a[j] = signed_by(1.0f, h0 & 1) + w * (signed_by(1.0f, h1 & 1) - signed_by(1.0f, h0 & 1));
+            b[j] = signed_by(1.0f, h0 & 2) + w * (signed_by(1.0f, h1 & 2) - signed_by(1.0f, h0 & 2));
+            const float c = (1.0f - w) * signed_by(zf, h0 & 4) + w * signed_by(zf - 1.0f, h1 & 4);
+            k[j] = b[j] * (yf - j) + c;
+        }
+        Column col;
+        col.p = NOISE3_SCALE * (a[0] + v * (a[1] - a[0]));
+        col.q = NOISE3_SCALE * (k[0] + v * (k[1] - k[0]));
+        col.dp = NOISE3_SCALE * dv * (a[1] - a[0]);
+        col.dq = NOISE3_SCALE * (dv * (k[1] - k[0]) + b[0] + v * (b[1] - b[0]));
+        return col;
+    };
+
+    const long first = static_cast<long>(std::floor(std::min(x_begin, x_end) * slice.step));
+    const long last = static_cast<long>(std::floor(std::max(x_begin, x_end) * slice.step)) + 1;
+    const long cells = std::min<long>(256, last - first + 1);
+    Column left = column(static_cast<int>(first & 255));
+    for (long c = 0; c < cells; ++c) {
+        const int cell = static_cast<int>((first + c) & 255);
+        const Column right = column((cell + 1) & 255);
+        slice.p0[cell] = left.p;
+        slice.q0[cell] = left.q;
+        slice.p1[cell] = right.p;
+        slice.q1[cell] = right.q;
+        if (gradient) {
+            slice.dp0[cell] = left.dp;
+            slice.dq0[cell] = left.dq;
+            slice.dp1[cell] = right.dp;
+            slice.dq1[cell] = right.dq;
+        }
+        left = right;
+    }
+}
+
+// out[i] += weight * n(x0 + i); with dx/dy also the pixel-unit gradient times weight
+void accumulate_slice(const OctaveSlice& s, float x0, int count, float weight, float* out, float* dx, float* dy) {
+    const float slope = weight * s.step;
+    int i = 0;
+#if defined(__AVX512F__)
+    {
+        const __m512 one = _mm512_set1_ps(1.0f), two = _mm512_set1_ps(2.0f), six = _mm512_set1_ps(6.0f);
+        const __m512 fifteen = _mm512_set1_ps(15.0f), ten = _mm512_set1_ps(10.0f), thirty = _mm512_set1_ps(30.0f);
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i low8 = _mm512_set1_epi32(255);
+        const __m512 vweight = _mm512_set1_ps(weight), vslope = _mm512_set1_ps(slope);
+        for (; i + 16 <= count; i += 16) {
+            const __m512 px = _mm512_add_ps(_mm512_set1_ps(x0),
+                                            _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(i), lane)));
+            const __m512 x = _mm512_mul_ps(px, _mm512_set1_ps(s.step));
+            const __m512 fx = _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            const __m512i cell = _mm512_and_si512(_mm512_cvtps_epi32(fx), low8);
+            const __m512 xf = _mm512_sub_ps(x, fx), xf1 = _mm512_sub_ps(xf, one);
+            const __m512 p0 = _mm512_i32gather_ps(cell, s.p0, 4), p1 = _mm512_i32gather_ps(cell, s.p1, 4);
+            const __m512 l0 = _mm512_add_ps(_mm512_mul_ps(p0, xf), _mm512_i32gather_ps(cell, s.q0, 4));
+            const __m512 l1 = _mm512_add_ps(_mm512_mul_ps(p1, xf1), _mm512_i32gather_ps(cell, s.q1, 4));
+            const __m512 xf2 = _mm512_mul_ps(xf, xf);
+            const __m512 u = _mm512_mul_ps(_mm512_mul_ps(xf2, xf),
+                                           _mm512_add_ps(_mm512_mul_ps(xf, _mm512_sub_ps(_mm512_mul_ps(xf, six), fifteen)), ten));
+            const __m512 d = _mm512_sub_ps(l1, l0);
+            const __m512 n = _mm512_add_ps(l0, _mm512_mul_ps(u, d));
+            _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(out + i), _mm512_mul_ps(vweight, n)));
+            if (!dx) continue;
+            const __m512 du = _mm512_mul_ps(_mm512_mul_ps(thirty, xf2),
+                                            _mm512_add_ps(_mm512_mul_ps(xf, _mm512_sub_ps(xf, two)), one));
+            const __m512 nx = _mm512_add_ps(_mm512_add_ps(p0, _mm512_mul_ps(u, _mm512_sub_ps(p1, p0))), _mm512_mul_ps(du, d));
+            const __m512 m0 = _mm512_add_ps(_mm512_mul_ps(_mm512_i32gather_ps(cell, s.dp0, 4), xf),
+                                            _mm512_i32gather_ps(cell, s.dq0, 4));
+            const __m512 m1 = _mm512_add_ps(_mm512_mul_ps(_mm512_i32gather_ps(cell, s.dp1, 4), xf1),
+                                            _mm512_i32gather_ps(cell, s.dq1, 4));
+            const __m512 ny = _mm512_add_ps(m0, _mm512_mul_ps(u, _mm512_sub_ps(m1, m0)));
+            _mm512_storeu_ps(dx + i, _mm512_add_ps(_mm512_loadu_ps(dx + i), _mm512_mul_ps(vslope, nx)));
+            _mm512_storeu_ps(dy + i, _mm512_add_ps(_mm512_loadu_ps(dy + i), _mm512_mul_ps(vslope, ny)));
+        }
+    }
+#endif
+#if defined(__AVX2__)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f), six = _mm256_set1_ps(6.0f);
+        const __m256 fifteen = _mm256_set1_ps(15.0f), ten = _mm256_set1_ps(10.0f), thirty = _mm256_set1_ps(30.0f);
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i low8 = _mm256_set1_epi32(255);
+        const __m256 vweight = _mm256_set1_ps(weight), vslope = _mm256_set1_ps(slope);
+        for (; i + 8 <= count; i += 8) {
+            const __m256 px = _mm256_add_ps(_mm256_set1_ps(x0),
+                                            _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(i), lane)));
+            const __m256 x = _mm256_mul_ps(px, _mm256_set1_ps(s.step));
+            const __m256 fx = _mm256_floor_ps(x);
+            const __m256i cell = _mm256_and_si256(_mm256_cvtps_epi32(fx), low8);
+            const __m256 xf = _mm256_sub_ps(x, fx), xf1 = _mm256_sub_ps(xf, one);
+            const __m256 p0 = _mm256_i32gather_ps(s.p0, cell, 4), p1 = _mm256_i32gather_ps(s.p1, cell, 4);
+            const __m256 l0 = _mm256_add_ps(_mm256_mul_ps(p0, xf), _mm256_i32gather_ps(s.q0, cell, 4));
+            const __m256 l1 = _mm256_add_ps(_mm256_mul_ps(p1, xf1), _mm256_i32gather_ps(s.q1, cell, 4));
+            const __m256 xf2 = _mm256_mul_ps(xf, xf);
+            const __m256 u = _mm256_mul_ps(_mm256_mul_ps(xf2, xf),
+                                           _mm256_add_ps(_mm256_mul_ps(xf, _mm256_sub_ps(_mm256_mul_ps(xf, six), fifteen)), ten));
+            const __m256 d = _mm256_sub_ps(l1, l0);
+            const __m256 n = _mm256_add_ps(l0, _mm256_mul_ps(u, d));
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(vweight, n)));
+            if (!dx) continue;
+            const __m256 du = _mm256_mul_ps(_mm256_mul_ps(thirty, xf2),
+                                            _mm256_add_ps(_mm256_mul_ps(xf, _mm256_sub_ps(xf, two)), one));
+            const __m256 nx = _mm256_add_ps(_mm256_add_ps(p0, _mm256_mul_ps(u, _mm256_sub_ps(p1, p0))), _mm256_mul_ps(du, d));
+            const __m256 m0 = _mm256_add_ps(_mm256_mul_ps(_mm256_i32gather_ps(s.dp0, cell, 4), xf),
+                                            _mm256_i32gather_ps(s.dq0, cell, 4));
+            const __m256 m1 = _mm256_add_ps(_mm256_mul_ps(_mm256_i32gather_ps(s.dp1, cell, 4), xf1),
+                                            _mm256_i32gather_ps(s.dq1, cell, 4));
+            const __m256 ny = _mm256_add_ps(m0, _mm256_mul_ps(u, _mm256_sub_ps(m1, m0)));
+            _mm256_storeu_ps(dx + i, _mm256_add_ps(_mm256_loadu_ps(dx + i), _mm256_mul_ps(vslope, nx)));
+            _mm256_storeu_ps(dy + i, _mm256_add_ps(_mm256_loadu_ps(dy + i), _mm256_mul_ps(vslope, ny)));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), six = _mm_set1_ps(6.0f);
+        const __m128 fifteen = _mm_set1_ps(15.0f), ten = _mm_set1_ps(10.0f), thirty = _mm_set1_ps(30.0f);
+        const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128 vweight = _mm_set1_ps(weight), vslope = _mm_set1_ps(slope);
+        alignas(16) int32_t cell[4];
+        alignas(16) float g[8][4];
+        for (; i + 4 <= count; i += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(x0), _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(i), lane)));
+            const __m128 x = _mm_mul_ps(px, _mm_set1_ps(s.step));
+            const __m128 tf = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+            const __m128 fx = _mm_sub_ps(tf, _mm_and_ps(_mm_cmpgt_ps(tf, x), one));
+            _mm_store_si128(reinterpret_cast<__m128i*>(cell), _mm_cvttps_epi32(fx));
+            for (int k = 0; k < 4; ++k) {
+                const int c = cell[k] & 255;
+                g[0][k] = s.p0[c];
+                g[1][k] = s.q0[c];
+                g[2][k] = s.p1[c];
+                g[3][k] = s.q1[c];
+            }
+            const __m128 xf = _mm_sub_ps(x, fx), xf1 = _mm_sub_ps(xf, one);
+            const __m128 p0 = _mm_load_ps(g[0]), p1 = _mm_load_ps(g[2]);
+            const __m128 l0 = _mm_add_ps(_mm_mul_ps(p0, xf), _mm_load_ps(g[1]));
+            const __m128 l1 = _mm_add_ps(_mm_mul_ps(p1, xf1), _mm_load_ps(g[3]));
+            const __m128 xf2 = _mm_mul_ps(xf, xf);
+            const __m128 u = _mm_mul_ps(_mm_mul_ps(xf2, xf),
+                                        _mm_add_ps(_mm_mul_ps(xf, _mm_sub_ps(_mm_mul_ps(xf, six), fifteen)), ten));
+            const __m128 d = _mm_sub_ps(l1, l0);
+            const __m128 n = _mm_add_ps(l0, _mm_mul_ps(u, d));
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(vweight, n)));
+            if (!dx) continue;
+            for (int k = 0; k < 4; ++k) {
+                const int c = cell[k] & 255;
+                g[4][k] = s.dp0[c];
+                g[5][k] = s.dq0[c];
+                g[6][k] = s.dp1[c];
+                g[7][k] = s.dq1[c];
+            }
+            const __m128 du = _mm_mul_ps(_mm_mul_ps(thirty, xf2), _mm_add_ps(_mm_mul_ps(xf, _mm_sub_ps(xf, two)), one));
+            const __m128 nx = _mm_add_ps(_mm_add_ps(p0, _mm_mul_ps(u, _mm_sub_ps(p1, p0))), _mm_mul_ps(du, d));
+            const __m128 m0 = _mm_add_ps(_mm_mul_ps(_mm_load_ps(g[4]), xf), _mm_load_ps(g[5]));
+            const __m128 m1 = _mm_add_ps(_mm_mul_ps(_mm_load_ps(g[6]), xf1), _mm_load_ps(g[7]));
+            const __m128 ny = _mm_add_ps(m0, _mm_mul_ps(u, _mm_sub_ps(m1, m0)));
+            _mm_storeu_ps(dx + i, _mm_add_ps(_mm_loadu_ps(dx + i), _mm_mul_ps(vslope, nx)));
+            _mm_storeu_ps(dy + i, _mm_add_ps(_mm_loadu_ps(dy + i), _mm_mul_ps(vslope, ny)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        const float x = (x0 + static_cast<float>(i)) * s.step;
+        const float fx = std::floor(x);
+        const int c = static_cast<int>(fx) & 255;
+        const float xf = x - fx;
+        const float l0 = s.p0[c] * xf + s.q0[c];
+        const float l1 = s.p1[c] * (xf - 1.0f) + s.q1[c];
+        const float u = fade(xf);
+        out[i] += weight * (l0 + u * (l1 - l0));
+        if (!dx) continue;
+        const float nx = s.p0[c] + u * (s.p1[c] - s.p0[c]) + fade_derivative(xf) * (l1 - l0);
+        const float m0 = s.dp0[c] * xf + s.dq0[c];
+        const float m1 = s.dp1[c] * (xf - 1.0f) + s.dq1[c];
+        dx[i] += slope * nx;
+        dy[i] += slope * (m0 + u * (m1 - m0));
+    }
+}
+
+} // namespace
+
+PerlinNoise::PerlinNoise(unsigned int seed) {
+    // Same construction as the original generator, so a seed keeps its image
+    std::mt19937 gen(seed);
+    std::vector<int> permutation(256);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), gen);
+    for (int i = 0; i < 512; ++i) perm_[i] = permutation[i & 255];
+}
+
+float PerlinNoise::noise(float x, float y) const {
+    const float fx = std::floor(x), fy = std::floor(y);
+    const int xi = static_cast<int>(fx) & 255, yi = static_cast<int>(fy) & 255;
+    const float xf = x - fx, yf = y - fy;
+    const int a = perm_[xi], b = perm_[xi + 1];
+    auto grad = [](int hash, float gx, float gy) {
+        const int s = gradient_signs(hash);
+        return signed_by(gx, s & 1) + signed_by(gy, s & 2);
+    };
+    const float u = fade(xf), v = fade(yf);
+    const float x1 = grad(perm_[a + yi], xf, yf) + u * (grad(perm_[b + yi], xf - 1.0f, yf) - grad(perm_[a + yi], xf, yf));
+    const float x2 = grad(perm_[a + yi + 1], xf, yf - 1.0f) +
+                     u * (grad(perm_[b + yi + 1], xf - 1.0f, yf - 1.0f) - grad(perm_[a + yi + 1], xf, yf - 1.0f));
+    return x1 + v * (x2 - x1);
+}
+
+float PerlinNoise::noise_periodic(float x, float y, int period) const {
+    period = std::max(1, period);
+    const float fx = std::floor(x), fy = std::floor(y);
+    const float xf = x - fx, yf = y - fy;
+    auto wrap = [period](float f) {
+        const int i = static_cast<int>(std::fmod(static_cast<double>(f), period));
+        return i < 0 ? i + period : i;
+    };
+    const int xi = wrap(fx), yi = wrap(fy);
+    const int xj = (xi + 1) % period, yj = (yi + 1) % period;
+    const int a = perm_[xi & 255], b = perm_[xj & 255];
+    auto grad = [](int hash, float gx, float gy) {
+        const int s = gradient_signs(hash);
+        return signed_by(gx, s & 1) + signed_by(gy, s & 2);
+    };
+    const float n00 = grad(perm_[a + (yi & 255)], xf, yf);
+    const float n10 = grad(perm_[b + (yi & 255)], xf - 1.0f, yf);
+    const float n01 = grad(perm_[a + (yj & 255)], xf, yf - 1.0f);
+    const float n11 = grad(perm_[b + (yj & 255)], xf - 1.0f, yf - 1.0f);
+    const float u = fade(xf), v = fade(yf);
+    const float x1 = n00 + u * (n10 - n00);
+    const float x2 = n01 + u * (n11 - n01);
+    return x1 + v * (x2 - x1);
+}
+
+float PerlinNoise::fractal(float x, float y, const FractalParams& params) const {
+    float result = 0.0f, amplitude = 1.0f, frequency = 1.0f, max_value = 0.0f;
+    for (int i = 0; i < std::min(params.octaves, MAX_OCTAVES); ++i) {
+        result += amplitude * noise(x * frequency, y * frequency);
+        max_value += amplitude;
+        amplitude *= params.persistence;
+        frequency *= params.lacunarity;
+    }
+    return max_value > 0.0f ? result / max_value : 0.0f;
+}
+
+void PerlinNoise::fractal_row(float x0, float y, int count, float scale, const FractalParams& params, float* out) const {
+    if (count <= 0) return;
+    OctaveRow rows[MAX_OCTAVES];
+    float inv_max = 0.0f;
+    const int octaves = prepare_rows(perm_, x0, y, count, scale, params, rows, inv_max);
+
+    int i = 0;
+#if defined(__AVX512F__)
+    {
+        const __m512 one = _mm512_set1_ps(1.0f), six = _mm512_set1_ps(6.0f);
+        const __m512 fifteen = _mm512_set1_ps(15.0f), ten = _mm512_set1_ps(10.0f);
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i low8 = _mm512_set1_epi32(255);
+        for (; i + 16 <= count; i += 16) {
+            const __m512 px = _mm512_add_ps(_mm512_set1_ps(x0),
+                                            _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(i), lane)));
+            __m512 acc = _mm512_setzero_ps();
+            for (int o = 0; o < octaves; ++o) {
+                const OctaveRow& r = rows[o];
+                const __m512 x = _mm512_mul_ps(px, _mm512_set1_ps(r.step));
+                const __m512 fx = _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+                const __m512i code = _mm512_i32gather_epi32(_mm512_and_si512(_mm512_cvtps_epi32(fx), low8), r.codes, 4);
+                const __m512 xf = _mm512_sub_ps(x, fx), xf1 = _mm512_sub_ps(xf, one);
+                const __m512 yf = _mm512_set1_ps(r.yf), yf1 = _mm512_set1_ps(r.yf - 1.0f);
+                // Sign of each term: code bit moved to the float sign bit
+                auto flip = [&](__m512 value, int bit) {
+                    return _mm512_castsi512_ps(_mm512_xor_si512(
+                        _mm512_castps_si512(value),
+                        _mm512_and_si512(_mm512_slli_epi32(code, 31 - bit), _mm512_set1_epi32(INT32_MIN))));
+                };
+                const __m512 n00 = _mm512_add_ps(flip(xf, 0), flip(yf, 1));
+                const __m512 n01 = _mm512_add_ps(flip(xf, 4), flip(yf1, 5));
+                const __m512 n10 = _mm512_add_ps(flip(xf1, 8), flip(yf, 9));
+                const __m512 n11 = _mm512_add_ps(flip(xf1, 12), flip(yf1, 13));
+                const __m512 xf3 = _mm512_mul_ps(_mm512_mul_ps(xf, xf), xf);
+                const __m512 u = _mm512_mul_ps(xf3, _mm512_add_ps(_mm512_mul_ps(xf, _mm512_sub_ps(_mm512_mul_ps(xf, six), fifteen)), ten));
+                const __m512 x1 = _mm512_add_ps(n00, _mm512_mul_ps(u, _mm512_sub_ps(n10, n00)));
+                const __m512 x2 = _mm512_add_ps(n01, _mm512_mul_ps(u, _mm512_sub_ps(n11, n01)));
+                const __m512 n = _mm512_add_ps(x1, _mm512_mul_ps(_mm512_set1_ps(r.v), _mm512_sub_ps(x2, x1)));
+                acc = _mm512_add_ps(acc, _mm512_mul_ps(_mm512_set1_ps(r.amplitude), n));
+            }
+            _mm512_storeu_ps(out + i, _mm512_mul_ps(acc, _mm512_set1_ps(inv_max)));
+        }
+    }
+#endif
+#if defined(__AVX2__)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f), six = _mm256_set1_ps(6.0f);
+        const __m256 fifteen = _mm256_set1_ps(15.0f), ten = _mm256_set1_ps(10.0f);
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i low8 = _mm256_set1_epi32(255);
+        const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+        for (; i + 8 <= count; i += 8) {
+            const __m256 px = _mm256_add_ps(_mm256_set1_ps(x0),
+                                            _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(i), lane)));
+            __m256 acc = _mm256_setzero_ps();
+            for (int o = 0; o < octaves; ++o) {
+                const OctaveRow& r = rows[o];
+                const __m256 x = _mm256_mul_ps(px, _mm256_set1_ps(r.step));
+                const __m256 fx = _mm256_floor_ps(x);
+                const __m256i code = _mm256_i32gather_epi32(r.codes, _mm256_and_si256(_mm256_cvtps_epi32(fx), low8), 4);
+                const __m256 xf = _mm256_sub_ps(x, fx), xf1 = _mm256_sub_ps(xf, one);
+                const __m256 yf = _mm256_set1_ps(r.yf), yf1 = _mm256_set1_ps(r.yf - 1.0f);
+                auto flip = [&](__m256 value, int bit) {
+                    return _mm256_castsi256_ps(_mm256_xor_si256(
+                        _mm256_castps_si256(value), _mm256_and_si256(_mm256_slli_epi32(code, 31 - bit), sign)));
+                };
+                const __m256 n00 = _mm256_add_ps(flip(xf, 0), flip(yf, 1));
+                const __m256 n01 = _mm256_add_ps(flip(xf, 4), flip(yf1, 5));
+                const __m256 n10 = _mm256_add_ps(flip(xf1, 8), flip(yf, 9));
+                const __m256 n11 = _mm256_add_ps(flip(xf1, 12), flip(yf1, 13));
+                const __m256 xf3 = _mm256_mul_ps(_mm256_mul_ps(xf, xf), xf);
+                const __m256 u = _mm256_mul_ps(xf3, _mm256_add_ps(_mm256_mul_ps(xf, _mm256_sub_ps(_mm256_mul_ps(xf, six), fifteen)), ten));
+                const __m256 x1 = _mm256_add_ps(n00, _mm256_mul_ps(u, _mm256_sub_ps(n10, n00)));
+                const __m256 x2 = _mm256_add_ps(n01, _mm256_mul_ps(u, _mm256_sub_ps(n11, n01)));
+                const __m256 n = _mm256_add_ps(x1, _mm256_mul_ps(_mm256_set1_ps(r.v), _mm256_sub_ps(x2, x1)));
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(r.amplitude), n));
+            }
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(acc, _mm256_set1_ps(inv_max)));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128 one = _mm_set1_ps(1.0f), six = _mm_set1_ps(6.0f);
+        const __m128 fifteen = _mm_set1_ps(15.0f), ten = _mm_set1_ps(10.0f);
+        const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i sign = _mm_set1_epi32(INT32_MIN);
+        alignas(16) int32_t cell[4];
+        alignas(16) int32_t codes[4];
+        for (; i + 4 <= count; i += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(x0), _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(i), lane)));
+            __m128 acc = _mm_setzero_ps();
+            for (int o = 0; o < octaves; ++o) {
+                const OctaveRow& r = rows[o];
+                const __m128 x = _mm_mul_ps(px, _mm_set1_ps(r.step));
+                // floor without SSE4.1: truncate, then step down where truncation went up
+                const __m128i t = _mm_cvttps_epi32(x);
+                const __m128 tf = _mm_cvtepi32_ps(t);
+                const __m128 fx = _mm_sub_ps(tf, _mm_and_ps(_mm_cmpgt_ps(tf, x), one));
+                _mm_store_si128(reinterpret_cast<__m128i*>(cell), _mm_cvttps_epi32(fx));
+                for (int k = 0; k < 4; ++k) codes[k] = r.codes[cell[k] & 255];
+                const __m128i code = _mm_load_si128(reinterpret_cast<const __m128i*>(codes));
+                const __m128 xf = _mm_sub_ps(x, fx), xf1 = _mm_sub_ps(xf, one);
+                const __m128 yf = _mm_set1_ps(r.yf), yf1 = _mm_set1_ps(r.yf - 1.0f);
+                auto flip = [&](__m128 value, int bit) {
+                    return _mm_castsi128_ps(_mm_xor_si128(
+                        _mm_castps_si128(value), _mm_and_si128(_mm_sll_epi32(code, _mm_cvtsi32_si128(31 - bit)), sign)));
+                };
+                const __m128 n00 = _mm_add_ps(flip(xf, 0), flip(yf, 1));
+                const __m128 n01 = _mm_add_ps(flip(xf, 4), flip(yf1, 5));
+                const __m128 n10 = _mm_add_ps(flip(xf1, 8), flip(yf, 9));
+                const __m128 n11 = _mm_add_ps(flip(xf1, 12), flip(yf1, 13));
+                const __m128 xf3 = _mm_mul_ps(_mm_mul_ps(xf, xf), xf);
+                const __m128 u = _mm_mul_ps(xf3, _mm_add_ps(_mm_mul_ps(xf, _mm_sub_ps(_mm_mul_ps(xf, six), fifteen)), ten));
+                const __m128 x1 = _mm_add_ps(n00, _mm_mul_ps(u, _mm_sub_ps(n10, n00)));
+                const __m128 x2 = _mm_add_ps(n01, _mm_mul_ps(u, _mm_sub_ps(n11, n01)));
+                const __m128 n = _mm_add_ps(x1, _mm_mul_ps(_mm_set1_ps(r.v), _mm_sub_ps(x2, x1)));
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(r.amplitude), n));
+            }
+            _mm_storeu_ps(out + i, _mm_mul_ps(acc, _mm_set1_ps(inv_max)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        const float px = x0 + static_cast<float>(i);
+        float acc = 0.0f;
+        for (int o = 0; o < octaves; ++o) acc += rows[o].amplitude * octave_sample(rows[o], px * rows[o].step);
+        out[i] = acc * inv_max;
+    }
+}
+
+void PerlinNoise::fractal_row_gradient(float x0, float y, int count, float scale, const FractalParams& params,
+                                       float* out, float* dx, float* dy) const {
+    if (count <= 0) return;
+    OctaveRow rows[MAX_OCTAVES];
+    float inv_max = 0.0f;
+    const int octaves = prepare_rows(perm_, x0, y, count, scale, params, rows, inv_max);
+
+    // n = lerp(v, lerp(u, n00, n10), lerp(u, n01, n11)) with n_ij = gx_ij (xf - i) + gy_ij (yf - j):
+    // dn/dx = lerp(v, lerp(u, gx00, gx10) + du (n10 - n00), lerp(u, gx01, gx11) + du (n11 - n01))
+    // dn/dy = lerp(v, lerp(u, gy00, gy10), lerp(u, gy01, gy11)) + dv (x2 - x1); each octave scaled by step
+    int i = 0;
+#if defined(__AVX512F__)
+    {
+        const __m512 one = _mm512_set1_ps(1.0f), two = _mm512_set1_ps(2.0f), six = _mm512_set1_ps(6.0f);
+        const __m512 fifteen = _mm512_set1_ps(15.0f), ten = _mm512_set1_ps(10.0f), thirty = _mm512_set1_ps(30.0f);
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i low8 = _mm512_set1_epi32(255);
+        const __m512i sign = _mm512_set1_epi32(INT32_MIN);
+        for (; i + 16 <= count; i += 16) {
+            const __m512 px = _mm512_add_ps(_mm512_set1_ps(x0),
+                                            _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(i), lane)));
+            __m512 acc = _mm512_setzero_ps(), acc_x = _mm512_setzero_ps(), acc_y = _mm512_setzero_ps();
+            for (int o = 0; o < octaves; ++o) {
+                const OctaveRow& r = rows[o];
+                const __m512 x = _mm512_mul_ps(px, _mm512_set1_ps(r.step));
+                const __m512 fx = _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+                const __m512i code = _mm512_i32gather_epi32(_mm512_and_si512(_mm512_cvtps_epi32(fx), low8), r.codes, 4);
+                const __m512 xf = _mm512_sub_ps(x, fx), xf1 = _mm512_sub_ps(xf, one);
+                const __m512 yf = _mm512_set1_ps(r.yf), yf1 = _mm512_set1_ps(r.yf - 1.0f);
+                auto flip = [&](__m512 value, int bit) {
+                    return _mm512_castsi512_ps(_mm512_xor_si512(
+                        _mm512_castps_si512(value), _mm512_and_si512(_mm512_slli_epi32(code, 31 - bit), sign)));
+                };
+                const __m512 gx00 = flip(one, 0), gy00 = flip(one, 1), gx01 = flip(one, 4), gy01 = flip(one, 5);
+                const __m512 gx10 = flip(one, 8), gy10 = flip(one, 9), gx11 = flip(one, 12), gy11 = flip(one, 13);
+                const __m512 n00 = _mm512_add_ps(flip(xf, 0), flip(yf, 1));
+                const __m512 n01 = _mm512_add_ps(flip(xf, 4), flip(yf1, 5));
+                const __m512 n10 = _mm512_add_ps(flip(xf1, 8), flip(yf, 9));
+                const __m512 n11 = _mm512_add_ps(flip(xf1, 12), flip(yf1, 13));
+                const __m512 xf2 = _mm512_mul_ps(xf, xf);
+                const __m512 xf3 = _mm512_mul_ps(xf2, xf);
+                const __m512 u = _mm512_mul_ps(xf3, _mm512_add_ps(_mm512_mul_ps(xf, _mm512_sub_ps(_mm512_mul_ps(xf, six), fifteen)), ten));
+                const __m512 du = _mm512_mul_ps(_mm512_mul_ps(thirty, xf2),
+                                                _mm512_add_ps(_mm512_mul_ps(xf, _mm512_sub_ps(xf, two)), one));
+                const __m512 v = _mm512_set1_ps(r.v);
+                const __m512 d0 = _mm512_sub_ps(n10, n00), d1 = _mm512_sub_ps(n11, n01);
+                const __m512 x1 = _mm512_add_ps(n00, _mm512_mul_ps(u, d0));
+                const __m512 x2 = _mm512_add_ps(n01, _mm512_mul_ps(u, d1));
+                const __m512 n = _mm512_add_ps(x1, _mm512_mul_ps(v, _mm512_sub_ps(x2, x1)));
+                const __m512 dx1 = _mm512_add_ps(_mm512_add_ps(gx00, _mm512_mul_ps(u, _mm512_sub_ps(gx10, gx00))), _mm512_mul_ps(du, d0));
+                const __m512 dx2 = _mm512_add_ps(_mm512_add_ps(gx01, _mm512_mul_ps(u, _mm512_sub_ps(gx11, gx01))), _mm512_mul_ps(du, d1));
+                const __m512 dy1 = _mm512_add_ps(gy00, _mm512_mul_ps(u, _mm512_sub_ps(gy10, gy00)));
+                const __m512 dy2 = _mm512_add_ps(gy01, _mm512_mul_ps(u, _mm512_sub_ps(gy11, gy01)));
+                const __m512 ndx = _mm512_add_ps(dx1, _mm512_mul_ps(v, _mm512_sub_ps(dx2, dx1)));
+                const __m512 ndy = _mm512_add_ps(_mm512_add_ps(dy1, _mm512_mul_ps(v, _mm512_sub_ps(dy2, dy1))),
+                                                 _mm512_mul_ps(_mm512_set1_ps(r.dv), _mm512_sub_ps(x2, x1)));
+                const __m512 amplitude = _mm512_set1_ps(r.amplitude);
+                const __m512 slope = _mm512_set1_ps(r.amplitude * r.step);
+                acc = _mm512_add_ps(acc, _mm512_mul_ps(amplitude, n));
+                acc_x = _mm512_add_ps(acc_x, _mm512_mul_ps(slope, ndx));
+                acc_y = _mm512_add_ps(acc_y, _mm512_mul_ps(slope, ndy));
+            }
+            const __m512 norm = _mm512_set1_ps(inv_max);
+            _mm512_storeu_ps(out + i, _mm512_mul_ps(acc, norm));
+            _mm512_storeu_ps(dx + i, _mm512_mul_ps(acc_x, norm));
+            _mm512_storeu_ps(dy + i, _mm512_mul_ps(acc_y, norm));
+        }
+    }
+#endif
+#if defined(__AVX2__)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f), six = _mm256_set1_ps(6.0f);
+        const __m256 fifteen = _mm256_set1_ps(15.0f), ten = _mm256_set1_ps(10.0f), thirty = _mm256_set1_ps(30.0f);
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i low8 = _mm256_set1_epi32(255);
+        const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+        for (; i + 8 <= count; i += 8) {
+            const __m256 px = _mm256_add_ps(_mm256_set1_ps(x0),
+                                            _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(i), lane)));
+            __m256 acc = _mm256_setzero_ps(), acc_x = _mm256_setzero_ps(), acc_y = _mm256_setzero_ps();
+            for (int o = 0; o < octaves; ++o) {
+                const OctaveRow& r = rows[o];
+                const __m256 x = _mm256_mul_ps(px, _mm256_set1_ps(r.step));
+                const __m256 fx = _mm256_floor_ps(x);
+                const __m256i code = _mm256_i32gather_epi32(r.codes, _mm256_and_si256(_mm256_cvtps_epi32(fx), low8), 4);
+                const __m256 xf = _mm256_sub_ps(x, fx), xf1 = _mm256_sub_ps(xf, one);
+                const __m256 yf = _mm256_set1_ps(r.yf), yf1 = _mm256_set1_ps(r.yf - 1.0f);
+                auto flip = [&](__m256 value, int bit) {
+                    return _mm256_castsi256_ps(_mm256_xor_si256(
+                        _mm256_castps_si256(value), _mm256_and_si256(_mm256_slli_epi32(code, 31 - bit), sign)));
+                };
+                const __m256 gx00 = flip(one, 0), gy00 = flip(one, 1), gx01 = flip(one, 4), gy01 = flip(one, 5);
+                const __m256 gx10 = flip(one, 8), gy10 = flip(one, 9), gx11 = flip(one, 12), gy11 = flip(one, 13);
+                const __m256 n00 = _mm256_add_ps(flip(xf, 0), flip(yf, 1));
+                const __m256 n01 = _mm256_add_ps(flip(xf, 4), flip(yf1, 5));
+                const __m256 n10 = _mm256_add_ps(flip(xf1, 8), flip(yf, 9));
+                const __m256 n11 = _mm256_add_ps(flip(xf1, 12), flip(yf1, 13));
+                const __m256 xf2 = _mm256_mul_ps(xf, xf);
+                const __m256 xf3 = _mm256_mul_ps(xf2, xf);
+                const __m256 u = _mm256_mul_ps(xf3, _mm256_add_ps(_mm256_mul_ps(xf, _mm256_sub_ps(_mm256_mul_ps(xf, six), fifteen)), ten));
+                const __m256 du = _mm256_mul_ps(_mm256_mul_ps(thirty, xf2),
+                                                _mm256_add_ps(_mm256_mul_ps(xf, _mm256_sub_ps(xf, two)), one));
+                const __m256 v = _mm256_set1_ps(r.v);
+                const __m256 d0 = _mm256_sub_ps(n10, n00), d1 = _mm256_sub_ps(n11, n01);
+                const __m256 x1 = _mm256_add_ps(n00, _mm256_mul_ps(u, d0));
+                const __m256 x2 = _mm256_add_ps(n01, _mm256_mul_ps(u, d1));
+                const __m256 n = _mm256_add_ps(x1, _mm256_mul_ps(v, _mm256_sub_ps(x2, x1)));
+                const __m256 dx1 = _mm256_add_ps(_mm256_add_ps(gx00, _mm256_mul_ps(u, _mm256_sub_ps(gx10, gx00))), _mm256_mul_ps(du, d0));
+                const __m256 dx2 = _mm256_add_ps(_mm256_add_ps(gx01, _mm256_mul_ps(u, _mm256_sub_ps(gx11, gx01))), _mm256_mul_ps(du, d1));
+                const __m256 dy1 = _mm256_add_ps(gy00, _mm256_mul_ps(u, _mm256_sub_ps(gy10, gy00)));
+                const __m256 dy2 = _mm256_add_ps(gy01, _mm256_mul_ps(u, _mm256_sub_ps(gy11, gy01)));
+                const __m256 ndx = _mm256_add_ps(dx1, _mm256_mul_ps(v, _mm256_sub_ps(dx2, dx1)));
+                const __m256 ndy = _mm256_add_ps(_mm256_add_ps(dy1, _mm256_mul_ps(v, _mm256_sub_ps(dy2, dy1))),
+                                                 _mm256_mul_ps(_mm256_set1_ps(r.dv), _mm256_sub_ps(x2, x1)));
+                const __m256 amplitude = _mm256_set1_ps(r.amplitude);
+                const __m256 slope = _mm256_set1_ps(r.amplitude * r.step);
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(amplitude, n));
+                acc_x = _mm256_add_ps(acc_x, _mm256_mul_ps(slope, ndx));
+                acc_y = _mm256_add_ps(acc_y, _mm256_mul_ps(slope, ndy));
+            }
+            const __m256 norm = _mm256_set1_ps(inv_max);
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(acc, norm));
+            _mm256_storeu_ps(dx + i, _mm256_mul_ps(acc_x, norm));
+            _mm256_storeu_ps(dy + i, _mm256_mul_ps(acc_y, norm));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), six = _mm_set1_ps(6.0f);
+        const __m128 fifteen = _mm_set1_ps(15.0f), ten = _mm_set1_ps(10.0f), thirty = _mm_set1_ps(30.0f);
+        const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i sign = _mm_set1_epi32(INT32_MIN);
+        alignas(16) int32_t cell[4];
+        alignas(16) int32_t codes[4];
+        for (; i + 4 <= count; i += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(x0), _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(i), lane)));
+            __m128 acc = _mm_setzero_ps(), acc_x = _mm_setzero_ps(), acc_y = _mm_setzero_ps();
+            for (int o = 0; o < octaves; ++o) {
+                const OctaveRow& r = rows[o];
+                const __m128 x = _mm_mul_ps(px, _mm_set1_ps(r.step));
+                const __m128 tf = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+                const __m128 fx = _mm_sub_ps(tf, _mm_and_ps(_mm_cmpgt_ps(tf, x), one));
+                _mm_store_si128(reinterpret_cast<__m128i*>(cell), _mm_cvttps_epi32(fx));
+                for (int k = 0; k < 4; ++k) codes[k] = r.codes[cell[k] & 255];
+                const __m128i code = _mm_load_si128(reinterpret_cast<const __m128i*>(codes));
+                const __m128 xf = _mm_sub_ps(x, fx), xf1 = _mm_sub_ps(xf, one);
+                const __m128 yf = _mm_set1_ps(r.yf), yf1 = _mm_set1_ps(r.yf - 1.0f);
+                auto flip = [&](__m128 value, int bit) {
+                    return _mm_castsi128_ps(_mm_xor_si128(
+                        _mm_castps_si128(value), _mm_and_si128(_mm_sll_epi32(code, _mm_cvtsi32_si128(31 - bit)), sign)));
+                };
+                const __m128 gx00 = flip(one, 0), gy00 = flip(one, 1), gx01 = flip(one, 4), gy01 = flip(one, 5);
+                const __m128 gx10 = flip(one, 8), gy10 = flip(one, 9), gx11 = flip(one, 12), gy11 = flip(one, 13);
+                const __m128 n00 = _mm_add_ps(flip(xf, 0), flip(yf, 1));
+                const __m128 n01 = _mm_add_ps(flip(xf, 4), flip(yf1, 5));
+                const __m128 n10 = _mm_add_ps(flip(xf1, 8), flip(yf, 9));
+                const __m128 n11 = _mm_add_ps(flip(xf1, 12), flip(yf1, 13));
+                const __m128 xf2 = _mm_mul_ps(xf, xf);
+                const __m128 xf3 = _mm_mul_ps(xf2, xf);
+                const __m128 u = _mm_mul_ps(xf3, _mm_add_ps(_mm_mul_ps(xf, _mm_sub_ps(_mm_mul_ps(xf, six), fifteen)), ten));
+                const __m128 du = _mm_mul_ps(_mm_mul_ps(thirty, xf2), _mm_add_ps(_mm_mul_ps(xf, _mm_sub_ps(xf, two)), one));
+                const __m128 v = _mm_set1_ps(r.v);
+                const __m128 d0 = _mm_sub_ps(n10, n00), d1 = _mm_sub_ps(n11, n01);
+                const __m128 x1 = _mm_add_ps(n00, _mm_mul_ps(u, d0));
+                const __m128 x2 = _mm_add_ps(n01, _mm_mul_ps(u, d1));
+                const __m128 n = _mm_add_ps(x1, _mm_mul_ps(v, _mm_sub_ps(x2, x1)));
+                const __m128 dx1 = _mm_add_ps(_mm_add_ps(gx00, _mm_mul_ps(u, _mm_sub_ps(gx10, gx00))), _mm_mul_ps(du, d0));
+                const __m128 dx2 = _mm_add_ps(_mm_add_ps(gx01, _mm_mul_ps(u, _mm_sub_ps(gx11, gx01))), _mm_mul_ps(du, d1));
+                const __m128 dy1 = _mm_add_ps(gy00, _mm_mul_ps(u, _mm_sub_ps(gy10, gy00)));
+                const __m128 dy2 = _mm_add_ps(gy01, _mm_mul_ps(u, _mm_sub_ps(gy11, gy01)));
+                const __m128 ndx = _mm_add_ps(dx1, _mm_mul_ps(v, _mm_sub_ps(dx2, dx1)));
+                const __m128 ndy = _mm_add_ps(_mm_add_ps(dy1, _mm_mul_ps(v, _mm_sub_ps(dy2, dy1))),
+                                              _mm_mul_ps(_mm_set1_ps(r.dv), _mm_sub_ps(x2, x1)));
+                const __m128 slope = _mm_set1_ps(r.amplitude * r.step);
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(r.amplitude), n));
+                acc_x = _mm_add_ps(acc_x, _mm_mul_ps(slope, ndx));
+                acc_y = _mm_add_ps(acc_y, _mm_mul_ps(slope, ndy));
+            }
+            const __m128 norm = _mm_set1_ps(inv_max);
+            _mm_storeu_ps(out + i, _mm_mul_ps(acc, norm));
+            _mm_storeu_ps(dx + i, _mm_mul_ps(acc_x, norm));
+            _mm_storeu_ps(dy + i, _mm_mul_ps(acc_y, norm));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        const float px = x0 + static_cast<float>(i);
+        float acc = 0.0f, acc_x = 0.0f, acc_y = 0.0f;
+        for (int o = 0; o < octaves; ++o) {
+            float sx = 0.0f, sy = 0.0f;
+            acc += rows[o].amplitude * octave_sample_gradient(rows[o], px * rows[o].step, sx, sy);
+            acc_x += rows[o].amplitude * rows[o].step * sx;
+            acc_y += rows[o].amplitude * rows[o].step * sy;
+        }
+        out[i] = acc * inv_max;
+        dx[i] = acc_x * inv_max;
+        dy[i] = acc_y * inv_max;
+    }
+}
+
+float PerlinNoise::noise3(float x, float y, float z) const {
+    const float fx = std::floor(x), fy = std::floor(y), fz = std::floor(z);
+    const int xi = static_cast<int>(fx) & 255, yi = static_cast<int>(fy) & 255, zi = static_cast<int>(fz) & 255;
+    const float xf = x - fx, yf = y - fy, zf = z - fz;
+    auto grad = [](int hash, float gx, float gy, float gz) {
+        return signed_by(gx, hash & 1) + signed_by(gy, hash & 2) + signed_by(gz, hash & 4);
+    };
+    auto lerp = [](float t, float a, float b) { return a + t * (b - a); };
+    const int a = perm_[xi] + yi, aa = perm_[a] + zi, ab = perm_[a + 1] + zi;
+    const int b = perm_[xi + 1] + yi, ba = perm_[b] + zi, bb = perm_[b + 1] + zi;
+    const float u = fade(xf), v = fade(yf), w = fade(zf);
+    const float near = lerp(v, lerp(u, grad(perm_[aa], xf, yf, zf), grad(perm_[ba], xf - 1.0f, yf, zf)),
+                            lerp(u, grad(perm_[ab], xf, yf - 1.0f, zf), grad(perm_[bb], xf - 1.0f, yf - 1.0f, zf)));
+    const float far = lerp(v, lerp(u, grad(perm_[aa + 1], xf, yf, zf - 1.0f), grad(perm_[ba + 1], xf - 1.0f, yf, zf - 1.0f)),
+                           lerp(u, grad(perm_[ab + 1], xf, yf - 1.0f, zf - 1.0f),
+                                grad(perm_[bb + 1], xf - 1.0f, yf - 1.0f, zf - 1.0f)));
+    return NOISE3_SCALE * lerp(w, near, far);
+}
+
+float PerlinNoise::fractal3(float x, float y, float z, const FractalParams& params) const {
+    float result = 0.0f, amplitude = 1.0f, frequency = 1.0f, max_value = 0.0f;
+    for (int i = 0; i < std::min(params.octaves, MAX_OCTAVES); ++i) {
+        result += amplitude * noise3(x * frequency, y * frequency, z * frequency);
+        max_value += amplitude;
+        amplitude *= params.persistence;
+        frequency *= params.lacunarity;
+    }
+    return max_value > 0.0f ? result / max_value : 0.0f;
+}
+
+void PerlinNoise::fractal_row_3d(float x0, float y, float z, int count, float scale, const FractalParams& params,
+                                 float* out, float* dx, float* dy) const {
+    if (count <= 0) return;
+    const bool gradient = dx && dy;
+    std::fill(out, out + count, 0.0f);
+    if (gradient) {
+        std::fill(dx, dx + count, 0.0f);
+        std::fill(dy, dy + count, 0.0f);
+    }
+    const int octaves = std::max(0, std::min(params.octaves, MAX_OCTAVES));
+    float max_value = 0.0f, amplitude = 1.0f;
+    for (int o = 0; o < octaves; ++o, amplitude *= params.persistence) max_value += amplitude;
+    if (octaves == 0) return;
+
+    // Octave by octave into the output: one slice table live at a time, and a row segment stays in L1
+    OctaveSlice slice;
+    amplitude = 1.0f;
+    float frequency = 1.0f;
+    for (int o = 0; o < octaves; ++o) {
+        slice.step = scale * frequency;
+        build_octave_slice(perm_, static_cast<double>(y) * scale, z, frequency, x0, x0 + (count - 1), gradient, slice);
+        accumulate_slice(slice, x0, count, amplitude / max_value, out, gradient ? dx : nullptr, gradient ? dy : nullptr);
+        amplitude *= params.persistence;
+        frequency *= params.lacunarity;
+    }
+}
+
+const char* PerlinNoise::simd_path() {
+#if defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace cpp_engine::generators
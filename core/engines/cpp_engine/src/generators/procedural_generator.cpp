@@ -0,0 +1,185 @@
+// generators/procedural_generator.cpp
+#include "generators/procedural_generator.h"
+#include "generators/noise_atlas.h"
+#include "generators/perlin_noise.h"
+#include "generators/simplex_noise.h"
+#include "generators/texture_kernels.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace cpp_engine::generators {
+
+namespace {
+
+// Settings of the original single-threaded generators
+constexpr float PERLIN_SCALE = 0.01f;
+constexpr FractalParams PERLIN_FRACTAL{4, 0.5f, 2.0f};
+constexpr float SILHOUETTE_SCALE = 0.015f;
+constexpr FractalParams SILHOUETTE_FRACTAL{5, 0.6f, 2.0f};
+constexpr double CANNY_LOW = 50.0, CANNY_HIGH = 150.0;
+
+struct Tile {
+    int x_begin, x_end, y_begin, y_end;
+};
+
+/**
+ * Runs fn(tile, scratch) over every tile on the shared pool
+ * Tile geometry depends only on the canvas and tile size, never on the
+ * number of threads, and tiles write disjoint pixels.
+ */
+template <typename Fn>
+void for_each_tile(int width, int height, int tile_size, size_t scratch_floats, Fn fn) {
+    const int tiles_x = (width + tile_size - 1) / tile_size;
+    const int tiles_y = (height + tile_size - 1) / tile_size;
+    const int tiles = tiles_x * tiles_y;
+    cv::parallel_for_(cv::Range(0, tiles), [&](const cv::Range& range) {
+        std::vector<float> scratch(scratch_floats);
+        for (int t = range.start; t < range.end; ++t) {
+            Tile tile;
+            tile.x_begin = (t % tiles_x) * tile_size;
+            tile.y_begin = (t / tiles_x) * tile_size;
+            tile.x_end = std::min(width, tile.x_begin + tile_size);
+            tile.y_end = std::min(height, tile.y_begin + tile_size);
+            fn(tile, scratch.data());
+        }
+    }, tiles);
+}
+
+} // namespace
+
+ProceduralGenerator::ProceduralGenerator(const ProceduralOptions& options) : options_(options) {
+    options_.tile_size = std::max(16, options_.tile_size);
+}
+
+int ProceduralGenerator::tile_count(int width, int height) const {
+    const int t = options_.tile_size;
+    return ((width + t - 1) / t) * ((height + t - 1) / t);
+}
+
+bool ProceduralGenerator::generate(ProceduralKind kind, int width, int height, unsigned int seed,
+                                   cv::Mat& out) const {
+    if (options_.noise == NoiseBackend::SIMPLEX) {
+        const SimplexNoise noise(seed);
+        return render(kind, width, height, NoiseField(noise), out);
+    }
+    const PerlinNoise noise(seed);
+    std::shared_ptr<const NoiseAtlas> atlas;
+    if (options_.atlas && kind != ProceduralKind::METALLIC) {
+        const bool perlin = kind == ProceduralKind::PERLIN;
+        const FractalParams& fractal = perlin ? PERLIN_FRACTAL : SILHOUETTE_FRACTAL;
+        // A failed build is logged by the store; the noise is then evaluated as usual
+        atlas = options_.atlas->get({seed, fractal.octaves, fractal.persistence,
+                                     perlin ? PERLIN_SCALE : SILHOUETTE_SCALE});
+    }
+    return render(kind, width, height, NoiseField(noise, atlas.get()), out);
+}
+
+bool ProceduralGenerator::generate_frame(ProceduralKind kind, int width, int height, const PerlinNoise& noise,
+                                         float time, cv::Mat& out) const {
+    return render(kind, width, height, NoiseField(noise, time), out);
+}
+
+bool ProceduralGenerator::render(ProceduralKind kind, int width, int height, const NoiseField& field,
+                                 cv::Mat& out) const {
+    if (width <= 0 || height <= 0) {
+        utils::Logger::instance().error("ProceduralGenerator: invalid size " + std::to_string(width) + "x" +
+                                        std::to_string(height));
+        return false;
+    }
+    const int tile_size = options_.tile_size;
+    out.create(height, width, CV_8UC3);
+
+    switch (kind) {
+    case ProceduralKind::PERLIN:
+        // The old hue cycle went through HSV; a gray pixel has no saturation, so the cycle is the identity
+        for_each_tile(width, height, tile_size, tile_size, [&](const Tile& tile, float* scratch) {
+            for (int y = tile.y_begin; y < tile.y_end; ++y) {
+                kernels::gray_row(field, PERLIN_SCALE, PERLIN_FRACTAL, y, tile.x_begin, tile.x_end, 3,
+                                  out.ptr<uint8_t>(y) + 3 * tile.x_begin, scratch);
+            }
+        });
+        return true;
+
+    case ProceduralKind::SILHOUETTE: {
+        cv::Mat base(height, width, CV_8UC1), edges;
+        for_each_tile(width, height, tile_size, tile_size, [&](const Tile& tile, float* scratch) {
+            for (int y = tile.y_begin; y < tile.y_end; ++y) {
+                kernels::gray_row(field, SILHOUETTE_SCALE, SILHOUETTE_FRACTAL, y, tile.x_begin, tile.x_end, 1,
+                                  base.ptr<uint8_t>(y) + tile.x_begin, scratch);
+            }
+        });
+        cv::Canny(base, edges, CANNY_LOW, CANNY_HIGH);
+        for_each_tile(width, height, tile_size, 0, [&](const Tile& tile, float*) {
+            for (int y = tile.y_begin; y < tile.y_end; ++y) {
+                const uint8_t* above = y > 0 ? edges.ptr<uint8_t>(y - 1) : nullptr;
+                const uint8_t* below = y + 1 < height ? edges.ptr<uint8_t>(y + 1) : nullptr;
+                kernels::silhouette_row(above, edges.ptr<uint8_t>(y), below, tile.x_begin, tile.x_end, width,
+                                        out.ptr<uint8_t>(y) + 3 * tile.x_begin);
+            }
+        });
+        return true;
+    }
+
+    case ProceduralKind::METALLIC: {
+        const MetallicParams params;
+        for_each_tile(width, height, tile_size, 3 * static_cast<size_t>(tile_size), [&](const Tile& tile,
+                                                                                       float* scratch) {
+            for (int y = tile.y_begin; y < tile.y_end; ++y) {
+                kernels::metallic_row(field, params, y, tile.x_begin, tile.x_end, width, height,
+                                      out.ptr<uint8_t>(y) + 3 * tile.x_begin, scratch);
+            }
+        });
+        return true;
+    }
+    }
+    return false;
+}
+
+bool ProceduralGenerator::parse_kind(const std::string& name, ProceduralKind& kind) {
+    std::string base = name;
+    const std::string suffix = "_video";
+    if (base.size() > suffix.size() && base.compare(base.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        base.resize(base.size() - suffix.size());
+    }
+    if (base == "perlin") {
+        kind = ProceduralKind::PERLIN;
+    } else if (base == "silhouette") {
+        kind = ProceduralKind::SILHOUETTE;
+    } else if (base == "metallic") {
+        kind = ProceduralKind::METALLIC;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* ProceduralGenerator::kind_name(ProceduralKind kind) {
+    switch (kind) {
+    case ProceduralKind::PERLIN: return "perlin";
+    case ProceduralKind::SILHOUETTE: return "silhouette";
+    case ProceduralKind::METALLIC: return "metallic";
+    }
+    return "unknown";
+}
+
+bool ProceduralGenerator::parse_backend(const std::string& name, NoiseBackend& backend) {
+    if (name == "perlin") {
+        backend = NoiseBackend::PERLIN;
+    } else if (name == "simplex") {
+        backend = NoiseBackend::SIMPLEX;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* ProceduralGenerator::backend_name(NoiseBackend backend) {
+    return backend == NoiseBackend::SIMPLEX ? "simplex" : "perlin";
+}
+
+} // namespace cpp_engine::generators
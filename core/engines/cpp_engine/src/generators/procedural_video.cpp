@@ -0,0 +1,162 @@
+// generators/procedural_video.cpp
+#include "generators/procedural_video.h"
+#include "generators/perlin_noise.h"
+#include "generators/simplex_noise.h"
+#include "generators/texture_kernels.h"
+#include "optimization/bounded_queue.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cpp_engine::generators {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+constexpr double TWO_PI = 6.283185307179586;
+
+// Both backends of one seed; a frame samples the one the options ask for
+struct VideoNoise {
+    explicit VideoNoise(unsigned int seed) : perlin(seed), simplex(seed) {}
+
+    PerlinNoise perlin;
+    SimplexNoise simplex;
+};
+
+NoiseField frame_field(const ProceduralVideoOptions& options, const VideoNoise& noise, int index) {
+    if (options.loop_frames > 0) {
+        const double angle = TWO_PI * (index % options.loop_frames) / options.loop_frames;
+        const double radius = options.loop_frames * static_cast<double>(options.time_step) / TWO_PI;
+        return NoiseField(noise.simplex, static_cast<float>(radius * std::cos(angle)),
+                          static_cast<float>(radius * std::sin(angle)));
+    }
+    const float time = static_cast<float>(index * static_cast<double>(options.time_step));
+    if (options.tiles.noise == NoiseBackend::SIMPLEX) return NoiseField(noise.simplex, time);
+    return NoiseField(noise.perlin, time);
+}
+
+} // namespace
+
+double ProceduralVideo::Stats::fps() const {
+    return seconds > 0.0 ? frames / seconds : 0.0;
+}
+
+ProceduralVideo::ProceduralVideo(const ProceduralVideoOptions& options) : options_(options) {
+    if (options_.render_threads <= 0) {
+        options_.render_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    if (options_.max_frames_in_flight <= 0) options_.max_frames_in_flight = 2 * options_.render_threads;
+    options_.max_frames_in_flight = std::max(options_.max_frames_in_flight, options_.render_threads);
+}
+
+bool ProceduralVideo::render_frame(ProceduralKind kind, int width, int height, unsigned int seed, int index,
+                                   cv::Mat& out) const {
+    const VideoNoise noise(seed);
+    return ProceduralGenerator(options_.tiles).render(kind, width, height, frame_field(options_, noise, index), out);
+}
+
+bool ProceduralVideo::render(ProceduralKind kind, int width, int height, int frames, unsigned int seed,
+                             const FrameSink& sink) {
+    stats_ = Stats();
+    if (width <= 0 || height <= 0 || frames < 0) {
+        utils::Logger::instance().error("ProceduralVideo: invalid size or frame count");
+        return false;
+    }
+    const auto start = Clock::now();
+    const VideoNoise noise(seed);  // one permutation for the whole video
+    const ProceduralGenerator generator(options_.tiles);
+    const int window = options_.max_frames_in_flight;
+    const int threads = std::min(options_.render_threads, std::max(1, frames));
+
+    cppengine::optimization::BoundedQueue<std::pair<int, cv::Mat>> rendered(static_cast<size_t>(window));
+    std::atomic<int> next_frame{0};
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    std::condition_variable delivered_cv;
+    int delivered = 0;
+    bool stop = false;
+    double render_ms = 0.0;
+
+    auto render_loop = [&] {
+        double busy_ms = 0.0;
+        for (;;) {
+            const int index = next_frame.fetch_add(1);
+            if (index >= frames) break;
+            {
+                // Stay within the window so the reorder buffer cannot grow behind a slow frame
+                std::unique_lock<std::mutex> lock(mutex);
+                delivered_cv.wait(lock, [&] { return stop || index < delivered + window; });
+                if (stop) break;
+            }
+            const auto frame_start = Clock::now();
+            cv::Mat frame;
+            if (!generator.render(kind, width, height, frame_field(options_, noise, index), frame)) {
+                failed = true;
+                rendered.close();
+                break;
+            }
+            busy_ms += elapsed_ms(frame_start);
+            if (!rendered.push({index, std::move(frame)})) break;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        render_ms += busy_ms;
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) workers.emplace_back(render_loop);
+
+    // Encoder side: reorder, then deliver in sequence
+    std::map<int, cv::Mat> pending;
+    bool sink_stopped = false;
+    std::pair<int, cv::Mat> item;
+    while (stats_.frames < frames && !sink_stopped && rendered.pop(item)) {
+        pending.emplace(item.first, std::move(item.second));
+        for (auto it = pending.find(stats_.frames); it != pending.end(); it = pending.find(stats_.frames)) {
+            const auto sink_start = Clock::now();
+            const bool keep_going = sink(it->first, it->second);
+            stats_.sink_ms += elapsed_ms(sink_start);
+            pending.erase(it);
+            ++stats_.frames;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                delivered = stats_.frames;
+            }
+            delivered_cv.notify_all();
+            if (!keep_going) {
+                sink_stopped = true;
+                break;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    delivered_cv.notify_all();
+    rendered.close();
+    for (auto& worker : workers) worker.join();
+
+    stats_.render_ms = render_ms;
+    stats_.seconds = elapsed_ms(start) / 1000.0;
+    if (failed) utils::Logger::instance().error("ProceduralVideo: frame rendering failed");
+    return !failed && !sink_stopped && stats_.frames == frames;
+}
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,582 @@
+// generators/reference_catalog.cpp
+#include "generators/reference_catalog.h"
+#include "filters/resample.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cpp_engine::generators {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char INDEX_MAGIC[4] = {'R', 'C', 'A', 'T'};
+constexpr uint32_t INDEX_VERSION = 1;
+constexpr const char* INDEX_NAME = ".reference_index";
+constexpr int HASH_WIDTH = 9;  // 8 horizontal differences per row
+constexpr int HASH_HEIGHT = 8;
+constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF |
+                                IN_MOVE_SELF | IN_ONLYDIR;
+constexpr size_t EVENT_BUFFER = 64 * 1024;
+constexpr int SCAN_ATTEMPTS = 3;  // scans redone when watch events land during them
+
+bool is_reference_name(const std::string& name) {
+    const size_t dot = name.rfind('.');
+    if (dot == std::string::npos) return false;
+    std::string ext = name.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp";
+}
+
+// A search name is one plain path component: nothing that could reach outside the root
+bool is_folder_name(const std::string& name) {
+    return !name.empty() && name != "." && name != ".." && name.find('/') == std::string::npos &&
+           name.find('\0') == std::string::npos;
+}
+
+int64_t mtime_ns(const struct stat& st) {
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+bool stat_regular(const std::string& path, ReferenceImage& image) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return false;
+    image.mtime_ns = mtime_ns(st);
+    image.bytes = static_cast<uint64_t>(st.st_size);
+    return true;
+}
+
+int64_t directory_mtime(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode) ? mtime_ns(st) : -1;
+}
+
+// Width/height of a BMP from its DIB header; height is negative for top-down rows
+bool read_bmp_size(const std::vector<unsigned char>& bytes, int& width, int& height) {
+    if (bytes.size() < 26 || bytes[0] != 'B' || bytes[1] != 'M') return false;
+    int32_t w, h;
+    std::memcpy(&w, &bytes[18], sizeof(w));
+    std::memcpy(&h, &bytes[22], sizeof(h));
+    width = w;
+    height = h < 0 ? -h : h;
+    return width > 0 && height > 0;
+}
+
+// Little-endian fields, as on every platform this engine builds for
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void put_string(std::string& out, const std::string& value) {
+    put(out, static_cast<uint16_t>(value.size()));
+    out.append(value);
+}
+
+class Reader {
+public:
+    explicit Reader(const std::string& data) : data_(data) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (data_.size() - pos_ < sizeof(T)) return false;
+        std::memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool get_string(std::string& value) {
+        uint16_t size = 0;
+        if (!get(size) || data_.size() - pos_ < size) return false;
+        value.assign(data_, pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    bool done() const { return pos_ == data_.size(); }
+
+private:
+    const std::string& data_;
+    size_t pos_ = 0;
+};
+
+struct FolderScan {
+    std::unordered_map<std::string, ReferenceImage> files;  // by file name
+    int probed = 0;
+};
+
+// Reference files of a folder: the entries of unchanged files are kept, the rest probed in parallel
+FolderScan scan_folder(const std::string& path, const std::unordered_map<std::string, ReferenceImage>& known) {
+    FolderScan scan;
+    std::vector<ReferenceImage*> pending;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(path, ec)) {
+        const std::string file = entry.path().filename().string();
+        if (!is_reference_name(file)) continue;
+        ReferenceImage image;
+        image.path = entry.path().string();
+        if (!stat_regular(image.path, image)) continue;
+        const auto found = known.find(file);
+        if (found != known.end() && found->second.mtime_ns == image.mtime_ns && found->second.bytes == image.bytes) {
+            scan.files.emplace(file, found->second);
+            continue;
+        }
+        pending.push_back(&scan.files.emplace(file, image).first->second);
+    }
+    std::vector<unsigned char> readable(pending.size(), 0);
+    cv::parallel_for_(cv::Range(0, static_cast<int>(pending.size())), [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; ++i) readable[i] = ReferenceCatalog::probe(pending[i]->path, *pending[i]);
+    });
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (readable[i]) continue;
+        utils::Logger::instance().debug("ReferenceCatalog: skipping unreadable " + pending[i]->path);
+        scan.files.erase(fs::path(pending[i]->path).filename().string());
+    }
+    scan.probed = static_cast<int>(pending.size());
+    return scan;
+}
+
+} // namespace
+
+ReferenceCatalog::ReferenceCatalog(const ReferenceCatalogOptions& options) : options_(options) {
+    if (options_.index_path.empty()) options_.index_path = (fs::path(options_.root) / INDEX_NAME).string();
+    load();
+    if (!options_.watch) return;
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0 || ::pipe2(wake_fds_, O_NONBLOCK | O_CLOEXEC) != 0) {
+        utils::Logger::instance().warning("ReferenceCatalog: inotify unavailable (" + std::string(std::strerror(errno)) +
+                                          "), folders are checked on every lookup");
+        if (inotify_fd_ >= 0) ::close(inotify_fd_);
+        inotify_fd_ = -1;
+        return;
+    }
+    watcher_ = std::thread(&ReferenceCatalog::watch_loop, this);
+}
+
+ReferenceCatalog::~ReferenceCatalog() {
+    if (watcher_.joinable()) {
+        const char stop = 1;
+        (void)!::write(wake_fds_[1], &stop, 1);
+        watcher_.join();
+    }
+    for (int fd : {inotify_fd_, wake_fds_[0], wake_fds_[1]}) {
+        if (fd >= 0) ::close(fd);
+    }
+    bool dirty = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dirty = dirty_;
+    }
+    if (dirty) save();
+}
+
+ReferenceCatalog& ReferenceCatalog::shared() {
+    // Never destroyed: outlives every static that might still look images up at exit. Its watcher
+    // saves changes after options.save_delay_ms, scans save right away
+    static ReferenceCatalog* catalog = new ReferenceCatalog();
+    return *catalog;
+}
+
+std::string ReferenceCatalog::folder_path(const std::string& name) const {
+    return (fs::path(options_.root) / name).string();
+}
+
+ReferenceCatalog::Images ReferenceCatalog::images(const std::string& name) {
+    static const Images none = std::make_shared<const std::vector<ReferenceImage>>();
+    if (!is_folder_name(name)) return none;
+    const std::string path = folder_path(name);
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool raced = false;
+    for (int attempt = 1;; ++attempt) {
+        // Watched folders are current once verified; the others are checked against the directory,
+        // which is stat'ed, listed and probed without the lock
+        const auto found = folders_.find(name);
+        if (found != folders_.end() && found->second.verified && found->second.watch >= 0) {
+            return snapshot_locked(found->second);
+        }
+        lock.unlock();
+        const int64_t mtime = directory_mtime(path);
+        lock.lock();
+        if (mtime < 0) {
+            forget_locked(name);
+            return none;
+        }
+        Folder& folder = folders_[name];
+        // Watch before listing, so nothing changing during the scan is missed
+        watch_locked(name, folder);
+        // After a raced scan the stored mtime may be the watcher's, covering only its own events
+        if (!raced && mtime == folder.dir_mtime_ns) {
+            folder.verified = true;
+            return snapshot_locked(folder);
+        }
+        const auto known = folder.files;
+        const uint64_t generation = folder.generation;
+        lock.unlock();
+        FolderScan scan = scan_folder(path, known);
+        lock.lock();
+
+        const auto it = folders_.find(name);
+        if (it == folders_.end()) continue;  // gone meanwhile
+        Folder& current = it->second;
+        raced = current.generation != generation;
+        if (raced && attempt < SCAN_ATTEMPTS) continue;  // redo from the entries the watcher updated
+        current.files = std::move(scan.files);
+        current.snapshot.reset();
+        current.dir_mtime_ns = mtime;
+        current.verified = !raced;  // still racing: rescanned on the next lookup
+        ++current.generation;
+        dirty_ = true;
+        ++stats_.folders_scanned;
+        stats_.images_probed += scan.probed;
+        Images images = snapshot_locked(current);
+        lock.unlock();
+        save();
+        return images;
+    }
+}
+
+ReferenceCatalog::Images ReferenceCatalog::snapshot_locked(Folder& folder) {
+    if (!folder.snapshot) {
+        auto images = std::make_shared<std::vector<ReferenceImage>>();
+        images->reserve(folder.files.size());
+        for (const auto& entry : folder.files) images->push_back(entry.second);
+        std::sort(images->begin(), images->end(),
+                  [](const ReferenceImage& a, const ReferenceImage& b) { return a.path < b.path; });
+        folder.snapshot = std::move(images);
+    }
+    return folder.snapshot;
+}
+
+void ReferenceCatalog::watch_locked(const std::string& name, Folder& folder) {
+    if (inotify_fd_ < 0 || folder.watch >= 0) return;
+    const std::string path = folder_path(name);
+    folder.watch = ::inotify_add_watch(inotify_fd_, path.c_str(), WATCH_MASK);
+    if (folder.watch >= 0) {
+        watched_[folder.watch] = name;
+    } else if (errno != ENOENT) {
+        utils::Logger::instance().warning("ReferenceCatalog: cannot watch " + path + " (" +
+                                          std::strerror(errno) + "), checked on every lookup");
+    }
+}
+
+// Drops a folder that no longer exists, so lookups of unknown names leave nothing behind
+void ReferenceCatalog::forget_locked(const std::string& name) {
+    const auto it = folders_.find(name);
+    if (it == folders_.end()) return;
+    if (it->second.watch >= 0) {
+        ::inotify_rm_watch(inotify_fd_, it->second.watch);
+        watched_.erase(it->second.watch);
+    }
+    if (it->second.dir_mtime_ns >= 0) dirty_ = true;
+    folders_.erase(it);
+}
+
+void ReferenceCatalog::watch_loop() {
+    struct Change {
+        int watch;
+        std::string file;
+        bool removed;
+        ReferenceImage image;
+    };
+    alignas(struct inotify_event) char buffer[EVENT_BUFFER];
+    pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}};
+    // Changes are saved save_delay_ms after the first unsaved one, together with those that follow
+    bool save_pending = false;
+    std::chrono::steady_clock::time_point save_at;
+    for (;;) {
+        int timeout = -1;
+        if (save_pending) {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(save_at -
+                                                                                    std::chrono::steady_clock::now());
+            timeout = static_cast<int>(std::max<int64_t>(0, left.count()));
+        }
+        const int ready = ::poll(fds, 2, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents) break;
+        if (ready == 0) {
+            save_pending = false;
+            save();
+            continue;
+        }
+
+        std::vector<Change> changes;
+        std::vector<int> gone;
+        bool overflow = false;
+        for (ssize_t n; (n = ::read(inotify_fd_, buffer, sizeof(buffer))) > 0;) {
+            for (char* p = buffer; p < buffer + n;) {
+                const auto* event = reinterpret_cast<const struct inotify_event*>(p);
+                p += sizeof(struct inotify_event) + event->len;
+                if (event->mask & IN_Q_OVERFLOW) {
+                    overflow = true;
+                } else if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                    gone.push_back(event->wd);
+                } else if (event->len > 0 && !(event->mask & IN_ISDIR) && is_reference_name(event->name)) {
+                    changes.push_back({event->wd, event->name, (event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0,
+                                       ReferenceImage()});
+                }
+            }
+        }
+
+        // Probe new and rewritten files without holding the lock
+        std::vector<std::string> folders(changes.size());
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < changes.size(); ++i) {
+                const auto it = watched_.find(changes[i].watch);
+                if (it != watched_.end()) folders[i] = it->second;
+            }
+        }
+        for (size_t i = 0; i < changes.size(); ++i) {
+            Change& change = changes[i];
+            if (change.removed || folders[i].empty()) continue;
+            change.image.path = (fs::path(folder_path(folders[i])) / change.file).string();
+            // Gone again or not an image: drop any entry of that name
+            change.removed = !stat_regular(change.image.path, change.image) || !probe(change.image.path, change.image);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < changes.size(); ++i) {
+            const auto folder = folders_.find(folders[i]);
+            if (folders[i].empty() || folder == folders_.end() || folder->second.watch != changes[i].watch) continue;
+            Folder& f = folder->second;
+            if (changes[i].removed) {
+                f.files.erase(changes[i].file);
+            } else {
+                f.files[changes[i].file] = std::move(changes[i].image);
+                ++stats_.images_probed;
+            }
+            f.snapshot.reset();
+            ++f.generation;
+            // Stat after the change: anything still queued moves the directory mtime past this one.
+            // Only for a reconciled folder: otherwise the mtime would vouch for entries never listed
+            if (f.verified) f.dir_mtime_ns = directory_mtime(folder_path(folders[i]));
+            dirty_ = true;
+            ++stats_.events;
+        }
+        for (int watch : gone) {
+            const auto it = watched_.find(watch);
+            if (it == watched_.end()) continue;
+            ::inotify_rm_watch(inotify_fd_, watch);  // a moved folder would stay watched under its old name
+            const auto folder = folders_.find(it->second);
+            if (folder != folders_.end() && folder->second.watch == watch) {
+                folder->second.watch = -1;
+                folder->second.verified = false;
+                ++folder->second.generation;
+            }
+            watched_.erase(it);
+        }
+        if (overflow) {
+            // Events were lost: rescan every folder on its next lookup, reusing unchanged entries
+            utils::Logger::instance().warning("ReferenceCatalog: inotify queue overflowed, rescanning on lookup");
+            for (auto& entry : folders_) {
+                entry.second.verified = false;
+                entry.second.dir_mtime_ns = -1;
+                ++entry.second.generation;
+            }
+        }
+        if (dirty_ && !save_pending) {
+            save_pending = true;
+            save_at = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.save_delay_ms);
+        }
+    }
+}
+
+bool ReferenceCatalog::probe(const std::string& path, ReferenceImage& image) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const std::streamsize size = in.tellg();
+    if (size <= 0) return false;
+    std::vector<unsigned char> bytes(static_cast<size_t>(size));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(bytes.data()), size)) return false;
+
+    int width = 0, height = 0;
+    ReferenceFormat format = ReferenceFormat::UNKNOWN;
+    if (cppengine::filters::read_jpeg_size(bytes.data(), bytes.size(), width, height)) {
+        format = ReferenceFormat::JPEG;
+        // Size as displayed (and decoded): transposed EXIF orientations swap it
+        if (cppengine::filters::read_jpeg_orientation(bytes.data(), bytes.size()) >= 5) std::swap(width, height);
+    } else if (cppengine::filters::read_png_size(bytes.data(), bytes.size(), width, height)) {
+        format = ReferenceFormat::PNG;
+    } else if (read_bmp_size(bytes, width, height)) {
+        format = ReferenceFormat::BMP;
+    }
+
+    // The hash only needs a thumbnail: JPEGs decode at 1/8 scale when that still covers it
+    int flags = cv::IMREAD_GRAYSCALE;
+    if (format == ReferenceFormat::JPEG) {
+        switch (cppengine::filters::reduced_decode_factor(width, height, HASH_WIDTH, HASH_HEIGHT)) {
+            case 8: flags = cv::IMREAD_REDUCED_GRAYSCALE_8; break;
+            case 4: flags = cv::IMREAD_REDUCED_GRAYSCALE_4; break;
+            case 2: flags = cv::IMREAD_REDUCED_GRAYSCALE_2; break;
+            default: break;
+        }
+    }
+    cv::Mat gray;
+    try {
+        gray = cv::imdecode(bytes, flags);
+    } catch (const cv::Exception&) {
+        return false;
+    }
+    if (gray.empty()) return false;
+    if (format == ReferenceFormat::UNKNOWN) {
+        width = gray.cols;
+        height = gray.rows;
+    }
+
+    cv::Mat thumb;
+    cv::resize(gray, thumb, cv::Size(HASH_WIDTH, HASH_HEIGHT), 0, 0, cv::INTER_AREA);
+    uint64_t hash = 0;
+    for (int y = 0; y < HASH_HEIGHT; ++y) {
+        const uchar* row = thumb.ptr<uchar>(y);
+        for (int x = 0; x + 1 < HASH_WIDTH; ++x) hash = hash << 1 | (row[x] > row[x + 1] ? 1u : 0u);
+    }
+
+    image.path = path;
+    image.width = width;
+    image.height = height;
+    image.format = format;
+    image.phash = hash;
+    return true;
+}
+
+int ReferenceCatalog::hamming(uint64_t a, uint64_t b) {
+    return static_cast<int>(std::bitset<64>(a ^ b).count());
+}
+
+ReferenceCatalog::Stats ReferenceCatalog::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.folders_tracked = static_cast<int>(folders_.size());
+    return stats;
+}
+
+// Serialized under the lock, written outside it; save_mutex_ keeps an older index from replacing
+// a newer one
+bool ReferenceCatalog::save() {
+    std::lock_guard<std::mutex> saving(save_mutex_);
+    std::string index;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index = serialize_locked();
+        dirty_ = false;
+    }
+    if (write_index(index)) return true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    dirty_ = true;
+    return false;
+}
+
+// Index layout: magic, version, folder count, then per folder its name, directory mtime and
+// images (file name, size, format, hash, mtime, bytes); strings carry a 16-bit length
+std::string ReferenceCatalog::serialize_locked() const {
+    std::string out;
+    std::vector<const std::pair<const std::string, Folder>*> folders;
+    for (const auto& entry : folders_) {
+        if (entry.second.dir_mtime_ns >= 0) folders.push_back(&entry);
+    }
+    out.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    put(out, INDEX_VERSION);
+    put(out, static_cast<uint32_t>(folders.size()));
+    for (const auto* folder : folders) {
+        put_string(out, folder->first);
+        put(out, folder->second.dir_mtime_ns);
+        put(out, static_cast<uint32_t>(folder->second.files.size()));
+        for (const auto& file : folder->second.files) {
+            const ReferenceImage& image = file.second;
+            put_string(out, file.first);
+            put(out, static_cast<int32_t>(image.width));
+            put(out, static_cast<int32_t>(image.height));
+            put(out, static_cast<uint8_t>(image.format));
+            put(out, image.phash);
+            put(out, image.mtime_ns);
+            put(out, image.bytes);
+        }
+    }
+    return out;
+}
+
+bool ReferenceCatalog::write_index(const std::string& index) const {
+    std::error_code ec;
+    fs::create_directories(fs::path(options_.index_path).parent_path(), ec);
+    const std::string tmp = options_.index_path + ".tmp." + std::to_string(::getpid());
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        file.write(index.data(), static_cast<std::streamsize>(index.size()));
+        if (!file) {
+            utils::Logger::instance().error("ReferenceCatalog: cannot write " + tmp);
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), options_.index_path.c_str()) != 0) {
+        utils::Logger::instance().error("ReferenceCatalog: cannot rename " + tmp + " to " + options_.index_path);
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ReferenceCatalog::load() {
+    std::ifstream in(options_.index_path, std::ios::binary);
+    if (!in) return false;
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Reader reader(data);
+    char magic[4];
+    uint32_t version = 0, folder_count = 0;
+    bool ok = reader.get(magic) && std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) == 0 && reader.get(version) &&
+              version == INDEX_VERSION && reader.get(folder_count);
+    std::unordered_map<std::string, Folder> folders;
+    for (uint32_t f = 0; ok && f < folder_count; ++f) {
+        std::string name;
+        Folder folder;
+        uint32_t count = 0;
+        ok = reader.get_string(name) && reader.get(folder.dir_mtime_ns) && reader.get(count);
+        const std::string path = folder_path(name);
+        for (uint32_t i = 0; ok && i < count; ++i) {
+            std::string file;
+            ReferenceImage image;
+            int32_t width = 0, height = 0;
+            uint8_t format = 0;
+            ok = reader.get_string(file) && reader.get(width) && reader.get(height) && reader.get(format) &&
+                 reader.get(image.phash) && reader.get(image.mtime_ns) && reader.get(image.bytes) &&
+                 format <= static_cast<uint8_t>(ReferenceFormat::BMP);
+            image.path = (fs::path(path) / file).string();
+            image.width = width;
+            image.height = height;
+            image.format = static_cast<ReferenceFormat>(format);
+            folder.files.emplace(std::move(file), std::move(image));
+        }
+        folders.emplace(std::move(name), std::move(folder));
+    }
+    if (!ok || !reader.done()) {
+        utils::Logger::instance().warning("ReferenceCatalog: ignoring unreadable index " + options_.index_path);
+        return false;
+    }
+    folders_ = std::move(folders);
+    stats_.folders_loaded = static_cast<int>(folders_.size());
+    return true;
+}
+
+} // namespace cpp_engine::generators
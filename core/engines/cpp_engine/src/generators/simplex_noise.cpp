@@ -0,0 +1,724 @@
+// generators/simplex_noise.cpp
+#include "generators/simplex_noise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX512F__) && defined(__GNUC__) && !defined(__clang__)
+// GCC 12 flags the _mm512_undefined_* passthrough of its own intrinsics
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace cpp_engine::generators {
+
+namespace {
+
+// Skew to the simplex lattice and back: F = (sqrt(N + 1) - 1) / N, G = (1 - 1 / sqrt(N + 1)) / N
+constexpr float F2 = 0.366025403784f, G2 = 0.211324865405f;
+constexpr float F3 = 1.0f / 3.0f, G3 = 1.0f / 6.0f;
+constexpr float F4 = 0.309016994375f, G4 = 0.138196601125f;
+// Squared falloff radius: 0.5 keeps a corner's kernel inside the simplices that share it (0.6, also
+// common in 3D/4D, leaves small steps at simplex faces); the scales bring the peaks to about +-1
+constexpr float RADIUS2 = 0.5f, RADIUS3 = 0.5f, RADIUS4 = 0.5f;
+constexpr float SCALE2 = 70.0f, SCALE3 = 76.883f, SCALE4 = 62.795f;
+
+constexpr float GRAD3[12][3] = {{1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}, {1, 0, 1}, {-1, 0, 1},
+                                {1, 0, -1}, {-1, 0, -1}, {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}};
+
+constexpr float GRAD4[32][4] = {
+    {0, 1, 1, 1}, {0, 1, 1, -1}, {0, 1, -1, 1}, {0, 1, -1, -1}, {0, -1, 1, 1}, {0, -1, 1, -1}, {0, -1, -1, 1},
+    {0, -1, -1, -1}, {1, 0, 1, 1}, {1, 0, 1, -1}, {1, 0, -1, 1}, {1, 0, -1, -1}, {-1, 0, 1, 1}, {-1, 0, 1, -1},
+    {-1, 0, -1, 1}, {-1, 0, -1, -1}, {1, 1, 0, 1}, {1, 1, 0, -1}, {1, -1, 0, 1}, {1, -1, 0, -1}, {-1, 1, 0, 1},
+    {-1, 1, 0, -1}, {-1, -1, 0, 1}, {-1, -1, 0, -1}, {1, 1, 1, 0}, {1, 1, -1, 0}, {1, -1, 1, 0}, {1, -1, -1, 0},
+    {-1, 1, 1, 0}, {-1, 1, -1, 0}, {-1, -1, 1, 0}, {-1, -1, -1, 0}};
+
+// A gradient packs into 2 bits per axis, component + 1, so one gather fetches all of it
+int pack_gradient(const float* g, int axes) {
+    int code = 0;
+    for (int a = 0; a < axes; ++a) code |= (static_cast<int>(g[a]) + 1) << (2 * a);
+    return code;
+}
+
+float gradient_axis(int code, int axis) {
+    return static_cast<float>(((code >> (2 * axis)) & 3) - 1);
+}
+
+int lattice(float floored) {
+    return static_cast<int>(floored) & 255;
+}
+
+/**
+ * Scalar simplex noise with its gradient
+ * Each corner adds t^4 (g . d) with t = r^2 - |d|^2 clamped at 0; its
+ * derivative is t^4 g - 8 t^3 (g . d) d. d is the offset from the corner,
+ * so the gradient is in noise units; null d* skips it.
+ */
+float simplex2(const int* perm, const int* grad, float x, float y, float* ddx, float* ddy) {
+    const float s = (x + y) * F2;
+    const float fi = std::floor(x + s), fj = std::floor(y + s);
+    const float t = (fi + fj) * G2;
+    const float x0 = x - (fi - t), y0 = y - (fj - t);
+    const int i1 = x0 > y0 ? 1 : 0, j1 = 1 - i1;
+    const int ii = lattice(fi), jj = lattice(fj);
+    const float cx[3] = {x0, x0 - i1 + G2, x0 - 1.0f + 2.0f * G2};
+    const float cy[3] = {y0, y0 - j1 + G2, y0 - 1.0f + 2.0f * G2};
+    const int slot[3] = {ii + perm[jj], ii + i1 + perm[jj + j1], ii + 1 + perm[jj + 1]};
+    float n = 0.0f, gx = 0.0f, gy = 0.0f;
+    for (int c = 0; c < 3; ++c) {
+        const float r = RADIUS2 - cx[c] * cx[c] - cy[c] * cy[c];
+        if (r <= 0.0f) continue;
+        const float r2 = r * r, r4 = r2 * r2;
+        const float ax = gradient_axis(grad[slot[c]], 0), ay = gradient_axis(grad[slot[c]], 1);
+        const float dot = ax * cx[c] + ay * cy[c];
+        n += r4 * dot;
+        const float k = -8.0f * r2 * r * dot;
+        gx += r4 * ax + k * cx[c];
+        gy += r4 * ay + k * cy[c];
+    }
+    if (ddx) *ddx = SCALE2 * gx;
+    if (ddy) *ddy = SCALE2 * gy;
+    return SCALE2 * n;
+}
+
+// Corner order of a 3D simplex: each axis is ranked against the others (ties to x, then y)
+float simplex3(const int* perm, const int* grad, float x, float y, float z, float* ddx, float* ddy) {
+    const float s = (x + y + z) * F3;
+    const float fi = std::floor(x + s), fj = std::floor(y + s), fk = std::floor(z + s);
+    const float t = (fi + fj + fk) * G3;
+    const float x0 = x - (fi - t), y0 = y - (fj - t), z0 = z - (fk - t);
+    const bool xy = x0 >= y0, xz = x0 >= z0, yz = y0 >= z0;
+    const int i1 = xy && xz, j1 = !xy && yz, k1 = !xz && !yz;
+    const int i2 = xy || xz, j2 = !xy || yz, k2 = !xz || !yz;
+    const int ii = lattice(fi), jj = lattice(fj), kk = lattice(fk);
+    const float cx[4] = {x0, x0 - i1 + G3, x0 - i2 + 2.0f * G3, x0 - 1.0f + 3.0f * G3};
+    const float cy[4] = {y0, y0 - j1 + G3, y0 - j2 + 2.0f * G3, y0 - 1.0f + 3.0f * G3};
+    const float cz[4] = {z0, z0 - k1 + G3, z0 - k2 + 2.0f * G3, z0 - 1.0f + 3.0f * G3};
+    const int slot[4] = {ii + perm[jj + perm[kk]], ii + i1 + perm[jj + j1 + perm[kk + k1]],
+                         ii + i2 + perm[jj + j2 + perm[kk + k2]], ii + 1 + perm[jj + 1 + perm[kk + 1]]};
+    float n = 0.0f, gx = 0.0f, gy = 0.0f;
+    for (int c = 0; c < 4; ++c) {
+        const float r = RADIUS3 - cx[c] * cx[c] - cy[c] * cy[c] - cz[c] * cz[c];
+        if (r <= 0.0f) continue;
+        const float r2 = r * r, r4 = r2 * r2;
+        const float ax = gradient_axis(grad[slot[c]], 0), ay = gradient_axis(grad[slot[c]], 1);
+        const float az = gradient_axis(grad[slot[c]], 2);
+        const float dot = ax * cx[c] + ay * cy[c] + az * cz[c];
+        n += r4 * dot;
+        const float k = -8.0f * r2 * r * dot;
+        gx += r4 * ax + k * cx[c];
+        gy += r4 * ay + k * cy[c];
+    }
+    if (ddx) *ddx = SCALE3 * gx;
+    if (ddy) *ddy = SCALE3 * gy;
+    return SCALE3 * n;
+}
+
+float simplex4(const int* perm, const int* grad, float x, float y, float z, float w, float* ddx, float* ddy) {
+    const float s = (x + y + z + w) * F4;
+    const float f[4] = {std::floor(x + s), std::floor(y + s), std::floor(z + s), std::floor(w + s)};
+    const float t = (f[0] + f[1] + f[2] + f[3]) * G4;
+    const float d0[4] = {x - (f[0] - t), y - (f[1] - t), z - (f[2] - t), w - (f[3] - t)};
+    int rank[4] = {0, 0, 0, 0};
+    for (int a = 0; a < 4; ++a) {
+        for (int b = a + 1; b < 4; ++b) ++rank[d0[a] >= d0[b] ? a : b];
+    }
+    int base[4];
+    for (int a = 0; a < 4; ++a) base[a] = lattice(f[a]);
+    float n = 0.0f, gx = 0.0f, gy = 0.0f;
+    // Corner c steps along the axes ranked at least 4 - c
+    for (int c = 0; c < 5; ++c) {
+        int offset[4];
+        float d[4], r = RADIUS4;
+        for (int a = 0; a < 4; ++a) {
+            offset[a] = c == 0 ? 0 : rank[a] >= 4 - c ? 1 : 0;
+            d[a] = d0[a] - offset[a] + c * G4;
+            r -= d[a] * d[a];
+        }
+        if (r <= 0.0f) continue;
+        const int slot = base[0] + offset[0] +
+                         perm[base[1] + offset[1] + perm[base[2] + offset[2] + perm[base[3] + offset[3]]]];
+        const float r2 = r * r, r4 = r2 * r2;
+        float g[4], dot = 0.0f;
+        for (int a = 0; a < 4; ++a) {
+            g[a] = gradient_axis(grad[slot], a);
+            dot += g[a] * d[a];
+        }
+        n += r4 * dot;
+        const float k = -8.0f * r2 * r * dot;
+        gx += r4 * g[0] + k * d[0];
+        gy += r4 * g[1] + k * d[1];
+    }
+    if (ddx) *ddx = SCALE4 * gx;
+    if (ddy) *ddy = SCALE4 * gy;
+    return SCALE4 * n;
+}
+
+// One octave along a row: out[i] += weight * n((x0 + i) * step, y), and slope times its gradient into dx/dy
+void accumulate2(const int* perm, const int* grad, float x0, float step, float y, int count, float weight,
+                 float* out, float* dx, float* dy) {
+    const float slope = weight * step;
+    int i = 0;
+#if defined(__AVX512F__)
+    {
+        const __m512 vf = _mm512_set1_ps(F2), vg = _mm512_set1_ps(G2), vg2 = _mm512_set1_ps(2.0f * G2 - 1.0f);
+        const __m512 one = _mm512_set1_ps(1.0f), zero = _mm512_setzero_ps(), radius = _mm512_set1_ps(RADIUS2);
+        const __m512 minus8 = _mm512_set1_ps(-8.0f), vy = _mm512_set1_ps(y);
+        const __m512 vweight = _mm512_set1_ps(weight * SCALE2), vslope = _mm512_set1_ps(slope * SCALE2);
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i low8 = _mm512_set1_epi32(255), three = _mm512_set1_epi32(3), ione = _mm512_set1_epi32(1);
+        auto axis = [&](__m512i code, int a) {
+            const __m512i bits = _mm512_and_si512(_mm512_srl_epi32(code, _mm_cvtsi32_si128(2 * a)), three);
+            return _mm512_cvtepi32_ps(_mm512_sub_epi32(bits, ione));
+        };
+        for (; i + 16 <= count; i += 16) {
+            const __m512 px = _mm512_add_ps(_mm512_set1_ps(x0),
+                                            _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(i), lane)));
+            const __m512 x = _mm512_mul_ps(px, _mm512_set1_ps(step));
+            const __m512 s = _mm512_mul_ps(_mm512_add_ps(x, vy), vf);
+            const __m512 fi = _mm512_roundscale_ps(_mm512_add_ps(x, s), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            const __m512 fj = _mm512_roundscale_ps(_mm512_add_ps(vy, s), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            const __m512 t = _mm512_mul_ps(_mm512_add_ps(fi, fj), vg);
+            const __m512 x0v = _mm512_sub_ps(x, _mm512_sub_ps(fi, t)), y0v = _mm512_sub_ps(vy, _mm512_sub_ps(fj, t));
+            const __mmask16 xy = _mm512_cmp_ps_mask(x0v, y0v, _CMP_GT_OQ);
+            const __m512 i1 = _mm512_mask_blend_ps(xy, zero, one), j1 = _mm512_sub_ps(one, i1);
+            const __m512i ii = _mm512_and_si512(_mm512_cvtps_epi32(fi), low8);
+            const __m512i jj = _mm512_and_si512(_mm512_cvtps_epi32(fj), low8);
+            const __m512i i1i = _mm512_mask_blend_epi32(xy, _mm512_setzero_si512(), ione);
+            const __m512i j1i = _mm512_sub_epi32(ione, i1i);
+
+            __m512 n = zero, gx = zero, gy = zero;
+            auto corner = [&](__m512i slot, __m512 cx, __m512 cy) {
+                __m512 r = _mm512_sub_ps(_mm512_sub_ps(radius, _mm512_mul_ps(cx, cx)), _mm512_mul_ps(cy, cy));
+                r = _mm512_max_ps(r, zero);
+                const __m512i code = _mm512_i32gather_epi32(slot, grad, 4);
+                const __m512 ax = axis(code, 0), ay = axis(code, 1);
+                const __m512 r2 = _mm512_mul_ps(r, r), r4 = _mm512_mul_ps(r2, r2);
+                const __m512 dot = _mm512_add_ps(_mm512_mul_ps(ax, cx), _mm512_mul_ps(ay, cy));
+                n = _mm512_add_ps(n, _mm512_mul_ps(r4, dot));
+                if (!dx) return;
+                const __m512 k = _mm512_mul_ps(_mm512_mul_ps(minus8, _mm512_mul_ps(r2, r)), dot);
+                gx = _mm512_add_ps(gx, _mm512_add_ps(_mm512_mul_ps(r4, ax), _mm512_mul_ps(k, cx)));
+                gy = _mm512_add_ps(gy, _mm512_add_ps(_mm512_mul_ps(r4, ay), _mm512_mul_ps(k, cy)));
+            };
+            corner(_mm512_add_epi32(ii, _mm512_i32gather_epi32(jj, perm, 4)), x0v, y0v);
+            corner(_mm512_add_epi32(_mm512_add_epi32(ii, i1i),
+                                    _mm512_i32gather_epi32(_mm512_add_epi32(jj, j1i), perm, 4)),
+                   _mm512_add_ps(_mm512_sub_ps(x0v, i1), vg), _mm512_add_ps(_mm512_sub_ps(y0v, j1), vg));
+            corner(_mm512_add_epi32(_mm512_add_epi32(ii, ione),
+                                    _mm512_i32gather_epi32(_mm512_add_epi32(jj, ione), perm, 4)),
+                   _mm512_add_ps(x0v, vg2), _mm512_add_ps(y0v, vg2));
+            _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(out + i), _mm512_mul_ps(vweight, n)));
+            if (!dx) continue;
+            _mm512_storeu_ps(dx + i, _mm512_add_ps(_mm512_loadu_ps(dx + i), _mm512_mul_ps(vslope, gx)));
+            _mm512_storeu_ps(dy + i, _mm512_add_ps(_mm512_loadu_ps(dy + i), _mm512_mul_ps(vslope, gy)));
+        }
+    }
+#endif
+#if defined(__AVX2__)
+    {
+        const __m256 vf = _mm256_set1_ps(F2), vg = _mm256_set1_ps(G2), vg2 = _mm256_set1_ps(2.0f * G2 - 1.0f);
+        const __m256 one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps(), radius = _mm256_set1_ps(RADIUS2);
+        const __m256 minus8 = _mm256_set1_ps(-8.0f), vy = _mm256_set1_ps(y);
+        const __m256 vweight = _mm256_set1_ps(weight * SCALE2), vslope = _mm256_set1_ps(slope * SCALE2);
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i low8 = _mm256_set1_epi32(255), three = _mm256_set1_epi32(3), ione = _mm256_set1_epi32(1);
+        auto axis = [&](__m256i code, int a) {
+            const __m256i bits = _mm256_and_si256(_mm256_srl_epi32(code, _mm_cvtsi32_si128(2 * a)), three);
+            return _mm256_cvtepi32_ps(_mm256_sub_epi32(bits, ione));
+        };
+        for (; i + 8 <= count; i += 8) {
+            const __m256 px = _mm256_add_ps(_mm256_set1_ps(x0),
+                                            _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(i), lane)));
+            const __m256 x = _mm256_mul_ps(px, _mm256_set1_ps(step));
+            const __m256 s = _mm256_mul_ps(_mm256_add_ps(x, vy), vf);
+            const __m256 fi = _mm256_floor_ps(_mm256_add_ps(x, s)), fj = _mm256_floor_ps(_mm256_add_ps(vy, s));
+            const __m256 t = _mm256_mul_ps(_mm256_add_ps(fi, fj), vg);
+            const __m256 x0v = _mm256_sub_ps(x, _mm256_sub_ps(fi, t)), y0v = _mm256_sub_ps(vy, _mm256_sub_ps(fj, t));
+            const __m256 xy = _mm256_cmp_ps(x0v, y0v, _CMP_GT_OQ);
+            const __m256 i1 = _mm256_and_ps(xy, one), j1 = _mm256_sub_ps(one, i1);
+            const __m256i ii = _mm256_and_si256(_mm256_cvtps_epi32(fi), low8);
+            const __m256i jj = _mm256_and_si256(_mm256_cvtps_epi32(fj), low8);
+            const __m256i i1i = _mm256_and_si256(_mm256_castps_si256(xy), ione);
+            const __m256i j1i = _mm256_sub_epi32(ione, i1i);
+
+            __m256 n = zero, gx = zero, gy = zero;
+            auto corner = [&](__m256i slot, __m256 cx, __m256 cy) {
+                __m256 r = _mm256_sub_ps(_mm256_sub_ps(radius, _mm256_mul_ps(cx, cx)), _mm256_mul_ps(cy, cy));
+                r = _mm256_max_ps(r, zero);
+                const __m256i code = _mm256_i32gather_epi32(grad, slot, 4);
+                const __m256 ax = axis(code, 0), ay = axis(code, 1);
+                const __m256 r2 = _mm256_mul_ps(r, r), r4 = _mm256_mul_ps(r2, r2);
+                const __m256 dot = _mm256_add_ps(_mm256_mul_ps(ax, cx), _mm256_mul_ps(ay, cy));
+                n = _mm256_add_ps(n, _mm256_mul_ps(r4, dot));
+                if (!dx) return;
+                const __m256 k = _mm256_mul_ps(_mm256_mul_ps(minus8, _mm256_mul_ps(r2, r)), dot);
+                gx = _mm256_add_ps(gx, _mm256_add_ps(_mm256_mul_ps(r4, ax), _mm256_mul_ps(k, cx)));
+                gy = _mm256_add_ps(gy, _mm256_add_ps(_mm256_mul_ps(r4, ay), _mm256_mul_ps(k, cy)));
+            };
+            corner(_mm256_add_epi32(ii, _mm256_i32gather_epi32(perm, jj, 4)), x0v, y0v);
+            corner(_mm256_add_epi32(_mm256_add_epi32(ii, i1i),
+                                    _mm256_i32gather_epi32(perm, _mm256_add_epi32(jj, j1i), 4)),
+                   _mm256_add_ps(_mm256_sub_ps(x0v, i1), vg), _mm256_add_ps(_mm256_sub_ps(y0v, j1), vg));
+            corner(_mm256_add_epi32(_mm256_add_epi32(ii, ione),
+                                    _mm256_i32gather_epi32(perm, _mm256_add_epi32(jj, ione), 4)),
+                   _mm256_add_ps(x0v, vg2), _mm256_add_ps(y0v, vg2));
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(vweight, n)));
+            if (!dx) continue;
+            _mm256_storeu_ps(dx + i, _mm256_add_ps(_mm256_loadu_ps(dx + i), _mm256_mul_ps(vslope, gx)));
+            _mm256_storeu_ps(dy + i, _mm256_add_ps(_mm256_loadu_ps(dy + i), _mm256_mul_ps(vslope, gy)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        float gx, gy;
+        out[i] += weight * simplex2(perm, grad, (x0 + static_cast<float>(i)) * step, y, dx ? &gx : nullptr, &gy);
+        if (!dx) continue;
+        dx[i] += slope * gx;
+        dy[i] += slope * gy;
+    }
+}
+
+void accumulate3(const int* perm, const int* grad, float x0, float step, float y, float z, int count,
+                 float weight, float* out, float* dx, float* dy) {
+    const float slope = weight * step;
+    int i = 0;
+#if defined(__AVX512F__)
+    {
+        const __m512 vf = _mm512_set1_ps(F3), vg = _mm512_set1_ps(G3), vg2 = _mm512_set1_ps(2.0f * G3);
+        const __m512 vg3 = _mm512_set1_ps(3.0f * G3 - 1.0f);
+        const __m512 one = _mm512_set1_ps(1.0f), zero = _mm512_setzero_ps(), radius = _mm512_set1_ps(RADIUS3);
+        const __m512 minus8 = _mm512_set1_ps(-8.0f), vy = _mm512_set1_ps(y), vz = _mm512_set1_ps(z);
+        const __m512 vweight = _mm512_set1_ps(weight * SCALE3), vslope = _mm512_set1_ps(slope * SCALE3);
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i low8 = _mm512_set1_epi32(255), ione = _mm512_set1_epi32(1), izero = _mm512_setzero_si512();
+        const __m512i three = _mm512_set1_epi32(3);
+        auto axis = [&](__m512i code, int a) {
+            const __m512i bits = _mm512_and_si512(_mm512_srl_epi32(code, _mm_cvtsi32_si128(2 * a)), three);
+            return _mm512_cvtepi32_ps(_mm512_sub_epi32(bits, ione));
+        };
+        for (; i + 16 <= count; i += 16) {
+            const __m512 px = _mm512_add_ps(_mm512_set1_ps(x0),
+                                            _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(i), lane)));
+            const __m512 x = _mm512_mul_ps(px, _mm512_set1_ps(step));
+            const __m512 s = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(x, vy), vz), vf);
+            const __m512 fi = _mm512_roundscale_ps(_mm512_add_ps(x, s), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            const __m512 fj = _mm512_roundscale_ps(_mm512_add_ps(vy, s), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            const __m512 fk = _mm512_roundscale_ps(_mm512_add_ps(vz, s), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            const __m512 t = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(fi, fj), fk), vg);
+            const __m512 x0v = _mm512_sub_ps(x, _mm512_sub_ps(fi, t));
+            const __m512 y0v = _mm512_sub_ps(vy, _mm512_sub_ps(fj, t));
+            const __m512 z0v = _mm512_sub_ps(vz, _mm512_sub_ps(fk, t));
+            const __mmask16 xy = _mm512_cmp_ps_mask(x0v, y0v, _CMP_GE_OQ);
+            const __mmask16 xz = _mm512_cmp_ps_mask(x0v, z0v, _CMP_GE_OQ);
+            const __mmask16 yz = _mm512_cmp_ps_mask(y0v, z0v, _CMP_GE_OQ);
+            const __mmask16 m[6] = {static_cast<__mmask16>(xy & xz), static_cast<__mmask16>(~xy & yz),
+                                    static_cast<__mmask16>(~xz & ~yz), static_cast<__mmask16>(xy | xz),
+                                    static_cast<__mmask16>(~xy | yz), static_cast<__mmask16>(~xz | ~yz)};
+            const __m512i ii = _mm512_and_si512(_mm512_cvtps_epi32(fi), low8);
+            const __m512i jj = _mm512_and_si512(_mm512_cvtps_epi32(fj), low8);
+            const __m512i kk = _mm512_and_si512(_mm512_cvtps_epi32(fk), low8);
+
+            __m512 n = zero, gx = zero, gy = zero;
+            auto corner = [&](__m512i oi, __m512i oj, __m512i ok, __m512 cx, __m512 cy, __m512 cz) {
+                const __m512i pk = _mm512_i32gather_epi32(_mm512_add_epi32(kk, ok), perm, 4);
+                const __m512i pj = _mm512_i32gather_epi32(_mm512_add_epi32(_mm512_add_epi32(jj, oj), pk), perm, 4);
+                const __m512i slot = _mm512_add_epi32(_mm512_add_epi32(ii, oi), pj);
+                __m512 r = _mm512_sub_ps(_mm512_sub_ps(radius, _mm512_mul_ps(cx, cx)),
+                                         _mm512_add_ps(_mm512_mul_ps(cy, cy), _mm512_mul_ps(cz, cz)));
+                r = _mm512_max_ps(r, zero);
+                const __m512i code = _mm512_i32gather_epi32(slot, grad, 4);
+                const __m512 ax = axis(code, 0), ay = axis(code, 1), az = axis(code, 2);
+                const __m512 r2 = _mm512_mul_ps(r, r), r4 = _mm512_mul_ps(r2, r2);
+                const __m512 dot = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(ax, cx), _mm512_mul_ps(ay, cy)),
+                                                 _mm512_mul_ps(az, cz));
+                n = _mm512_add_ps(n, _mm512_mul_ps(r4, dot));
+                if (!dx) return;
+                const __m512 k = _mm512_mul_ps(_mm512_mul_ps(minus8, _mm512_mul_ps(r2, r)), dot);
+                gx = _mm512_add_ps(gx, _mm512_add_ps(_mm512_mul_ps(r4, ax), _mm512_mul_ps(k, cx)));
+                gy = _mm512_add_ps(gy, _mm512_add_ps(_mm512_mul_ps(r4, ay), _mm512_mul_ps(k, cy)));
+            };
+            auto offset = [&](__mmask16 mask) { return _mm512_mask_blend_epi32(mask, izero, ione); };
+            auto step_back = [&](__m512 c, __mmask16 mask, __m512 g) {
+                return _mm512_add_ps(_mm512_sub_ps(c, _mm512_mask_blend_ps(mask, zero, one)), g);
+            };
+            corner(izero, izero, izero, x0v, y0v, z0v);
+            corner(offset(m[0]), offset(m[1]), offset(m[2]), step_back(x0v, m[0], vg), step_back(y0v, m[1], vg),
+                   step_back(z0v, m[2], vg));
+            corner(offset(m[3]), offset(m[4]), offset(m[5]), step_back(x0v, m[3], vg2), step_back(y0v, m[4], vg2),
+                   step_back(z0v, m[5], vg2));
+            corner(ione, ione, ione, _mm512_add_ps(x0v, vg3), _mm512_add_ps(y0v, vg3), _mm512_add_ps(z0v, vg3));
+            _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(out + i), _mm512_mul_ps(vweight, n)));
+            if (!dx) continue;
+            _mm512_storeu_ps(dx + i, _mm512_add_ps(_mm512_loadu_ps(dx + i), _mm512_mul_ps(vslope, gx)));
+            _mm512_storeu_ps(dy + i, _mm512_add_ps(_mm512_loadu_ps(dy + i), _mm512_mul_ps(vslope, gy)));
+        }
+    }
+#endif
+#if defined(__AVX2__)
+    {
+        const __m256 vf = _mm256_set1_ps(F3), vg = _mm256_set1_ps(G3), vg2 = _mm256_set1_ps(2.0f * G3);
+        const __m256 vg3 = _mm256_set1_ps(3.0f * G3 - 1.0f);
+        const __m256 one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps(), radius = _mm256_set1_ps(RADIUS3);
+        const __m256 minus8 = _mm256_set1_ps(-8.0f), vy = _mm256_set1_ps(y), vz = _mm256_set1_ps(z);
+        const __m256 vweight = _mm256_set1_ps(weight * SCALE3), vslope = _mm256_set1_ps(slope * SCALE3);
+        const __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i low8 = _mm256_set1_epi32(255), ione = _mm256_set1_epi32(1), izero = _mm256_setzero_si256();
+        const __m256i three = _mm256_set1_epi32(3);
+        auto axis = [&](__m256i code, int a) {
+            const __m256i bits = _mm256_and_si256(_mm256_srl_epi32(code, _mm_cvtsi32_si128(2 * a)), three);
+            return _mm256_cvtepi32_ps(_mm256_sub_epi32(bits, ione));
+        };
+        for (; i + 8 <= count; i += 8) {
+            const __m256 px = _mm256_add_ps(_mm256_set1_ps(x0),
+                                            _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(i), lane)));
+            const __m256 x = _mm256_mul_ps(px, _mm256_set1_ps(step));
+            const __m256 s = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(x, vy), vz), vf);
+            const __m256 fi = _mm256_floor_ps(_mm256_add_ps(x, s)), fj = _mm256_floor_ps(_mm256_add_ps(vy, s));
+            const __m256 fk = _mm256_floor_ps(_mm256_add_ps(vz, s));
+            const __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(fi, fj), fk), vg);
+            const __m256 x0v = _mm256_sub_ps(x, _mm256_sub_ps(fi, t));
+            const __m256 y0v = _mm256_sub_ps(vy, _mm256_sub_ps(fj, t));
+            const __m256 z0v = _mm256_sub_ps(vz, _mm256_sub_ps(fk, t));
+            const __m256 xy = _mm256_cmp_ps(x0v, y0v, _CMP_GE_OQ);
+            const __m256 xz = _mm256_cmp_ps(x0v, z0v, _CMP_GE_OQ);
+            const __m256 yz = _mm256_cmp_ps(y0v, z0v, _CMP_GE_OQ);
+            const __m256 m[6] = {_mm256_and_ps(xy, xz), _mm256_andnot_ps(xy, yz),
+                                 _mm256_andnot_ps(_mm256_or_ps(xz, yz), all), _mm256_or_ps(xy, xz),
+                                 _mm256_or_ps(_mm256_andnot_ps(xy, all), yz),
+                                 _mm256_andnot_ps(_mm256_and_ps(xz, yz), all)};
+            const __m256i ii = _mm256_and_si256(_mm256_cvtps_epi32(fi), low8);
+            const __m256i jj = _mm256_and_si256(_mm256_cvtps_epi32(fj), low8);
+            const __m256i kk = _mm256_and_si256(_mm256_cvtps_epi32(fk), low8);
+
+            __m256 n = zero, gx = zero, gy = zero;
+            auto corner = [&](__m256i oi, __m256i oj, __m256i ok, __m256 cx, __m256 cy, __m256 cz) {
+                const __m256i pk = _mm256_i32gather_epi32(perm, _mm256_add_epi32(kk, ok), 4);
+                const __m256i pj = _mm256_i32gather_epi32(perm, _mm256_add_epi32(_mm256_add_epi32(jj, oj), pk), 4);
+                const __m256i slot = _mm256_add_epi32(_mm256_add_epi32(ii, oi), pj);
+                __m256 r = _mm256_sub_ps(_mm256_sub_ps(radius, _mm256_mul_ps(cx, cx)),
+                                         _mm256_add_ps(_mm256_mul_ps(cy, cy), _mm256_mul_ps(cz, cz)));
+                r = _mm256_max_ps(r, zero);
+                const __m256i code = _mm256_i32gather_epi32(grad, slot, 4);
+                const __m256 ax = axis(code, 0), ay = axis(code, 1), az = axis(code, 2);
+                const __m256 r2 = _mm256_mul_ps(r, r), r4 = _mm256_mul_ps(r2, r2);
+                const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, cx), _mm256_mul_ps(ay, cy)),
+                                                 _mm256_mul_ps(az, cz));
+                n = _mm256_add_ps(n, _mm256_mul_ps(r4, dot));
+                if (!dx) return;
+                const __m256 k = _mm256_mul_ps(_mm256_mul_ps(minus8, _mm256_mul_ps(r2, r)), dot);
+                gx = _mm256_add_ps(gx, _mm256_add_ps(_mm256_mul_ps(r4, ax), _mm256_mul_ps(k, cx)));
+                gy = _mm256_add_ps(gy, _mm256_add_ps(_mm256_mul_ps(r4, ay), _mm256_mul_ps(k, cy)));
+            };
+            auto offset = [&](__m256 mask) { return _mm256_and_si256(_mm256_castps_si256(mask), ione); };
+            auto step_back = [&](__m256 c, __m256 mask, __m256 g) {
+                return _mm256_add_ps(_mm256_sub_ps(c, _mm256_and_ps(mask, one)), g);
+            };
+            corner(izero, izero, izero, x0v, y0v, z0v);
+            corner(offset(m[0]), offset(m[1]), offset(m[2]), step_back(x0v, m[0], vg), step_back(y0v, m[1], vg),
+                   step_back(z0v, m[2], vg));
+            corner(offset(m[3]), offset(m[4]), offset(m[5]), step_back(x0v, m[3], vg2), step_back(y0v, m[4], vg2),
+                   step_back(z0v, m[5], vg2));
+            corner(ione, ione, ione, _mm256_add_ps(x0v, vg3), _mm256_add_ps(y0v, vg3), _mm256_add_ps(z0v, vg3));
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(vweight, n)));
+            if (!dx) continue;
+            _mm256_storeu_ps(dx + i, _mm256_add_ps(_mm256_loadu_ps(dx + i), _mm256_mul_ps(vslope, gx)));
+            _mm256_storeu_ps(dy + i, _mm256_add_ps(_mm256_loadu_ps(dy + i), _mm256_mul_ps(vslope, gy)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        float gx, gy;
+        out[i] += weight * simplex3(perm, grad, (x0 + static_cast<float>(i)) * step, y, z, dx ? &gx : nullptr, &gy);
+        if (!dx) continue;
+        dx[i] += slope * gx;
+        dy[i] += slope * gy;
+    }
+}
+
+void accumulate4(const int* perm, const int* grad, float x0, float step, float y, float z, float w, int count,
+                 float weight, float* out, float* dx, float* dy) {
+    const float slope = weight * step;
+    int i = 0;
+    // Same corner walk as simplex4(): the pairwise ranks decide which axes corners 1-3 step along
+#if defined(__AVX512F__)
+    {
+        const __m512 vf = _mm512_set1_ps(F4), vg = _mm512_set1_ps(G4);
+        const __m512 zero = _mm512_setzero_ps(), one = _mm512_set1_ps(1.0f), radius = _mm512_set1_ps(RADIUS4);
+        const __m512 minus8 = _mm512_set1_ps(-8.0f);
+        const __m512 vweight = _mm512_set1_ps(weight * SCALE4), vslope = _mm512_set1_ps(slope * SCALE4);
+        const __m512 fixed[3] = {_mm512_set1_ps(y), _mm512_set1_ps(z), _mm512_set1_ps(w)};
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i low8 = _mm512_set1_epi32(255), three = _mm512_set1_epi32(3), ione = _mm512_set1_epi32(1);
+        auto axis = [&](__m512i code, int a) {
+            const __m512i bits = _mm512_and_si512(_mm512_srl_epi32(code, _mm_cvtsi32_si128(2 * a)), three);
+            return _mm512_cvtepi32_ps(_mm512_sub_epi32(bits, ione));
+        };
+        for (; i + 16 <= count; i += 16) {
+            const __m512 px = _mm512_add_ps(_mm512_set1_ps(x0),
+                                            _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(i), lane)));
+            const __m512 p[4] = {_mm512_mul_ps(px, _mm512_set1_ps(step)), fixed[0], fixed[1], fixed[2]};
+            const __m512 s = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(p[0], p[1]), _mm512_add_ps(p[2], p[3])), vf);
+            __m512 f[4];
+            for (int a = 0; a < 4; ++a) {
+                f[a] = _mm512_roundscale_ps(_mm512_add_ps(p[a], s), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            }
+            const __m512 t = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(f[0], f[1]), _mm512_add_ps(f[2], f[3])), vg);
+            __m512 d0[4];
+            __m512i base[4], rank[4];
+            for (int a = 0; a < 4; ++a) {
+                d0[a] = _mm512_sub_ps(p[a], _mm512_sub_ps(f[a], t));
+                base[a] = _mm512_and_si512(_mm512_cvtps_epi32(f[a]), low8);
+                rank[a] = _mm512_setzero_si512();
+            }
+            for (int a = 0; a < 4; ++a) {
+                for (int b = a + 1; b < 4; ++b) {
+                    const __mmask16 ge = _mm512_cmp_ps_mask(d0[a], d0[b], _CMP_GE_OQ);
+                    rank[a] = _mm512_mask_add_epi32(rank[a], ge, rank[a], ione);
+                    rank[b] = _mm512_mask_add_epi32(rank[b], static_cast<__mmask16>(~ge), rank[b], ione);
+                }
+            }
+
+            __m512 n = zero, gx = zero, gy = zero;
+            for (int c = 0; c < 5; ++c) {
+                const __m512i threshold = _mm512_set1_epi32(3 - c);
+                __mmask16 stepped[4];
+                __m512 d[4];
+                __m512 r = radius;
+                for (int a = 0; a < 4; ++a) {
+                    stepped[a] = c == 0 ? 0 : _mm512_cmpgt_epi32_mask(rank[a], threshold);
+                    d[a] = _mm512_add_ps(_mm512_mask_sub_ps(d0[a], stepped[a], d0[a], one),
+                                         _mm512_set1_ps(c * G4));
+                    r = _mm512_sub_ps(r, _mm512_mul_ps(d[a], d[a]));
+                }
+                r = _mm512_max_ps(r, zero);
+                auto lattice_index = [&](int a) { return _mm512_mask_add_epi32(base[a], stepped[a], base[a], ione); };
+                __m512i hash = _mm512_i32gather_epi32(lattice_index(3), perm, 4);
+                hash = _mm512_i32gather_epi32(_mm512_add_epi32(lattice_index(2), hash), perm, 4);
+                hash = _mm512_i32gather_epi32(_mm512_add_epi32(lattice_index(1), hash), perm, 4);
+                const __m512i code = _mm512_i32gather_epi32(_mm512_add_epi32(lattice_index(0), hash), grad, 4);
+                __m512 g[4];
+                __m512 dot = zero;
+                for (int a = 0; a < 4; ++a) {
+                    g[a] = axis(code, a);
+                    dot = _mm512_add_ps(dot, _mm512_mul_ps(g[a], d[a]));
+                }
+                const __m512 r2 = _mm512_mul_ps(r, r), r4 = _mm512_mul_ps(r2, r2);
+                n = _mm512_add_ps(n, _mm512_mul_ps(r4, dot));
+                if (!dx) continue;
+                const __m512 k = _mm512_mul_ps(_mm512_mul_ps(minus8, _mm512_mul_ps(r2, r)), dot);
+                gx = _mm512_add_ps(gx, _mm512_add_ps(_mm512_mul_ps(r4, g[0]), _mm512_mul_ps(k, d[0])));
+                gy = _mm512_add_ps(gy, _mm512_add_ps(_mm512_mul_ps(r4, g[1]), _mm512_mul_ps(k, d[1])));
+            }
+            _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(out + i), _mm512_mul_ps(vweight, n)));
+            if (!dx) continue;
+            _mm512_storeu_ps(dx + i, _mm512_add_ps(_mm512_loadu_ps(dx + i), _mm512_mul_ps(vslope, gx)));
+            _mm512_storeu_ps(dy + i, _mm512_add_ps(_mm512_loadu_ps(dy + i), _mm512_mul_ps(vslope, gy)));
+        }
+    }
+#endif
+#if defined(__AVX2__)
+    {
+        const __m256 vf = _mm256_set1_ps(F4), vg = _mm256_set1_ps(G4);
+        const __m256 zero = _mm256_setzero_ps(), radius = _mm256_set1_ps(RADIUS4);
+        const __m256 minus8 = _mm256_set1_ps(-8.0f);
+        const __m256 vweight = _mm256_set1_ps(weight * SCALE4), vslope = _mm256_set1_ps(slope * SCALE4);
+        const __m256 fixed[3] = {_mm256_set1_ps(y), _mm256_set1_ps(z), _mm256_set1_ps(w)};
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i low8 = _mm256_set1_epi32(255), three = _mm256_set1_epi32(3), ione = _mm256_set1_epi32(1);
+        auto axis = [&](__m256i code, int a) {
+            const __m256i bits = _mm256_and_si256(_mm256_srl_epi32(code, _mm_cvtsi32_si128(2 * a)), three);
+            return _mm256_cvtepi32_ps(_mm256_sub_epi32(bits, ione));
+        };
+        for (; i + 8 <= count; i += 8) {
+            const __m256 px = _mm256_add_ps(_mm256_set1_ps(x0),
+                                            _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(i), lane)));
+            const __m256 p[4] = {_mm256_mul_ps(px, _mm256_set1_ps(step)), fixed[0], fixed[1], fixed[2]};
+            const __m256 s = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(p[0], p[1]), _mm256_add_ps(p[2], p[3])), vf);
+            __m256 f[4];
+            for (int a = 0; a < 4; ++a) f[a] = _mm256_floor_ps(_mm256_add_ps(p[a], s));
+            const __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(f[0], f[1]), _mm256_add_ps(f[2], f[3])), vg);
+            __m256 d0[4];
+            __m256i base[4], rank[4];
+            for (int a = 0; a < 4; ++a) {
+                d0[a] = _mm256_sub_ps(p[a], _mm256_sub_ps(f[a], t));
+                base[a] = _mm256_and_si256(_mm256_cvtps_epi32(f[a]), low8);
+                rank[a] = _mm256_setzero_si256();
+            }
+            for (int a = 0; a < 4; ++a) {
+                for (int b = a + 1; b < 4; ++b) {
+                    const __m256i ge = _mm256_castps_si256(_mm256_cmp_ps(d0[a], d0[b], _CMP_GE_OQ));
+                    rank[a] = _mm256_add_epi32(rank[a], _mm256_and_si256(ge, ione));
+                    rank[b] = _mm256_add_epi32(rank[b], _mm256_andnot_si256(ge, ione));
+                }
+            }
+
+            __m256 n = zero, gx = zero, gy = zero;
+            for (int c = 0; c < 5; ++c) {
+                const __m256i threshold = _mm256_set1_epi32(3 - c);
+                __m256i stepped[4];
+                __m256 d[4];
+                __m256 r = radius;
+                for (int a = 0; a < 4; ++a) {
+                    stepped[a] = c == 0 ? _mm256_setzero_si256()
+                                        : _mm256_and_si256(_mm256_cmpgt_epi32(rank[a], threshold), ione);
+                    d[a] = _mm256_add_ps(_mm256_sub_ps(d0[a], _mm256_cvtepi32_ps(stepped[a])), _mm256_set1_ps(c * G4));
+                    r = _mm256_sub_ps(r, _mm256_mul_ps(d[a], d[a]));
+                }
+                r = _mm256_max_ps(r, zero);
+                auto lattice_index = [&](int a) { return _mm256_add_epi32(base[a], stepped[a]); };
+                __m256i hash = _mm256_i32gather_epi32(perm, lattice_index(3), 4);
+                hash = _mm256_i32gather_epi32(perm, _mm256_add_epi32(lattice_index(2), hash), 4);
+                hash = _mm256_i32gather_epi32(perm, _mm256_add_epi32(lattice_index(1), hash), 4);
+                const __m256i code = _mm256_i32gather_epi32(grad, _mm256_add_epi32(lattice_index(0), hash), 4);
+                __m256 g[4];
+                __m256 dot = zero;
+                for (int a = 0; a < 4; ++a) {
+                    g[a] = axis(code, a);
+                    dot = _mm256_add_ps(dot, _mm256_mul_ps(g[a], d[a]));
+                }
+                const __m256 r2 = _mm256_mul_ps(r, r), r4 = _mm256_mul_ps(r2, r2);
+                n = _mm256_add_ps(n, _mm256_mul_ps(r4, dot));
+                if (!dx) continue;
+                const __m256 k = _mm256_mul_ps(_mm256_mul_ps(minus8, _mm256_mul_ps(r2, r)), dot);
+                gx = _mm256_add_ps(gx, _mm256_add_ps(_mm256_mul_ps(r4, g[0]), _mm256_mul_ps(k, d[0])));
+                gy = _mm256_add_ps(gy, _mm256_add_ps(_mm256_mul_ps(r4, g[1]), _mm256_mul_ps(k, d[1])));
+            }
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(vweight, n)));
+            if (!dx) continue;
+            _mm256_storeu_ps(dx + i, _mm256_add_ps(_mm256_loadu_ps(dx + i), _mm256_mul_ps(vslope, gx)));
+            _mm256_storeu_ps(dy + i, _mm256_add_ps(_mm256_loadu_ps(dy + i), _mm256_mul_ps(vslope, gy)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        float gx, gy;
+        out[i] += weight * simplex4(perm, grad, (x0 + static_cast<float>(i)) * step, y, z, w, dx ? &gx : nullptr, &gy);
+        if (!dx) continue;
+        dx[i] += slope * gx;
+        dy[i] += slope * gy;
+    }
+}
+
+/**
+ * fBm rows of any dimension
+ * Zeroes the outputs, then calls octave(step, frequency, weight) per octave
+ * with the octave's weight already divided by the amplitude sum.
+ */
+template <typename Octave>
+void fractal_rows(int count, float scale, const FractalParams& params, float* out, float* dx, float* dy,
+                  Octave octave) {
+    if (count <= 0) return;
+    std::fill(out, out + count, 0.0f);
+    if (dx) {
+        std::fill(dx, dx + count, 0.0f);
+        std::fill(dy, dy + count, 0.0f);
+    }
+    const int octaves = std::max(0, std::min(params.octaves, SimplexNoise::MAX_OCTAVES));
+    float max_value = 0.0f, amplitude = 1.0f;
+    for (int o = 0; o < octaves; ++o, amplitude *= params.persistence) max_value += amplitude;
+    amplitude = 1.0f;
+    float frequency = 1.0f;
+    for (int o = 0; o < octaves; ++o) {
+        octave(scale * frequency, frequency, amplitude / max_value);
+        amplitude *= params.persistence;
+        frequency *= params.lacunarity;
+    }
+}
+
+template <typename Noise>
+float fractal_sum(const FractalParams& params, Noise noise) {
+    float result = 0.0f, amplitude = 1.0f, frequency = 1.0f, max_value = 0.0f;
+    for (int i = 0; i < std::min(params.octaves, SimplexNoise::MAX_OCTAVES); ++i) {
+        result += amplitude * noise(frequency);
+        max_value += amplitude;
+        amplitude *= params.persistence;
+        frequency *= params.lacunarity;
+    }
+    return max_value > 0.0f ? result / max_value : 0.0f;
+}
+
+} // namespace
+
+SimplexNoise::SimplexNoise(unsigned int seed) {
+    // The PerlinNoise construction, so one seed drives both backends
+    std::mt19937 gen(seed);
+    std::vector<int> permutation(256);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), gen);
+    for (int i = 0; i < 512; ++i) {
+        perm_[i] = permutation[i & 255];
+        grad3_[i] = pack_gradient(GRAD3[perm_[i] % 12], 3);
+        grad4_[i] = pack_gradient(GRAD4[perm_[i] & 31], 4);
+    }
+}
+
+float SimplexNoise::noise(float x, float y) const {
+    return simplex2(perm_, grad3_, x, y, nullptr, nullptr);
+}
+
+float SimplexNoise::noise3(float x, float y, float z) const {
+    return simplex3(perm_, grad3_, x, y, z, nullptr, nullptr);
+}
+
+float SimplexNoise::noise4(float x, float y, float z, float w) const {
+    return simplex4(perm_, grad4_, x, y, z, w, nullptr, nullptr);
+}
+
+float SimplexNoise::fractal(float x, float y, const FractalParams& params) const {
+    return fractal_sum(params, [&](float f) { return noise(x * f, y * f); });
+}
+
+float SimplexNoise::fractal3(float x, float y, float z, const FractalParams& params) const {
+    return fractal_sum(params, [&](float f) { return noise3(x * f, y * f, z * f); });
+}
+
+float SimplexNoise::fractal4(float x, float y, float z, float w, const FractalParams& params) const {
+    return fractal_sum(params, [&](float f) { return noise4(x * f, y * f, z * f, w * f); });
+}
+
+void SimplexNoise::fractal_row(float x0, float y, int count, float scale, const FractalParams& params, float* out,
+                               float* dx, float* dy) const {
+    if (!dy) dx = nullptr;
+    fractal_rows(count, scale, params, out, dx, dy, [&](float step, float frequency, float weight) {
+        const float ny = static_cast<float>(static_cast<double>(y) * scale * frequency);
+        accumulate2(perm_, grad3_, x0, step, ny, count, weight, out, dx, dy);
+    });
+}
+
+void SimplexNoise::fractal_row_3d(float x0, float y, float z, int count, float scale, const FractalParams& params,
+                                  float* out, float* dx, float* dy) const {
+    if (!dy) dx = nullptr;
+    fractal_rows(count, scale, params, out, dx, dy, [&](float step, float frequency, float weight) {
+        const float ny = static_cast<float>(static_cast<double>(y) * scale * frequency);
+        accumulate3(perm_, grad3_, x0, step, ny, z * frequency, count, weight, out, dx, dy);
+    });
+}
+
+void SimplexNoise::fractal_row_4d(float x0, float y, float z, float w, int count, float scale,
+                                  const FractalParams& params, float* out, float* dx, float* dy) const {
+    if (!dy) dx = nullptr;
+    fractal_rows(count, scale, params, out, dx, dy, [&](float step, float frequency, float weight) {
+        const float ny = static_cast<float>(static_cast<double>(y) * scale * frequency);
+        accumulate4(perm_, grad4_, x0, step, ny, z * frequency, w * frequency, count, weight, out, dx, dy);
+    });
+}
+
+const char* SimplexNoise::simd_path() {
+#if defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,192 @@
+// generators/texture_kernels.cpp
+#include "generators/texture_kernels.h"
+#include "generators/noise_atlas.h"
+#include "generators/simplex_noise.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace cpp_engine::generators {
+
+namespace {
+
+// Light from the upper left, viewer straight above; H = normalize(L + V)
+constexpr float LIGHT[3] = {-0.4f, -0.5f, 0.7681146f};
+constexpr float HALF[3] = {-0.2127109f, -0.2658886f, 0.9402432f};
+
+constexpr float HIGHLIGHT_RADIUS = 50.0f;
+constexpr int HIGHLIGHT_MARGIN = 10;
+
+/**
+ * Per pixel: normal = normalize(tilt * (gx, gy), 1), diffuse = max(0, N.L),
+ * specular = max(0, N.H)^32, value = clamp((0.5 + 0.5 h) (0.45 + 0.75 diffuse)
+ * + weight * specular) * 200 + 30 to [0, 255]. tilt turns pixel-unit slopes
+ * into noise-unit slopes times the bump strength. value may alias h.
+ */
+void shade_metallic(const float* h, const float* gx, const float* gy, int count, float tilt, float weight,
+                    float* value) {
+    int i = 0;
+#if defined(__AVX2__)
+    {
+        const __m256 vtilt = _mm256_set1_ps(tilt), vweight = _mm256_set1_ps(weight);
+        const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f), half = _mm256_set1_ps(0.5f);
+        const __m256 lx = _mm256_set1_ps(LIGHT[0]), ly = _mm256_set1_ps(LIGHT[1]), lz = _mm256_set1_ps(LIGHT[2]);
+        const __m256 hx = _mm256_set1_ps(HALF[0]), hy = _mm256_set1_ps(HALF[1]), hz = _mm256_set1_ps(HALF[2]);
+        for (; i + 8 <= count; i += 8) {
+            const __m256 nx = _mm256_mul_ps(vtilt, _mm256_loadu_ps(gx + i));
+            const __m256 ny = _mm256_mul_ps(vtilt, _mm256_loadu_ps(gy + i));
+            const __m256 inv_len = _mm256_div_ps(one, _mm256_sqrt_ps(
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, nx), _mm256_mul_ps(ny, ny)), one)));
+            const __m256 diffuse = _mm256_max_ps(zero, _mm256_mul_ps(
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, lx), _mm256_mul_ps(ny, ly)), lz), inv_len));
+            __m256 spec = _mm256_max_ps(zero, _mm256_mul_ps(
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, hx), _mm256_mul_ps(ny, hy)), hz), inv_len));
+            for (int k = 0; k < 5; ++k) spec = _mm256_mul_ps(spec, spec);
+            const __m256 base = _mm256_add_ps(half, _mm256_mul_ps(half, _mm256_loadu_ps(h + i)));
+            const __m256 light = _mm256_add_ps(
+                _mm256_mul_ps(base, _mm256_add_ps(_mm256_set1_ps(0.45f), _mm256_mul_ps(_mm256_set1_ps(0.75f), diffuse))),
+                _mm256_mul_ps(vweight, spec));
+            const __m256 v = _mm256_add_ps(_mm256_mul_ps(light, _mm256_set1_ps(200.0f)), _mm256_set1_ps(30.0f));
+            _mm256_storeu_ps(value + i, _mm256_min_ps(_mm256_set1_ps(255.0f), _mm256_max_ps(zero, v)));
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    {
+        const __m128 vtilt = _mm_set1_ps(tilt), vweight = _mm_set1_ps(weight);
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f);
+        const __m128 lx = _mm_set1_ps(LIGHT[0]), ly = _mm_set1_ps(LIGHT[1]), lz = _mm_set1_ps(LIGHT[2]);
+        const __m128 hx = _mm_set1_ps(HALF[0]), hy = _mm_set1_ps(HALF[1]), hz = _mm_set1_ps(HALF[2]);
+        for (; i + 4 <= count; i += 4) {
+            const __m128 nx = _mm_mul_ps(vtilt, _mm_loadu_ps(gx + i));
+            const __m128 ny = _mm_mul_ps(vtilt, _mm_loadu_ps(gy + i));
+            const __m128 inv_len = _mm_div_ps(one, _mm_sqrt_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), one)));
+            const __m128 diffuse = _mm_max_ps(zero, _mm_mul_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, lx), _mm_mul_ps(ny, ly)), lz), inv_len));
+            __m128 spec = _mm_max_ps(zero, _mm_mul_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, hx), _mm_mul_ps(ny, hy)), hz), inv_len));
+            for (int k = 0; k < 5; ++k) spec = _mm_mul_ps(spec, spec);
+            const __m128 base = _mm_add_ps(half, _mm_mul_ps(half, _mm_loadu_ps(h + i)));
+            const __m128 light = _mm_add_ps(
+                _mm_mul_ps(base, _mm_add_ps(_mm_set1_ps(0.45f), _mm_mul_ps(_mm_set1_ps(0.75f), diffuse))),
+                _mm_mul_ps(vweight, spec));
+            const __m128 v = _mm_add_ps(_mm_mul_ps(light, _mm_set1_ps(200.0f)), _mm_set1_ps(30.0f));
+            _mm_storeu_ps(value + i, _mm_min_ps(_mm_set1_ps(255.0f), _mm_max_ps(zero, v)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        const float nx = tilt * gx[i], ny = tilt * gy[i];
+        const float inv_len = 1.0f / std::sqrt(nx * nx + ny * ny + 1.0f);
+        const float diffuse = std::max(0.0f, (nx * LIGHT[0] + ny * LIGHT[1] + LIGHT[2]) * inv_len);
+        float spec = std::max(0.0f, (nx * HALF[0] + ny * HALF[1] + HALF[2]) * inv_len);
+        for (int k = 0; k < 5; ++k) spec *= spec;  // ^32
+        const float base = 0.5f + 0.5f * h[i];
+        const float light = base * (0.45f + 0.75f * diffuse) + weight * spec;
+        value[i] = std::min(255.0f, std::max(0.0f, light * 200.0f + 30.0f));
+    }
+}
+
+} // namespace
+
+void NoiseField::row(float x0, float y, int count, float scale, const FractalParams& params, float* out) const {
+    if (simplex) {
+        if (dimensions == 4) {
+            simplex->fractal_row_4d(x0, y, z, w, count, scale, params, out);
+        } else if (dimensions == 3) {
+            simplex->fractal_row_3d(x0, y, z, count, scale, params, out);
+        } else {
+            simplex->fractal_row(x0, y, count, scale, params, out);
+        }
+    } else if (dimensions == 3) {
+        perlin->fractal_row_3d(x0, y, z, count, scale, params, out);
+    } else if (atlas && atlas->key().matches(scale, params)) {
+        atlas->sample_row(x0, y, count, out);
+    } else {
+        perlin->fractal_row(x0, y, count, scale, params, out);
+    }
+}
+
+void NoiseField::row_gradient(float x0, float y, int count, float scale, const FractalParams& params, float* out,
+                              float* dx, float* dy) const {
+    if (simplex) {
+        if (dimensions == 4) {
+            simplex->fractal_row_4d(x0, y, z, w, count, scale, params, out, dx, dy);
+        } else if (dimensions == 3) {
+            simplex->fractal_row_3d(x0, y, z, count, scale, params, out, dx, dy);
+        } else {
+            simplex->fractal_row(x0, y, count, scale, params, out, dx, dy);
+        }
+    } else if (dimensions == 3) {
+        perlin->fractal_row_3d(x0, y, z, count, scale, params, out, dx, dy);
+    } else {
+        perlin->fractal_row_gradient(x0, y, count, scale, params, out, dx, dy);
+    }
+}
+
+namespace kernels {
+
+void metallic_row(const NoiseField& field, const MetallicParams& params, int y, int x_begin, int x_end,
+                  int width, int height, uint8_t* dst, float* scratch) {
+    const int count = x_end - x_begin;
+    if (count <= 0) return;
+    float* h = scratch;
+    float* gx = scratch + count;
+    float* gy = scratch + 2 * count;
+    field.row_gradient(static_cast<float>(x_begin), static_cast<float>(y), count, params.scale, params.fractal, h,
+                       gx, gy);
+
+    // Shaded value per pixel, in place of the height
+    shade_metallic(h, gx, gy, count, -params.bump / params.scale, params.specular, h);
+    for (int i = 0; i < count; ++i) {
+        const uint8_t intensity = static_cast<uint8_t>(h[i]);
+        dst[3 * i] = dst[3 * i + 1] = dst[3 * i + 2] = intensity;
+    }
+
+    // Centre highlight of the former second pass, only on the rows and columns it reaches
+    const double cx = width / 2.0, cy = height / 2.0;
+    const double ry = y - cy;
+    if (y < HIGHLIGHT_MARGIN || y >= height - HIGHLIGHT_MARGIN || std::fabs(ry) >= HIGHLIGHT_RADIUS) return;
+    const int hx0 = std::max({x_begin, HIGHLIGHT_MARGIN, static_cast<int>(std::floor(cx - HIGHLIGHT_RADIUS))});
+    const int hx1 = std::min({x_end, width - HIGHLIGHT_MARGIN, static_cast<int>(std::ceil(cx + HIGHLIGHT_RADIUS)) + 1});
+    for (int x = hx0; x < hx1; ++x) {
+        const double rx = x - cx;
+        const double dist2 = rx * rx + ry * ry;
+        if (dist2 >= HIGHLIGHT_RADIUS * HIGHLIGHT_RADIUS) continue;
+        const int highlight = static_cast<int>(200 * std::exp(-dist2 / 1000.0));
+        uint8_t* p = dst + 3 * (x - x_begin);
+        for (int c = 0; c < 3; ++c) p[c] = static_cast<uint8_t>(std::min(255, p[c] + highlight));
+    }
+}
+
+void gray_row(const NoiseField& field, float scale, const FractalParams& fractal, int y, int x_begin, int x_end,
+              int channels, uint8_t* dst, float* scratch) {
+    const int count = x_end - x_begin;
+    if (count <= 0) return;
+    field.row(static_cast<float>(x_begin), static_cast<float>(y), count, scale, fractal, scratch);
+    for (int i = 0; i < count; ++i) {
+        const uint8_t pixel = static_cast<uint8_t>((scratch[i] + 1.0) / 2.0 * 255.0);
+        for (int c = 0; c < channels; ++c) dst[i * channels + c] = pixel;
+    }
+}
+
+void silhouette_row(const uint8_t* above, const uint8_t* edges, const uint8_t* below, int x_begin, int x_end,
+                    int width, uint8_t* dst) {
+    for (int x = x_begin; x < x_end; ++x) {
+        bool hit = edges[x] || (above && above[x]) || (below && below[x]);
+        hit = hit || (x > 0 && edges[x - 1]) || (x + 1 < width && edges[x + 1]);
+        uint8_t* p = dst + 3 * (x - x_begin);
+        p[0] = hit ? 255 : 0;
+        p[1] = hit ? 200 : 0;
+        p[2] = hit ? 50 : 0;
+    }
+}
+
+} // namespace kernels
+
+} // namespace cpp_engine::generators
@@ -0,0 +1,430 @@
+// generators/video_encoder.cpp
+#include "generators/video_encoder.h"
+#include "optimization/bounded_queue.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#ifdef WITH_FFMPEG
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/opt.h>
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+#endif
+
+namespace cpp_engine::generators {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// "h264" and friends to a fourcc; anything else of four characters is taken as one
+int fourcc_for(const std::string& codec) {
+    if (codec == "h264" || codec == "avc1") return cv::VideoWriter::fourcc('a', 'v', 'c', '1');
+    if (codec == "mjpg" || codec == "mjpeg") return cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+    if (codec == "vp9" || codec == "vp09") return cv::VideoWriter::fourcc('V', 'P', '9', '0');
+    if (codec == "hevc" || codec == "h265") return cv::VideoWriter::fourcc('h', 'v', 'c', '1');
+    if (codec == "mpeg4") return cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+    if (codec.size() == 4) return cv::VideoWriter::fourcc(codec[0], codec[1], codec[2], codec[3]);
+    return cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+}
+
+#ifdef WITH_FFMPEG
+struct CodecAlias {
+    const char* name;
+    const char* encoder;  // preferred implementation, by name
+    AVCodecID id;         // any encoder of the format when that one is missing
+};
+
+constexpr CodecAlias CODEC_ALIASES[] = {
+    {"h264", "libx264", AV_CODEC_ID_H264},    {"avc1", "libx264", AV_CODEC_ID_H264},
+    {"hevc", "libx265", AV_CODEC_ID_HEVC},    {"h265", "libx265", AV_CODEC_ID_HEVC},
+    {"vp9", "libvpx-vp9", AV_CODEC_ID_VP9},   {"vp09", "libvpx-vp9", AV_CODEC_ID_VP9},
+    {"mpeg4", "mpeg4", AV_CODEC_ID_MPEG4},    {"mp4v", "mpeg4", AV_CODEC_ID_MPEG4},
+    {"mjpeg", "mjpeg", AV_CODEC_ID_MJPEG},    {"mjpg", "mjpeg", AV_CODEC_ID_MJPEG},
+};
+
+// Fewest rows worth a conversion band of their own; bands start on even rows so 4:2:0 chroma splits cleanly
+constexpr int MIN_BAND_ROWS = 64;
+
+const AVCodec* find_encoder(const std::string& codec) {
+    for (const CodecAlias& alias : CODEC_ALIASES) {
+        if (codec != alias.name) continue;
+        const AVCodec* found = avcodec_find_encoder_by_name(alias.encoder);
+        return found ? found : avcodec_find_encoder(alias.id);
+    }
+    return avcodec_find_encoder_by_name(codec.c_str());
+}
+
+// YUV 4:2:0 when the encoder takes it, else its first format
+AVPixelFormat pixel_format_for(const AVCodec* codec) {
+    const AVPixelFormat* formats = nullptr;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(61, 13, 100)
+    // AVCodec::pix_fmts is deprecated from FFmpeg 7.1
+    const void* configs = nullptr;
+    if (avcodec_get_supported_config(nullptr, codec, AV_CODEC_CONFIG_PIX_FORMAT, 0, &configs, nullptr) >= 0) {
+        formats = static_cast<const AVPixelFormat*>(configs);
+    }
+#else
+    formats = codec->pix_fmts;
+#endif
+    if (!formats) return AV_PIX_FMT_YUV420P;
+    for (const AVPixelFormat* f = formats; *f != AV_PIX_FMT_NONE; ++f) {
+        if (*f == AV_PIX_FMT_YUV420P) return *f;
+    }
+    return formats[0];
+}
+
+std::string av_error(int code) {
+    char text[AV_ERROR_MAX_STRING_SIZE] = {};
+    av_strerror(code, text, sizeof(text));
+    return text;
+}
+#endif
+
+} // namespace
+
+struct VideoEncoder::Impl {
+    Backend backend = Backend::NONE;
+    bool open = false;
+    int width = 0;
+    int height = 0;
+    std::unique_ptr<cppengine::optimization::BoundedQueue<cv::Mat>> queue;
+    std::thread worker;
+    std::atomic<bool> failed{false};
+    std::atomic<size_t> frames{0};
+    std::atomic<int64_t> encode_ns{0};
+    size_t peak_queued = 0;
+
+    cv::VideoWriter writer;
+
+#ifdef WITH_FFMPEG
+    AVFormatContext* format = nullptr;
+    AVCodecContext* codec = nullptr;
+    AVStream* stream = nullptr;
+    AVFrame* frame = nullptr;
+    AVPacket* packet = nullptr;
+    std::vector<SwsContext*> bands;  // one converter per horizontal band, run in parallel
+    std::vector<int> band_start;     // first row of each band, then height
+    int chroma_shift = 0;            // log2 of the vertical chroma subsampling
+    int64_t pts = 0;
+
+    bool open_libav(const std::string& path, double fps, const VideoEncoderOptions& options);
+    bool encode_libav(const cv::Mat& bgr);
+    bool drain_packets();
+    bool finish_libav();
+    void release_libav();
+#endif
+
+    bool open_writer(const std::string& path, double fps, const VideoEncoderOptions& options);
+    bool write_writer(const cv::Mat& bgr);
+    void run();
+};
+
+#ifdef WITH_FFMPEG
+bool VideoEncoder::Impl::open_libav(const std::string& path, double fps, const VideoEncoderOptions& options) {
+    const AVCodec* encoder = find_encoder(options.codec);
+    if (!encoder) return false;
+    if (width % 2 || height % 2) {
+        utils::Logger::instance().warning("VideoEncoder: odd frame size, 4:2:0 needs even; using cv::VideoWriter");
+        return false;
+    }
+    auto fail = [&](const std::string& what, int code) {
+        utils::Logger::instance().warning("VideoEncoder: " + what + " (" + av_error(code) + ")");
+        release_libav();
+        return false;
+    };
+
+    int code = avformat_alloc_output_context2(&format, nullptr, nullptr, path.c_str());
+    if (code < 0 || !format) return fail("no container for " + path, code);
+    codec = avcodec_alloc_context3(encoder);
+    if (!codec) return fail("cannot allocate " + std::string(encoder->name), AVERROR(ENOMEM));
+
+    const AVRational rate = av_d2q(fps, 100000);
+    codec->width = width;
+    codec->height = height;
+    codec->pix_fmt = pixel_format_for(encoder);
+    // JPEG is full range; mjpeg refuses limited-range yuv420p unless told to be non-standard
+    if (encoder->id == AV_CODEC_ID_MJPEG) codec->color_range = AVCOL_RANGE_JPEG;
+    codec->framerate = rate;
+    codec->time_base = av_inv_q(rate);
+    codec->thread_count = std::max(0, options.threads);  // 0 lets libavcodec pick one per core
+    codec->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    if (format->oformat->flags & AVFMT_GLOBALHEADER) codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+    // Rate control: a target bitrate, else the codec's constant-quality mode (CRF for x264/x265/vpx,
+    // a fixed quantizer for mpeg4/mjpeg, which have no CRF)
+    if (options.bitrate_kbps > 0) {
+        codec->bit_rate = static_cast<int64_t>(options.bitrate_kbps) * 1000;
+    } else if (av_opt_set_int(codec->priv_data, "crf", options.crf, 0) < 0) {
+        codec->flags |= AV_CODEC_FLAG_QSCALE;
+        codec->global_quality = FF_QP2LAMBDA * std::clamp((options.crf + 2) / 5, 2, 31);
+    }
+    // Optional per-encoder knobs; encoders without them ignore the failure
+    if (!options.preset.empty()) av_opt_set(codec->priv_data, "preset", options.preset.c_str(), 0);
+    av_opt_set_int(codec->priv_data, "row-mt", 1, 0);  // libvpx-vp9 threads within a frame only with row-mt
+
+    if ((code = avcodec_open2(codec, encoder, nullptr)) < 0) return fail("cannot open " + std::string(encoder->name), code);
+    stream = avformat_new_stream(format, nullptr);
+    if (!stream) return fail("cannot add a stream to " + path, AVERROR(ENOMEM));
+    if ((code = avcodec_parameters_from_context(stream->codecpar, codec)) < 0) return fail("bad codec parameters", code);
+    stream->time_base = codec->time_base;
+    stream->avg_frame_rate = rate;
+    if (!(format->oformat->flags & AVFMT_NOFILE) && (code = avio_open(&format->pb, path.c_str(), AVIO_FLAG_WRITE)) < 0) {
+        return fail("cannot create " + path, code);
+    }
+    if ((code = avformat_write_header(format, nullptr)) < 0) return fail("cannot write the header of " + path, code);
+
+    frame = av_frame_alloc();
+    packet = av_packet_alloc();
+    if (!frame || !packet) return fail("out of memory", AVERROR(ENOMEM));
+    frame->format = codec->pix_fmt;
+    frame->width = width;
+    frame->height = height;
+    if ((code = av_frame_get_buffer(frame, 0)) < 0) return fail("cannot allocate a frame", code);
+
+    // Same-size BGR -> YUV has no vertical filter, so bands convert independently
+    chroma_shift = av_pix_fmt_desc_get(codec->pix_fmt)->log2_chroma_h;
+    const int band_count = std::max(1, std::min(cv::getNumThreads(), height / MIN_BAND_ROWS));
+    const int band_rows = ((height + band_count - 1) / band_count + 1) & ~1;
+    for (int y = 0; y < height; y += band_rows) {
+        const int rows = std::min(band_rows, height - y);
+        SwsContext* band = sws_getContext(width, rows, AV_PIX_FMT_BGR24, width, rows, codec->pix_fmt, SWS_POINT,
+                                          nullptr, nullptr, nullptr);
+        if (!band) return fail("no BGR to " + std::string(av_get_pix_fmt_name(codec->pix_fmt)) + " conversion",
+                               AVERROR(EINVAL));
+        if (codec->color_range == AVCOL_RANGE_JPEG) {
+            const int* coefficients = sws_getCoefficients(SWS_CS_DEFAULT);
+            sws_setColorspaceDetails(band, coefficients, 1, coefficients, 1, 0, 1 << 16, 1 << 16);
+        }
+        bands.push_back(band);
+        band_start.push_back(y);
+    }
+    band_start.push_back(height);
+    utils::Logger::instance().info("VideoEncoder: " + std::string(encoder->name) + " " + std::to_string(width) + "x" +
+                                   std::to_string(height) + ", " + std::to_string(bands.size()) + " conversion bands");
+    return true;
+}
+
+bool VideoEncoder::Impl::encode_libav(const cv::Mat& bgr) {
+    // The encoder may still reference the previous frame's buffer under frame threading
+    int code = av_frame_make_writable(frame);
+    if (code < 0) {
+        utils::Logger::instance().error("VideoEncoder: frame not writable (" + av_error(code) + ")");
+        return false;
+    }
+    cv::parallel_for_(cv::Range(0, static_cast<int>(bands.size())), [&](const cv::Range& range) {
+        for (int b = range.start; b < range.end; ++b) {
+            const int y = band_start[b];
+            const uint8_t* src[1] = {bgr.ptr<uint8_t>(y)};
+            const int src_stride[1] = {static_cast<int>(bgr.step)};
+            uint8_t* dst[AV_NUM_DATA_POINTERS] = {};
+            for (int p = 0; p < AV_NUM_DATA_POINTERS && frame->data[p]; ++p) {
+                const int row = (p == 1 || p == 2) ? (y >> chroma_shift) : y;
+                dst[p] = frame->data[p] + static_cast<ptrdiff_t>(row) * frame->linesize[p];
+            }
+            sws_scale(bands[b], src, src_stride, 0, band_start[b + 1] - y, dst, frame->linesize);
+        }
+    });
+    frame->pts = pts++;
+    if ((code = avcodec_send_frame(codec, frame)) < 0) {
+        utils::Logger::instance().error("VideoEncoder: encode failed (" + av_error(code) + ")");
+        return false;
+    }
+    return drain_packets();
+}
+
+bool VideoEncoder::Impl::drain_packets() {
+    for (;;) {
+        int code = avcodec_receive_packet(codec, packet);
+        if (code == AVERROR(EAGAIN) || code == AVERROR_EOF) return true;
+        if (code >= 0) {
+            av_packet_rescale_ts(packet, codec->time_base, stream->time_base);
+            packet->stream_index = stream->index;
+            code = av_interleaved_write_frame(format, packet);  // takes the packet's reference
+        }
+        if (code < 0) {
+            utils::Logger::instance().error("VideoEncoder: cannot write a packet (" + av_error(code) + ")");
+            return false;
+        }
+    }
+}
+
+bool VideoEncoder::Impl::finish_libav() {
+    bool ok = avcodec_send_frame(codec, nullptr) >= 0 && drain_packets();
+    ok = av_write_trailer(format) >= 0 && ok;
+    release_libav();
+    return ok;
+}
+
+void VideoEncoder::Impl::release_libav() {
+    for (SwsContext* band : bands) sws_freeContext(band);
+    bands.clear();
+    band_start.clear();
+    av_packet_free(&packet);
+    av_frame_free(&frame);
+    avcodec_free_context(&codec);
+    if (format) {
+        if (!(format->oformat->flags & AVFMT_NOFILE)) avio_closep(&format->pb);
+        avformat_free_context(format);
+        format = nullptr;
+    }
+    stream = nullptr;
+    pts = 0;
+}
+#endif
+
+bool VideoEncoder::Impl::open_writer(const std::string& path, double fps, const VideoEncoderOptions& options) {
+    // Neither preset, CRF nor bitrate has a cv::VideoWriter property; the backend's defaults apply
+    try {
+        if (!writer.open(path, fourcc_for(options.codec), fps, cv::Size(width, height))) {
+            utils::Logger::instance().warning("VideoEncoder: no " + options.codec + " writer, falling back to mp4v");
+            writer.open(path, cv::VideoWriter::fourcc('m', 'p', '4', 'v'), fps, cv::Size(width, height));
+        }
+    } catch (const cv::Exception& e) {
+        utils::Logger::instance().error("VideoEncoder: OpenCV error opening " + path + ": " + e.what());
+        return false;
+    }
+    return writer.isOpened();
+}
+
+bool VideoEncoder::Impl::write_writer(const cv::Mat& bgr) {
+    // cv::VideoWriter::write() returns nothing; a backend that fails releases itself or throws
+    try {
+        writer.write(bgr);
+    } catch (const cv::Exception& e) {
+        utils::Logger::instance().error(std::string("VideoEncoder: OpenCV error writing frame: ") + e.what());
+        return false;
+    }
+    if (!writer.isOpened()) {
+        utils::Logger::instance().error("VideoEncoder: video writer closed while writing");
+        return false;
+    }
+    return true;
+}
+
+void VideoEncoder::Impl::run() {
+    cv::Mat bgr;
+    while (queue->pop(bgr)) {
+        if (failed) continue;  // drain so a blocked write() returns
+        const auto start = Clock::now();
+        bool ok = true;
+#ifdef WITH_FFMPEG
+        if (backend == Backend::LIBAVCODEC) ok = encode_libav(bgr);
+#endif
+        if (backend == Backend::VIDEO_WRITER) ok = write_writer(bgr);
+        bgr.release();
+        encode_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        if (ok) ++frames;
+        else failed = true;
+    }
+}
+
+VideoEncoder::VideoEncoder() : impl_(std::make_unique<Impl>()) {}
+
+VideoEncoder::~VideoEncoder() {
+    close();
+}
+
+bool VideoEncoder::libavcodec_available() {
+#ifdef WITH_FFMPEG
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* VideoEncoder::backend_name(Backend backend) {
+    switch (backend) {
+        case Backend::LIBAVCODEC: return "libavcodec";
+        case Backend::VIDEO_WRITER: return "cv::VideoWriter";
+        default: return "none";
+    }
+}
+
+bool VideoEncoder::open(const std::string& path, int width, int height, double fps,
+                        const VideoEncoderOptions& options) {
+    close();
+    if (width <= 0 || height <= 0 || !(fps > 0.0)) {
+        utils::Logger::instance().error("VideoEncoder: invalid size " + std::to_string(width) + "x" +
+                                        std::to_string(height) + " or fps " + std::to_string(fps));
+        return false;
+    }
+    Impl& impl = *impl_;
+    impl.width = width;
+    impl.height = height;
+    impl.failed = false;
+    impl.frames = 0;
+    impl.encode_ns = 0;
+    impl.peak_queued = 0;
+    impl.backend = Backend::NONE;
+#ifdef WITH_FFMPEG
+    if (impl.open_libav(path, fps, options)) impl.backend = Backend::LIBAVCODEC;
+#endif
+    if (impl.backend == Backend::NONE) {
+        if (!impl.open_writer(path, fps, options)) {
+            utils::Logger::instance().error("VideoEncoder: cannot create video " + path);
+            return false;
+        }
+        impl.backend = Backend::VIDEO_WRITER;
+    }
+    impl.queue = std::make_unique<cppengine::optimization::BoundedQueue<cv::Mat>>(std::max<size_t>(options.queue_frames, 1));
+    impl.worker = std::thread([&impl] { impl.run(); });
+    impl.open = true;
+    return true;
+}
+
+bool VideoEncoder::write(const cv::Mat& frame) {
+    Impl& impl = *impl_;
+    if (!impl.open || impl.failed) return false;
+    if (frame.type() != CV_8UC3 || frame.cols != impl.width || frame.rows != impl.height) {
+        utils::Logger::instance().error("VideoEncoder: frame is not " + std::to_string(impl.width) + "x" +
+                                        std::to_string(impl.height) + " BGR");
+        return false;
+    }
+    if (!impl.queue->push(frame)) return false;  // shares the buffer; no pixel copy
+    impl.peak_queued = std::max(impl.peak_queued, impl.queue->size());
+    return true;
+}
+
+bool VideoEncoder::close() {
+    Impl& impl = *impl_;
+    if (!impl.open) return true;
+    impl.queue->close();
+    impl.worker.join();
+    impl.open = false;
+    bool ok = !impl.failed;
+#ifdef WITH_FFMPEG
+    if (impl.backend == Backend::LIBAVCODEC) ok = impl.finish_libav() && ok;
+#endif
+    if (impl.backend == Backend::VIDEO_WRITER) impl.writer.release();
+    return ok;
+}
+
+bool VideoEncoder::is_open() const {
+    return impl_->open;
+}
+
+VideoEncoder::Backend VideoEncoder::backend() const {
+    return impl_->backend;
+}
+
+VideoEncoder::Stats VideoEncoder::stats() const {
+    Stats stats;
+    stats.frames = impl_->frames;
+    stats.encode_ms = impl_->encode_ns / 1e6;
+    stats.peak_queued = impl_->peak_queued;
+    return stats;
+}
+
+} // namespace cpp_engine::generators
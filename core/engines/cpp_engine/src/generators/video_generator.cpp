@@ -1,28 +1,144 @@
 // generators/video_generator.cpp
 #include "generators/video_generator.h"
+#include "filters/image_filter.h"
+#include "filters/resample.h"
+#include "optimization/bounded_queue.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace cpp_engine::generators {
 
-VideoGenerator::VideoGenerator() : codec_("h264"), bitrate_(5000) {}
+using cppengine::optimization::ImageEncoder;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// One image of a sequence on its way to the encoder
+struct SequenceFrame {
+    int index = 0;
+    bool repeat = false;  // same path as the previous image: not decoded, its frame is written again
+    cv::Mat image;        // empty when unreadable
+};
+
+bool read_file(const std::string& path, std::vector<unsigned char>& bytes) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const std::streamsize size = in.tellg();
+    if (size <= 0) return false;
+    bytes.resize(static_cast<size_t>(size));
+    in.seekg(0);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(bytes.data()), size));
+}
+
+// Width/height from a JPEG SOF or a PNG IHDR without decoding
+bool read_image_size(const std::vector<unsigned char>& bytes, int& width, int& height) {
+    return cppengine::filters::read_jpeg_size(bytes.data(), bytes.size(), width, height) ||
+           cppengine::filters::read_png_size(bytes.data(), bytes.size(), width, height);
+}
+
+// Output size of a sequence: the requested one, completed from the first readable image's aspect
+bool sequence_size(const std::vector<std::string>& paths, const ImageSequenceOptions& options, cv::Size& size) {
+    if (options.width > 0 && options.height > 0) {
+        size = cv::Size(options.width, options.height);
+        return true;
+    }
+    std::vector<unsigned char> bytes;
+    int width = 0, height = 0;
+    for (const std::string& path : paths) {
+        if (!read_file(path, bytes)) continue;
+        if (read_image_size(bytes, width, height)) break;
+        cv::Mat image;
+        if (cppengine::filters::ImageFilter::decode_for_size(bytes, 0, 0, image)) {
+            width = image.cols;
+            height = image.rows;
+            break;
+        }
+    }
+    if (width <= 0 || height <= 0) return false;
+    if (options.width > 0) {
+        height = std::max(1, static_cast<int>(static_cast<int64_t>(height) * options.width / width));
+        width = options.width;
+    } else if (options.height > 0) {
+        width = std::max(1, static_cast<int>(static_cast<int64_t>(width) * options.height / height));
+        height = options.height;
+    }
+    size = cv::Size(width, height);
+    return true;
+}
+
+} // namespace
+
+VideoGenerator::VideoGenerator() {}
+
+VideoGenerator::VideoGenerator(const ProceduralVideoOptions& options) : options_(options) {}
 
 VideoGenerator::~VideoGenerator() {}
 
 void VideoGenerator::set_codec(const std::string& codec) {
-    codec_ = codec;
-    std::cout << "VideoGenerator: codec set to " << codec_ << std::endl;
+    video_options_.codec = codec;
+    std::cout << "VideoGenerator: codec set to " << codec << std::endl;
 }
 
 void VideoGenerator::set_bitrate(int bitrate) {
-    bitrate_ = bitrate;
-    std::cout << "VideoGenerator: bitrate set to " << bitrate_ << std::endl;
+    video_options_.bitrate_kbps = bitrate;
+    std::cout << "VideoGenerator: bitrate set to " << bitrate << std::endl;
 }
 
-bool VideoGenerator::generate_perlin_video(int width, int height, int frames, int fps, int seed, const std::string& output_path) {
-    (void)width; (void)height; (void)frames; (void)fps; (void)seed; (void)output_path;
-    std::cout << "VideoGenerator: generate_perlin_video stub - " << width << "x" << height 
-              << ", " << frames << " frames, " << fps << " fps, seed: " << seed << std::endl;
-    return true; // Stub implementation
+bool VideoGenerator::render(const VideoRequest& request, const FrameSink& sink, ProceduralVideo::Stats* stats) const {
+    ProceduralVideoOptions options = options_;
+    options.tiles.noise = request.noise;
+    options.loop_frames = request.loop_frames;
+    ProceduralVideo video(options);
+    const bool ok = video.render(request.kind, request.width, request.height, request.frames, request.seed, sink);
+    if (stats) *stats = video.stats();
+    return ok;
+}
+
+bool VideoGenerator::encode_frames(const VideoRequest& request, const std::string& format,
+                                   const EncodedFrameSink& sink, ProceduralVideo::Stats* stats) const {
+    std::vector<unsigned char> bytes;
+    bool encoded = true;
+    const bool ok = render(request, [&](int index, const cv::Mat& frame) {
+        if (!ImageEncoder::encode(frame, format, encode_options_, bytes).success) {
+            utils::Logger::instance().error("VideoGenerator: cannot encode frame " + std::to_string(index) +
+                                            " as " + format);
+            encoded = false;
+            return false;
+        }
+        return sink(index, bytes);
+    }, stats);
+    return ok && encoded;
+}
+
+bool VideoGenerator::generate_perlin_video(int width, int height, int frames, int fps, int seed,
+                                           const std::string& output_path) {
+    if (fps <= 0) {
+        utils::Logger::instance().error("VideoGenerator: invalid fps " + std::to_string(fps));
+        return false;
+    }
+    VideoEncoder encoder;
+    if (!encoder.open(output_path, width, height, fps, video_options_)) return false;
+
+    VideoRequest request;
+    request.width = width;
+    request.height = height;
+    request.frames = frames;
+    request.seed = static_cast<unsigned int>(seed);
+    // Frames are fresh Mats, so the encoder queues them without copying while the next ones render
+    const bool rendered = render(request, [&](int, const cv::Mat& frame) { return encoder.write(frame); });
+    return encoder.close() && rendered;
 }
 
 bool VideoGenerator::generate_video(const std::string& prompt, const std::string& output_path, int duration_seconds) {
@@ -31,14 +147,140 @@ bool VideoGenerator::generate_video(const std::string& prompt, const std::string
     return true; // Stub implementation
 }
 
-bool VideoGenerator::generate_video_from_images(const std::vector<std::string>& image_paths, const std::string& output_path) {
-    (void)image_paths; (void)output_path;
-    std::cout << "VideoGenerator: generate_video_from_images stub - " << image_paths.size() << " images" << std::endl;
-    return true; // Stub implementation
+bool VideoGenerator::generate_video_from_images(const std::vector<std::string>& image_paths,
+                                                const std::string& output_path) {
+    return generate_video_from_images(image_paths, output_path, ImageSequenceOptions());
+}
+
+bool VideoGenerator::generate_video_from_images(const std::vector<std::string>& image_paths,
+                                                const std::string& output_path, const ImageSequenceOptions& options,
+                                                ImageSequenceStats* stats) {
+    ImageSequenceStats result;
+    if (stats) *stats = result;
+    cv::Size target;
+    if (image_paths.empty() || !sequence_size(image_paths, options, target)) {
+        utils::Logger::instance().error("VideoGenerator: no readable image for " + output_path);
+        return false;
+    }
+    VideoEncoder encoder;
+    if (!encoder.open(output_path, target.width, target.height, options.fps, video_options_)) return false;
+
+    const auto start = Clock::now();
+    const int count = static_cast<int>(image_paths.size());
+    const int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int decoders = std::min(options.decoders > 0 ? options.decoders : hardware, count);
+    const int resizers = options.resizers > 0 ? options.resizers : std::max(1, decoders / 2);
+    const int window = std::max(options.max_frames_in_flight > 0 ? options.max_frames_in_flight : 2 * decoders,
+                                decoders);
+
+    cppengine::optimization::BoundedQueue<SequenceFrame> decoded(static_cast<size_t>(window));
+    cppengine::optimization::BoundedQueue<SequenceFrame> ready(static_cast<size_t>(window));
+    std::atomic<int> next_frame{0};
+    std::atomic<int> decoders_left{decoders}, resizers_left{resizers};
+    std::atomic<int> resized{0};
+    std::atomic<int64_t> decode_us{0};
+    std::mutex mutex;
+    std::condition_variable delivered_cv;
+    int delivered = 0;
+    bool stop = false;
+
+    auto decode_loop = [&] {
+        std::vector<unsigned char> bytes;
+        for (;;) {
+            const int index = next_frame.fetch_add(1);
+            if (index >= count) break;
+            {
+                // Stay within the window so the reorder buffer cannot grow behind a slow image
+                std::unique_lock<std::mutex> lock(mutex);
+                delivered_cv.wait(lock, [&] { return stop || index < delivered + window; });
+                if (stop) break;
+            }
+            SequenceFrame frame;
+            frame.index = index;
+            frame.repeat = index > 0 && image_paths[index] == image_paths[index - 1];
+            if (!frame.repeat) {
+                const auto decode_start = Clock::now();
+                if (!read_file(image_paths[index], bytes) ||
+                    !cppengine::filters::ImageFilter::decode_for_size(bytes, target.width, target.height,
+                                                                      frame.image)) {
+                    utils::Logger::instance().error("VideoGenerator: cannot read image " + image_paths[index]);
+                    frame.image.release();
+                }
+                decode_us += std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - decode_start).count();
+            }
+            if (!decoded.push(std::move(frame))) break;
+        }
+        if (decoders_left.fetch_sub(1) == 1) decoded.close();
+    };
+
+    auto resize_loop = [&] {
+        cppengine::filters::Resampler resampler;  // keeps its taps and buffers across frames of one size
+        SequenceFrame frame;
+        while (decoded.pop(frame)) {
+            if (!frame.image.empty() && frame.image.size() != target) {
+                cv::Mat scaled(target, CV_8UC3);
+                resampler.resize(frame.image.data, frame.image.step, frame.image.rows, frame.image.cols, scaled.data,
+                                 scaled.step, target.height, target.width, 3, cppengine::filters::ResizeKernel::AREA);
+                frame.image = scaled;
+                ++resized;
+            }
+            if (!ready.push(std::move(frame))) break;
+        }
+        if (resizers_left.fetch_sub(1) == 1) ready.close();
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < decoders; ++t) workers.emplace_back(decode_loop);
+    for (int t = 0; t < resizers; ++t) workers.emplace_back(resize_loop);
+
+    // Encoder side: reorder, then write in sequence; frames are fresh Mats, queued without copying
+    std::map<int, SequenceFrame> pending;
+    cv::Mat last;
+    bool written = true;
+    int next_index = 0;
+    SequenceFrame item;
+    while (written && next_index < count && ready.pop(item)) {
+        pending.emplace(item.index, std::move(item));
+        for (auto it = pending.find(next_index); written && it != pending.end(); it = pending.find(next_index)) {
+            if (!it->second.repeat) last = it->second.image;
+            if (last.empty()) {
+                ++result.failed;
+            } else if ((written = encoder.write(last))) {
+                ++result.frames;
+                if (it->second.repeat) ++result.reused;
+            }
+            pending.erase(it);
+            ++next_index;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                delivered = next_index;
+            }
+            delivered_cv.notify_all();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    delivered_cv.notify_all();
+    decoded.close();
+    ready.close();
+    for (auto& worker : workers) worker.join();
+    const bool closed = encoder.close();
+
+    result.resized = resized;
+    result.decode_ms = decode_us / 1000.0;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (stats) *stats = result;
+    utils::Logger::instance().info("VideoGenerator: " + std::to_string(result.frames) + " frames from " +
+                                   std::to_string(count) + " images (" + std::to_string(result.failed) +
+                                   " unreadable) to " + output_path);
+    return written && closed && result.frames > 0;
 }
 
 std::vector<std::string> VideoGenerator::get_available_models() {
     return {"stub_video_model_v1", "stub_video_model_v2"};
 }
 
-} // namespace cpp_engine::generators
\ No newline at end of file
+} // namespace cpp_engine::generators
@@ -4,18 +4,29 @@
 #include "filters/image_filter.h"
 #include "effects/effects_engine.h"
 #include "optimization/performance_optimizer.h"
+#include "optimization/batch_pipeline.h"
+#include "optimization/frame_pool.h"
+#include "optimization/image_encoder.h"
+#include "optimization/memfd_handoff.h"
+#include "optimization/parameter_sweep.h"
+#include "optimization/video_pipeline.h"
 #include "utils/logger.h"
 #include "utils/config.h"
 #include "modules/system/memory_manager.h"
 #include "modules/system/notification_manager.h"
 #include "modules/vision/kinect_interface.h"
 
+#include <opencv2/core.hpp>
+
 #include <iostream>
 #include <string>
 #include <vector>
 #include <sstream>
+#include <stdexcept>
 #include <thread>
 #include <chrono>
+#include <functional>
+#include <memory>
 
 using namespace cppengine;
 
@@ -25,12 +36,31 @@ void print_usage() {
               << "  demo                    Run full demo (default)\n"
               << "  filter <type> <input> <output> [params...]  Apply image filter\n"
               << "  effect <type> <input> <output> [params...]  Apply visual effect\n"
+              << "  filter-batch <type> <input_dir|list.txt> <output_dir> [params...] [batch options]\n"
+              << "  effect-batch <type> <input_dir|list.txt> <output_dir> [params...] [batch options]\n"
+              << "  filter-video <type> <input_video> <output_video> [params...] [video options]\n"
+              << "  effect-video <type> <input_video> <output_video> [params...] [video options]\n"
+              << "  sweep <type> <input> <output> <v1> [v2...]   One decode, one output per parameter value (a:b for several)\n"
               << "  kinect_demo            Run Kinect demonstration\n\n"
-              << "Filters: blur, sharpen, gaussian_blur, brightness, contrast, saturation, detect_edges, dilate, erode\n"
-              << "Effects: lighting, shadows, particles, wave_distortion, radial_distortion, chromatic_aberration, bloom\n\n"
+              << "Filters: blur, sharpen, gaussian_blur, brightness, contrast, saturation, detect_edges, dilate, erode,\n"
+              << "         open, close, morph_gradient, resize <w> [h] [area|lanczos], pyramid <w1,w2,...> [area|lanczos]\n"
+              << "Effects: lighting, shadows, particles, wave_distortion, radial_distortion, chromatic_aberration, bloom,\n"
+              << "         particles_video [count] [fire|water|spark] [seed]  (video in/out)\n"
+              << "         bloom <threshold> <intensity> [radius] [pyramid|gaussian]\n"
+              << "Batch options: --decoders N --workers N --encoders N --queue N --progress N\n"
+              << "Video options: --workers N (transform threads) --ring N (frames in flight) --codec h264|hevc|vp9|mp4v|mjpeg\n"
+              << "Encode options: --profile fastest|balanced|smallest|auto --latency-budget-ms N\n"
+              << "Memory options: --pool-mb N (frame buffer cache, 0 = plain allocations) --huge-pages\n"
+              << "filter/effect <input>/<output> may be fd:<n>[.<ext>] memfds passed by cpp_engine_server\n\n"
               << "Examples:\n"
               << "  image_video_generator filter blur input.png output.png 5\n"
               << "  image_video_generator effect bloom input.png output.png 0.8 0.6\n"
+              << "  image_video_generator effect particles_video clip.mp4 out.mp4 100000 spark 7\n"
+              << "  image_video_generator filter-batch dilate catalog/ out/ 31 --workers 16\n"
+              << "  image_video_generator effect-video bloom clip.mp4 out.mp4 0.8 0.6 --workers 8\n"
+              << "  image_video_generator sweep bloom input.png out/bloom.png 0.8:0.3 0.8:0.6 0.7:0.6\n"
+              << "  image_video_generator filter pyramid photo.jpg thumbs/photo.jpg 1024,512,256 lanczos\n"
+              << "  image_video_generator filter blur input.png output.png 5 --profile auto --latency-budget-ms 20\n"
               << "  image_video_generator kinect_demo\n";
 }
 
@@ -47,7 +77,65 @@ bool parse_args(int argc, char* argv[], std::string& command, std::vector<std::s
     return true;
 }
 
-bool run_image_filter(const std::vector<std::string>& args) {
+// Pulls --profile/--latency-budget-ms out of args; a budget without a profile implies auto
+optimization::EncodeOptions parse_encode_options(std::vector<std::string>& args) {
+    optimization::EncodeOptions options;
+    bool profile_given = false;
+    std::vector<std::string> rest;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const bool has_value = i + 1 < args.size();
+        if (args[i] == "--profile" && has_value) {
+            options.profile = optimization::ImageEncoder::parse_profile(args[++i]);
+            profile_given = true;
+        } else if (args[i] == "--latency-budget-ms" && has_value) {
+            options.latency_budget_ms = std::stod(args[++i]);
+        } else {
+            rest.push_back(args[i]);
+        }
+    }
+    if (!profile_given && options.latency_budget_ms > 0.0) options.profile = optimization::EncodeProfile::AUTO;
+    args.swap(rest);
+    return options;
+}
+
+// Pulls --pool-mb/--huge-pages out of args; returns false when pooling is disabled
+bool parse_pool_options(std::vector<std::string>& args, optimization::FramePoolOptions& options) {
+    bool enabled = true;
+    std::vector<std::string> rest;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const bool has_value = i + 1 < args.size();
+        if (args[i] == "--pool-mb" && has_value) {
+            const size_t mb = static_cast<size_t>(std::stoul(args[++i]));
+            enabled = mb > 0;
+            options.max_cached_bytes = mb << 20;
+        } else if (args[i] == "--huge-pages") {
+            options.huge_pages = true;
+        } else {
+            rest.push_back(args[i]);
+        }
+    }
+    args.swap(rest);
+    return enabled;
+}
+
+filters::ResizeKernel parse_resize_kernel(const std::string& name) {
+    if (name == "area") return filters::ResizeKernel::AREA;
+    if (name == "lanczos") return filters::ResizeKernel::LANCZOS3;
+    throw std::invalid_argument("Unknown resize kernel: " + name);
+}
+
+std::vector<int> parse_int_list(const std::string& list) {
+    std::vector<int> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) values.push_back(std::stoi(item));
+    }
+    return values;
+}
+
+bool run_image_filter(std::vector<std::string> args) {
+    const auto encode_options = parse_encode_options(args);
     if (args.size() < 3) {
         std::cerr << "Error: filter command requires at least 3 arguments: <type> <input> <output>\n";
         return false;
@@ -58,6 +146,7 @@ bool run_image_filter(const std::vector<std::string>& args) {
     std::string output_file = args[2];
 
     filters::ImageFilter filter;
+    filter.set_encode_options(encode_options);
     bool result = false;
 
     if (filter_type == "blur") {
@@ -86,12 +175,31 @@ bool run_image_filter(const std::vector<std::string>& args) {
     } else if (filter_type == "erode") {
         int kernel_size = args.size() > 3 ? std::stoi(args[3]) : 2;
         result = filter.erode(input_file, output_file, kernel_size);
+    } else if (filter_type == "open") {
+        int kernel_size = args.size() > 3 ? std::stoi(args[3]) : 3;
+        result = filter.morph_open(input_file, output_file, kernel_size);
+    } else if (filter_type == "close") {
+        int kernel_size = args.size() > 3 ? std::stoi(args[3]) : 3;
+        result = filter.morph_close(input_file, output_file, kernel_size);
+    } else if (filter_type == "morph_gradient") {
+        int kernel_size = args.size() > 3 ? std::stoi(args[3]) : 3;
+        result = filter.morph_gradient(input_file, output_file, kernel_size);
+    } else if (filter_type == "resize") {
+        int width = args.size() > 3 ? std::stoi(args[3]) : 512;
+        int height = args.size() > 4 ? std::stoi(args[4]) : 0;
+        auto kernel = parse_resize_kernel(args.size() > 5 ? args[5] : "area");
+        result = filter.resize(input_file, output_file, width, height, kernel);
+    } else if (filter_type == "pyramid") {
+        auto widths = parse_int_list(args.size() > 3 ? args[3] : "1024,512,256");
+        auto kernel = parse_resize_kernel(args.size() > 4 ? args[4] : "area");
+        result = filter.pyramid(input_file, output_file, widths, kernel);
     } else {
         std::cerr << "Unknown filter type: " << filter_type << "\n";
         return false;
     }
 
     if (result) {
+        std::cout << filter.last_encode().summary() << std::endl;
         cpp_engine::utils::Logger::instance().info("Filter " + filter_type + " applied successfully to " + output_file);
         return true;
     } else {
@@ -100,7 +208,8 @@ bool run_image_filter(const std::vector<std::string>& args) {
     }
 }
 
-bool run_visual_effect(const std::vector<std::string>& args) {
+bool run_visual_effect(std::vector<std::string> args) {
+    const auto encode_options = parse_encode_options(args);
     if (args.size() < 3) {
         std::cerr << "Error: effect command requires at least 3 arguments: <type> <input> <output>\n";
         return false;
@@ -111,6 +220,7 @@ bool run_visual_effect(const std::vector<std::string>& args) {
     std::string output_file = args[2];
 
     effects::EffectsEngine effects;
+    effects.set_encode_options(encode_options);
     bool result = false;
 
     if (effect_type == "lighting") {
@@ -125,6 +235,11 @@ bool run_visual_effect(const std::vector<std::string>& args) {
         int count = args.size() > 3 ? std::stoi(args[3]) : 50;
         std::string type = args.size() > 4 ? args[4] : "fire";
         result = effects.add_particles(input_file, output_file, count, type);
+    } else if (effect_type == "particles_video") {
+        int count = args.size() > 3 ? std::stoi(args[3]) : 100000;
+        std::string type = args.size() > 4 ? args[4] : "fire";
+        if (args.size() > 5) effects.set_particle_seed(std::stoull(args[5]));
+        result = effects.add_particles_video(input_file, output_file, count, type);
     } else if (effect_type == "wave_distortion") {
         float amplitude = args.size() > 3 ? std::stof(args[3]) : 10.0f;
         float frequency = args.size() > 4 ? std::stof(args[4]) : 0.02f;
@@ -139,6 +254,13 @@ bool run_visual_effect(const std::vector<std::string>& args) {
     } else if (effect_type == "bloom") {
         float threshold = args.size() > 3 ? std::stof(args[3]) : 0.8f;
         float intensity = args.size() > 4 ? std::stof(args[4]) : 0.6f;
+        effects::BloomOptions bloom;
+        if (args.size() > 5) bloom.radius = std::stoi(args[5]);
+        if (args.size() > 6 && !effects::Bloom::parse_mode(args[6], bloom.mode)) {
+            std::cerr << "Unknown bloom mode: " << args[6] << " (gaussian|pyramid)\n";
+            return false;
+        }
+        effects.set_bloom_options(bloom);
         result = effects.apply_bloom(input_file, output_file, threshold, intensity);
     } else {
         std::cerr << "Unknown effect type: " << effect_type << "\n";
@@ -146,6 +268,7 @@ bool run_visual_effect(const std::vector<std::string>& args) {
     }
 
     if (result) {
+        std::cout << effects.last_encode().summary() << std::endl;
         cpp_engine::utils::Logger::instance().info("Effect " + effect_type + " applied successfully to " + output_file);
         return true;
     } else {
@@ -154,6 +277,278 @@ bool run_visual_effect(const std::vector<std::string>& args) {
     }
 }
 
+// ============================================================================
+// Batch mode: one process, overlapped decode/process/encode over many images
+// ============================================================================
+
+template <typename Engine>
+using MatOp = std::function<bool(Engine&, const cv::Mat&, cv::Mat&)>;
+
+// params are the values following <output>, with the same defaults as the single-image commands
+MatOp<filters::ImageFilter> make_filter_op(const std::string& filter_type, const std::vector<std::string>& params) {
+    auto int_arg = [&params](size_t i, int def) { return params.size() > i ? std::stoi(params[i]) : def; };
+    auto float_arg = [&params](size_t i, float def) { return params.size() > i ? std::stof(params[i]) : def; };
+    using F = filters::ImageFilter;
+
+    if (filter_type == "blur") {
+        int radius = int_arg(0, 5);
+        return [radius](F& f, const cv::Mat& in, cv::Mat& out) { return f.apply_blur(in, out, radius); };
+    } else if (filter_type == "sharpen") {
+        float strength = float_arg(0, 1.0f);
+        return [strength](F& f, const cv::Mat& in, cv::Mat& out) { return f.apply_sharpen(in, out, strength); };
+    } else if (filter_type == "gaussian_blur") {
+        int kernel_size = int_arg(0, 5);
+        return [kernel_size](F& f, const cv::Mat& in, cv::Mat& out) { return f.apply_gaussian_blur(in, out, kernel_size); };
+    } else if (filter_type == "brightness") {
+        float factor = float_arg(0, 0.5f);
+        return [factor](F& f, const cv::Mat& in, cv::Mat& out) { return f.adjust_brightness(in, out, factor); };
+    } else if (filter_type == "contrast") {
+        float factor = float_arg(0, 1.2f);
+        return [factor](F& f, const cv::Mat& in, cv::Mat& out) { return f.adjust_contrast(in, out, factor); };
+    } else if (filter_type == "saturation") {
+        float factor = float_arg(0, 1.5f);
+        return [factor](F& f, const cv::Mat& in, cv::Mat& out) { return f.adjust_saturation(in, out, factor); };
+    } else if (filter_type == "detect_edges") {
+        return [](F& f, const cv::Mat& in, cv::Mat& out) { return f.detect_edges(in, out); };
+    } else if (filter_type == "dilate") {
+        int kernel_size = int_arg(0, 3);
+        return [kernel_size](F& f, const cv::Mat& in, cv::Mat& out) { return f.dilate(in, out, kernel_size); };
+    } else if (filter_type == "erode") {
+        int kernel_size = int_arg(0, 2);
+        return [kernel_size](F& f, const cv::Mat& in, cv::Mat& out) { return f.erode(in, out, kernel_size); };
+    } else if (filter_type == "open") {
+        int kernel_size = int_arg(0, 3);
+        return [kernel_size](F& f, const cv::Mat& in, cv::Mat& out) { return f.morph_open(in, out, kernel_size); };
+    } else if (filter_type == "close") {
+        int kernel_size = int_arg(0, 3);
+        return [kernel_size](F& f, const cv::Mat& in, cv::Mat& out) { return f.morph_close(in, out, kernel_size); };
+    } else if (filter_type == "morph_gradient") {
+        int kernel_size = int_arg(0, 3);
+        return [kernel_size](F& f, const cv::Mat& in, cv::Mat& out) { return f.morph_gradient(in, out, kernel_size); };
+    } else if (filter_type == "resize") {
+        int width = int_arg(0, 512), height = int_arg(1, 0);
+        auto kernel = parse_resize_kernel(params.size() > 2 ? params[2] : "area");
+        return [width, height, kernel](F& f, const cv::Mat& in, cv::Mat& out) {
+            return f.resize(in, out, width, height, kernel);
+        };
+    }
+    return nullptr;
+}
+
+MatOp<effects::EffectsEngine> make_effect_op(const std::string& effect_type, const std::vector<std::string>& params) {
+    auto int_arg = [&params](size_t i, int def) { return params.size() > i ? std::stoi(params[i]) : def; };
+    auto float_arg = [&params](size_t i, float def) { return params.size() > i ? std::stof(params[i]) : def; };
+    using E = effects::EffectsEngine;
+
+    if (effect_type == "lighting") {
+        float lx = float_arg(0, 1.0f), ly = float_arg(1, 0.5f), lz = float_arg(2, 0.8f);
+        return [lx, ly, lz](E& e, const cv::Mat& in, cv::Mat& out) { return e.apply_lighting(in, out, lx, ly, lz); };
+    } else if (effect_type == "shadows") {
+        float intensity = float_arg(0, 0.7f);
+        return [intensity](E& e, const cv::Mat& in, cv::Mat& out) { return e.apply_shadows(in, out, intensity); };
+    } else if (effect_type == "particles") {
+        int count = int_arg(0, 50);
+        std::string type = params.size() > 1 ? params[1] : "fire";
+        return [count, type](E& e, const cv::Mat& in, cv::Mat& out) { return e.add_particles(in, out, count, type); };
+    } else if (effect_type == "wave_distortion") {
+        float amplitude = float_arg(0, 10.0f), frequency = float_arg(1, 0.02f);
+        return [amplitude, frequency](E& e, const cv::Mat& in, cv::Mat& out) {
+            return e.apply_wave_distortion(in, out, amplitude, frequency);
+        };
+    } else if (effect_type == "radial_distortion") {
+        float factor = float_arg(0, 0.0001f);
+        return [factor](E& e, const cv::Mat& in, cv::Mat& out) { return e.apply_radial_distortion(in, out, factor); };
+    } else if (effect_type == "chromatic_aberration") {
+        float red_shift = float_arg(0, 2.0f), blue_shift = float_arg(1, 1.5f);
+        return [red_shift, blue_shift](E& e, const cv::Mat& in, cv::Mat& out) {
+            return e.apply_chromatic_aberration(in, out, red_shift, blue_shift);
+        };
+    } else if (effect_type == "bloom") {
+        float threshold = float_arg(0, 0.8f), intensity = float_arg(1, 0.6f);
+        effects::BloomOptions bloom;
+        bloom.radius = int_arg(2, bloom.radius);
+        if (params.size() > 3 && !effects::Bloom::parse_mode(params[3], bloom.mode)) return nullptr;
+        return [threshold, intensity, bloom](E& e, const cv::Mat& in, cv::Mat& out) {
+            e.set_bloom_options(bloom);
+            return e.apply_bloom(in, out, threshold, intensity);
+        };
+    }
+    return nullptr;
+}
+
+// Pulls --decoders/--workers/--encoders/--queue/--progress and the encode options out of args
+optimization::BatchPipeline::Config parse_batch_options(std::vector<std::string>& args) {
+    optimization::BatchPipeline::Config config;
+    config.encode = parse_encode_options(args);
+    std::vector<std::string> rest;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const bool has_value = i + 1 < args.size();
+        if (args[i] == "--decoders" && has_value) config.decoder_threads = std::stoi(args[++i]);
+        else if (args[i] == "--workers" && has_value) config.worker_threads = std::stoi(args[++i]);
+        else if (args[i] == "--encoders" && has_value) config.encoder_threads = std::stoi(args[++i]);
+        else if (args[i] == "--queue" && has_value) config.queue_capacity = static_cast<size_t>(std::stoul(args[++i]));
+        else if (args[i] == "--progress" && has_value) config.progress_every = std::stoi(args[++i]);
+        else rest.push_back(args[i]);
+    }
+    args.swap(rest);
+    return config;
+}
+
+template <typename Engine>
+bool run_batch(const std::string& kind, std::vector<std::string> args,
+               MatOp<Engine> (*make_op)(const std::string&, const std::vector<std::string>&)) {
+    auto config = parse_batch_options(args);
+    config.report_encodes = true;  // the HTTP server sums these into the task's encode metrics
+    if (args.size() < 3) {
+        std::cerr << "Error: " << kind << "-batch requires at least 3 arguments: <type> <input_dir|list> <output_dir>\n";
+        return false;
+    }
+
+    const std::string type = args[0];
+    const std::vector<std::string> params(args.begin() + 3, args.end());
+    MatOp<Engine> op = make_op(type, params);
+    if (!op) {
+        std::cerr << "Unknown " << kind << " type: " << type << "\n";
+        return false;
+    }
+
+    // Downscaling batches only need enough pixels for the target: let decoders use DCT scaling
+    if (kind == "filter" && type == "resize") {
+        config.decode_width = params.size() > 0 ? std::stoi(params[0]) : 512;
+        config.decode_height = params.size() > 1 ? std::stoi(params[1]) : 0;
+    }
+
+    const auto inputs = optimization::BatchPipeline::collect_inputs(args[1]);
+    if (inputs.empty()) {
+        std::cerr << "No input images found in: " << args[1] << "\n";
+        return false;
+    }
+    const auto jobs = optimization::BatchPipeline::make_jobs(inputs, args[2]);
+
+    // Each worker owns its engine instance (filters keep per-instance scratch buffers)
+    optimization::BatchPipeline pipeline(config);
+    const auto stats = pipeline.run(jobs, [op]() -> optimization::BatchPipeline::Processor {
+        auto engine = std::make_shared<Engine>();
+        return [engine, op](const cv::Mat& in, cv::Mat& out) { return op(*engine, in, out); };
+    });
+
+    cpp_engine::utils::Logger::instance().info(kind + "-batch " + type + ": " + std::to_string(stats.images_ok) +
+                                               "/" + std::to_string(stats.images_total) + " images");
+    return stats.images_failed == 0;
+}
+
+// ============================================================================
+// Video mode: decode thread, per-frame transform pool, in-order encode
+// ============================================================================
+
+// Pulls --workers/--ring/--codec out of args
+optimization::VideoPipeline::Config parse_video_options(std::vector<std::string>& args) {
+    optimization::VideoPipeline::Config config;
+    std::vector<std::string> rest;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const bool has_value = i + 1 < args.size();
+        if (args[i] == "--workers" && has_value) config.transform_threads = std::stoi(args[++i]);
+        else if (args[i] == "--ring" && has_value) config.ring_frames = static_cast<size_t>(std::stoul(args[++i]));
+        else if (args[i] == "--codec" && has_value) config.encode.codec = args[++i];
+        else rest.push_back(args[i]);
+    }
+    args.swap(rest);
+    return config;
+}
+
+template <typename Engine>
+bool run_video(const std::string& kind, std::vector<std::string> args,
+               MatOp<Engine> (*make_op)(const std::string&, const std::vector<std::string>&)) {
+    const auto config = parse_video_options(args);
+    if (args.size() < 3) {
+        std::cerr << "Error: " << kind << "-video requires at least 3 arguments: <type> <input_video> <output_video>\n";
+        return false;
+    }
+
+    const std::string type = args[0];
+    MatOp<Engine> op = make_op(type, std::vector<std::string>(args.begin() + 3, args.end()));
+    if (!op) {
+        std::cerr << "Unknown " << kind << " type: " << type << "\n";
+        return false;
+    }
+
+    // Each transform thread owns its engine instance, as in batch mode
+    optimization::VideoPipeline pipeline(config);
+    const auto stats = pipeline.run(args[1], args[2], [op]() -> optimization::VideoPipeline::Transform {
+        auto engine = std::make_shared<Engine>();
+        return [engine, op](optimization::VideoPipeline::Frame& frame, cv::Mat& out) {
+            return op(*engine, frame.image, out);
+        };
+    });
+    std::cout << kind << "-video " << type << ": " << stats.summary() << std::endl;
+    return stats.ok;
+}
+
+// Single image with input and/or output given as "fd:<n>[.<ext>]" memfds inherited from cpp_engine_server
+bool uses_memfd(const std::vector<std::string>& args) {
+    return args.size() >= 3 &&
+           (optimization::MemfdHandoff::is_fd_spec(args[1]) || optimization::MemfdHandoff::is_fd_spec(args[2]));
+}
+
+template <typename Engine>
+bool run_memfd(const std::string& kind, std::vector<std::string> args,
+               MatOp<Engine> (*make_op)(const std::string&, const std::vector<std::string>&)) {
+    const auto encode_options = parse_encode_options(args);
+    const std::string type = args[0];
+    MatOp<Engine> op = make_op(type, std::vector<std::string>(args.begin() + 3, args.end()));
+    if (!op) {
+        std::cerr << "Unknown " << kind << " type: " << type << "\n";
+        return false;
+    }
+
+    Engine engine;
+    cv::Mat image, result;
+    if (!optimization::MemfdHandoff::load(args[1], image) || !op(engine, image, result)) {
+        cpp_engine::utils::Logger::instance().error("Failed to apply " + kind + " " + type);
+        return false;
+    }
+    const auto encoded = optimization::MemfdHandoff::store(args[2], result, encode_options);
+    if (!encoded.success) return false;
+    std::cout << encoded.summary() << std::endl;
+    return true;
+}
+
+// One decode, every variant of one operation: sweep <op> <input> <output> <v1> <v2> ... (multi-param: a:b)
+bool run_sweep(std::vector<std::string> args) {
+    const auto encode_options = parse_encode_options(args);
+    if (args.size() < 4) {
+        std::cerr << "Error: sweep requires <op> <input> <output> <variant> [variant...]\n";
+        return false;
+    }
+    const std::string op = args[0];
+    const std::vector<std::string> variants(args.begin() + 3, args.end());
+
+    optimization::ParameterSweep sweep;
+    sweep.set_encode_options(encode_options);
+    if (!optimization::ParameterSweep::has_shared_state(op)) {
+        auto filter = std::make_shared<filters::ImageFilter>();
+        auto effects_engine = std::make_shared<effects::EffectsEngine>();
+        sweep.set_fallback([op, filter, effects_engine](const cv::Mat& in, const optimization::ParameterSweep::Params& p, cv::Mat& out) {
+            std::vector<std::string> params;
+            for (float v : p) params.push_back(std::to_string(v));
+            if (auto filter_op = make_filter_op(op, params)) return filter_op(*filter, in, out);
+            if (auto effect_op = make_effect_op(op, params)) return effect_op(*effects_engine, in, out);
+            return false;
+        });
+    }
+
+    std::vector<optimization::ParameterSweep::Output> outputs;
+    if (!sweep.run(op, args[1], args[2], variants, outputs)) {
+        cpp_engine::utils::Logger::instance().error("Parameter sweep " + op + " failed");
+        return false;
+    }
+    for (const auto& o : outputs) {
+        std::cout << o.encode.summary() << " file=" << o.file << std::endl;
+    }
+    std::cout << "[sweep] op=" << op << " variants=" << outputs.size() << std::endl;
+    return true;
+}
+
 bool run_kinect_demo() {
     cpp_engine::utils::Logger::instance().info("Starting Kinect demonstration...");
 
@@ -268,14 +663,34 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
+        // Every cv::Mat of the command draws from the frame pool: video and batch loops stop allocating after warm-up
+        optimization::FramePoolOptions pool_options;
+        std::unique_ptr<optimization::ScopedFramePool> frame_pool;
+        if (parse_pool_options(args, pool_options)) {
+            optimization::FramePool::instance().set_options(pool_options);
+            frame_pool = std::make_unique<optimization::ScopedFramePool>();
+        }
+
         bool success = false;
 
         if (command == "demo") {
             success = run_full_demo();
         } else if (command == "filter") {
-            success = run_image_filter(args);
+            success = uses_memfd(args) ? run_memfd<filters::ImageFilter>("filter", args, &make_filter_op)
+                                       : run_image_filter(args);
         } else if (command == "effect") {
-            success = run_visual_effect(args);
+            success = uses_memfd(args) ? run_memfd<effects::EffectsEngine>("effect", args, &make_effect_op)
+                                       : run_visual_effect(args);
+        } else if (command == "filter-batch") {
+            success = run_batch<filters::ImageFilter>("filter", args, &make_filter_op);
+        } else if (command == "effect-batch") {
+            success = run_batch<effects::EffectsEngine>("effect", args, &make_effect_op);
+        } else if (command == "filter-video") {
+            success = run_video<filters::ImageFilter>("filter", args, &make_filter_op);
+        } else if (command == "effect-video") {
+            success = run_video<effects::EffectsEngine>("effect", args, &make_effect_op);
+        } else if (command == "sweep") {
+            success = run_sweep(args);
         } else if (command == "kinect_demo") {
             success = run_kinect_demo();
         } else {
@@ -284,6 +699,9 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
+        if (frame_pool) {
+            cpp_engine::utils::Logger::instance().info(optimization::FramePool::instance().stats().summary());
+        }
         return success ? 0 : 1;
 
     } catch (const std::exception& e) {
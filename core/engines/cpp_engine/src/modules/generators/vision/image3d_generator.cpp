@@ -1,60 +1,69 @@
 #include <iostream>
-#include <fstream>
-#include <vector>
 #include <string>
-#include <filesystem>
-#include <array>
-#include <cmath>
+#include <stdexcept>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+#include "generators/isosurface.h"
+#include "generators/mesh_io.h"
+#include "generators/mesh_simplifier.h"
 
-namespace fs = std::filesystem;
-
-// Simple procedural 3D shape exporter (OBJ)
+// Procedural 3D shape exporter (OBJ, binary PLY, GLB)
 namespace cpp_engine { namespace modules { namespace generators {
 
+using cpp_engine::generators::IsosurfaceExtractor;
+using cpp_engine::generators::IsosurfaceOptions;
+using cpp_engine::generators::Mesh;
+using cpp_engine::generators::MeshIO;
+using cpp_engine::generators::MeshSimplifier;
+using cpp_engine::generators::MeshTessellator;
+using cpp_engine::generators::SimplifyOptions;
+using cpp_engine::generators::SphereOptions;
+
 class Image3DGenerator {
 public:
     static std::string name() { return "image3d_generator"; }
 
-    // Generate a simple low-poly sphere and write as OBJ
-    static std::string generate_obj(const std::string &output_path, int lat = 8, int lon = 16, float radius = 1.0f) {
-        fs::create_directories(fs::path(output_path).parent_path());
-        std::ofstream out(output_path);
-        if (!out) throw std::runtime_error("Failed to open " + output_path);
-
-        std::vector<std::array<float,3>> verts;
-        for (int i = 0; i <= lat; ++i) {
-            float theta = static_cast<float>(i) / lat * M_PI;
-            for (int j = 0; j < lon; ++j) {
-                float phi = static_cast<float>(j) / lon * 2.0f * M_PI;
-                float x = radius * std::sin(theta) * std::cos(phi);
-                float y = radius * std::cos(theta);
-                float z = radius * std::sin(theta) * std::sin(phi);
-                verts.push_back(std::array<float,3>{x, y, z});
-            }
-        }
-
-        for (auto &v : verts) out << "v " << v[0] << " " << v[1] << " " << v[2] << "\n";
+    // Generate a sphere (optionally noise-displaced) and write it in the format of the
+    // output extension: .obj, .ply (binary) or .glb
+    static std::string generate(const std::string &output_path, const SphereOptions &options) {
+        Mesh mesh;
+        if (!MeshTessellator::sphere(options, mesh)) throw std::runtime_error("Invalid sphere for " + output_path);
+        if (!MeshIO::write(output_path, mesh)) throw std::runtime_error("Failed to write " + output_path);
+        std::cout << "[Image3DGenerator] Wrote " << mesh.triangle_count() << " triangles to " << output_path
+                  << std::endl;
+        return output_path;
+    }
 
-        // Simple face generation
-        int cols = lon;
-        for (int i = 0; i < lat; ++i) {
-            for (int j = 0; j < lon; ++j) {
-                int a = i * cols + j + 1;
-                int b = i * cols + ((j+1)%cols) + 1;
-                int c = (i+1) * cols + ((j+1)%cols) + 1;
-                int d = (i+1) * cols + j + 1;
-                out << "f " << a << " " << b << " " << c << "\n";
-                out << "f " << a << " " << c << " " << d << "\n";
-            }
+    // Extract a noise-displaced sphere by marching cubes on a resolution^3 grid, then decimate it
+    // to target_triangles when given
+    static std::string generate_isosurface(const std::string &output_path, int resolution = 128, unsigned int seed = 0,
+                                           size_t target_triangles = 0) {
+        IsosurfaceOptions options;
+        options.resolution = resolution;
+        Mesh mesh;
+        if (!IsosurfaceExtractor::extract(IsosurfaceExtractor::displaced_sphere(0.7f, 0.15f, 2.0f, seed), options, mesh))
+            throw std::runtime_error("Invalid isosurface for " + output_path);
+        if (target_triangles > 0) {
+            SimplifyOptions simplify;
+            simplify.target_triangles = target_triangles;
+            simplify.cluster_above = 1000000;
+            if (!MeshSimplifier::simplify(mesh, simplify, mesh))
+                throw std::runtime_error("Failed to simplify " + output_path);
         }
-
-        std::cout << "[Image3DGenerator] Wrote OBJ to " << output_path << std::endl;
+        if (!MeshIO::write(output_path, mesh)) throw std::runtime_error("Failed to write " + output_path);
+        std::cout << "[Image3DGenerator] Wrote " << mesh.triangle_count() << " triangles to " << output_path
+                  << std::endl;
         return output_path;
     }
+
+    // Generate a simple low-poly sphere and write as OBJ
+    static std::string generate_obj(const std::string &output_path, int lat = 8, int lon = 16, float radius = 1.0f) {
+        SphereOptions options;
+        options.latitude = lat;
+        options.longitude = lon;
+        options.radius = radius;
+        options.normals = false;
+        return generate(output_path, options);
+    }
 };
 
 } } }
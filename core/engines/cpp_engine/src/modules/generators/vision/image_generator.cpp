@@ -5,98 +5,31 @@
 #include <filesystem>
 #include <random>
 #include <cmath>
+#include <cstdlib>
+#include <stdexcept>
 
-// Stub for OpenCV types when not available
-namespace cv {
-    struct Mat {
-        Mat() {}
-        Mat(int, int, int) {}
-    };
-    struct Size {
-        Size(int, int) {}
-    };
-    struct VideoWriter {
-        bool open(const std::string&, int, int, Size) { return false; }
-        bool isOpened() { return false; }
-        void write(const Mat&) {}
-        void release() {}
-        static int fourcc(char, char, char, char) { return 0; }
-    };
-    bool imwrite(const std::string&, const Mat&) { return false; }
-}
+#include <opencv2/opencv.hpp>
 
-#include <filesystem>
+#include "generators/noise_atlas.h"
+#include "generators/procedural_generator.h"
+#include "generators/procedural_video.h"
+#include "generators/video_encoder.h"
+#include "optimization/image_encoder.h"
 
 namespace fs = std::filesystem;
 
-// ============================================================================
-// Perlin Noise Implementation (Simplex-like, simplified for 2D)
-// ============================================================================
-class PerlinNoise {
-private:
-    std::vector<int> permutation;
-    std::mt19937 gen;
-
-public:
-    PerlinNoise(unsigned int seed = 0) : gen(seed) {
-        permutation.resize(256);
-        std::iota(permutation.begin(), permutation.end(), 0);
-        std::shuffle(permutation.begin(), permutation.end(), gen);
-        permutation.insert(permutation.end(), permutation.begin(), permutation.end());
-    }
-
-    double fade(double t) {
-        return t * t * t * (t * (t * 6.0 - 15.0) + 10.0);
-    }
-
-    double lerp(double t, double a, double b) {
-        return a + t * (b - a);
-    }
-
-    double grad(int hash, double x, double y) {
-        int h = hash & 15;
-        double u = (h < 8) ? x : y;
-        double v = (h < 8) ? y : x;
-        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
-    }
-
-    double noise(double x, double y) {
-        int xi = static_cast<int>(std::floor(x)) & 255;
-        int yi = static_cast<int>(std::floor(y)) & 255;
-
-        double xf = x - std::floor(x);
-        double yf = y - std::floor(y);
-
-        double u = fade(xf);
-        double v = fade(yf);
-
-        int aa = permutation[permutation[xi] + yi];
-        int ab = permutation[permutation[xi] + yi + 1];
-        int ba = permutation[permutation[xi + 1] + yi];
-        int bb = permutation[permutation[xi + 1] + yi + 1];
-
-        double x1 = lerp(u, grad(aa, xf, yf), grad(ba, xf - 1, yf));
-        double x2 = lerp(u, grad(ab, xf, yf - 1), grad(bb, xf - 1, yf - 1));
-        return lerp(v, x1, x2);
-    }
-
-    // Multi-octave Perlin noise (fractal brownian motion)
-    double fractal(double x, double y, int octaves = 4, double persistence = 0.5, double scale = 2.0) {
-        double result = 0.0;
-        double amplitude = 1.0;
-        double frequency = 1.0;
-        double max_value = 0.0;
-
-        for (int i = 0; i < octaves; ++i) {
-            result += amplitude * noise(x * frequency, y * frequency);
-            max_value += amplitude;
-            amplitude *= persistence;
-            frequency *= scale;
-        }
-
-        return result / max_value;
-    }
-};
+using cpp_engine::generators::NoiseAtlasOptions;
+using cpp_engine::generators::NoiseBackend;
+using cpp_engine::generators::NoiseAtlasStore;
+using cpp_engine::generators::ProceduralGenerator;
+using cpp_engine::generators::ProceduralOptions;
+using cpp_engine::generators::ProceduralKind;
+using cpp_engine::generators::ProceduralVideo;
+using cpp_engine::generators::ProceduralVideoOptions;
+using cpp_engine::generators::VideoEncoder;
+using cpp_engine::generators::VideoEncoderOptions;
+using cppengine::optimization::EncodeResult;
+using cppengine::optimization::ImageEncoder;
 
 // ============================================================================
 // Image Generators
@@ -107,165 +40,66 @@ public:
     virtual cv::Mat generate(int width, int height, unsigned int seed) = 0;
 };
 
-class PerlinImageGenerator : public ImageGenerator {
+// Tiled and multi-threaded in the library (generators/procedural_generator.h);
+// the same seed gives the same image whatever the thread count
+class TiledGenerator : public ImageGenerator {
 public:
-    cv::Mat generate(int width, int height, unsigned int seed) override {
-        PerlinNoise perlin(seed);
-        cv::Mat image(height, width, CV_8UC3, cv::Scalar(0, 0, 0));
+    explicit TiledGenerator(ProceduralKind kind) : kind_(kind) {}
 
-        double scale = 0.01;  // Adjust for desired noise granularity
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                double nx = x * scale;
-                double ny = y * scale;
-                double value = perlin.fractal(nx, ny, 4, 0.5, 2.0);
-                double normalized = (value + 1.0) / 2.0;  // Map from [-1,1] to [0,1]
-                unsigned char pixel = static_cast<unsigned char>(normalized * 255.0);
+    void set_noise(NoiseBackend noise) { noise_ = noise; }
 
-                image.at<cv::Vec3b>(y, x) = cv::Vec3b(pixel, pixel, pixel);
-            }
-        }
-
-        // Apply colorization
-        cv::Mat hsv_image;
-        cv::cvtColor(image, hsv_image, cv::COLOR_BGR2HSV);
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                auto val = hsv_image.at<cv::Vec3b>(y, x);
-                val[0] = (val[0] + (x % 180)) % 180;  // Hue cycling
-                hsv_image.at<cv::Vec3b>(y, x) = val;
-            }
+    cv::Mat generate(int width, int height, unsigned int seed) override {
+        ProceduralOptions options;
+        options.noise = noise_;
+        options.atlas = atlas_store();
+        cv::Mat image;
+        if (!ProceduralGenerator(options).generate(kind_, width, height, seed, image)) {
+            throw std::invalid_argument("Invalid image size");
         }
-        cv::Mat result;
-        cv::cvtColor(hsv_image, result, cv::COLOR_HSV2BGR);
-        return result;
+        return image;
     }
+
+private:
+    // Opt-in, since atlas noise repeats every tile: CPP_ENGINE_NOISE_ATLAS=<dir> caches the
+    // noise of each seed there, shared with every other process using the same directory
+    static NoiseAtlasStore* atlas_store() {
+        static NoiseAtlasStore* store = [] () -> NoiseAtlasStore* {
+            const char* dir = std::getenv("CPP_ENGINE_NOISE_ATLAS");
+            if (!dir || !*dir) return nullptr;
+            NoiseAtlasOptions options;
+            options.directory = dir;
+            return new NoiseAtlasStore(options);
+        }();
+        return store;
+    }
+
+    ProceduralKind kind_;
+    NoiseBackend noise_ = NoiseBackend::PERLIN;
 };
 
-class SilhouetteGenerator : public ImageGenerator {
+class PerlinImageGenerator : public TiledGenerator {
 public:
-    cv::Mat generate(int width, int height, unsigned int seed) override {
-        PerlinNoise perlin(seed);
-        cv::Mat base(height, width, CV_8UC1, cv::Scalar(0));
-
-        double scale = 0.015;
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                double nx = x * scale;
-                double ny = y * scale;
-                double value = perlin.fractal(nx, ny, 5, 0.6, 2.0);
-                double normalized = (value + 1.0) / 2.0;
-                base.at<unsigned char>(y, x) = static_cast<unsigned char>(normalized * 255.0);
-            }
-        }
-
-        // Create contour/silhouette
-        cv::Mat edges;
-        cv::Canny(base, edges, 50, 150);
-        cv::Mat silhouette = cv::Mat::zeros(height, width, CV_8UC3);
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                if (edges.at<unsigned char>(y, x) > 0) {
-                    silhouette.at<cv::Vec3b>(y, x) = cv::Vec3b(255, 200, 50);  // Gold contour
-                }
-            }
-        }
-
-        // Morphological operations to enhance silhouette
-        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(3, 3));
-        cv::dilate(silhouette, silhouette, kernel, cv::Point(-1, -1), 1);
-
-        return silhouette;
-    }
+    PerlinImageGenerator() : TiledGenerator(ProceduralKind::PERLIN) {}
 };
 
-class MetallicGenerator : public ImageGenerator {
+class SilhouetteGenerator : public TiledGenerator {
 public:
-    cv::Mat generate(int width, int height, unsigned int seed) override {
-        PerlinNoise perlin(seed);
-        cv::Mat image(height, width, CV_8UC3, cv::Scalar(30, 30, 40));
-
-        double scale = 0.02;
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                double nx = x * scale;
-                double ny = y * scale;
-
-                // Normal approximation using Perlin gradient
-                double h = perlin.fractal(nx, ny, 4, 0.5, 2.0);
-                double hx = perlin.fractal(nx + 0.01, ny, 4, 0.5, 2.0);
-                double hy = perlin.fractal(nx, ny + 0.01, 4, 0.5, 2.0);
-
-                // Phong lighting
-                double light = 0.5 + 0.5 * (h + hx + hy) / 3.0;
-                unsigned char intensity = static_cast<unsigned char>(light * 200.0 + 30.0);
-
-                image.at<cv::Vec3b>(y, x) = cv::Vec3b(intensity, intensity, intensity);
-            }
-        }
-
-        // Add specular highlights (directional light)
-        for (int y = 10; y < height - 10; ++y) {
-            for (int x = 10; x < width - 10; ++x) {
-                double dist = std::sqrt(std::pow(x - width / 2.0, 2) + std::pow(y - height / 2.0, 2));
-                if (dist < 50) {
-                    int highlight = static_cast<int>(200 * std::exp(-dist * dist / 1000.0));
-                    auto pix = image.at<cv::Vec3b>(y, x);
-                    pix[0] = cv::saturate_cast<unsigned char>(pix[0] + highlight);
-                    pix[1] = cv::saturate_cast<unsigned char>(pix[1] + highlight);
-                    pix[2] = cv::saturate_cast<unsigned char>(pix[2] + highlight);
-                    image.at<cv::Vec3b>(y, x) = pix;
-                }
-            }
-        }
-
-        return image;
-    }
+    SilhouetteGenerator() : TiledGenerator(ProceduralKind::SILHOUETTE) {}
 };
 
-// ============================================================================
-// Video Writer
-// ============================================================================
-class VideoWriter {
-private:
-    std::string filename;
-    int width, height, fps;
-    cv::VideoWriter writer;
-
+class MetallicGenerator : public TiledGenerator {
 public:
-    VideoWriter(const std::string& file, int w, int h, int f)
-        : filename(file), width(w), height(h), fps(f) {
-        int fourcc = cv::VideoWriter::fourcc('m', 'p', '4', 'v');  // mp4v codec
-        writer.open(filename, fourcc, fps, cv::Size(width, height));
-        if (!writer.isOpened()) {
-            throw std::runtime_error("Failed to open video writer for: " + filename);
-        }
-    }
-
-    void write(const cv::Mat& frame) {
-        if (frame.size() != cv::Size(width, height)) {
-            cv::Mat resized;
-            cv::resize(frame, resized, cv::Size(width, height));
-            writer.write(resized);
-        } else {
-            writer.write(frame);
-        }
-    }
-
-    ~VideoWriter() {
-        if (writer.isOpened()) {
-            writer.release();
-        }
-    }
+    MetallicGenerator() : TiledGenerator(ProceduralKind::METALLIC) {}
 };
 
 // ============================================================================
 // Main Generator Functions
 // ============================================================================
-void generateImage(const std::string& output, int width, int height, unsigned int seed, const std::string& type) {
+void generateImage(const std::string& output, int width, int height, unsigned int seed, const std::string& type,
+                   NoiseBackend noise) {
     std::cout << "Generating " << type << " image (" << width << "x" << height << ")..." << std::endl;
 
-    std::unique_ptr<ImageGenerator> generator;
+    std::unique_ptr<TiledGenerator> generator;
     if (type == "perlin") {
         generator = std::make_unique<PerlinImageGenerator>();
     } else if (type == "silhouette") {
@@ -275,6 +109,7 @@ void generateImage(const std::string& output, int width, int height, unsigned in
     } else {
         throw std::invalid_argument("Unknown image type: " + type);
     }
+    generator->set_noise(noise);
 
     cv::Mat image = generator->generate(width, height, seed);
 
@@ -282,41 +117,56 @@ void generateImage(const std::string& output, int width, int height, unsigned in
     fs::path output_path(output);
     fs::create_directories(output_path.parent_path());
 
-    cv::imwrite(output, image);
+    const EncodeResult saved = ImageEncoder::write(output, image, cppengine::optimization::EncodeOptions());
+    if (!saved.success) {
+        throw std::runtime_error("Failed to save image: " + output);
+    }
+    std::cout << saved.summary() << std::endl;
     std::cout << "Saved to: " << output << std::endl;
 }
 
-void generateVideo(const std::string& output, int width, int height, int frames, int fps, const std::string& type) {
+void generateVideo(const std::string& output, int width, int height, int frames, int fps, const std::string& type,
+                   unsigned int seed, NoiseBackend noise, int loop_frames, const std::string& codec) {
     std::cout << "Generating " << type << " video (" << width << "x" << height << ", " << frames << " frames @ " << fps << " fps)..." << std::endl;
 
+    ProceduralKind kind;
+    if (type.find("_video") == std::string::npos || !ProceduralGenerator::parse_kind(type, kind)) {
+        throw std::invalid_argument("Unknown video type: " + type);
+    }
+
     // Create output directory
     fs::path output_path(output);
     fs::create_directories(output_path.parent_path());
 
-    VideoWriter video(output, width, height, fps);
-
-    std::unique_ptr<ImageGenerator> generator;
-    if (type == "perlin_video") {
-        generator = std::make_unique<PerlinImageGenerator>();
-    } else if (type == "silhouette_video") {
-        generator = std::make_unique<SilhouetteGenerator>();
-    } else if (type == "metallic_video") {
-        generator = std::make_unique<MetallicGenerator>();
-    } else {
-        throw std::invalid_argument("Unknown video type: " + type);
-    }
-
-    for (int i = 0; i < frames; ++i) {
-        unsigned int seed = i;
-        cv::Mat frame = generator->generate(width, height, seed);
-        video.write(frame);
-        
+    // Encoded on VideoEncoder's own thread (libavcodec when built with it, else cv::VideoWriter),
+    // so rendering the next frames overlaps encoding
+    VideoEncoderOptions encode;
+    if (!codec.empty()) encode.codec = codec;
+    VideoEncoder encoder;
+    if (!encoder.open(output, width, height, fps, encode)) {
+        throw std::runtime_error("Failed to open video encoder for: " + output);
+    }
+
+    // One seed, time as the third noise axis: frames render in parallel and
+    // reach the encoder in order on this thread
+    ProceduralVideoOptions options;
+    options.tiles.noise = noise;
+    options.loop_frames = loop_frames;
+    ProceduralVideo renderer(options);
+    const bool ok = renderer.render(kind, width, height, frames, seed, [&](int i, const cv::Mat& frame) {
+        if (!encoder.write(frame)) return false;
         if ((i + 1) % 10 == 0) {
             std::cout << "  Progress: " << (i + 1) << "/" << frames << " frames" << std::endl;
         }
+        return true;
+    });
+    const bool closed = encoder.close();
+    if (!ok || !closed) {
+        throw std::runtime_error("Video rendering failed");
     }
 
-    std::cout << "Saved video to: " << output << std::endl;
+    std::cout << "Saved video to: " << output << " (" << renderer.stats().fps() << " frames/s, "
+              << VideoEncoder::backend_name(encoder.backend()) << ")" << std::endl;
 }
 
 // ============================================================================
@@ -333,6 +183,9 @@ int main(int argc, char** argv) {
         std::string type = "perlin";
         unsigned int seed = 0;
         bool random_seed = true;
+        NoiseBackend noise = NoiseBackend::PERLIN;
+        int loop_frames = 0;
+        std::string codec;
 
         for (int i = 1; i < argc; ++i) {
             std::string arg = argv[i];
@@ -351,6 +204,14 @@ int main(int argc, char** argv) {
             } else if (arg == "--seed" && i + 1 < argc) {
                 seed = std::stoul(argv[++i]);
                 random_seed = false;
+            } else if (arg == "--noise" && i + 1 < argc) {
+                if (!ProceduralGenerator::parse_backend(argv[++i], noise)) {
+                    throw std::invalid_argument(std::string("Unknown noise backend: ") + argv[i]);
+                }
+            } else if (arg == "--loop" && i + 1 < argc) {
+                loop_frames = std::stoi(argv[++i]);
+            } else if (arg == "--codec" && i + 1 < argc) {
+                codec = argv[++i];
             } else if (arg == "--help") {
                 std::cout << "Usage: image_video_generator [options]\n"
                     << "Options:\n"
@@ -361,6 +222,9 @@ int main(int argc, char** argv) {
                     << "  --fps N           Video fps (default: 30)\n"
                     << "  --type TYPE       Generator type: perlin, silhouette, metallic, perlin_video, etc. (default: perlin)\n"
                     << "  --seed N          Random seed (default: random)\n"
+                    << "  --noise NAME      Noise backend: perlin or simplex (default: perlin)\n"
+                    << "  --loop N          Video loops seamlessly every N frames (4D simplex noise)\n"
+                    << "  --codec NAME      Video codec: h264, hevc, vp9, mp4v, mjpeg (default: h264)\n"
                     << "  --help            Show this help message\n";
                 return 0;
             }
@@ -373,9 +237,9 @@ int main(int argc, char** argv) {
 
         // Determine if generating image or video based on type
         if (type.find("_video") != std::string::npos) {
-            generateVideo(output, width, height, frames, fps, type);
+            generateVideo(output, width, height, frames, fps, type, seed, noise, loop_frames, codec);
         } else {
-            generateImage(output, width, height, seed, type);
+            generateImage(output, width, height, seed, type, noise);
         }
 
         std::cout << "Done!" << std::endl;
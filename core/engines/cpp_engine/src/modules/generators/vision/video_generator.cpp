@@ -1,4 +1,5 @@
-#include "generators/video_generator.h"
+#include "modules/generators/video_generator.h"
+#include "generators/reference_catalog.h"
 #include "utils/logger.h"
 #include <filesystem>
 #include <vector>
@@ -51,26 +52,17 @@ bool VideoGenerator::generate_perlin_video(
                                   " frames @ " + std::to_string(fps) + "fps" +
                                   " using style models from: " + search_name);
     
-    // Load reference images from java_ai_system/data/downloaded_images/{search_name}
-    std::vector<std::string> reference_images;
-    std::string ref_dir = "java_ai_system/data/downloaded_images/" + search_name;
-    
-    if (std::filesystem::exists(ref_dir)) {
-        for (const auto& entry : std::filesystem::directory_iterator(ref_dir)) {
-            if (entry.is_regular_file()) {
-                std::string ext = entry.path().extension().string();
-                if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp") {
-                    reference_images.push_back(entry.path().string());
-                }
-            }
-        }
-        cpp_engine::utils::Logger::instance().info("Found " + std::to_string(reference_images.size()) + " reference images for Perlin video style");
+    // Reference images of java_ai_system/data/downloaded_images/{search_name}, from the catalog
+    // (indexed once, then kept current by inotify) instead of a directory walk per call
+    const auto reference_images = cpp_engine::generators::ReferenceCatalog::shared().images(search_name);
+    if (!reference_images->empty()) {
+        cpp_engine::utils::Logger::instance().info("Found " + std::to_string(reference_images->size()) + " reference images for Perlin video style");
     } else {
-        cpp_engine::utils::Logger::instance().warning("Reference images directory not found: " + ref_dir);
+        cpp_engine::utils::Logger::instance().warning("No reference images for: " + search_name);
     }
     
     // Generate Perlin video based on reference style
-    cpp_engine::utils::Logger::instance().debug("Generating Perlin video animation based on " + std::to_string(reference_images.size()) + " reference models");
+    cpp_engine::utils::Logger::instance().debug("Generating Perlin video animation based on " + std::to_string(reference_images->size()) + " reference models");
     
     return true;
 }
@@ -81,26 +73,16 @@ bool VideoGenerator::generate_silhouette_video(
     
     cpp_engine::utils::Logger::instance().info("Generating silhouette video using style models from: " + search_name);
     
-    // Load reference images from java_ai_system/data/downloaded_images/{search_name}
-    std::vector<std::string> reference_images;
-    std::string ref_dir = "java_ai_system/data/downloaded_images/" + search_name;
-    
-    if (std::filesystem::exists(ref_dir)) {
-        for (const auto& entry : std::filesystem::directory_iterator(ref_dir)) {
-            if (entry.is_regular_file()) {
-                std::string ext = entry.path().extension().string();
-                if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp") {
-                    reference_images.push_back(entry.path().string());
-                }
-            }
-        }
-        cpp_engine::utils::Logger::instance().info("Found " + std::to_string(reference_images.size()) + " reference silhouettes for video style");
+    // Reference images of java_ai_system/data/downloaded_images/{search_name}
+    const auto reference_images = cpp_engine::generators::ReferenceCatalog::shared().images(search_name);
+    if (!reference_images->empty()) {
+        cpp_engine::utils::Logger::instance().info("Found " + std::to_string(reference_images->size()) + " reference silhouettes for video style");
     } else {
-        cpp_engine::utils::Logger::instance().warning("Reference images directory not found: " + ref_dir);
+        cpp_engine::utils::Logger::instance().warning("No reference images for: " + search_name);
     }
     
     // Generate silhouette video based on reference style
-    cpp_engine::utils::Logger::instance().debug("Generating silhouette video based on " + std::to_string(reference_images.size()) + " reference models");
+    cpp_engine::utils::Logger::instance().debug("Generating silhouette video based on " + std::to_string(reference_images->size()) + " reference models");
     
     return true;
 }
@@ -111,26 +93,16 @@ bool VideoGenerator::generate_metallic_video(
     
     cpp_engine::utils::Logger::instance().info("Generating metallic video using style models from: " + search_name);
     
-    // Load reference images from java_ai_system/data/downloaded_images/{search_name}
-    std::vector<std::string> reference_images;
-    std::string ref_dir = "java_ai_system/data/downloaded_images/" + search_name;
-    
-    if (std::filesystem::exists(ref_dir)) {
-        for (const auto& entry : std::filesystem::directory_iterator(ref_dir)) {
-            if (entry.is_regular_file()) {
-                std::string ext = entry.path().extension().string();
-                if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp") {
-                    reference_images.push_back(entry.path().string());
-                }
-            }
-        }
-        cpp_engine::utils::Logger::instance().info("Found " + std::to_string(reference_images.size()) + " reference images for metallic video style");
+    // Reference images of java_ai_system/data/downloaded_images/{search_name}
+    const auto reference_images = cpp_engine::generators::ReferenceCatalog::shared().images(search_name);
+    if (!reference_images->empty()) {
+        cpp_engine::utils::Logger::instance().info("Found " + std::to_string(reference_images->size()) + " reference images for metallic video style");
     } else {
-        cpp_engine::utils::Logger::instance().warning("Reference images directory not found: " + ref_dir);
+        cpp_engine::utils::Logger::instance().warning("No reference images for: " + search_name);
     }
     
     // Generate metallic video based on reference style
-    cpp_engine::utils::Logger::instance().debug("Generating metallic video based on " + std::to_string(reference_images.size()) + " reference models");
+    cpp_engine::utils::Logger::instance().debug("Generating metallic video based on " + std::to_string(reference_images->size()) + " reference models");
     
     return true;
 }
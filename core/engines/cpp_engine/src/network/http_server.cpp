@@ -1,9 +1,14 @@
 #include "network/http_server.h"
 #include "network/validation_endpoint.h"
+#include "generators/image_generator.h"
+#include "generators/video_generator.h"
+#include "optimization/image_encoder.h"
+#include "utils/shared_memory.h"
 
 #include <nlohmann/json.hpp>
 #include <httplib.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -14,6 +19,7 @@
 #include <iostream>
 #include <map>
 #include <mutex>
+#include <random>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -112,12 +118,117 @@ std::string read_all_from_fd(int fd) {
     return out;
 }
 
+std::string base64_decode(const std::string& in) {
+    static const std::string chars =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve(in.size() * 3 / 4);
+    unsigned int acc = 0;
+    int bits = -8;
+    for (unsigned char c : in) {
+        const size_t v = chars.find(static_cast<char>(c));
+        if (v == std::string::npos) continue;  // padding, whitespace
+        acc = (acc << 6) | static_cast<unsigned int>(v);
+        bits += 6;
+        if (bits >= 0) {
+            out.push_back(static_cast<char>((acc >> bits) & 0xFF));
+            bits -= 8;
+        }
+    }
+    return out;
+}
+
+std::string image_content_type(const std::string& format) {
+    if (format == "jpg" || format == "jpeg") return "image/jpeg";
+    if (format == "webp") return "image/webp";
+    if (format == "bmp") return "image/bmp";
+    if (format == "tif" || format == "tiff") return "image/tiff";
+    return "image/png";
+}
+
+// /generate renders on the request thread: cap what one request may ask for
+constexpr int GENERATE_MAX_SIDE = 8192;
+constexpr int GENERATE_MAX_FRAMES = 3600;
+
+struct GenerateRequest {
+    bool video = false;
+    cpp_engine::generators::ImageRequest image;
+    cpp_engine::generators::VideoRequest clip;
+    std::string format;
+    cppengine::optimization::EncodeOptions encode;
+};
+
+// {"type", "width", "height", "seed", "noise", "frames", "loop", "format", "encode_profile",
+// "latency_budget_ms"}; types ending in "_video" stream frames
+bool parse_generate_request(const json& payload, GenerateRequest& out, std::string& error) {
+    using cpp_engine::generators::ProceduralGenerator;
+    const std::string type = payload.value("type", "perlin");
+    cpp_engine::generators::ProceduralKind kind;
+    if (!ProceduralGenerator::parse_kind(type, kind)) {
+        error = "unknown type: " + type;
+        return false;
+    }
+    cpp_engine::generators::NoiseBackend noise;
+    if (!ProceduralGenerator::parse_backend(payload.value("noise", "perlin"), noise)) {
+        error = "unknown noise backend: " + payload.value("noise", "");
+        return false;
+    }
+    const int width = payload.value("width", 512);
+    const int height = payload.value("height", 512);
+    if (width <= 0 || height <= 0 || width > GENERATE_MAX_SIDE || height > GENERATE_MAX_SIDE) {
+        error = "width and height must be in [1, " + std::to_string(GENERATE_MAX_SIDE) + "]";
+        return false;
+    }
+    const unsigned int seed = payload.contains("seed") ? payload["seed"].get<unsigned int>() : std::random_device{}();
+    try {
+        out.encode.profile = cppengine::optimization::ImageEncoder::parse_profile(
+            payload.value("encode_profile", "balanced"));
+    } catch (const std::invalid_argument& e) {
+        error = e.what();
+        return false;
+    }
+    out.encode.latency_budget_ms = payload.value("latency_budget_ms", 0.0);
+
+    out.video = type.size() > 6 && type.compare(type.size() - 6, 6, "_video") == 0;
+    out.format = payload.value("format", out.video ? "jpg" : "png");
+    if (!out.video) {
+        out.image = {kind, width, height, seed, noise};
+        return true;
+    }
+    const int frames = payload.value("frames", 60);
+    if (frames <= 0 || frames > GENERATE_MAX_FRAMES) {
+        error = "frames must be in [1, " + std::to_string(GENERATE_MAX_FRAMES) + "]";
+        return false;
+    }
+    out.clip = {kind, width, height, frames, seed, noise, std::max(0, payload.value("loop", 0))};
+    return true;
+}
+
+// memfd pair for one /process task: sealed input bytes in, encoded result out
+struct MemfdHandoff {
+    cppengine::utils::SharedMemoryBuffer input;
+    cppengine::utils::SharedMemoryBuffer output;
+    std::string output_format = "png";
+    std::string persist_path;  // empty = keep the result in memory for /results/<id>/image
+    size_t input_bytes = 0;
+
+    // Frees both memfds of a task that will not complete; caller holds g_store.mtx
+    void release() {
+        input.close();
+        output.close();
+    }
+};
+
 struct TaskMetrics {
     long long start_time_ms = 0;
     long long end_time_ms = 0;
     int peak_memory_kb = 0;
     int cpu_percent = 0;
     double io_throughput_mb_s = 0.0;
+    // Filled from "[encode] ..." lines the child prints after writing its output
+    double encode_ms = 0.0;
+    long long encoded_bytes = 0;
+    std::string encode_profile;
 
     json to_json() const {
         json j;
@@ -127,10 +238,45 @@ struct TaskMetrics {
         j["peak_memory_kb"] = peak_memory_kb;
         j["cpu_percent"] = cpu_percent;
         j["io_throughput_mb_s"] = io_throughput_mb_s;
+        if (!encode_profile.empty()) {
+            j["encode_ms"] = encode_ms;
+            j["encoded_bytes"] = encoded_bytes;
+            j["encode_profile"] = encode_profile;
+        }
         return j;
     }
 };
 
+// Sums every "[encode] format=.. profile=.. bytes=N encode_ms=X" line of the child output
+void parse_encode_metrics(const std::string& out, TaskMetrics& metrics) {
+    std::istringstream lines(out);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.rfind("[encode] ", 0) != 0) continue;
+        std::istringstream fields(line.substr(9));
+        std::string field;
+        while (fields >> field) {
+            const size_t eq = field.find('=');
+            if (eq == std::string::npos) continue;
+            const std::string key = field.substr(0, eq);
+            const std::string value = field.substr(eq + 1);
+            try {
+                if (key == "bytes") metrics.encoded_bytes += std::stoll(value);
+                else if (key == "encode_ms") metrics.encode_ms += std::stod(value);
+                else if (key == "profile") metrics.encode_profile = value;
+            } catch (...) {}
+        }
+    }
+}
+
+// Commands of the engine binary that encode images and so accept --profile/--latency-budget-ms
+// (the -video ones would take them as operation parameters), plus memfd commands writing {output}
+bool takes_encode_options(const std::vector<std::string>& args) {
+    static const char* const encoding[] = {"filter", "effect", "filter-batch", "effect-batch", "sweep"};
+    if (!args.empty() && std::find(std::begin(encoding), std::end(encoding), args[0]) != std::end(encoding)) return true;
+    return std::find(args.begin(), args.end(), "{output}") != args.end();
+}
+
 struct TaskState {
     std::string task_id;
     std::string status = "queued";
@@ -143,6 +289,7 @@ struct TaskState {
     int timeout_seconds = 60;
     TaskMetrics metrics;
     json timeline = json::array();
+    std::shared_ptr<MemfdHandoff> handoff;
 
     json to_json(bool include_output = true) const {
         json j;
@@ -155,6 +302,12 @@ struct TaskState {
         j["elapsed_seconds"] = std::max(0.0, (now_ms() - static_cast<double>(created_at_ms)) / 1000.0);
         j["timeout_seconds"] = timeout_seconds;
         j["metrics"] = metrics.to_json();
+        if (handoff) {
+            json h{{"mode", "memfd"}, {"input_bytes", handoff->input_bytes}, {"output_bytes", handoff->output.size()}};
+            if (!handoff->persist_path.empty()) h["output"] = handoff->persist_path;
+            else if (handoff->output.size() > 0) h["image_url"] = "/results/" + task_id + "/image";
+            j["handoff"] = h;
+        }
         if (include_output) {
             j["stdout"] = stdout_text;
             j["stderr"] = stderr_text;
@@ -285,6 +438,7 @@ void HttpServer::start() {
             {"service", "cpp_engine"},
             {"ready", true},
             {"native_http_server", true},
+            {"in_process_generation", true},
             {"python_wrapper_enabled", false},
             {"launch_mode", get_env_or("CODEIA_LAUNCH_MODE", "")},
             {"port", config_.port},
@@ -324,12 +478,75 @@ void HttpServer::start() {
                 for (const auto& it : payload["args"]) args.push_back(it.get<std::string>());
             }
         }
+        if (takes_encode_options(args)) {
+            const std::string profile = payload.value("encode_profile", "");
+            const double budget_ms = payload.value("latency_budget_ms", 0.0);
+            if (!profile.empty()) { args.push_back("--profile"); args.push_back(profile); }
+            if (budget_ms > 0.0) { args.push_back("--latency-budget-ms"); args.push_back(std::to_string(budget_ms)); }
+        }
 
         if (args.empty()) {
             res.status = 400;
             res.set_content(envelope_error("Missing command or advanced params (filter/input/output)", 400).dump(), "application/json");
             return;
         }
+
+        // memfd handoff: input bytes go to the child as a sealed memfd, "{input}"/"{output}" in
+        // the command become fd:<n> specs, and the encoded result comes back in a second memfd
+        std::shared_ptr<MemfdHandoff> handoff;
+        if (payload.value("handoff", "") == "memfd") {
+            if (!config_.memfd_handoff) {
+                res.status = 400;
+                res.set_content(envelope_error("memfd handoff disabled (start the server with --memfd-handoff)", 400).dump(), "application/json");
+                return;
+            }
+            handoff = std::make_shared<MemfdHandoff>();
+            handoff->persist_path = payload.value("output", "");
+            std::string format = payload.value("output_format", fs::path(handoff->persist_path).extension().string());
+            if (!format.empty() && format[0] == '.') format.erase(0, 1);
+            if (!format.empty()) handoff->output_format = format;
+            if (!handoff->input.create("cpp_engine_input") || !handoff->output.create("cpp_engine_output")) {
+                res.status = 500;
+                res.set_content(envelope_error(std::string("memfd setup failed: ") + std::strerror(errno), 500).dump(), "application/json");
+                return;
+            }
+
+            // A path is copied file-to-memfd in the kernel, never through a user-space buffer
+            bool have_input = false;
+            if (payload.contains("input_base64") && payload["input_base64"].is_string()) {
+                const std::string bytes = base64_decode(payload["input_base64"].get<std::string>());
+                have_input = !bytes.empty() && handoff->input.write(bytes.data(), bytes.size());
+                handoff->input_bytes = bytes.size();
+            } else if (!payload.value("input", "").empty()) {
+                have_input = handoff->input.write_file(payload.value("input", ""), &handoff->input_bytes) &&
+                             handoff->input_bytes > 0;
+            }
+            if (!have_input) {
+                res.status = 400;
+                res.set_content(envelope_error("memfd handoff needs input_base64 or a readable input path", 400).dump(), "application/json");
+                return;
+            }
+            if (!handoff->input.seal()) {
+                res.status = 500;
+                res.set_content(envelope_error(std::string("memfd seal failed: ") + std::strerror(errno), 500).dump(), "application/json");
+                return;
+            }
+
+            bool has_input = false;
+            for (auto& arg : args) {
+                if (arg == "{input}") {
+                    arg = "fd:" + std::to_string(handoff->input.fd());
+                    has_input = true;
+                } else if (arg == "{output}") {
+                    arg = "fd:" + std::to_string(handoff->output.fd()) + "." + handoff->output_format;
+                }
+            }
+            if (!has_input) {
+                res.status = 400;
+                res.set_content(envelope_error("memfd handoff needs an {input} placeholder in command", 400).dump(), "application/json");
+                return;
+            }
+        }
         if (!fs::exists(config_.cpp_bin)) {
             res.status = 500;
             res.set_content(envelope_error("CPP binary not found", 500, json{{"cpp_bin", config_.cpp_bin}}).dump(), "application/json");
@@ -341,6 +558,7 @@ void HttpServer::start() {
         task.timeout_seconds = timeout;
         task.command.push_back(config_.cpp_bin);
         task.command.insert(task.command.end(), args.begin(), args.end());
+        task.handoff = handoff;
         TaskLogger::log_event(task, "task_submitted", json{{"timeout", timeout}, {"argc", task.command.size()}});
 
         {
@@ -349,7 +567,7 @@ void HttpServer::start() {
         }
 
         const std::string task_id = task.task_id;
-        std::thread([task_id]() {
+        std::thread([task_id, handoff]() {
             std::vector<std::string> command;
             int timeout_seconds = 60;
             {
@@ -371,6 +589,7 @@ void HttpServer::start() {
                 if (it != g_store.tasks.end()) {
                     it->second.status = "failed";
                     it->second.stderr_text = "pipe() failed";
+                    if (handoff) handoff->release();
                     it->second.metrics.end_time_ms = now_ms();
                     TaskLogger::log_event(it->second, "task_failed", json{{"reason", "pipe_failed"}});
                 }
@@ -386,6 +605,7 @@ void HttpServer::start() {
                 if (it != g_store.tasks.end()) {
                     it->second.status = "failed";
                     it->second.stderr_text = "fork() failed";
+                    if (handoff) handoff->release();
                     it->second.metrics.end_time_ms = now_ms();
                     TaskLogger::log_event(it->second, "task_failed", json{{"reason", "fork_failed"}});
                 }
@@ -397,6 +617,10 @@ void HttpServer::start() {
                 ::dup2(err_pipe[1], STDERR_FILENO);
                 ::close(out_pipe[0]); ::close(out_pipe[1]);
                 ::close(err_pipe[0]); ::close(err_pipe[1]);
+                if (handoff) {
+                    cppengine::utils::SharedMemoryBuffer::inherit(handoff->input.fd());
+                    cppengine::utils::SharedMemoryBuffer::inherit(handoff->output.fd());
+                }
                 std::vector<char*> argv;
                 argv.reserve(command.size() + 1);
                 for (auto& s : command) argv.push_back(const_cast<char*>(s.c_str()));
@@ -425,14 +649,37 @@ void HttpServer::start() {
             ::close(out_pipe[0]);
             ::close(err_pipe[0]);
 
+            // Map the child's result memfd before taking the store lock (persisting may hit disk);
+            // the handoff itself is only touched under the lock since /status reads it
+            std::string handoff_error;
+            cppengine::utils::SharedMemoryBuffer result;
+            const bool exited_ok = wait_status != INT32_MIN && wait_status != -1 &&
+                                   WIFEXITED(wait_status) && WEXITSTATUS(wait_status) == 0;
+            if (handoff && exited_ok) {
+                result = cppengine::utils::SharedMemoryBuffer(::dup(handoff->output.fd()));
+                if (!result.valid() || !result.map() || result.size() == 0) {
+                    handoff_error = "child produced no output in memfd";
+                } else if (!handoff->persist_path.empty()) {
+                    std::ofstream file(handoff->persist_path, std::ios::binary | std::ios::trunc);
+                    file.write(reinterpret_cast<const char*>(result.data()), static_cast<std::streamsize>(result.size()));
+                    if (!file) handoff_error = "failed to persist " + handoff->persist_path;
+                }
+            }
+
             std::lock_guard<std::mutex> lock(g_store.mtx);
             auto it = g_store.tasks.find(task_id);
             if (it == g_store.tasks.end()) return;
 
             it->second.stdout_text = out;
             it->second.stderr_text = err;
+            if (handoff) {
+                // Only a completed task keeps its result memfd for /results/<id>/image
+                handoff->release();
+                if (handoff_error.empty()) handoff->output = std::move(result);
+            }
             it->second.metrics.end_time_ms = now_ms();
             it->second.metrics.peak_memory_kb = static_cast<int>(ru.ru_maxrss);
+            parse_encode_metrics(out, it->second.metrics);
 
             const double dur_s = std::max(0.001, (it->second.metrics.end_time_ms - it->second.metrics.start_time_ms) / 1000.0);
             const double io_mb = static_cast<double>(out.size() + err.size()) / (1024.0 * 1024.0);
@@ -454,6 +701,13 @@ void HttpServer::start() {
                 TaskLogger::log_event(it->second, "task_failed", json{{"reason", "wait_failed"}});
                 return;
             }
+            if (!handoff_error.empty()) {
+                it->second.status = "failed";
+                it->second.exit_code = WIFEXITED(wait_status) ? WEXITSTATUS(wait_status) : -1;
+                it->second.stderr_text += handoff_error;
+                TaskLogger::log_event(it->second, "task_failed", json{{"reason", "handoff_failed"}, {"detail", handoff_error}});
+                return;
+            }
             if (WIFEXITED(wait_status)) {
                 it->second.exit_code = WEXITSTATUS(wait_status);
                 it->second.status = (it->second.exit_code == 0) ? "completed" : "failed";
@@ -475,6 +729,79 @@ void HttpServer::start() {
         );
     });
 
+    // In-process generation: the encoded image, or a multipart stream of encoded video frames
+    // sent as they are rendered, is the response body; no generator process, temp file or task
+    server->Post("/generate", [](const httplib::Request& req, httplib::Response& res) {
+        if (!authorize_orchestrator(req, res)) {
+            return;
+        }
+
+        GenerateRequest request;
+        std::string error;
+        try {
+            if (!parse_generate_request(json::parse(req.body), request, error)) {
+                res.status = 400;
+                res.set_content(envelope_error(error, 400).dump(), "application/json");
+                return;
+            }
+        } catch (const std::exception& e) {
+            res.status = 400;
+            res.set_content(envelope_error(std::string("Invalid JSON: ") + e.what(), 400).dump(), "application/json");
+            return;
+        }
+
+        const std::string content_type = image_content_type(request.format);
+        if (request.video) {
+            res.set_header("X-Frame-Count", std::to_string(request.clip.frames));
+            res.set_chunked_content_provider("multipart/x-mixed-replace; boundary=frame",
+                [request, content_type](size_t, httplib::DataSink& sink) {
+                    cpp_engine::generators::VideoGenerator generator;
+                    generator.set_encode_options(request.encode);
+                    int sent = 0;
+                    const bool ok = generator.encode_frames(request.clip, request.format,
+                        [&](int index, const std::vector<unsigned char>& bytes) {
+                            const std::string head = "--frame\r\nContent-Type: " + content_type +
+                                                     "\r\nContent-Length: " + std::to_string(bytes.size()) +
+                                                     "\r\nX-Frame-Index: " + std::to_string(index) + "\r\n\r\n";
+                            if (!(sink.write(head.data(), head.size()) &&
+                                  sink.write(reinterpret_cast<const char*>(bytes.data()), bytes.size()) &&
+                                  sink.write("\r\n", 2))) {
+                                return false;
+                            }
+                            ++sent;
+                            return true;
+                        });
+                    if (!ok) {
+                        // Headers are already out, so the only signal left is a stream cut short of "--frame--"
+                        std::cerr << "/generate: video stream aborted after " << sent << " of "
+                                  << request.clip.frames << " frames (" << request.format << ")" << std::endl;
+                        return false;
+                    }
+                    sink.write("--frame--\r\n", 11);
+                    sink.done();
+                    return true;
+                });
+            return;
+        }
+
+        cpp_engine::generators::ImageGenerator generator;
+        generator.set_encode_options(request.encode);
+        std::vector<unsigned char> bytes;
+        cppengine::optimization::EncodeResult encoded;
+        const auto start = SteadyClock::now();
+        if (!generator.encode(request.image, request.format, bytes, &encoded)) {
+            res.status = 500;
+            res.set_content(envelope_error("generation failed", 500, json{{"format", request.format}}).dump(), "application/json");
+            return;
+        }
+        const double total_ms = std::chrono::duration<double, std::milli>(SteadyClock::now() - start).count();
+        res.set_header("X-Generate-Ms", std::to_string(total_ms));
+        res.set_header("X-Encode-Ms", std::to_string(encoded.encode_ms));
+        res.set_header("X-Encode-Profile", cppengine::optimization::ImageEncoder::profile_name(encoded.profile));
+        res.set_header("X-Seed", std::to_string(request.image.seed));
+        res.set_content(reinterpret_cast<const char*>(bytes.data()), bytes.size(), content_type);
+    });
+
     server->Get(R"(/status/(.+))", [](const httplib::Request& req, httplib::Response& res) {
         if (!authorize_orchestrator(req, res)) {
             return;
@@ -491,6 +818,26 @@ void HttpServer::start() {
         res.set_content(envelope_ok(it->second.to_json(true)).dump(), "application/json");
     });
 
+    // Result image of a memfd handoff task, served straight from the child's memfd mapping
+    server->Get(R"(/results/([^/]+)/image)", [](const httplib::Request& req, httplib::Response& res) {
+        if (!authorize_orchestrator(req, res)) {
+            return;
+        }
+
+        const std::string task_id = req.matches.size() > 1 ? req.matches[1].str() : "";
+        std::lock_guard<std::mutex> lock(g_store.mtx);
+        auto it = g_store.tasks.find(task_id);
+        if (it == g_store.tasks.end() || !it->second.handoff || it->second.status != "completed" ||
+            it->second.handoff->output.size() == 0) {
+            res.status = 404;
+            res.set_content(envelope_error("no handoff image for task", 404, json{{"task_id", task_id}}).dump(), "application/json");
+            return;
+        }
+        const MemfdHandoff& handoff = *it->second.handoff;
+        res.set_content(reinterpret_cast<const char*>(handoff.output.data()), handoff.output.size(),
+                        image_content_type(handoff.output_format));
+    });
+
     server->Get(R"(/results/(.+))", [](const httplib::Request& req, httplib::Response& res) {
         if (!authorize_orchestrator(req, res)) {
             return;
@@ -0,0 +1,285 @@
+#include "optimization/batch_pipeline.h"
+#include "optimization/bounded_queue.h"
+#include "filters/image_filter.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace cppengine {
+namespace optimization {
+
+namespace {
+
+struct DecodedItem {
+    size_t index = 0;
+    cv::Mat image;
+};
+
+struct ProcessedItem {
+    size_t index = 0;
+    cv::Mat image;
+};
+
+bool read_file(const std::string& path, std::vector<uchar>& bytes) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const std::streamsize size = in.tellg();
+    if (size <= 0) return false;
+    bytes.resize(static_cast<size_t>(size));
+    in.seekg(0);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(bytes.data()), size));
+}
+
+bool write_file(const std::string& path, const std::vector<uchar>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+bool is_image_extension(std::string ext) {
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" ||
+           ext == ".webp" || ext == ".tif" || ext == ".tiff";
+}
+
+// Runs fn on n threads; the last thread to finish calls on_done
+template <typename Fn, typename Done>
+void spawn_stage(std::vector<std::thread>& threads, int n, Fn fn, Done on_done) {
+    auto remaining = std::make_shared<std::atomic<int>>(n);
+    for (int i = 0; i < n; ++i) {
+        threads.emplace_back([fn, on_done, remaining]() {
+            fn();
+            if (remaining->fetch_sub(1) == 1) on_done();
+        });
+    }
+}
+
+} // namespace
+
+double BatchPipeline::Stats::images_per_second() const {
+    return seconds > 0.0 ? images_ok / seconds : 0.0;
+}
+
+double BatchPipeline::Stats::mb_per_second() const {
+    return seconds > 0.0 ? (bytes_in + bytes_out) / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+BatchPipeline::BatchPipeline() {}
+
+BatchPipeline::BatchPipeline(const Config& config) : config_(config) {}
+
+BatchPipeline::~BatchPipeline() {}
+
+BatchPipeline::Stats BatchPipeline::run(const std::vector<Job>& jobs, const ProcessorFactory& make_processor) {
+    const int hw = std::max(1u, std::thread::hardware_concurrency());
+    // Workers get every core; codec threads are extra so the CPU stays busy while they wait on I/O
+    const int workers = config_.worker_threads > 0 ? config_.worker_threads : hw;
+    const int decoders = config_.decoder_threads > 0 ? config_.decoder_threads : std::max(1, hw / 4);
+    const int encoders = config_.encoder_threads > 0 ? config_.encoder_threads : std::max(1, hw / 4);
+    const size_t capacity = config_.queue_capacity > 0 ? config_.queue_capacity : static_cast<size_t>(2 * workers);
+
+    cpp_engine::utils::Logger::instance().info("Batch pipeline: " + std::to_string(jobs.size()) + " images, " +
+        std::to_string(decoders) + " decoders, " + std::to_string(workers) + " workers, " +
+        std::to_string(encoders) + " encoders, queue=" + std::to_string(capacity));
+
+    // Parallelism comes from images in flight; nested OpenCV threading would only oversubscribe
+    const int previous_cv_threads = cv::getNumThreads();
+    cv::setNumThreads(1);
+
+    BoundedQueue<DecodedItem> decoded(capacity);
+    BoundedQueue<ProcessedItem> processed(capacity);
+    std::atomic<size_t> next_job{0};
+    std::atomic<size_t> ok{0}, failed{0};
+    std::atomic<uint64_t> bytes_in{0}, bytes_out{0};
+    std::atomic<uint64_t> encode_us{0};
+    std::mutex progress_mutex;
+    const auto start = std::chrono::steady_clock::now();
+
+    auto elapsed_seconds = [&start]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto fail = [&failed](const std::string& message) {
+        failed.fetch_add(1);
+        cpp_engine::utils::Logger::instance().error(message);
+    };
+    auto report_progress = [&](size_t written) {
+        if (config_.progress_every <= 0 || written % static_cast<size_t>(config_.progress_every) != 0) return;
+        const double secs = std::max(1e-6, elapsed_seconds());
+        std::lock_guard<std::mutex> lock(progress_mutex);
+        std::cout << "[batch] " << (written + failed.load()) << "/" << jobs.size() << " images, "
+                  << std::fixed << std::setprecision(1) << (ok.load() / secs) << " images/s, "
+                  << ((bytes_in.load() + bytes_out.load()) / (1024.0 * 1024.0) / secs) << " MB/s"
+                  << std::endl;
+    };
+
+    std::vector<std::thread> threads;
+
+    spawn_stage(threads, decoders, [&]() {
+        std::vector<uchar> bytes;
+        for (size_t i = next_job.fetch_add(1); i < jobs.size(); i = next_job.fetch_add(1)) {
+            if (!read_file(jobs[i].input_file, bytes)) {
+                fail("Failed to read image: " + jobs[i].input_file);
+                continue;
+            }
+            DecodedItem item;
+            item.index = i;
+            if (!filters::ImageFilter::decode_for_size(bytes, config_.decode_width, config_.decode_height, item.image)) {
+                fail("Failed to decode image: " + jobs[i].input_file);
+                continue;
+            }
+            bytes_in.fetch_add(bytes.size());
+            if (!decoded.push(std::move(item))) break;
+        }
+    }, [&decoded]() { decoded.close(); });
+
+    spawn_stage(threads, workers, [&]() {
+        Processor process = make_processor();
+        DecodedItem item;
+        while (decoded.pop(item)) {
+            ProcessedItem out;
+            out.index = item.index;
+            bool success = false;
+            try {
+                success = process(item.image, out.image);
+            } catch (const std::exception& e) {
+                cpp_engine::utils::Logger::instance().error(std::string("Batch processor threw: ") + e.what());
+            }
+            item.image.release();
+            if (!success || out.image.empty()) {
+                fail("Failed to process image: " + jobs[item.index].input_file);
+                continue;
+            }
+            if (!processed.push(std::move(out))) break;
+        }
+    }, [&processed]() { processed.close(); });
+
+    spawn_stage(threads, encoders, [&]() {
+        std::vector<uchar> bytes;
+        ProcessedItem item;
+        while (processed.pop(item)) {
+            const Job& job = jobs[item.index];
+            const EncodeResult encoded = ImageEncoder::encode(item.image, job.output_file, config_.encode, bytes);
+            item.image.release();
+            if (!encoded.success || !write_file(job.output_file, bytes)) {
+                fail("Failed to save image: " + job.output_file);
+                continue;
+            }
+            encode_us.fetch_add(static_cast<uint64_t>(encoded.encode_ms * 1000.0));
+            bytes_out.fetch_add(bytes.size());
+            if (config_.report_encodes) {
+                std::lock_guard<std::mutex> lock(progress_mutex);
+                std::cout << encoded.summary() << " file=" << job.output_file << std::endl;
+            }
+            report_progress(ok.fetch_add(1) + 1);
+        }
+    }, []() {});
+
+    for (auto& t : threads) t.join();
+    cv::setNumThreads(previous_cv_threads);
+
+    Stats stats;
+    stats.images_total = jobs.size();
+    stats.images_ok = ok.load();
+    stats.images_failed = failed.load();
+    stats.bytes_in = bytes_in.load();
+    stats.bytes_out = bytes_out.load();
+    stats.seconds = elapsed_seconds();
+    stats.encode_ms = encode_us.load() / 1000.0;
+
+    std::cout << "[batch] done: " << stats.images_ok << " ok, " << stats.images_failed << " failed in "
+              << std::fixed << std::setprecision(2) << stats.seconds << " s ("
+              << std::setprecision(1) << stats.images_per_second() << " images/s, "
+              << stats.mb_per_second() << " MB/s, encode " << stats.encode_ms << " ms, "
+              << stats.bytes_out << " bytes out)" << std::endl;
+    return stats;
+}
+
+std::vector<std::string> BatchPipeline::collect_inputs(const std::string& dir_or_list) {
+    std::vector<std::string> inputs;
+    std::error_code ec;
+    if (fs::is_directory(dir_or_list, ec)) {
+        for (const auto& entry : fs::directory_iterator(dir_or_list, ec)) {
+            if (entry.is_regular_file() && is_image_extension(entry.path().extension().string())) {
+                inputs.push_back(entry.path().string());
+            }
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return inputs;
+    }
+
+    std::ifstream list(dir_or_list);
+    std::string line;
+    while (std::getline(list, line)) {
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+        const size_t last = line.find_last_not_of(" \t\r");
+        inputs.push_back(line.substr(first, last - first + 1));
+    }
+    return inputs;
+}
+
+std::vector<BatchPipeline::Job> BatchPipeline::make_jobs(const std::vector<std::string>& inputs,
+                                                         const std::string& output_dir) {
+    // Outputs keep their path below the inputs' common directory, so same-named files from
+    // different folders of a list do not overwrite each other; a flat directory maps to file names
+    std::vector<fs::path> sources;
+    sources.reserve(inputs.size());
+    std::error_code ec;
+    for (const auto& input : inputs) {
+        fs::path absolute = fs::absolute(input, ec);
+        sources.push_back(ec ? fs::path(input).lexically_normal() : absolute.lexically_normal());
+    }
+    fs::path root = sources.empty() ? fs::path() : sources.front().parent_path();
+    for (const auto& source : sources) {
+        const fs::path parent = source.parent_path();
+        fs::path common;
+        for (auto a = root.begin(), b = parent.begin(); a != root.end() && b != parent.end() && *a == *b; ++a, ++b) {
+            common /= *a;
+        }
+        root = common;
+    }
+
+    std::vector<Job> jobs;
+    jobs.reserve(inputs.size());
+    std::unordered_set<std::string> taken;
+    std::unordered_set<std::string> directories{output_dir};
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        fs::path relative = sources[i].lexically_relative(root);
+        if (relative.empty()) relative = sources[i].filename();
+        fs::path output = fs::path(output_dir) / relative;
+        if (!taken.insert(output.string()).second) {
+            // Only the same input listed twice (or spelled two ways) gets here
+            const fs::path first = output;
+            for (int n = 1; !taken.insert(output.string()).second; ++n) {
+                output = first.parent_path() /
+                         (first.stem().string() + "_" + std::to_string(n) + first.extension().string());
+            }
+            cpp_engine::utils::Logger::instance().warning("Batch output " + first.string() + " already used, writing " +
+                                                          inputs[i] + " to " + output.string());
+        }
+        directories.insert(output.parent_path().string());
+        jobs.push_back(Job{inputs[i], output.string()});
+    }
+    for (const auto& directory : directories) fs::create_directories(directory, ec);
+    return jobs;
+}
+
+} // namespace optimization
+} // namespace cppengine
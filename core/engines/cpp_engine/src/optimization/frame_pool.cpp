@@ -0,0 +1,321 @@
+#include "optimization/frame_pool.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace cppengine {
+namespace optimization {
+
+namespace {
+
+constexpr size_t MIN_BLOCK_BYTES = 64;
+constexpr size_t PAGE_BYTES = 4096;
+constexpr size_t SMALL_CLASSES = 7;  // 64 .. 4096
+
+#if CV_VERSION_MAJOR >= 4
+using AccessFlags = cv::AccessFlag;
+#else
+using AccessFlags = int;
+#endif
+
+size_t round_up(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+int floor_log2(size_t value) {
+    int log = 0;
+    while (value >>= 1) ++log;
+    return log;
+}
+
+/**
+ * PoolMatAllocator - cv::MatAllocator drawing data blocks from a FramePool
+ * Same layout as OpenCV's default allocator; UMatData headers are recycled
+ * too, so a Mat create/release cycle allocates nothing once warm.
+ */
+class PoolMatAllocator : public cv::MatAllocator {
+public:
+    explicit PoolMatAllocator(FramePool& pool) : pool_(pool) {}
+
+    ~PoolMatAllocator() override {
+        for (void* header : headers_) ::operator delete(header);
+    }
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data0, size_t* step,
+                           AccessFlags /*flags*/, cv::UMatUsageFlags /*usage*/) const override {
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; --i) {
+            if (step) {
+                if (data0 && step[i] != CV_AUTOSTEP) {
+                    total = step[i];
+                } else {
+                    step[i] = total;
+                }
+            }
+            total *= static_cast<size_t>(sizes[i]);
+        }
+        uchar* data = data0 ? static_cast<uchar*>(data0) : static_cast<uchar*>(pool_.acquire(total));
+        if (!data) throw std::bad_alloc();
+        cv::UMatData* u = new (header()) cv::UMatData(this);
+        u->data = u->origdata = data;
+        u->size = total;
+        if (data0) u->flags |= cv::UMatData::USER_ALLOCATED;
+        return u;
+    }
+
+    bool allocate(cv::UMatData* u, AccessFlags /*flags*/, cv::UMatUsageFlags /*usage*/) const override {
+        return u != nullptr;
+    }
+
+    void deallocate(cv::UMatData* u) const override {
+        if (!u) return;
+        if (!(u->flags & cv::UMatData::USER_ALLOCATED) && u->origdata) {
+            pool_.release(u->origdata, u->size);
+            u->origdata = nullptr;
+        }
+        u->~UMatData();
+        std::lock_guard<std::mutex> lock(mutex_);
+        headers_.push_back(u);
+    }
+
+private:
+    void* header() const {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!headers_.empty()) {
+                void* h = headers_.back();
+                headers_.pop_back();
+                return h;
+            }
+        }
+        return ::operator new(sizeof(cv::UMatData));
+    }
+
+    FramePool& pool_;
+    mutable std::mutex mutex_;
+    mutable std::vector<void*> headers_;
+};
+
+} // namespace
+
+double FramePool::Stats::hit_rate() const {
+    const uint64_t acquires = hits + misses;
+    return acquires ? static_cast<double>(hits) / acquires : 0.0;
+}
+
+std::string FramePool::Stats::summary() const {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "[pool] hits=%llu misses=%llu hit_rate=%.1f%% in_use_mb=%.1f peak_mb=%.1f cached_mb=%.1f huge_blocks=%llu",
+                  static_cast<unsigned long long>(hits), static_cast<unsigned long long>(misses), 100.0 * hit_rate(),
+                  bytes_in_use / 1048576.0, peak_bytes_in_use / 1048576.0, bytes_cached / 1048576.0,
+                  static_cast<unsigned long long>(huge_page_blocks));
+    return buffer;
+}
+
+FramePool::FramePool(const FramePoolOptions& options)
+    : options_(options), allocator_(new PoolMatAllocator(*this)) {}
+
+FramePool::~FramePool() {
+    trim();
+}
+
+FramePool& FramePool::instance() {
+    static FramePool* pool = new FramePool();
+    return *pool;
+}
+
+size_t FramePool::class_index(size_t bytes) {
+    bytes = std::max(bytes, MIN_BLOCK_BYTES);
+    if (bytes <= PAGE_BYTES) {
+        return static_cast<size_t>(floor_log2(bytes - 1) + 1 - floor_log2(MIN_BLOCK_BYTES));
+    }
+    // 2^o < bytes <= 2^(o+1), split into four steps of 2^(o-2)
+    const int o = floor_log2(bytes - 1);
+    const size_t base = size_t(1) << o, quarter = base >> 2;
+    const size_t k = (bytes - base + quarter - 1) / quarter;  // 1..4
+    return SMALL_CLASSES + static_cast<size_t>(o - floor_log2(PAGE_BYTES)) * 4 + (k - 1);
+}
+
+size_t FramePool::class_bytes(size_t index) {
+    if (index < SMALL_CLASSES) return MIN_BLOCK_BYTES << index;
+    const size_t octave = (index - SMALL_CLASSES) / 4, k = (index - SMALL_CLASSES) % 4 + 1;
+    const size_t base = PAGE_BYTES << octave;
+    return base + k * (base >> 2);
+}
+
+size_t FramePool::block_bytes(size_t bytes) {
+    return class_bytes(class_index(bytes));
+}
+
+void* FramePool::allocate_block(size_t bytes, bool huge_pages, bool& huge) {
+    huge = false;
+    if (bytes < HUGE_PAGE_BYTES) return std::aligned_alloc(MIN_BLOCK_BYTES, bytes);
+
+    // Large blocks are mmap'd so freeing them really returns the memory
+    const size_t length = round_up(bytes, PAGE_BYTES);
+    if (!huge_pages) {
+        void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+    // Over-map, then cut back to a 2 MB aligned range the kernel can back with huge pages
+    void* raw = ::mmap(nullptr, length + HUGE_PAGE_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+    const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = round_up(start, HUGE_PAGE_BYTES);
+    if (aligned > start) ::munmap(raw, aligned - start);
+    const size_t tail = start + length + HUGE_PAGE_BYTES - (aligned + length);
+    if (tail > 0) ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+#if defined(MADV_HUGEPAGE)
+    huge = ::madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE) == 0;
+#endif
+    return reinterpret_cast<void*>(aligned);
+}
+
+void FramePool::free_block(void* block, size_t bytes) {
+    if (bytes < HUGE_PAGE_BYTES) {
+        std::free(block);
+    } else {
+        ::munmap(block, round_up(bytes, PAGE_BYTES));
+    }
+}
+
+void* FramePool::acquire(size_t bytes) {
+    const size_t index = class_index(bytes);
+    const size_t size = class_bytes(index);
+    bool huge_pages = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (classes_.size() <= index) classes_.resize(index + 1);
+        SizeClass& size_class = classes_[index];
+        ++size_class.in_use;
+        ++stats_.blocks_in_use;
+        stats_.bytes_in_use += size;
+        stats_.peak_bytes_in_use = std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+        if (!size_class.free.empty()) {
+            void* block = size_class.free.back();
+            size_class.free.pop_back();
+            --stats_.blocks_cached;
+            stats_.bytes_cached -= size;
+            ++stats_.hits;
+            return block;
+        }
+        ++stats_.misses;
+        huge_pages = options_.huge_pages;
+    }
+
+    // Outside the lock: the allocation itself and any page-fault cost are per thread
+    bool huge = false;
+    void* block = allocate_block(size, huge_pages, huge);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!block) {
+        --classes_[index].in_use;
+        --stats_.blocks_in_use;
+        stats_.bytes_in_use -= size;
+        return nullptr;
+    }
+    if (huge) ++stats_.huge_page_blocks;
+    return block;
+}
+
+void FramePool::release(void* block, size_t bytes) {
+    if (!block) return;
+    const size_t index = class_index(bytes);
+    const size_t size = class_bytes(index);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SizeClass& size_class = classes_[index];
+        --size_class.in_use;
+        --stats_.blocks_in_use;
+        stats_.bytes_in_use -= size;
+        ++stats_.releases;
+        if (stats_.bytes_cached + size <= options_.max_cached_bytes) {
+            size_class.free.push_back(block);
+            ++stats_.blocks_cached;
+            stats_.bytes_cached += size;
+            return;
+        }
+        ++stats_.drops;
+    }
+    free_block(block, size);
+}
+
+cv::Mat FramePool::mat(int rows, int cols, int type) {
+    cv::Mat m;
+    m.allocator = allocator_.get();
+    m.create(rows, cols, type);
+    return m;
+}
+
+cv::MatAllocator* FramePool::allocator() {
+    return allocator_.get();
+}
+
+void FramePool::set_options(const FramePoolOptions& options) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+    drop_cached_locked(options_.max_cached_bytes);
+}
+
+FramePoolOptions FramePool::options() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return options_;
+}
+
+void FramePool::trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drop_cached_locked(0);
+}
+
+void FramePool::drop_cached_locked(size_t budget) {
+    // Largest classes first: fewest frees for the most memory
+    for (size_t index = classes_.size(); index-- > 0 && stats_.bytes_cached > budget;) {
+        SizeClass& size_class = classes_[index];
+        const size_t size = class_bytes(index);
+        while (!size_class.free.empty() && stats_.bytes_cached > budget) {
+            free_block(size_class.free.back(), size);
+            size_class.free.pop_back();
+            --stats_.blocks_cached;
+            stats_.bytes_cached -= size;
+        }
+    }
+}
+
+void FramePool::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.hits = stats_.misses = stats_.releases = stats_.drops = stats_.huge_page_blocks = 0;
+    stats_.peak_bytes_in_use = stats_.bytes_in_use;
+}
+
+FramePool::Stats FramePool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::vector<FramePool::ClassOccupancy> FramePool::occupancy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ClassOccupancy> result;
+    for (size_t index = 0; index < classes_.size(); ++index) {
+        const SizeClass& size_class = classes_[index];
+        if (size_class.in_use == 0 && size_class.free.empty()) continue;
+        result.push_back({class_bytes(index), size_class.in_use, size_class.free.size()});
+    }
+    return result;
+}
+
+ScopedFramePool::ScopedFramePool(FramePool& pool) : previous_(cv::Mat::getDefaultAllocator()) {
+    cv::Mat::setDefaultAllocator(pool.allocator());
+}
+
+ScopedFramePool::~ScopedFramePool() {
+    cv::Mat::setDefaultAllocator(previous_);
+}
+
+} // namespace optimization
+} // namespace cppengine
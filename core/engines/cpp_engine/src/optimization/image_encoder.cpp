@@ -0,0 +1,180 @@
+#include "optimization/image_encoder.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+namespace cppengine {
+namespace optimization {
+
+namespace {
+
+enum FormatFamily { FAMILY_PNG = 0, FAMILY_JPEG, FAMILY_WEBP, FAMILY_OTHER, FAMILY_COUNT };
+
+// Encode cost priors in ns/pixel for 8-bit BGR, indexed [family][FASTEST, BALANCED, SMALLEST].
+// Refined with an exponential moving average of measured encodes.
+struct CostModel {
+    std::mutex mutex;
+    double ns_per_pixel[FAMILY_COUNT][3] = {
+        {6.0, 14.0, 70.0},   // png: zlib level dominates
+        {5.0, 8.0, 10.0},    // jpeg: optimized Huffman costs a second pass
+        {40.0, 60.0, 90.0},  // webp
+        {2.0, 2.0, 2.0},     // bmp/tiff/ppm: mostly memcpy
+    };
+};
+
+CostModel& cost_model() {
+    static CostModel model;
+    return model;
+}
+
+std::string normalize_format(const std::string& format) {
+    std::string ext = format;
+    const size_t dot = ext.find_last_of('.');
+    if (dot != std::string::npos) ext = ext.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (ext == "jpeg") ext = "jpg";
+    return ext.empty() ? "png" : ext;
+}
+
+FormatFamily family_of(const std::string& format) {
+    if (format == "png") return FAMILY_PNG;
+    if (format == "jpg" || format == "jpe") return FAMILY_JPEG;
+    if (format == "webp") return FAMILY_WEBP;
+    return FAMILY_OTHER;
+}
+
+int profile_index(EncodeProfile profile) {
+    switch (profile) {
+        case EncodeProfile::FASTEST: return 0;
+        case EncodeProfile::SMALLEST: return 2;
+        default: return 1;
+    }
+}
+
+} // namespace
+
+std::string EncodeResult::summary() const {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer), "[encode] format=%s profile=%s bytes=%zu encode_ms=%.2f",
+                  format.c_str(), ImageEncoder::profile_name(profile).c_str(), bytes, encode_ms);
+    return buffer;
+}
+
+EncodeProfile ImageEncoder::parse_profile(const std::string& name) {
+    if (name == "auto") return EncodeProfile::AUTO;
+    if (name == "fastest") return EncodeProfile::FASTEST;
+    if (name == "balanced") return EncodeProfile::BALANCED;
+    if (name == "smallest") return EncodeProfile::SMALLEST;
+    throw std::invalid_argument("Unknown encode profile: " + name);
+}
+
+std::string ImageEncoder::profile_name(EncodeProfile profile) {
+    switch (profile) {
+        case EncodeProfile::AUTO: return "auto";
+        case EncodeProfile::FASTEST: return "fastest";
+        case EncodeProfile::BALANCED: return "balanced";
+        case EncodeProfile::SMALLEST: return "smallest";
+    }
+    return "balanced";
+}
+
+std::vector<int> ImageEncoder::params_for(const std::string& format, EncodeProfile profile) {
+    switch (family_of(normalize_format(format))) {
+        case FAMILY_PNG:
+            switch (profile) {
+                case EncodeProfile::FASTEST:
+                    return {cv::IMWRITE_PNG_COMPRESSION, 1, cv::IMWRITE_PNG_STRATEGY, cv::IMWRITE_PNG_STRATEGY_RLE};
+                case EncodeProfile::SMALLEST:
+                    return {cv::IMWRITE_PNG_COMPRESSION, 9, cv::IMWRITE_PNG_STRATEGY, cv::IMWRITE_PNG_STRATEGY_DEFAULT};
+                default:
+                    return {cv::IMWRITE_PNG_COMPRESSION, 3, cv::IMWRITE_PNG_STRATEGY, cv::IMWRITE_PNG_STRATEGY_FILTERED};
+            }
+        case FAMILY_JPEG:
+            switch (profile) {
+                case EncodeProfile::FASTEST:
+                    return {cv::IMWRITE_JPEG_QUALITY, 90, cv::IMWRITE_JPEG_OPTIMIZE, 0};
+                case EncodeProfile::SMALLEST:
+                    return {cv::IMWRITE_JPEG_QUALITY, 85, cv::IMWRITE_JPEG_OPTIMIZE, 1};
+                default:
+                    return {cv::IMWRITE_JPEG_QUALITY, 90, cv::IMWRITE_JPEG_OPTIMIZE, 1};
+            }
+        case FAMILY_WEBP:
+            // OpenCV's WebP writer exposes quality only (no method/effort knob)
+            switch (profile) {
+                case EncodeProfile::FASTEST: return {cv::IMWRITE_WEBP_QUALITY, 90};
+                case EncodeProfile::SMALLEST: return {cv::IMWRITE_WEBP_QUALITY, 75};
+                default: return {cv::IMWRITE_WEBP_QUALITY, 85};
+            }
+        default:
+            return {};
+    }
+}
+
+double ImageEncoder::predicted_ms(const std::string& format, EncodeProfile profile, size_t pixels) {
+    CostModel& model = cost_model();
+    std::lock_guard<std::mutex> lock(model.mutex);
+    return model.ns_per_pixel[family_of(normalize_format(format))][profile_index(profile)] * pixels / 1e6;
+}
+
+EncodeProfile ImageEncoder::select_profile(const std::string& format, size_t pixels, double latency_budget_ms) {
+    if (latency_budget_ms <= 0.0) return EncodeProfile::BALANCED;
+    for (EncodeProfile candidate : {EncodeProfile::SMALLEST, EncodeProfile::BALANCED}) {
+        if (predicted_ms(format, candidate, pixels) <= latency_budget_ms) return candidate;
+    }
+    return EncodeProfile::FASTEST;
+}
+
+EncodeResult ImageEncoder::encode(const cv::Mat& image, const std::string& format,
+                                  const EncodeOptions& options, std::vector<unsigned char>& out) {
+    EncodeResult result;
+    result.format = normalize_format(format);
+    const size_t pixels = image.total();
+    result.profile = options.profile == EncodeProfile::AUTO
+        ? select_profile(result.format, pixels, options.latency_budget_ms)
+        : options.profile;
+
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        result.success = cv::imencode("." + result.format, image, out, params_for(result.format, result.profile));
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error encoding " + result.format + ": " + std::string(e.what()));
+        result.success = false;
+    }
+    result.encode_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!result.success) return result;
+    result.bytes = out.size();
+
+    if (pixels > 0) {
+        CostModel& model = cost_model();
+        std::lock_guard<std::mutex> lock(model.mutex);
+        double& cost = model.ns_per_pixel[family_of(result.format)][profile_index(result.profile)];
+        cost = 0.8 * cost + 0.2 * (result.encode_ms * 1e6 / pixels);
+    }
+    return result;
+}
+
+EncodeResult ImageEncoder::write(const std::string& output_file, const cv::Mat& image, const EncodeOptions& options) {
+    std::vector<unsigned char> bytes;
+    EncodeResult result = encode(image, std::filesystem::path(output_file).extension().string(), options, bytes);
+    if (!result.success) return result;
+
+    std::ofstream out(output_file, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+        cpp_engine::utils::Logger::instance().error("Failed to write encoded image: " + output_file);
+        result.success = false;
+    }
+    return result;
+}
+
+} // namespace optimization
+} // namespace cppengine
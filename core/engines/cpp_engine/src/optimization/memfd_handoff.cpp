@@ -0,0 +1,63 @@
+#include "optimization/memfd_handoff.h"
+#include "utils/logger.h"
+#include "utils/shared_memory.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <vector>
+
+namespace cppengine {
+namespace optimization {
+
+bool MemfdHandoff::is_fd_spec(const std::string& spec) {
+    int fd = -1;
+    return utils::SharedMemoryBuffer::parse_fd_spec(spec, fd, nullptr);
+}
+
+bool MemfdHandoff::load(const std::string& spec, cv::Mat& image) {
+    int fd = -1;
+    try {
+        if (!utils::SharedMemoryBuffer::parse_fd_spec(spec, fd, nullptr)) {
+            image = cv::imread(spec);
+        } else {
+            utils::SharedMemoryBuffer buffer(fd);
+            if (!buffer.map() || buffer.size() == 0) {
+                cpp_engine::utils::Logger::instance().error("Failed to map input memfd: " + spec);
+                return false;
+            }
+            // Decode from the mapping itself; the wrapper Mat owns nothing
+            const cv::Mat bytes(1, static_cast<int>(buffer.size()), CV_8U, const_cast<uint8_t*>(buffer.data()));
+            image = cv::imdecode(bytes, cv::IMREAD_COLOR);
+        }
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error loading " + spec + ": " + std::string(e.what()));
+        return false;
+    }
+    if (image.empty()) {
+        cpp_engine::utils::Logger::instance().error("Failed to load image: " + spec);
+        return false;
+    }
+    return true;
+}
+
+EncodeResult MemfdHandoff::store(const std::string& spec, const cv::Mat& image, const EncodeOptions& options) {
+    int fd = -1;
+    std::string ext;
+    if (!utils::SharedMemoryBuffer::parse_fd_spec(spec, fd, &ext)) {
+        return ImageEncoder::write(spec, image, options);
+    }
+
+    std::vector<unsigned char> bytes;
+    EncodeResult result = ImageEncoder::encode(image, ext.empty() ? "png" : ext, options, bytes);
+    if (!result.success) return result;
+
+    utils::SharedMemoryBuffer buffer(fd);
+    if (!buffer.write(bytes.data(), bytes.size()) || !buffer.seal()) {
+        cpp_engine::utils::Logger::instance().error("Failed to write output memfd: " + spec);
+        result.success = false;
+    }
+    return result;
+}
+
+} // namespace optimization
+} // namespace cppengine
@@ -0,0 +1,233 @@
+#include "optimization/parameter_sweep.h"
+#include "effects/bloom.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+
+namespace cppengine {
+namespace optimization {
+
+namespace {
+
+// Summed-area table over a border-padded image; uint32 wraps but window sums stay exact
+struct SummedAreaTable {
+    std::vector<uint32_t> sums;  // (rows + 1) x (cols + 1) x cn, first row/column zero
+    int rows = 0, cols = 0, cn = 0;
+    int pad_before = 0;
+
+    size_t index(int y, int x) const { return (static_cast<size_t>(y) * (cols + 1) + x) * cn; }
+
+    void build(const cv::Mat& padded) {
+        rows = padded.rows;
+        cols = padded.cols;
+        cn = padded.channels();
+        sums.assign(static_cast<size_t>(rows + 1) * (cols + 1) * cn, 0);
+        std::vector<uint32_t> row_sum(cn);
+        for (int y = 0; y < rows; ++y) {
+            const uint8_t* src = padded.ptr<uint8_t>(y);
+            std::fill(row_sum.begin(), row_sum.end(), 0u);
+            uint32_t* above = &sums[index(y, 1)];
+            uint32_t* out = &sums[index(y + 1, 1)];
+            for (int x = 0; x < cols * cn; ++x) {
+                row_sum[x % cn] += src[x];
+                out[x] = above[x] + row_sum[x % cn];
+            }
+        }
+    }
+};
+
+// Same footprint and border as cv::blur(image, result, Size(k, k)): anchor k/2, BORDER_REFLECT_101
+void box_from_sat(const SummedAreaTable& sat, int k, int out_rows, int out_cols, cv::Mat& result) {
+    result.create(out_rows, out_cols, CV_8UC(sat.cn));
+    const int cn = sat.cn;
+    const uint32_t area = static_cast<uint32_t>(k) * k;
+    const int offset = sat.pad_before - k / 2;
+    cv::parallel_for_(cv::Range(0, out_rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            const uint32_t* top = &sat.sums[sat.index(y + offset, offset)];
+            const uint32_t* bottom = &sat.sums[sat.index(y + offset + k, offset)];
+            uint8_t* out = result.ptr<uint8_t>(y);
+            const size_t span = static_cast<size_t>(k) * cn;
+            for (int i = 0; i < out_cols * cn; ++i) {
+                const uint32_t sum = bottom[i + span] - bottom[i] - top[i + span] + top[i];
+                out[i] = static_cast<uint8_t>((sum + area / 2) / area);
+            }
+        }
+    });
+}
+
+void blur_sweep(const cv::Mat& image, const std::vector<ParameterSweep::Params>& variants,
+                std::vector<cv::Mat>& results) {
+    int max_k = 1;
+    for (const auto& p : variants) max_k = std::max(max_k, static_cast<int>(p.at(0)));
+    cv::Mat padded;
+    const int before = max_k / 2, after = max_k - 1 - max_k / 2;
+    cv::copyMakeBorder(image, padded, before, after, before, after, cv::BORDER_REFLECT_101);
+
+    SummedAreaTable sat;
+    sat.pad_before = before;
+    sat.build(padded);
+    for (size_t i = 0; i < variants.size(); ++i) {
+        box_from_sat(sat, static_cast<int>(variants[i][0]), image.rows, image.cols, results[i]);
+    }
+}
+
+cv::Mat linear_lut(double alpha, double beta) {
+    cv::Mat lut(1, 256, CV_8U);
+    for (int v = 0; v < 256; ++v) lut.at<uchar>(v) = cv::saturate_cast<uchar>(v * alpha + beta);
+    return lut;
+}
+
+void saturation_sweep(const cv::Mat& image, const std::vector<ParameterSweep::Params>& variants,
+                      std::vector<cv::Mat>& results) {
+    cv::Mat hsv;
+    cv::cvtColor(image, hsv, cv::COLOR_BGR2HSV);
+    std::vector<cv::Mat> planes;
+    cv::split(hsv, planes);
+
+    cv::parallel_for_(cv::Range(0, static_cast<int>(variants.size())), [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; ++i) {
+            // Same rounding as adjust_saturation: saturate_cast<uchar>(s * factor) in float
+            const float factor = variants[i][0];
+            cv::Mat lut(1, 256, CV_8U);
+            for (int v = 0; v < 256; ++v) lut.at<uchar>(v) = cv::saturate_cast<uchar>(v * factor);
+            std::vector<cv::Mat> adjusted = {planes[0], cv::Mat(), planes[2]};
+            cv::LUT(planes[1], lut, adjusted[1]);
+            cv::Mat merged;
+            cv::merge(adjusted, merged);
+            cv::cvtColor(merged, results[i], cv::COLOR_HSV2BGR);
+        }
+    });
+}
+
+// Default BloomOptions, as EffectsEngine::apply_bloom
+void bloom_sweep(const cv::Mat& image, const std::vector<ParameterSweep::Params>& variants,
+                 std::vector<cv::Mat>& results) {
+    const effects::BloomOptions options;
+
+    // One glow per distinct threshold
+    std::map<float, std::vector<size_t>> by_threshold;
+    for (size_t i = 0; i < variants.size(); ++i) by_threshold[variants[i].at(0)].push_back(i);
+    std::vector<std::pair<float, std::vector<size_t>>> groups(by_threshold.begin(), by_threshold.end());
+
+    cv::parallel_for_(cv::Range(0, static_cast<int>(groups.size())), [&](const cv::Range& range) {
+        for (int g = range.start; g < range.end; ++g) {
+            cv::Mat glow;
+            effects::Bloom::glow(image, groups[g].first, options, glow);
+            for (size_t i : groups[g].second) {
+                const float intensity = variants[i].size() > 1 ? variants[i][1] : 0.6f;
+                effects::Bloom::combine(image, glow, intensity, options, results[i]);
+            }
+        }
+    });
+}
+
+} // namespace
+
+ParameterSweep::ParameterSweep() {}
+
+ParameterSweep::~ParameterSweep() {}
+
+bool ParameterSweep::has_shared_state(const std::string& op) {
+    return op == "blur" || op == "saturation" || op == "brightness" || op == "contrast" || op == "bloom";
+}
+
+ParameterSweep::Params ParameterSweep::parse_params(const std::string& variant) {
+    Params params;
+    size_t start = 0;
+    while (start <= variant.size()) {
+        const size_t end = std::min(variant.find(':', start), variant.size());
+        params.push_back(std::stof(variant.substr(start, end - start)));
+        start = end + 1;
+    }
+    return params;
+}
+
+bool ParameterSweep::run(const std::string& op, const cv::Mat& image, const std::vector<Params>& variants,
+                         std::vector<cv::Mat>& results) {
+    results.assign(variants.size(), cv::Mat());
+    for (const auto& p : variants) {
+        if (p.empty()) return false;
+    }
+    try {
+        cpp_engine::utils::Logger::instance().info("Parameter sweep " + op + ": " + std::to_string(variants.size()) + " variants");
+        const bool eight_bit = image.depth() == CV_8U;
+        if (op == "blur" && eight_bit) {
+            for (const auto& p : variants) {
+                if (p[0] < 1.0f) return false;
+            }
+            blur_sweep(image, variants, results);
+        } else if (op == "brightness" || op == "contrast") {
+            for (size_t i = 0; i < variants.size(); ++i) {
+                // Same mapping as adjust_brightness/adjust_contrast (convertTo alpha/beta)
+                const bool brightness = op == "brightness";
+                const double alpha = brightness ? 1.0 : variants[i][0];
+                const double beta = brightness ? variants[i][0] * 50.0 : 0.0;
+                if (eight_bit) cv::LUT(image, linear_lut(alpha, beta), results[i]);
+                else image.convertTo(results[i], -1, alpha, beta);
+            }
+        } else if (op == "saturation" && image.type() == CV_8UC3) {
+            saturation_sweep(image, variants, results);
+        } else if (op == "bloom" && image.type() == CV_8UC3) {
+            bloom_sweep(image, variants, results);
+        } else if (fallback_) {
+            // Engines keep per-instance scratch state, so fallback variants run one by one
+            for (size_t i = 0; i < variants.size(); ++i) {
+                if (!fallback_(image, variants[i], results[i])) return false;
+            }
+        } else {
+            cpp_engine::utils::Logger::instance().error("Parameter sweep: unsupported operation " + op);
+            return false;
+        }
+        return true;
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error in parameter sweep: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool ParameterSweep::run(const std::string& op, const std::string& input_file, const std::string& output_file,
+                         const std::vector<std::string>& variants, std::vector<Output>& outputs) {
+    std::vector<Params> params;
+    for (const auto& v : variants) params.push_back(parse_params(v));
+
+    cv::Mat image;
+    try {
+        image = cv::imread(input_file);
+    } catch (const cv::Exception& e) {
+        cpp_engine::utils::Logger::instance().error("OpenCV error loading " + input_file + ": " + std::string(e.what()));
+        return false;
+    }
+    if (image.empty()) {
+        cpp_engine::utils::Logger::instance().error("Failed to load image: " + input_file);
+        return false;
+    }
+
+    std::vector<cv::Mat> results;
+    if (!run(op, image, params, results)) return false;
+
+    const std::filesystem::path out(output_file);
+    outputs.clear();
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::string tag = variants[i];
+        std::replace(tag.begin(), tag.end(), ':', '_');
+        Output o;
+        o.file = (out.parent_path() / (out.stem().string() + "_" + op + "_" + tag + out.extension().string())).string();
+        o.encode = ImageEncoder::write(o.file, results[i], encode_options_);
+        if (!o.encode.success) {
+            cpp_engine::utils::Logger::instance().error("Failed to save sweep variant: " + o.file);
+            return false;
+        }
+        outputs.push_back(o);
+    }
+    return true;
+}
+
+} // namespace optimization
+} // namespace cppengine
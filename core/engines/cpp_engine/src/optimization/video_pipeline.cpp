@@ -0,0 +1,224 @@
+#include "optimization/video_pipeline.h"
+#include "optimization/bounded_queue.h"
+#include "optimization/frame_pool.h"
+#include "utils/logger.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace cppengine {
+namespace optimization {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+int64_t microseconds_since(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+} // namespace
+
+double VideoPipeline::Stats::fps() const {
+    return seconds > 0.0 ? frames / seconds : 0.0;
+}
+
+std::string VideoPipeline::Stats::summary() const {
+    const double n = frames > 0 ? static_cast<double>(frames) : 1.0;
+    std::ostringstream out;
+    out << frames << " frames in " << std::fixed << std::setprecision(2) << seconds << " s ("
+        << std::setprecision(1) << fps() << " fps); per frame: decode " << std::setprecision(2) << decode_ms / n
+        << " ms, transform " << transform_ms / n << " ms (all threads), encode " << encode_ms / n << " ms";
+    return out.str();
+}
+
+VideoPipeline::VideoPipeline() {}
+
+VideoPipeline::VideoPipeline(const Config& config) : config_(config) {}
+
+VideoPipeline::~VideoPipeline() {}
+
+VideoPipeline::Stats VideoPipeline::run(const Source& source, const TransformFactory& make_transform,
+                                        const Sink& sink) {
+    const int hw = std::max(1u, std::thread::hardware_concurrency());
+    const int transforms = config_.transform_threads > 0 ? config_.transform_threads : hw;
+    const int64_t ring = static_cast<int64_t>(config_.ring_frames > 0 ? config_.ring_frames
+                                                                      : static_cast<size_t>(2 * transforms));
+
+    // Parallelism comes from frames in flight; nested OpenCV threading would only oversubscribe
+    const int previous_cv_threads = cv::getNumThreads();
+    if (transforms > 1) cv::setNumThreads(1);
+
+    BoundedQueue<Frame> decoded(static_cast<size_t>(ring));
+    BoundedQueue<Frame> transformed(static_cast<size_t>(ring));
+    std::mutex mutex;
+    std::condition_variable delivered_cv;
+    int64_t delivered = 0;
+    bool stop = false;
+    std::atomic<bool> failed{false};
+    std::atomic<int64_t> decode_us{0}, transform_us{0};
+    std::atomic<int> transforms_left{transforms};
+    const auto start = Clock::now();
+
+    auto halt = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        delivered_cv.notify_all();
+        decoded.close();
+        transformed.close();
+    };
+    auto fail = [&](const std::string& message) {
+        cpp_engine::utils::Logger::instance().error("VideoPipeline: " + message);
+        failed = true;
+        halt();
+    };
+
+    std::vector<std::thread> threads;
+    threads.emplace_back([&]() {
+        for (int64_t sequence = 0;; ++sequence) {
+            {
+                // At most ring frames between the decoder and the last delivered one
+                std::unique_lock<std::mutex> lock(mutex);
+                delivered_cv.wait(lock, [&] { return stop || sequence < delivered + ring; });
+                if (stop) break;
+            }
+            Frame frame;
+            frame.sequence = sequence;
+            const auto decode_start = Clock::now();
+            bool more = false;
+            try {
+                more = source(frame);
+            } catch (const std::exception& e) {
+                fail(std::string("source threw: ") + e.what());
+                break;
+            }
+            decode_us += microseconds_since(decode_start);
+            if (!more) break;
+            if (frame.image.empty()) {
+                fail("empty frame " + std::to_string(sequence));
+                break;
+            }
+            if (!decoded.push(std::move(frame))) break;
+        }
+        decoded.close();
+    });
+
+    for (int t = 0; t < transforms; ++t) {
+        threads.emplace_back([&]() {
+            Transform transform = make_transform();
+            Frame frame;
+            while (decoded.pop(frame)) {
+                cv::Mat out = FramePool::instance().mat(frame.image.rows, frame.image.cols, frame.image.type());
+                const auto transform_start = Clock::now();
+                bool ok = false;
+                try {
+                    ok = transform && transform(frame, out);
+                } catch (const std::exception& e) {
+                    cpp_engine::utils::Logger::instance().error(std::string("VideoPipeline: transform threw: ") +
+                                                                e.what());
+                }
+                transform_us += microseconds_since(transform_start);
+                if (!ok || out.empty()) {
+                    fail("transform failed on frame " + std::to_string(frame.sequence));
+                    break;
+                }
+                frame.image = out;  // the decoded buffer goes back to the pool here
+                frame.context.reset();
+                if (!transformed.push(std::move(frame))) break;
+            }
+            if (transforms_left.fetch_sub(1) == 1) transformed.close();
+        });
+    }
+
+    // Calling thread: restore sequence order and hand frames to the sink
+    Stats stats;
+    std::map<int64_t, Frame> pending;
+    int64_t sink_us = 0;
+    Frame frame;
+    while (!failed && transformed.pop(frame)) {
+        pending.emplace(frame.sequence, std::move(frame));
+        for (auto it = pending.find(delivered); !failed && it != pending.end(); it = pending.find(delivered)) {
+            const auto sink_start = Clock::now();
+            bool ok = false;
+            try {
+                ok = sink(it->first, it->second.image);
+            } catch (const std::exception& e) {
+                cpp_engine::utils::Logger::instance().error(std::string("VideoPipeline: sink threw: ") + e.what());
+            }
+            sink_us += microseconds_since(sink_start);
+            pending.erase(it);
+            if (!ok) {
+                fail("sink failed on frame " + std::to_string(delivered));
+                break;
+            }
+            ++stats.frames;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++delivered;
+            }
+            delivered_cv.notify_all();
+        }
+        stats.peak_reorder = std::max(stats.peak_reorder, pending.size());
+    }
+
+    halt();
+    for (auto& t : threads) t.join();
+    cv::setNumThreads(previous_cv_threads);
+
+    stats.ok = !failed && pending.empty();
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    stats.decode_ms = decode_us / 1000.0;
+    stats.transform_ms = transform_us / 1000.0;
+    stats.encode_ms = sink_us / 1000.0;
+    return stats;
+}
+
+VideoPipeline::Stats VideoPipeline::run(const std::string& input_file, const std::string& output_file,
+                                        const TransformFactory& make_transform) {
+    Stats stats;
+    cv::VideoCapture capture(input_file);
+    if (!capture.isOpened()) {
+        cpp_engine::utils::Logger::instance().error("VideoPipeline: cannot open video " + input_file);
+        return stats;
+    }
+    const int width = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    const int height = static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    double fps = capture.get(cv::CAP_PROP_FPS);
+    if (!(fps > 0.0)) fps = 30.0;
+
+    // Opened on the first frame: transforms may change the frame size
+    cpp_engine::generators::VideoEncoder encoder;
+    stats = run(
+        [&](Frame& frame) {
+            if (width > 0 && height > 0) frame.image = FramePool::instance().mat(height, width, CV_8UC3);
+            return capture.read(frame.image);
+        },
+        make_transform,
+        [&](int64_t, const cv::Mat& image) {
+            if (!encoder.is_open() && !encoder.open(output_file, image.cols, image.rows, fps, config_.encode)) {
+                return false;
+            }
+            return encoder.write(image);  // queued to the encoder thread by reference
+        });
+    const bool closed = encoder.close();
+    stats.ok = stats.ok && closed && stats.frames > 0;
+    stats.encode_ms = encoder.stats().encode_ms;
+    cpp_engine::utils::Logger::instance().info("Video pipeline " + input_file + " -> " + output_file + ": " +
+                                               stats.summary());
+    return stats;
+}
+
+} // namespace optimization
+} // namespace cppengine
@@ -5,6 +5,7 @@
 int main(int argc, char* argv[]) {
     std::string host = "127.0.0.1";
     int port = 3004;
+    bool memfd_handoff = false;
     
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -13,12 +14,15 @@ int main(int argc, char* argv[]) {
             host = argv[++i];
         } else if (arg == "--port" && i + 1 < argc) {
             port = std::stoi(argv[++i]);
+        } else if (arg == "--memfd-handoff") {
+            memfd_handoff = true;
         } else if (arg == "-h" || arg == "--help") {
             std::cout << "cpp_engine HTTP Server\n"
                       << "Usage: cpp_engine_server [OPTIONS]\n"
                       << "Options:\n"
                       << "  --host <HOST>  Bind to host (default: 127.0.0.1)\n"
                       << "  --port <PORT>  Bind to port (default: 3004)\n"
+                      << "  --memfd-handoff  Allow /process to pass images to workers through memfds\n"
                       << "  -h, --help     Show this help message\n";
             return 0;
         }
@@ -28,6 +32,7 @@ int main(int argc, char* argv[]) {
         cppengine::network::HttpServer::Config config;
         config.host = host;
         config.port = port;
+        config.memfd_handoff = memfd_handoff;
         
         cppengine::network::HttpServer server(config);
         server.start();
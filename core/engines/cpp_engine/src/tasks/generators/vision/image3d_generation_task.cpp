@@ -1,8 +1,18 @@
 #include "../../include/tasks/image3d_generation_task.h"
 #include <iostream>
+#include "generators/isosurface.h"
+#include "generators/mesh_io.h"
+#include "generators/mesh_simplifier.h"
 #include "utils/logger.h"
 
-Image3DGenerationTask::Image3DGenerationTask() : configured_(false) {}
+using cpp_engine::generators::IsosurfaceExtractor;
+using cpp_engine::generators::IsosurfaceOptions;
+using cpp_engine::generators::Mesh;
+using cpp_engine::generators::MeshIO;
+using cpp_engine::generators::MeshSimplifier;
+using cpp_engine::generators::SimplifyOptions;
+
+Image3DGenerationTask::Image3DGenerationTask() : configured_(false), resolution_(128), seed_(0), targetTriangles_(0) {}
 Image3DGenerationTask::~Image3DGenerationTask() {}
 
 void Image3DGenerationTask::configure(const std::string& modelPath) {
@@ -11,9 +21,37 @@ void Image3DGenerationTask::configure(const std::string& modelPath) {
     log("Modèle 3D configuré: " + modelPath_);
 }
 
+void Image3DGenerationTask::set_resolution(int resolution) {
+    resolution_ = resolution;
+}
+
+void Image3DGenerationTask::set_seed(unsigned int seed) {
+    seed_ = seed;
+}
+
+void Image3DGenerationTask::set_target_triangles(size_t target) {
+    targetTriangles_ = target;
+}
+
 bool Image3DGenerationTask::run(const std::string& outputPath) {
     if (!configured_) throw std::runtime_error("Tâche non configurée");
     log("Génération 3D vers " + outputPath);
+    // Sphère déformée par du bruit, extraite par tranches; le format suit l'extension (.obj, .ply, .glb)
+    IsosurfaceOptions options;
+    options.resolution = resolution_;
+    Mesh mesh;
+    if (!IsosurfaceExtractor::extract(IsosurfaceExtractor::displaced_sphere(0.7f, 0.15f, 2.0f, seed_), options, mesh)) {
+        return false;
+    }
+    // Décimation par quadriques; au-delà d'un million de triangles, un regroupement parallèle la précède
+    if (targetTriangles_ > 0 && mesh.triangle_count() > targetTriangles_) {
+        SimplifyOptions simplify;
+        simplify.target_triangles = targetTriangles_;
+        simplify.cluster_above = 1000000;
+        if (!MeshSimplifier::simplify(mesh, simplify, mesh)) return false;
+    }
+    if (!MeshIO::write(outputPath, mesh)) return false;
+    log(std::to_string(mesh.triangle_count()) + " triangles écrits");
     return true;
 }
 
@@ -12,12 +12,14 @@ Logger& Logger::instance() {
 }
 
 void Logger::init(const std::string& log_file, LogLevel level) {
-    level_ = level;
+    std::lock_guard<std::mutex> lock(mutex_);
+    level_.store(level, std::memory_order_relaxed);
     log_file_.open(log_file, std::ios::app);
 }
 
 void Logger::log(LogLevel level, const std::string& message) {
-    if (level < level_) return;
+    if (level < level_.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(mutex_);  // also guards std::localtime
     
     auto now = std::chrono::system_clock::now();
     auto time = std::chrono::system_clock::to_time_t(now);
@@ -63,11 +65,11 @@ void Logger::critical(const std::string& message) {
 }
 
 void Logger::set_level(LogLevel level) {
-    level_ = level;
+    level_.store(level, std::memory_order_relaxed);
 }
 
 LogLevel Logger::get_level() const {
-    return level_;
+    return level_.load(std::memory_order_relaxed);
 }
 
 } // namespace utils
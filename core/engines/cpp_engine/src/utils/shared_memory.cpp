@@ -0,0 +1,235 @@
+#include "utils/shared_memory.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
+namespace cppengine {
+namespace utils {
+
+namespace {
+
+#if defined(__linux__)
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#define F_SEAL_WRITE 0x0008
+#endif
+
+// Raw syscall: glibc only wraps memfd_create since 2.27
+int memfd_create_compat(const char* name, unsigned int flags) {
+#if defined(SYS_memfd_create)
+    return static_cast<int>(::syscall(SYS_memfd_create, name, flags));
+#else
+    (void)name;
+    (void)flags;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+// Raw syscall: glibc only wraps copy_file_range since 2.27
+ssize_t copy_file_range_compat(int in, off_t* in_offset, int out, off_t* out_offset, size_t size) {
+#if defined(SYS_copy_file_range)
+    return static_cast<ssize_t>(::syscall(SYS_copy_file_range, in, in_offset, out, out_offset, size, 0u));
+#else
+    (void)in;
+    (void)in_offset;
+    (void)out;
+    (void)out_offset;
+    (void)size;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+#endif
+
+} // namespace
+
+SharedMemoryBuffer::SharedMemoryBuffer() : fd_(-1), data_(nullptr), size_(0) {}
+
+SharedMemoryBuffer::SharedMemoryBuffer(int fd) : fd_(fd), data_(nullptr), size_(0) {}
+
+SharedMemoryBuffer::~SharedMemoryBuffer() {
+    close();
+}
+
+SharedMemoryBuffer::SharedMemoryBuffer(SharedMemoryBuffer&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+SharedMemoryBuffer& SharedMemoryBuffer::operator=(SharedMemoryBuffer&& other) noexcept {
+    if (this != &other) {
+        close();
+        fd_ = std::exchange(other.fd_, -1);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+bool SharedMemoryBuffer::create(const std::string& name) {
+    close();
+#if defined(__linux__)
+    fd_ = memfd_create_compat(name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    return fd_ >= 0;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+bool SharedMemoryBuffer::write(const void* data, size_t size) {
+    if (fd_ < 0) return false;
+    unmap();
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) return false;
+    const char* p = static_cast<const char*>(data);
+    size_t done = 0;
+    while (done < size) {
+        const ssize_t n = ::pwrite(fd_, p + done, size - done, static_cast<off_t>(done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool SharedMemoryBuffer::write_file(const std::string& path, size_t* bytes) {
+    if (bytes) *bytes = 0;
+#if defined(__linux__)
+    if (fd_ < 0) return false;
+    unmap();
+    const int in = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) return false;
+    struct stat st{};
+    if (::fstat(in, &st) != 0 || !S_ISREG(st.st_mode) || ::ftruncate(fd_, 0) != 0) {
+        ::close(in);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    off_t in_offset = 0;
+    off_t out_offset = 0;
+    bool use_sendfile = false;
+    bool ok = true;
+    while (static_cast<size_t>(out_offset) < size) {
+        const size_t left = size - static_cast<size_t>(out_offset);
+        ssize_t n;
+        if (!use_sendfile) {
+            n = copy_file_range_compat(in, &in_offset, fd_, &out_offset, left);
+            // Older kernels and some source filesystems refuse (tmpfs target, cross-filesystem)
+            if (n < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)) {
+                use_sendfile = true;
+                continue;
+            }
+        } else {
+            // sendfile writes at the target's file offset
+            if (::lseek(fd_, out_offset, SEEK_SET) < 0) {
+                ok = false;
+                break;
+            }
+            n = ::sendfile(fd_, in, &in_offset, left);
+            if (n > 0) out_offset += n;
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+        if (n == 0) break;  // file shrank while copying
+    }
+    ::close(in);
+    if (!ok) return false;
+    if (bytes) *bytes = static_cast<size_t>(out_offset);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+bool SharedMemoryBuffer::seal() {
+#if defined(__linux__)
+    unmap();  // F_SEAL_WRITE fails with EBUSY while any shared mapping of the fd exists
+    return fd_ >= 0 && ::fcntl(fd_, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) == 0;
+#else
+    return false;
+#endif
+}
+
+bool SharedMemoryBuffer::is_sealed() const {
+#if defined(__linux__)
+    if (fd_ < 0) return false;
+    const int seals = ::fcntl(fd_, F_GET_SEALS);
+    return seals >= 0 && (seals & F_SEAL_WRITE) != 0;
+#else
+    return false;
+#endif
+}
+
+bool SharedMemoryBuffer::map() {
+    if (fd_ < 0) return false;
+    unmap();
+    struct stat st{};
+    if (::fstat(fd_, &st) != 0) return false;
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) return true;
+    void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        size_ = 0;
+        return false;
+    }
+    data_ = static_cast<uint8_t*>(p);
+    return true;
+}
+
+void SharedMemoryBuffer::unmap() {
+    if (data_) ::munmap(data_, size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void SharedMemoryBuffer::close() {
+    unmap();
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+}
+
+bool SharedMemoryBuffer::inherit(int fd) {
+    const int flags = ::fcntl(fd, F_GETFD);
+    return flags >= 0 && ::fcntl(fd, F_SETFD, flags & ~FD_CLOEXEC) == 0;
+}
+
+bool SharedMemoryBuffer::parse_fd_spec(const std::string& spec, int& fd, std::string* ext) {
+    if (spec.rfind("fd:", 0) != 0) return false;
+    char* end = nullptr;
+    const long value = std::strtol(spec.c_str() + 3, &end, 10);
+    if (end == spec.c_str() + 3 || value < 0) return false;
+    if (*end != '\0' && *end != '.') return false;
+    fd = static_cast<int>(value);
+    if (ext) *ext = *end == '.' ? std::string(end + 1) : std::string();
+    return true;
+}
+
+} // namespace utils
+} // namespace cppengine
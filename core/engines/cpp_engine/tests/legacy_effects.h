@@ -0,0 +1,121 @@
+// tests/legacy_effects.h
+// Per-pixel EffectsEngine implementations the row kernels and remap tables
+// replaced; reference for the effects tests and benchmarks/bench_effects.cpp
+#ifndef CPP_ENGINE_TESTS_LEGACY_EFFECTS_H
+#define CPP_ENGINE_TESTS_LEGACY_EFFECTS_H
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace legacy {
+
+inline cv::Mat lighting(const cv::Mat& image, float light_x, float light_y, float light_z) {
+    cv::Mat result = image.clone();
+    cv::Vec3f light_dir(light_x, light_y, light_z);
+    cv::normalize(light_dir, light_dir);
+
+    cv::Mat gray, grad_x, grad_y;
+    cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+    cv::Sobel(gray, grad_x, CV_32F, 1, 0, 3);
+    cv::Sobel(gray, grad_y, CV_32F, 0, 1, 3);
+
+    for (int i = 0; i < result.rows; ++i) {
+        for (int j = 0; j < result.cols; ++j) {
+            cv::Vec3f normal(0, 0, 1);
+            if (i > 0 && i < grad_x.rows && j > 0 && j < grad_x.cols) {
+                normal[0] = grad_x.at<float>(i, j) / 255.0f;
+                normal[1] = grad_y.at<float>(i, j) / 255.0f;
+            }
+            cv::normalize(normal, normal);
+            float intensity = std::max(0.3f, normal.dot(light_dir) * 0.7f + 0.3f);
+            cv::Vec3b& pixel = result.at<cv::Vec3b>(i, j);
+            for (int c = 0; c < 3; ++c) pixel[c] = cv::saturate_cast<uchar>(pixel[c] * intensity);
+        }
+    }
+    return result;
+}
+
+inline cv::Mat shadows(const cv::Mat& image, float shadow_intensity) {
+    cv::Mat result = image.clone();
+    cv::Mat shadow_mask = cv::Mat::zeros(image.size(), CV_8UC1);
+    cv::rectangle(shadow_mask, cv::Rect(image.cols / 4, image.rows / 4, image.cols / 2, image.rows / 2),
+                  cv::Scalar(255), -1);
+    cv::GaussianBlur(shadow_mask, shadow_mask, cv::Size(21, 21), 0);
+
+    for (int i = 0; i < result.rows; ++i) {
+        for (int j = 0; j < result.cols; ++j) {
+            float shadow_factor = shadow_mask.at<uchar>(i, j) / 255.0f * shadow_intensity;
+            cv::Vec3b& pixel = result.at<cv::Vec3b>(i, j);
+            for (int c = 0; c < 3; ++c) pixel[c] = cv::saturate_cast<uchar>(pixel[c] * (1.0f - shadow_factor * 0.5f));
+        }
+    }
+    return result;
+}
+
+inline cv::Mat chromatic_aberration(const cv::Mat& image, float red_shift, float blue_shift) {
+    std::vector<cv::Mat> channels;
+    cv::split(image, channels);
+    cv::Mat red_shifted, blue_shifted;
+    cv::Mat translation_red = (cv::Mat_<float>(2, 3) << 1, 0, red_shift, 0, 1, 0);
+    cv::Mat translation_blue = (cv::Mat_<float>(2, 3) << 1, 0, -blue_shift, 0, 1, 0);
+    cv::warpAffine(channels[2], red_shifted, translation_red, image.size());
+    cv::warpAffine(channels[0], blue_shifted, translation_blue, image.size());
+    cv::Mat output;
+    cv::merge(std::vector<cv::Mat>{blue_shifted, channels[1], red_shifted}, output);
+    return output;
+}
+
+inline cv::Mat wave_distortion(const cv::Mat& image, float amplitude, float frequency) {
+    cv::Mat result = cv::Mat::zeros(image.size(), image.type());
+    for (int i = 0; i < image.rows; ++i) {
+        for (int j = 0; j < image.cols; ++j) {
+            int offset_x = static_cast<int>(amplitude * sin(2 * M_PI * frequency * i / image.rows));
+            int offset_y = static_cast<int>(amplitude * cos(2 * M_PI * frequency * j / image.cols));
+            int src_x = j + offset_x;
+            int src_y = i + offset_y;
+            if (src_x >= 0 && src_x < image.cols && src_y >= 0 && src_y < image.rows) {
+                result.at<cv::Vec3b>(i, j) = image.at<cv::Vec3b>(src_y, src_x);
+            }
+        }
+    }
+    return result;
+}
+
+inline cv::Mat radial_distortion(const cv::Mat& image, float distortion_factor) {
+    cv::Mat result = cv::Mat::zeros(image.size(), image.type());
+    cv::Point2f center(image.cols / 2.0f, image.rows / 2.0f);
+    float max_radius = std::sqrt(center.x * center.x + center.y * center.y);
+    for (int i = 0; i < image.rows; ++i) {
+        for (int j = 0; j < image.cols; ++j) {
+            cv::Point2f vec = cv::Point2f(j, i) - center;
+            float radius = cv::norm(vec);
+            if (radius > 0) {
+                float distortion = 1.0f + distortion_factor * (radius / max_radius) * (radius / max_radius);
+                cv::Point2f src_point = center + vec / distortion;
+                if (src_point.x >= 0 && src_point.x < image.cols - 1 &&
+                    src_point.y >= 0 && src_point.y < image.rows - 1) {
+                    result.at<cv::Vec3b>(i, j) = image.at<cv::Vec3b>(cv::saturate_cast<int>(src_point.y),
+                                                                   cv::saturate_cast<int>(src_point.x));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+inline cv::Mat bloom(const cv::Mat& image, float threshold, float intensity) {
+    cv::Mat float_image, bright_areas, bloom, result, output;
+    image.convertTo(float_image, CV_32FC3, 1.0 / 255.0);
+    cv::threshold(float_image, bright_areas, threshold, 1.0, cv::THRESH_BINARY);
+    cv::GaussianBlur(bright_areas, bloom, cv::Size(21, 21), 0);
+    cv::addWeighted(float_image, 1.0, bloom, intensity, 0.0, result);
+    result.convertTo(output, CV_8UC3, 255.0);
+    return output;
+}
+
+} // namespace legacy
+
+#endif // CPP_ENGINE_TESTS_LEGACY_EFFECTS_H
@@ -0,0 +1,50 @@
+// tests/legacy_mesh.h
+// OBJ sphere exporter of the original 3D generator
+// (src/modules/generators/vision/image3d_generator.cpp), writing to a stream instead of a file;
+// golden reference for the MeshIO OBJ tests
+#ifndef CPP_ENGINE_TESTS_LEGACY_MESH_H
+#define CPP_ENGINE_TESTS_LEGACY_MESH_H
+
+#include <array>
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace legacy {
+
+inline void generate_obj(std::ostream& out, int lat = 8, int lon = 16, float radius = 1.0f) {
+    std::vector<std::array<float,3>> verts;
+    for (int i = 0; i <= lat; ++i) {
+        float theta = static_cast<float>(i) / lat * M_PI;
+        for (int j = 0; j < lon; ++j) {
+            float phi = static_cast<float>(j) / lon * 2.0f * M_PI;
+            float x = radius * std::sin(theta) * std::cos(phi);
+            float y = radius * std::cos(theta);
+            float z = radius * std::sin(theta) * std::sin(phi);
+            verts.push_back(std::array<float,3>{x, y, z});
+        }
+    }
+
+    for (auto &v : verts) out << "v " << v[0] << " " << v[1] << " " << v[2] << "\n";
+
+    // Simple face generation
+    int cols = lon;
+    for (int i = 0; i < lat; ++i) {
+        for (int j = 0; j < lon; ++j) {
+            int a = i * cols + j + 1;
+            int b = i * cols + ((j+1)%cols) + 1;
+            int c = (i+1) * cols + ((j+1)%cols) + 1;
+            int d = (i+1) * cols + j + 1;
+            out << "f " << a << " " << b << " " << c << "\n";
+            out << "f " << a << " " << c << " " << d << "\n";
+        }
+    }
+}
+
+} // namespace legacy
+
+#endif // CPP_ENGINE_TESTS_LEGACY_MESH_H
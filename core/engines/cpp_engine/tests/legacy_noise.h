@@ -0,0 +1,115 @@
+// tests/legacy_noise.h
+// Scalar double-precision Perlin noise of the original image generators
+// (src/modules/generators/vision/image_generator.cpp); reference for the noise
+// tests and benchmarks/bench_noise.cpp
+#ifndef CPP_ENGINE_TESTS_LEGACY_NOISE_H
+#define CPP_ENGINE_TESTS_LEGACY_NOISE_H
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace legacy {
+
+class PerlinNoise {
+private:
+    std::vector<int> permutation;
+    std::mt19937 gen;
+
+public:
+    PerlinNoise(unsigned int seed = 0) : gen(seed) {
+        permutation.resize(256);
+        std::iota(permutation.begin(), permutation.end(), 0);
+        std::shuffle(permutation.begin(), permutation.end(), gen);
+        permutation.insert(permutation.end(), permutation.begin(), permutation.end());
+    }
+
+    double fade(double t) {
+        return t * t * t * (t * (t * 6.0 - 15.0) + 10.0);
+    }
+
+    double lerp(double t, double a, double b) {
+        return a + t * (b - a);
+    }
+
+    double grad(int hash, double x, double y) {
+        int h = hash & 15;
+        double u = (h < 8) ? x : y;
+        double v = (h < 8) ? y : x;
+        return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+    }
+
+    double noise(double x, double y) {
+        int xi = static_cast<int>(std::floor(x)) & 255;
+        int yi = static_cast<int>(std::floor(y)) & 255;
+
+        double xf = x - std::floor(x);
+        double yf = y - std::floor(y);
+
+        double u = fade(xf);
+        double v = fade(yf);
+
+        int aa = permutation[permutation[xi] + yi];
+        int ab = permutation[permutation[xi] + yi + 1];
+        int ba = permutation[permutation[xi + 1] + yi];
+        int bb = permutation[permutation[xi + 1] + yi + 1];
+
+        double x1 = lerp(u, grad(aa, xf, yf), grad(ba, xf - 1, yf));
+        double x2 = lerp(u, grad(ab, xf, yf - 1), grad(bb, xf - 1, yf - 1));
+        return lerp(v, x1, x2);
+    }
+
+    double fractal(double x, double y, int octaves = 4, double persistence = 0.5, double scale = 2.0) {
+        double result = 0.0;
+        double amplitude = 1.0;
+        double frequency = 1.0;
+        double max_value = 0.0;
+
+        for (int i = 0; i < octaves; ++i) {
+            result += amplitude * noise(x * frequency, y * frequency);
+            max_value += amplitude;
+            amplitude *= persistence;
+            frequency *= scale;
+        }
+
+        return result / max_value;
+    }
+};
+
+// MetallicGenerator::generate before the fused shader: three fBm calls per pixel for a
+// finite-difference normal, then a second pass for the centre highlight. BGR, row-major.
+inline std::vector<unsigned char> metallic(int width, int height, unsigned int seed) {
+    PerlinNoise perlin(seed);
+    std::vector<unsigned char> image(static_cast<size_t>(width) * height * 3);
+    double scale = 0.02;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            double nx = x * scale;
+            double ny = y * scale;
+            double h = perlin.fractal(nx, ny, 4, 0.5, 2.0);
+            double hx = perlin.fractal(nx + 0.01, ny, 4, 0.5, 2.0);
+            double hy = perlin.fractal(nx, ny + 0.01, 4, 0.5, 2.0);
+            double light = 0.5 + 0.5 * (h + hx + hy) / 3.0;
+            unsigned char intensity = static_cast<unsigned char>(light * 200.0 + 30.0);
+            unsigned char* p = &image[(static_cast<size_t>(y) * width + x) * 3];
+            p[0] = p[1] = p[2] = intensity;
+        }
+    }
+    for (int y = 10; y < height - 10; ++y) {
+        for (int x = 10; x < width - 10; ++x) {
+            double dist = std::sqrt(std::pow(x - width / 2.0, 2) + std::pow(y - height / 2.0, 2));
+            if (dist < 50) {
+                int highlight = static_cast<int>(200 * std::exp(-dist * dist / 1000.0));
+                unsigned char* p = &image[(static_cast<size_t>(y) * width + x) * 3];
+                for (int c = 0; c < 3; ++c) p[c] = static_cast<unsigned char>(std::min(255, p[c] + highlight));
+            }
+        }
+    }
+    return image;
+}
+
+} // namespace legacy
+
+#endif // CPP_ENGINE_TESTS_LEGACY_NOISE_H
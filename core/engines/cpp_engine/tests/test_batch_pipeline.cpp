@@ -0,0 +1,253 @@
+// tests/test_batch_pipeline.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/optimization/batch_pipeline.h"
+#include "../include/optimization/bounded_queue.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using cppengine::optimization::BatchPipeline;
+using cppengine::optimization::BoundedQueue;
+
+namespace {
+
+// Fresh empty directory under the system temp dir
+fs::path scratch_dir(const std::string& name) {
+    const fs::path dir = fs::temp_directory_path() / name;
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    return dir;
+}
+
+void touch(const fs::path& path) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << "x";
+}
+
+} // namespace
+
+TEST_CASE("BoundedQueue is a FIFO that blocks at capacity", "[batch_pipeline]") {
+    BoundedQueue<int> queue(2);
+    REQUIRE(queue.capacity() == 2);
+    REQUIRE(queue.push(1));
+    REQUIRE(queue.push(2));
+    REQUIRE(queue.size() == 2);
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&]() {
+        queue.push(3);  // full: waits for the pop below
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK_FALSE(pushed.load());
+
+    int value = 0;
+    REQUIRE(queue.pop(value));
+    CHECK(value == 1);
+    producer.join();
+    CHECK(pushed.load());
+    REQUIRE(queue.pop(value));
+    CHECK(value == 2);
+    REQUIRE(queue.pop(value));
+    CHECK(value == 3);
+    CHECK(queue.size() == 0);
+
+    BoundedQueue<int> zero(0);
+    CHECK(zero.capacity() == 1);
+}
+
+TEST_CASE("BoundedQueue close drains, then fails pops and pushes", "[batch_pipeline]") {
+    BoundedQueue<int> queue(4);
+    REQUIRE(queue.push(7));
+    REQUIRE(queue.push(8));
+    queue.close();
+    CHECK_FALSE(queue.push(9));
+
+    int value = 0;
+    REQUIRE(queue.pop(value));
+    CHECK(value == 7);
+    REQUIRE(queue.pop(value));
+    CHECK(value == 8);
+    CHECK_FALSE(queue.pop(value));
+
+    // close() wakes a consumer blocked on an empty queue
+    BoundedQueue<int> empty(1);
+    std::thread consumer([&]() {
+        int item = 0;
+        CHECK_FALSE(empty.pop(item));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    empty.close();
+    consumer.join();
+}
+
+TEST_CASE("BoundedQueue hands every item to exactly one consumer", "[batch_pipeline]") {
+    BoundedQueue<int> queue(3);
+    const int producers = 3, consumers = 4, per_producer = 500;
+    std::vector<std::thread> threads;
+    std::atomic<long long> sum{0};
+    std::atomic<int> count{0};
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            int item = 0;
+            while (queue.pop(item)) {
+                sum += item;
+                ++count;
+            }
+        });
+    }
+    std::vector<std::thread> producing;
+    for (int p = 0; p < producers; ++p) {
+        producing.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; ++i) queue.push(p * per_producer + i + 1);
+        });
+    }
+    for (auto& t : producing) t.join();
+    queue.close();
+    for (auto& t : threads) t.join();
+
+    const long long n = producers * per_producer;
+    CHECK(count.load() == n);
+    CHECK(sum.load() == n * (n + 1) / 2);
+}
+
+TEST_CASE("collect_inputs lists a directory's images or reads a list file", "[batch_pipeline]") {
+    const fs::path dir = scratch_dir("test_batch_collect");
+    touch(dir / "b.png");
+    touch(dir / "a.JPG");
+    touch(dir / "c.webp");
+    touch(dir / "notes.txt");
+    touch(dir / "nested" / "d.png");  // not recursive
+
+    const auto inputs = BatchPipeline::collect_inputs(dir.string());
+    REQUIRE(inputs.size() == 3);
+    CHECK(inputs[0] == (dir / "a.JPG").string());
+    CHECK(inputs[1] == (dir / "b.png").string());
+    CHECK(inputs[2] == (dir / "c.webp").string());
+
+    const fs::path list = dir / "list.txt";
+    std::ofstream(list) << "# comment\n  /data/x.png \r\n\n\t/data/y y.jpg\n";
+    const auto listed = BatchPipeline::collect_inputs(list.string());
+    REQUIRE(listed.size() == 2);
+    CHECK(listed[0] == "/data/x.png");
+    CHECK(listed[1] == "/data/y y.jpg");
+
+    CHECK(BatchPipeline::collect_inputs((dir / "missing.txt").string()).empty());
+    fs::remove_all(dir);
+}
+
+TEST_CASE("make_jobs never maps two inputs to the same output", "[batch_pipeline]") {
+    const fs::path dir = scratch_dir("test_batch_jobs");
+    const fs::path out = dir / "out";
+
+    SECTION("flat directory keeps file names") {
+        const auto jobs = BatchPipeline::make_jobs({(dir / "in" / "a.png").string(), (dir / "in" / "b.png").string()},
+                                                   out.string());
+        REQUIRE(jobs.size() == 2);
+        CHECK(jobs[0].output_file == (out / "a.png").string());
+        CHECK(jobs[1].output_file == (out / "b.png").string());
+        CHECK(fs::is_directory(out));
+    }
+
+    SECTION("same names from different folders keep their relative path") {
+        const std::vector<std::string> inputs = {(dir / "cats" / "1.png").string(), (dir / "dogs" / "1.png").string(),
+                                                 (dir / "dogs" / "young" / "1.png").string()};
+        const auto jobs = BatchPipeline::make_jobs(inputs, out.string());
+        REQUIRE(jobs.size() == 3);
+        CHECK(jobs[0].input_file == inputs[0]);
+        CHECK(jobs[0].output_file == (out / "cats" / "1.png").string());
+        CHECK(jobs[1].output_file == (out / "dogs" / "1.png").string());
+        CHECK(jobs[2].output_file == (out / "dogs" / "young" / "1.png").string());
+        CHECK(fs::is_directory(out / "dogs" / "young"));
+    }
+
+    SECTION("an input listed twice gets a suffixed output") {
+        const std::string input = (dir / "in" / "a.png").string();
+        const auto jobs = BatchPipeline::make_jobs({input, input, (dir / "in" / "." / "a.png").string()}, out.string());
+        REQUIRE(jobs.size() == 3);
+        std::set<std::string> outputs;
+        for (const auto& job : jobs) outputs.insert(job.output_file);
+        CHECK(outputs.size() == 3);
+        CHECK(jobs[0].output_file == (out / "a.png").string());
+        CHECK(jobs[1].output_file == (out / "a_1.png").string());
+        CHECK(jobs[2].output_file == (out / "a_2.png").string());
+    }
+    fs::remove_all(dir);
+}
+
+TEST_CASE("BatchPipeline processes every image and counts failures", "[batch_pipeline]") {
+    const fs::path dir = scratch_dir("test_batch_run");
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 12; ++i) {
+        const fs::path path = dir / "in" / (i % 2 ? "odd" : "even") / ("img" + std::to_string(i / 2) + ".png");
+        fs::create_directories(path.parent_path());
+        REQUIRE(cv::imwrite(path.string(), cv::Mat(16, 24, CV_8UC3, cv::Scalar(i * 10, 0, 255 - i * 10))));
+        inputs.push_back(path.string());
+    }
+    inputs.push_back((dir / "in" / "missing.png").string());
+    touch(dir / "in" / "corrupt.png");
+    inputs.push_back((dir / "in" / "corrupt.png").string());
+    const auto jobs = BatchPipeline::make_jobs(inputs, (dir / "out").string());
+
+    BatchPipeline::Config config;
+    config.decoder_threads = 2;
+    config.worker_threads = 3;
+    config.encoder_threads = 2;
+    config.queue_capacity = 2;
+    config.progress_every = 0;
+    config.report_encodes = true;
+    BatchPipeline pipeline(config);
+    std::ostringstream output;
+    std::streambuf* const cout_buffer = std::cout.rdbuf(output.rdbuf());
+    const auto stats = pipeline.run(jobs, []() -> BatchPipeline::Processor {
+        return [](const cv::Mat& image, cv::Mat& result) {
+            if (image.at<cv::Vec3b>(0, 0)[0] == 50) return false;  // image 5 fails processing
+            cv::bitwise_not(image, result);
+            return true;
+        };
+    });
+    std::cout.rdbuf(cout_buffer);
+
+    CHECK(stats.images_total == 14);
+    CHECK(stats.images_ok == 11);
+    CHECK(stats.images_failed == 3);
+    CHECK(stats.bytes_in > 0);
+    CHECK(stats.bytes_out > 0);
+
+    // One "[encode]" line per written image, summing to the output bytes (what the HTTP server parses)
+    std::istringstream lines(output.str());
+    size_t encode_lines = 0;
+    uint64_t encoded_bytes = 0;
+    for (std::string line; std::getline(lines, line);) {
+        if (line.rfind("[encode] ", 0) != 0) continue;
+        ++encode_lines;
+        const size_t at = line.find(" bytes=");
+        REQUIRE(at != std::string::npos);
+        encoded_bytes += std::stoull(line.substr(at + 7));
+    }
+    CHECK(encode_lines == stats.images_ok);
+    CHECK(encoded_bytes == stats.bytes_out);
+    for (size_t i = 0; i < 12; ++i) {
+        const cv::Mat written = cv::imread(jobs[i].output_file);
+        if (i == 5) {
+            CHECK(written.empty());
+            continue;
+        }
+        REQUIRE_FALSE(written.empty());
+        CHECK(written.at<cv::Vec3b>(0, 0) == cv::Vec3b(static_cast<uchar>(255 - i * 10), 255, static_cast<uchar>(i * 10)));
+    }
+    fs::remove_all(dir);
+}
@@ -0,0 +1,62 @@
+// tests/test_bloom.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/effects/bloom.h"
+#include "../include/effects/effects_engine.h"
+#include "legacy_effects.h"
+
+#include <opencv2/opencv.hpp>
+
+using cppengine::effects::Bloom;
+using cppengine::effects::BloomMode;
+using cppengine::effects::BloomOptions;
+using cppengine::effects::EffectsEngine;
+
+TEST_CASE("Gaussian bloom mode keeps the original output", "[bloom]") {
+    cv::Mat image(64, 80, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    EffectsEngine engine;
+    BloomOptions options;
+    options.mode = BloomMode::GAUSSIAN;
+    engine.set_bloom_options(options);
+    cv::Mat result;
+    REQUIRE(engine.apply_bloom(image, result, 0.7f, 0.6f));
+    REQUIRE(cv::norm(result, legacy::bloom(image, 0.7f, 0.6f), cv::NORM_INF) == 0.0);
+}
+
+TEST_CASE("Pyramid bloom spreads a bright spot and leaves dark images alone", "[bloom]") {
+    EffectsEngine engine;  // pyramid by default
+    cv::Mat dark(120, 160, CV_8UC3, cv::Scalar(60, 60, 60)), result;
+    REQUIRE(engine.apply_bloom(dark, result, 0.5f, 1.0f));
+    REQUIRE(cv::norm(result, dark, cv::NORM_INF) == 0.0);
+
+    cv::Mat spot = dark.clone();
+    cv::circle(spot, cv::Point(80, 60), 12, cv::Scalar(255, 255, 255), -1);
+    int glow_at[2][2];
+    for (int i = 0; i < 2; ++i) {
+        BloomOptions options;
+        options.radius = i == 0 ? 10 : 40;
+        engine.set_bloom_options(options);
+        REQUIRE(engine.apply_bloom(spot, result, 0.5f, 1.0f));
+        glow_at[i][0] = result.at<cv::Vec3b>(60, 80 + 15)[0];
+        glow_at[i][1] = result.at<cv::Vec3b>(60, 80 + 27)[0];
+    }
+    // Glow falls off with distance and reaches further with a larger radius
+    REQUIRE(glow_at[0][0] > 80);
+    REQUIRE(glow_at[0][0] >= glow_at[0][1]);
+    REQUIRE(glow_at[1][0] >= glow_at[1][1]);
+    REQUIRE(glow_at[1][1] > glow_at[0][1]);
+    REQUIRE(glow_at[1][1] > 60);
+}
+
+TEST_CASE("Pyramid levels follow the radius and the image size", "[bloom]") {
+    REQUIRE(Bloom::pyramid_levels(10, 1080, 1920) == 3);
+    REQUIRE(Bloom::pyramid_levels(20, 1080, 1920) == 4);
+    REQUIRE(Bloom::pyramid_levels(160, 1080, 1920) == 7);
+    REQUIRE(Bloom::pyramid_levels(1000, 16, 16) == 3);
+    REQUIRE(Bloom::pyramid_levels(1, 2, 2) == 1);
+
+    BloomMode mode;
+    REQUIRE(Bloom::parse_mode("gaussian", mode));
+    REQUIRE(mode == BloomMode::GAUSSIAN);
+    REQUIRE_FALSE(Bloom::parse_mode("kawase", mode));
+}
@@ -0,0 +1,80 @@
+// tests/test_effects_simd.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/effects/effects_engine.h"
+#include "../include/effects/effect_kernels.h"
+#include "legacy_effects.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <random>
+#include <vector>
+
+using cppengine::effects::EffectsEngine;
+namespace kernels = cppengine::effects::kernels;
+
+namespace {
+
+cv::Mat random_image(int rows, int cols) {
+    cv::Mat image(rows, cols, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    return image;
+}
+
+} // namespace
+
+TEST_CASE("Lighting row kernels match the per-pixel implementation", "[effects]") {
+    EffectsEngine engine;
+    for (const cv::Size size : {cv::Size(1, 1), cv::Size(37, 23), cv::Size(160, 90)}) {
+        const cv::Mat image = random_image(size.height, size.width);
+        cv::Mat result;
+        REQUIRE(engine.apply_lighting(image, result, 1.0f, -1.0f, 1.0f));
+        // Normalization in float instead of cv::normalize's double: at most one step apart
+        REQUIRE(cv::norm(result, legacy::lighting(image, 1.0f, -1.0f, 1.0f), cv::NORM_INF) <= 1.0);
+    }
+}
+
+TEST_CASE("Shadow row kernels match the per-pixel implementation exactly", "[effects]") {
+    EffectsEngine engine;
+    const cv::Mat image = random_image(97, 131);
+    for (float intensity : {0.0f, 0.5f, 1.0f, 2.5f}) {
+        cv::Mat result;
+        REQUIRE(engine.apply_shadows(image, result, intensity));
+        REQUIRE(cv::norm(result, legacy::shadows(image, intensity), cv::NORM_INF) == 0.0);
+    }
+}
+
+TEST_CASE("Chromatic aberration matches the warpAffine implementation", "[effects]") {
+    EffectsEngine engine;
+    const cv::Mat image = random_image(41, 203);
+    for (float shift : {0.0f, 2.0f, 3.25f, -1.6f, 40.0f, 500.0f}) {
+        cv::Mat result;
+        REQUIRE(engine.apply_chromatic_aberration(image, result, shift, shift * 0.5f));
+        REQUIRE(cv::norm(result, legacy::chromatic_aberration(image, shift, shift * 0.5f), cv::NORM_INF) <= 1.0);
+    }
+}
+
+TEST_CASE("Chromatic row keeps green and zero-fills outside the row", "[effects]") {
+    const int cols = 70;
+    std::mt19937 rng(5);
+    std::vector<uint8_t> src(cols * 3), dst(cols * 3);
+    for (auto& v : src) v = static_cast<uint8_t>(1 + rng() % 255);
+
+    kernels::chromatic_row(src.data(), dst.data(), cols, kernels::make_shift_tap(4.0f), kernels::make_shift_tap(-4.0f));
+    for (int x = 0; x < cols; ++x) {
+        REQUIRE(dst[3 * x + 1] == src[3 * x + 1]);
+        REQUIRE(dst[3 * x] == (x + 4 < cols ? src[3 * (x + 4)] : 0));
+        REQUIRE(dst[3 * x + 2] == (x >= 4 ? src[3 * (x - 4) + 2] : 0));
+    }
+}
+
+TEST_CASE("multiply_row rounds like saturate_cast", "[effects]") {
+    const int n = 77;
+    std::vector<uint8_t> src(n), dst(n);
+    std::vector<float> factors(n);
+    for (int i = 0; i < n; ++i) {
+        src[i] = static_cast<uint8_t>(i * 3);
+        factors[i] = 0.25f * (i % 9);
+    }
+    kernels::multiply_row(src.data(), factors.data(), dst.data(), n);
+    for (int i = 0; i < n; ++i) REQUIRE(dst[i] == cv::saturate_cast<uchar>(src[i] * factors[i]));
+}
@@ -0,0 +1,107 @@
+// tests/test_frame_pool.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/optimization/frame_pool.h"
+#include "../include/effects/effects_engine.h"
+#include "../include/filters/image_filter.h"
+
+#include <opencv2/opencv.hpp>
+
+using cppengine::optimization::FramePool;
+using cppengine::optimization::FramePoolOptions;
+using cppengine::optimization::ScopedFramePool;
+
+TEST_CASE("Size classes cover the request with at most 25% slack", "[frame_pool]") {
+    REQUIRE(FramePool::block_bytes(1) == 64);
+    REQUIRE(FramePool::block_bytes(4096) == 4096);
+    REQUIRE(FramePool::block_bytes(4097) == 5120);
+    REQUIRE(FramePool::block_bytes(1920 * 1080 * 3) == 6u << 20);
+    size_t previous = 0;
+    for (size_t bytes = 4097; bytes < (64u << 20); bytes = bytes * 9 / 8 + 1) {
+        const size_t block = FramePool::block_bytes(bytes);
+        REQUIRE(block >= bytes);
+        REQUIRE(block - bytes <= block / 4);
+        REQUIRE(block >= previous);
+        previous = block;
+    }
+}
+
+TEST_CASE("Released blocks are reused and counted", "[frame_pool]") {
+    for (bool huge_pages : {false, true}) {
+        FramePoolOptions options;
+        options.huge_pages = huge_pages;
+        FramePool pool(options);
+        for (int frame = 0; frame < 4; ++frame) {
+            void* image = pool.acquire(3840 * 2160 * 3);
+            void* mask = pool.acquire(3840 * 2160);
+            REQUIRE(image != nullptr);
+            REQUIRE(mask != nullptr);
+            pool.release(mask, 3840 * 2160);
+            pool.release(image, 3840 * 2160 * 3);
+        }
+        const auto stats = pool.stats();
+        REQUIRE(stats.misses == 2);
+        REQUIRE(stats.hits == 6);
+        REQUIRE(stats.blocks_in_use == 0);
+        REQUIRE(stats.blocks_cached == 2);
+        REQUIRE(stats.hit_rate() == 0.75);
+        REQUIRE(pool.occupancy().size() == 2);
+
+        pool.trim();
+        REQUIRE(pool.stats().bytes_cached == 0);
+    }
+}
+
+TEST_CASE("A full cache frees instead of keeping blocks", "[frame_pool]") {
+    FramePoolOptions options;
+    options.max_cached_bytes = 1u << 20;
+    FramePool pool(options);
+    void* small = pool.acquire(512u << 10);
+    void* large = pool.acquire(2u << 20);
+    pool.release(small, 512u << 10);
+    pool.release(large, 2u << 20);
+    const auto stats = pool.stats();
+    REQUIRE(stats.drops == 1);
+    REQUIRE(stats.blocks_cached == 1);
+    REQUIRE(stats.bytes_cached <= options.max_cached_bytes);
+}
+
+TEST_CASE("Pooled Mats return their block when the last reference goes", "[frame_pool]") {
+    FramePool pool;
+    cv::Mat copy;
+    {
+        cv::Mat frame = pool.mat(120, 160, CV_8UC3);
+        REQUIRE(frame.isContinuous());
+        frame.setTo(cv::Scalar(1, 2, 3));
+        copy = frame;
+    }
+    REQUIRE(pool.stats().blocks_in_use == 1);
+    REQUIRE(copy.at<cv::Vec3b>(5, 7)[2] == 3);
+    copy.release();
+    REQUIRE(pool.stats().blocks_in_use == 0);
+    REQUIRE(pool.stats().blocks_cached == 1);
+}
+
+TEST_CASE("Steady-state effect and filter frames allocate nothing", "[frame_pool]") {
+    FramePool pool;
+    cv::Mat input(240, 320, CV_8UC3), blurred, bloomed, shadowed;
+    cv::randu(input, cv::Scalar::all(0), cv::Scalar::all(255));
+    cppengine::effects::EffectsEngine effects;
+    cppengine::filters::ImageFilter filter;
+    uint64_t warm_misses = 0;
+    {
+        ScopedFramePool scope(pool);
+        for (int frame = 0; frame < 6; ++frame) {
+            if (frame == 3) warm_misses = pool.stats().misses;
+            REQUIRE(filter.apply_blur(input, blurred, 5));
+            REQUIRE(effects.apply_bloom(blurred, bloomed, 0.6f, 0.5f));
+            REQUIRE(effects.apply_shadows(bloomed, shadowed, 0.5f));
+        }
+    }
+    const auto stats = pool.stats();
+    REQUIRE(stats.misses == warm_misses);
+    REQUIRE(stats.hits > 0);
+    blurred.release();
+    bloomed.release();
+    shadowed.release();
+    REQUIRE(pool.stats().blocks_in_use == 0);
+}
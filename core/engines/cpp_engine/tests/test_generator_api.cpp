@@ -0,0 +1,155 @@
+// tests/test_generator_api.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/image_generator.h"
+#include "../include/generators/video_generator.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using cpp_engine::generators::ImageGenerator;
+using cpp_engine::generators::ImageRequest;
+using cpp_engine::generators::ImageSequenceOptions;
+using cpp_engine::generators::ImageSequenceStats;
+using cpp_engine::generators::NoiseBackend;
+using cpp_engine::generators::ProceduralGenerator;
+using cpp_engine::generators::ProceduralKind;
+using cpp_engine::generators::ProceduralVideo;
+using cpp_engine::generators::VideoEncoderOptions;
+using cpp_engine::generators::VideoGenerator;
+using cpp_engine::generators::VideoRequest;
+using cppengine::optimization::EncodeResult;
+
+TEST_CASE("Image requests render and encode in memory", "[generator_api]") {
+    ImageRequest request;
+    request.kind = ProceduralKind::METALLIC;
+    request.width = 96;
+    request.height = 64;
+    request.seed = 5;
+    ImageGenerator generator;
+    cv::Mat image, direct;
+    REQUIRE(generator.render(request, image));
+    REQUIRE(ProceduralGenerator().generate(ProceduralKind::METALLIC, 96, 64, 5, direct));
+    REQUIRE(cv::norm(image, direct, cv::NORM_INF) == 0.0);
+
+    std::vector<unsigned char> bytes;
+    EncodeResult result;
+    REQUIRE(generator.encode(request, "png", bytes, &result));
+    REQUIRE(result.success);
+    REQUIRE(result.format == "png");
+    REQUIRE(result.bytes == bytes.size());
+    REQUIRE(cv::norm(cv::imdecode(bytes, cv::IMREAD_COLOR), image, cv::NORM_INF) == 0.0);
+
+    cv::Mat simplex;
+    request.noise = NoiseBackend::SIMPLEX;
+    REQUIRE(generator.render(request, simplex));
+    REQUIRE(cv::norm(simplex, image, cv::NORM_INF) > 0.0);
+
+    request.width = 0;
+    REQUIRE_FALSE(generator.render(request, image));
+    REQUIRE_FALSE(generator.encode(request, "png", bytes));
+}
+
+TEST_CASE("Video requests stream frames and encoded frames in order", "[generator_api]") {
+    VideoRequest request;
+    request.width = 80;
+    request.height = 48;
+    request.frames = 6;
+    request.seed = 3;
+    VideoGenerator generator;
+    std::vector<cv::Mat> frames;
+    ProceduralVideo::Stats stats;
+    REQUIRE(generator.render(request, [&](int index, const cv::Mat& frame) {
+        REQUIRE(index == static_cast<int>(frames.size()));
+        frames.push_back(frame.clone());
+        return true;
+    }, &stats));
+    REQUIRE(stats.frames == 6);
+    for (int i = 0; i < request.frames; ++i) {
+        cv::Mat expected;
+        REQUIRE(ProceduralVideo().render_frame(ProceduralKind::PERLIN, 80, 48, 3, i, expected));
+        REQUIRE(cv::norm(frames[i], expected, cv::NORM_INF) == 0.0);
+    }
+
+    int delivered = 0;
+    REQUIRE(generator.encode_frames(request, "png", [&](int index, const std::vector<unsigned char>& bytes) {
+        REQUIRE(index == delivered++);
+        REQUIRE(cv::norm(cv::imdecode(bytes, cv::IMREAD_COLOR), frames[index], cv::NORM_INF) == 0.0);
+        return true;
+    }));
+    REQUIRE(delivered == 6);
+
+    delivered = 0;
+    REQUIRE_FALSE(generator.encode_frames(request, "png", [&](int, const std::vector<unsigned char>&) {
+        return ++delivered < 3;
+    }));
+    REQUIRE(delivered == 3);
+}
+
+TEST_CASE("generate_perlin writes the rendered image", "[generator_api]") {
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              ("cpp_engine_generator_api_" + std::to_string(::getpid()) + ".png")).string();
+    ImageGenerator generator;
+    REQUIRE(generator.generate_perlin(64, 48, 9, path));
+    ImageRequest request;
+    request.width = 64;
+    request.height = 48;
+    request.seed = 9;
+    cv::Mat expected;
+    REQUIRE(generator.render(request, expected));
+    REQUIRE(cv::norm(cv::imread(path), expected, cv::NORM_INF) == 0.0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("generate_video_from_images writes images in order at the output size", "[generator_api]") {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() /
+                                      ("cpp_engine_image_sequence_" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    std::vector<std::string> paths;
+    for (int i = 0; i < 10; ++i) {
+        // Every other image at twice the size, so half the sequence goes through the resize stage
+        const int scale = i % 2 ? 2 : 1;
+        const std::string path = (dir / ("frame_" + std::to_string(i) + ".png")).string();
+        REQUIRE(cv::imwrite(path, cv::Mat(24 * scale, 32 * scale, CV_8UC3, cv::Scalar(0, 0, i * 16))));
+        paths.push_back(path);
+        if (i == 4) paths.push_back(path);  // a repeat: written again without decoding
+    }
+    paths.insert(paths.begin() + 7, (dir / "missing.png").string());
+
+    VideoGenerator generator;
+    VideoEncoderOptions video_options;
+    video_options.codec = "mjpeg";
+    generator.set_video_options(video_options);
+    ImageSequenceOptions options;
+    options.decoders = 3;
+    options.resizers = 2;
+    options.max_frames_in_flight = 4;
+    ImageSequenceStats stats;
+    const std::string output = (dir / "sequence.avi").string();
+    REQUIRE(generator.generate_video_from_images(paths, output, options, &stats));
+    REQUIRE(stats.frames == 11);
+    REQUIRE(stats.failed == 1);
+    REQUIRE(stats.reused == 1);
+    REQUIRE(stats.resized == 5);
+
+    cv::VideoCapture capture(output);
+    REQUIRE(capture.isOpened());
+    const std::vector<int> expected = {0, 1, 2, 3, 4, 4, 5, 6, 7, 8, 9};
+    cv::Mat frame;
+    int frames = 0;
+    for (; capture.read(frame); ++frames) {
+        REQUIRE(frames < static_cast<int>(expected.size()));
+        REQUIRE(frame.cols == 32);
+        REQUIRE(frame.rows == 24);
+        REQUIRE(std::abs(frame.at<cv::Vec3b>(12, 16)[2] - expected[frames] * 16) <= 8);
+    }
+    REQUIRE(frames == 11);
+
+    REQUIRE_FALSE(generator.generate_video_from_images({(dir / "missing.png").string()}, output, options));
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,60 @@
+// tests/test_image_encoder.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/optimization/image_encoder.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using cppengine::optimization::EncodeOptions;
+using cppengine::optimization::EncodeProfile;
+using cppengine::optimization::ImageEncoder;
+
+namespace {
+
+cv::Mat gradient_image(int rows, int cols) {
+    cv::Mat image(rows, cols, CV_8UC3);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            image.at<cv::Vec3b>(y, x) = cv::Vec3b(static_cast<uchar>(x), static_cast<uchar>(y), static_cast<uchar>(x ^ y));
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+TEST_CASE("Encode profiles parse and print", "[encoder]") {
+    for (const char* name : {"auto", "fastest", "balanced", "smallest"}) {
+        REQUIRE(ImageEncoder::profile_name(ImageEncoder::parse_profile(name)) == name);
+    }
+    REQUIRE_THROWS_AS(ImageEncoder::parse_profile("tiny"), std::invalid_argument);
+}
+
+TEST_CASE("Latency budget selects a profile", "[encoder]") {
+    const size_t pixels = 1920 * 1080;
+    REQUIRE(ImageEncoder::select_profile("png", pixels, 0.0) == EncodeProfile::BALANCED);
+    REQUIRE(ImageEncoder::select_profile("png", pixels, 1e-6) == EncodeProfile::FASTEST);
+    REQUIRE(ImageEncoder::select_profile("png", pixels, 1e9) == EncodeProfile::SMALLEST);
+}
+
+TEST_CASE("PNG profiles round-trip and trade size for time", "[encoder]") {
+    const cv::Mat image = gradient_image(256, 256);
+    std::vector<unsigned char> fastest, smallest;
+
+    EncodeOptions options;
+    options.profile = EncodeProfile::FASTEST;
+    const auto fast = ImageEncoder::encode(image, ".png", options, fastest);
+    options.profile = EncodeProfile::SMALLEST;
+    const auto small = ImageEncoder::encode(image, "out/frame.PNG", options, smallest);
+
+    REQUIRE(fast.success);
+    REQUIRE(small.success);
+    REQUIRE(small.format == "png");
+    REQUIRE(small.bytes == smallest.size());
+    REQUIRE(small.bytes <= fast.bytes);
+
+    const cv::Mat decoded = cv::imdecode(smallest, cv::IMREAD_COLOR);
+    REQUIRE(cv::norm(decoded, image, cv::NORM_INF) == 0.0);
+}
@@ -0,0 +1,109 @@
+// tests/test_isosurface.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/isosurface.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+using cpp_engine::generators::FieldRow;
+using cpp_engine::generators::IsosurfaceExtractor;
+using cpp_engine::generators::IsosurfaceOptions;
+using cpp_engine::generators::Mesh;
+
+namespace {
+
+// Closed and consistently oriented: every directed edge appears once and its reverse once
+bool watertight(const Mesh& mesh) {
+    std::set<std::pair<uint32_t, uint32_t>> directed;
+    for (size_t t = 0; t < mesh.triangle_count(); ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t a = mesh.indices[t * 3 + k], b = mesh.indices[t * 3 + (k + 1) % 3];
+            if (!directed.insert({a, b}).second) return false;
+        }
+    }
+    for (const auto& [a, b] : directed) {
+        if (!directed.count({b, a})) return false;
+    }
+    return true;
+}
+
+long euler_characteristic(const Mesh& mesh) {
+    return static_cast<long>(mesh.vertex_count()) - static_cast<long>(mesh.triangle_count() * 3 / 2) +
+           static_cast<long>(mesh.triangle_count());
+}
+
+} // namespace
+
+TEST_CASE("A sphere field extracts a closed, outward-facing sphere", "[isosurface]") {
+    IsosurfaceOptions options;
+    options.resolution = 40;
+    options.slab_cells = 7;
+    Mesh mesh;
+    IsosurfaceExtractor::Stats stats;
+    REQUIRE(IsosurfaceExtractor::extract(IsosurfaceExtractor::displaced_sphere(0.61f, 0.0f, 1.0f, 0), options, mesh,
+                                         &stats));
+    REQUIRE(stats.slabs == 6);
+    REQUIRE(stats.seam_vertices > 0);
+    REQUIRE(stats.peak_working_bytes > 0);
+    REQUIRE(mesh.valid());
+    REQUIRE(mesh.triangle_count() > 1000);
+    REQUIRE(watertight(mesh));
+    REQUIRE(euler_characteristic(mesh) == 2);
+
+    const float step = 2.0f / options.resolution;
+    std::set<std::vector<float>> distinct;
+    for (size_t v = 0; v < mesh.vertex_count(); ++v) {
+        const float* p = mesh.positions.data() + v * 3;
+        const float* n = mesh.normals.data() + v * 3;
+        const float r = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        REQUIRE(std::abs(r - 0.61f) < step * 0.1f);
+        REQUIRE((n[0] * p[0] + n[1] * p[1] + n[2] * p[2]) / r > 0.9f);
+        distinct.insert({p[0], p[1], p[2]});
+    }
+    REQUIRE(distinct.size() == mesh.vertex_count());
+}
+
+TEST_CASE("Extraction does not depend on slab size or thread count", "[isosurface]") {
+    const FieldRow field = IsosurfaceExtractor::noise_volume(3.0f, 7);
+    IsosurfaceOptions options;
+    options.resolution = 37;
+    options.slab_cells = 37;
+    Mesh reference;
+    REQUIRE(IsosurfaceExtractor::extract(field, options, reference));
+    REQUIRE(reference.triangle_count() > 0);
+    REQUIRE_FALSE(watertight(reference));  // caves are cut open by the faces of the cube
+
+    const int threads = cv::getNumThreads();
+    for (int slab_cells : {1, 4, 16}) {
+        for (int t : {1, threads}) {
+            cv::setNumThreads(t);
+            options.slab_cells = slab_cells;
+            Mesh mesh;
+            REQUIRE(IsosurfaceExtractor::extract(field, options, mesh));
+            REQUIRE(mesh.positions == reference.positions);
+            REQUIRE(mesh.indices == reference.indices);
+            REQUIRE(mesh.normals == reference.normals);
+        }
+    }
+    cv::setNumThreads(threads);
+
+    options.resolution = 0;
+    Mesh mesh;
+    REQUIRE_FALSE(IsosurfaceExtractor::extract(field, options, mesh));
+}
+
+TEST_CASE("Displaced spheres stay closed", "[isosurface]") {
+    IsosurfaceOptions options;
+    options.resolution = 48;
+    options.slab_cells = 5;
+    Mesh mesh;
+    REQUIRE(IsosurfaceExtractor::extract(IsosurfaceExtractor::displaced_sphere(0.5f, 0.08f, 2.5f, 11), options,
+                                         mesh));
+    REQUIRE(watertight(mesh));
+    REQUIRE(euler_characteristic(mesh) == 2);
+}
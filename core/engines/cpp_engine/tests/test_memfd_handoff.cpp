@@ -0,0 +1,175 @@
+// tests/test_memfd_handoff.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/utils/shared_memory.h"
+#include "../include/optimization/memfd_handoff.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using cppengine::optimization::MemfdHandoff;
+using cppengine::utils::SharedMemoryBuffer;
+
+namespace {
+
+std::vector<uint8_t> pattern(size_t size) {
+    std::vector<uint8_t> bytes(size);
+    std::iota(bytes.begin(), bytes.end(), static_cast<uint8_t>(7));
+    return bytes;
+}
+
+} // namespace
+
+TEST_CASE("parse_fd_spec accepts fd:<n>[.<ext>] only", "[memfd_handoff]") {
+    int fd = -1;
+    std::string ext = "unchanged";
+
+    REQUIRE(SharedMemoryBuffer::parse_fd_spec("fd:3", fd, &ext));
+    CHECK(fd == 3);
+    CHECK(ext.empty());
+
+    REQUIRE(SharedMemoryBuffer::parse_fd_spec("fd:3.png", fd, &ext));
+    CHECK(fd == 3);
+    CHECK(ext == "png");
+
+    REQUIRE(SharedMemoryBuffer::parse_fd_spec("fd:117.jpg", fd, nullptr));
+    CHECK(fd == 117);
+
+    fd = -1;
+    for (const char* bad : {"", "fd:", "fd:.png", "fd:-1", "fd:3x", "fd:3png", "FD:3", "3", "image.png", "/tmp/fd:3"}) {
+        INFO(bad);
+        CHECK_FALSE(SharedMemoryBuffer::parse_fd_spec(bad, fd, &ext));
+        CHECK_FALSE(MemfdHandoff::is_fd_spec(bad));
+    }
+    CHECK(fd == -1);
+    CHECK(MemfdHandoff::is_fd_spec("fd:4.webp"));
+}
+
+#if defined(__linux__)
+
+TEST_CASE("SharedMemoryBuffer writes, seals and maps", "[memfd_handoff]") {
+    SharedMemoryBuffer buffer;
+    REQUIRE(buffer.create("test_memfd"));
+    REQUIRE(buffer.valid());
+    CHECK((::fcntl(buffer.fd(), F_GETFD) & FD_CLOEXEC) != 0);
+    CHECK_FALSE(buffer.is_sealed());
+
+    const auto first = pattern(1000);
+    REQUIRE(buffer.write(first.data(), first.size()));
+    const auto bytes = pattern(5000);
+    REQUIRE(buffer.write(bytes.data(), bytes.size()));  // replaces, does not append
+    REQUIRE(buffer.map());
+    REQUIRE(buffer.size() == bytes.size());
+    CHECK(std::memcmp(buffer.data(), bytes.data(), bytes.size()) == 0);
+
+    REQUIRE(buffer.seal());
+    CHECK(buffer.is_sealed());
+    CHECK_FALSE(buffer.write(first.data(), first.size()));  // no write, shrink or grow once sealed
+    REQUIRE(buffer.map());
+    CHECK(buffer.size() == bytes.size());
+    CHECK(std::memcmp(buffer.data(), bytes.data(), bytes.size()) == 0);
+
+    SharedMemoryBuffer empty;
+    REQUIRE(empty.create("test_memfd_empty"));
+    REQUIRE(empty.map());
+    CHECK(empty.size() == 0);
+    CHECK(empty.data() == nullptr);
+
+    SharedMemoryBuffer closed;
+    CHECK_FALSE(closed.write(bytes.data(), bytes.size()));
+    CHECK_FALSE(closed.map());
+    CHECK_FALSE(closed.seal());
+    CHECK_FALSE(closed.is_sealed());
+}
+
+TEST_CASE("SharedMemoryBuffer copies a file in the kernel", "[memfd_handoff]") {
+    const std::string path = (std::filesystem::temp_directory_path() / "test_memfd_handoff.bin").string();
+    const auto bytes = pattern(300000);
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    SharedMemoryBuffer buffer;
+    REQUIRE(buffer.create("test_memfd_file"));
+    const auto stale = pattern(400000);
+    REQUIRE(buffer.write(stale.data(), stale.size()));  // longer content is replaced, not kept as a tail
+    size_t copied = 0;
+    REQUIRE(buffer.write_file(path, &copied));
+    CHECK(copied == bytes.size());
+    REQUIRE(buffer.seal());
+    REQUIRE(buffer.map());
+    REQUIRE(buffer.size() == bytes.size());
+    CHECK(std::memcmp(buffer.data(), bytes.data(), bytes.size()) == 0);
+
+    SharedMemoryBuffer other;
+    REQUIRE(other.create("test_memfd_file_missing"));
+    CHECK_FALSE(other.write_file(path + ".missing", &copied));
+    CHECK(copied == 0);
+    CHECK_FALSE(other.write_file(std::filesystem::temp_directory_path().string()));  // not a regular file
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("SharedMemoryBuffer moves ownership of the fd and mapping", "[memfd_handoff]") {
+    SharedMemoryBuffer a;
+    REQUIRE(a.create("test_memfd_move"));
+    const auto bytes = pattern(64);
+    REQUIRE(a.write(bytes.data(), bytes.size()));
+    REQUIRE(a.map());
+    const int fd = a.fd();
+
+    SharedMemoryBuffer b(std::move(a));
+    CHECK_FALSE(a.valid());
+    CHECK(a.data() == nullptr);
+    CHECK(b.fd() == fd);
+    REQUIRE(b.size() == bytes.size());
+    CHECK(std::memcmp(b.data(), bytes.data(), bytes.size()) == 0);
+
+    SharedMemoryBuffer c;
+    c = std::move(b);
+    CHECK_FALSE(b.valid());
+    CHECK(c.fd() == fd);
+    c.close();
+    CHECK_FALSE(c.valid());
+    CHECK(::fcntl(fd, F_GETFD) == -1);  // closed, not leaked
+}
+
+TEST_CASE("Bytes round-trip through an fd spec like a parent/child handoff", "[memfd_handoff]") {
+    // Parent: create, fill, seal, and pass the descriptor as "fd:<n>.<ext>"
+    SharedMemoryBuffer parent;
+    REQUIRE(parent.create("test_memfd_handoff"));
+    const auto bytes = pattern(1 << 20);
+    REQUIRE(parent.write(bytes.data(), bytes.size()));
+    REQUIRE(parent.seal());
+    const int child_fd = ::dup(parent.fd());
+    REQUIRE(child_fd >= 0);
+    REQUIRE(SharedMemoryBuffer::inherit(child_fd));
+    CHECK((::fcntl(child_fd, F_GETFD) & FD_CLOEXEC) == 0);
+    const std::string spec = "fd:" + std::to_string(child_fd) + ".png";
+
+    // Child: parse the spec and map what the parent wrote
+    int fd = -1;
+    std::string ext;
+    REQUIRE(SharedMemoryBuffer::parse_fd_spec(spec, fd, &ext));
+    CHECK(ext == "png");
+    {
+        SharedMemoryBuffer child(fd);
+        CHECK(child.is_sealed());
+        REQUIRE(child.map());
+        REQUIRE(child.size() == bytes.size());
+        CHECK(std::memcmp(child.data(), bytes.data(), bytes.size()) == 0);
+    }
+
+    // The parent's descriptor outlives the child's copy
+    REQUIRE(parent.map());
+    CHECK(parent.size() == bytes.size());
+}
+
+#endif
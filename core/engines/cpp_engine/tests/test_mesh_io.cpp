@@ -0,0 +1,164 @@
+// tests/test_mesh_io.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/mesh_io.h"
+#include "legacy_mesh.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using cpp_engine::generators::Mesh;
+using cpp_engine::generators::MeshFormat;
+using cpp_engine::generators::MeshIO;
+using cpp_engine::generators::MeshTessellator;
+using cpp_engine::generators::SphereOptions;
+
+namespace {
+
+uint32_t read_u32(const std::vector<unsigned char>& bytes, size_t at) {
+    uint32_t value;
+    std::memcpy(&value, bytes.data() + at, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+TEST_CASE("Sphere tessellation fills the original layout independent of threads", "[mesh_io]") {
+    SphereOptions options;
+    options.latitude = 6;
+    options.longitude = 10;
+    options.radius = 2.0f;
+    Mesh mesh;
+    REQUIRE(MeshTessellator::sphere(options, mesh));
+    REQUIRE(mesh.vertex_count() == 7 * 10);
+    REQUIRE(mesh.triangle_count() == 6 * 10 * 2);
+    REQUIRE(mesh.valid());
+    for (size_t v = 0; v < mesh.vertex_count(); ++v) {
+        const float* p = mesh.positions.data() + v * 3;
+        const float* n = mesh.normals.data() + v * 3;
+        REQUIRE(std::abs(std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]) - 2.0f) < 1e-5f);
+        REQUIRE(std::abs(n[0] * p[0] + n[1] * p[1] + n[2] * p[2] - 2.0f) < 1e-5f);
+    }
+    // Quad (1, 3): the exporter's a, b, c / a, c, d triangles, zero-based
+    const uint32_t* quad = mesh.indices.data() + (1 * 10 + 3) * 6;
+    REQUIRE(std::vector<uint32_t>(quad, quad + 6) == std::vector<uint32_t>{13, 14, 24, 13, 24, 23});
+
+    options.displacement = 0.2f;
+    options.seed = 4;
+    const int threads = cv::getNumThreads();
+    Mesh serial;
+    cv::setNumThreads(1);
+    REQUIRE(MeshTessellator::sphere(options, serial));
+    cv::setNumThreads(threads);
+    REQUIRE(MeshTessellator::sphere(options, mesh));
+    REQUIRE(mesh.positions == serial.positions);
+    REQUIRE(mesh.normals == serial.normals);
+    for (size_t v = 0; v < mesh.vertex_count(); ++v) {
+        const float* p = mesh.positions.data() + v * 3;
+        const float r = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        REQUIRE(r >= 2.0f * 0.75f);
+        REQUIRE(r <= 2.0f * 1.25f);
+    }
+
+    options.longitude = 2;
+    REQUIRE_FALSE(MeshTessellator::sphere(options, mesh));
+}
+
+TEST_CASE("OBJ export of an undisplaced sphere matches the original exporter byte for byte", "[mesh_io]") {
+    struct Case { int latitude, longitude; float radius; };
+    for (const Case c : {Case{8, 16, 1.0f}, Case{6, 10, 2.5f}, Case{31, 57, 0.3f}}) {
+        INFO(c.latitude << "x" << c.longitude << " radius " << c.radius);
+        std::ostringstream golden;
+        legacy::generate_obj(golden, c.latitude, c.longitude, c.radius);
+
+        SphereOptions options;
+        options.latitude = c.latitude;
+        options.longitude = c.longitude;
+        options.radius = c.radius;
+        options.normals = false;
+        Mesh mesh;
+        REQUIRE(MeshTessellator::sphere(options, mesh));
+        std::vector<unsigned char> obj;
+        REQUIRE(MeshIO::encode(mesh, MeshFormat::OBJ, obj));
+        REQUIRE(std::string(obj.begin(), obj.end()) == golden.str());
+    }
+}
+
+TEST_CASE("Binary formats round-trip the arrays exactly", "[mesh_io]") {
+    SphereOptions options;
+    options.latitude = 12;
+    options.longitude = 24;
+    options.displacement = 0.1f;
+    Mesh mesh;
+    REQUIRE(MeshTessellator::sphere(options, mesh));
+
+    std::vector<unsigned char> glb;
+    REQUIRE(MeshIO::encode(mesh, MeshFormat::GLB, glb));
+    REQUIRE(read_u32(glb, 0) == 0x46546C67);
+    REQUIRE(read_u32(glb, 4) == 2);
+    REQUIRE(read_u32(glb, 8) == glb.size());
+    const uint32_t json_bytes = read_u32(glb, 12);
+    REQUIRE(json_bytes % 4 == 0);
+    REQUIRE(read_u32(glb, 20 + json_bytes) ==
+            (mesh.positions.size() + mesh.normals.size()) * sizeof(float) + mesh.indices.size() * 4);
+    REQUIRE(std::memcmp(glb.data() + 28 + json_bytes, mesh.positions.data(), mesh.positions.size() * 4) == 0);
+
+    for (MeshFormat format : {MeshFormat::GLB, MeshFormat::PLY}) {
+        std::vector<unsigned char> bytes;
+        Mesh decoded;
+        REQUIRE(MeshIO::encode(mesh, format, bytes));
+        REQUIRE(MeshIO::decode(bytes.data(), bytes.size(), format, decoded));
+        REQUIRE(decoded.positions == mesh.positions);
+        REQUIRE(decoded.normals == mesh.normals);
+        REQUIRE(decoded.indices == mesh.indices);
+    }
+
+    std::vector<unsigned char> obj;
+    Mesh decoded;
+    REQUIRE(MeshIO::encode(mesh, MeshFormat::OBJ, obj));
+    REQUIRE(MeshIO::decode(obj.data(), obj.size(), MeshFormat::OBJ, decoded));
+    REQUIRE(decoded.indices == mesh.indices);
+    REQUIRE(decoded.positions.size() == mesh.positions.size());
+    for (size_t i = 0; i < mesh.positions.size(); ++i) {
+        REQUIRE(std::abs(decoded.positions[i] - mesh.positions[i]) < 1e-5f);
+    }
+
+    Mesh flat = mesh;
+    flat.normals.clear();
+    std::vector<unsigned char> ply;
+    REQUIRE(MeshIO::encode(flat, MeshFormat::PLY, ply));
+    REQUIRE(ply.size() < glb.size());
+    REQUIRE(MeshIO::decode(ply.data(), ply.size(), MeshFormat::PLY, decoded));
+    REQUIRE_FALSE(decoded.has_normals());
+    REQUIRE(decoded.indices == mesh.indices);
+
+    glb.resize(glb.size() - 8);
+    REQUIRE_FALSE(MeshIO::decode(glb.data(), glb.size(), MeshFormat::GLB, decoded));
+    Mesh broken = mesh;
+    broken.indices.back() = static_cast<uint32_t>(mesh.vertex_count());
+    REQUIRE_FALSE(MeshIO::encode(broken, MeshFormat::GLB, glb));
+}
+
+TEST_CASE("write() picks the format from the extension", "[mesh_io]") {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() /
+                                      ("cpp_engine_mesh_io_" + std::to_string(::getpid()));
+    Mesh mesh;
+    REQUIRE(MeshTessellator::sphere(SphereOptions(), mesh));
+    for (const char* name : {"sphere.glb", "sphere.PLY", "nested/sphere.obj"}) {
+        const std::string path = (dir / name).string();
+        Mesh loaded;
+        REQUIRE(MeshIO::write(path, mesh));
+        REQUIRE(MeshIO::read(path, loaded));
+        REQUIRE(loaded.indices == mesh.indices);
+        REQUIRE(loaded.vertex_count() == mesh.vertex_count());
+    }
+    REQUIRE_FALSE(MeshIO::write((dir / "sphere.stl").string(), mesh));
+    std::filesystem::remove_all(dir);
+}
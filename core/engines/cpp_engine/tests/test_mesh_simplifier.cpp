@@ -0,0 +1,136 @@
+// tests/test_mesh_simplifier.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/isosurface.h"
+#include "../include/generators/mesh_simplifier.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+using cpp_engine::generators::IsosurfaceExtractor;
+using cpp_engine::generators::IsosurfaceOptions;
+using cpp_engine::generators::Mesh;
+using cpp_engine::generators::MeshSimplifier;
+using cpp_engine::generators::SimplifyOptions;
+
+namespace {
+
+Mesh sphere(int resolution, float radius) {
+    IsosurfaceOptions options;
+    options.resolution = resolution;
+    Mesh mesh;
+    IsosurfaceExtractor::extract(IsosurfaceExtractor::displaced_sphere(radius, 0.0f, 1.0f, 0), options, mesh);
+    return mesh;
+}
+
+bool watertight(const Mesh& mesh) {
+    std::set<std::pair<uint32_t, uint32_t>> directed;
+    for (size_t t = 0; t < mesh.triangle_count(); ++t) {
+        for (int k = 0; k < 3; ++k) {
+            if (!directed.insert({mesh.indices[t * 3 + k], mesh.indices[t * 3 + (k + 1) % 3]}).second) return false;
+        }
+    }
+    for (const auto& [a, b] : directed) {
+        if (!directed.count({b, a})) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Decimation reaches the target and keeps a closed sphere", "[mesh_simplifier]") {
+    const Mesh input = sphere(48, 0.61f);
+    REQUIRE(input.triangle_count() > 8000);
+    SimplifyOptions options;
+    options.target_triangles = 1000;
+    Mesh output;
+    MeshSimplifier::Stats stats;
+    REQUIRE(MeshSimplifier::simplify(input, options, output, &stats));
+    REQUIRE(output.valid());
+    REQUIRE(output.triangle_count() <= 1000);
+    REQUIRE(output.triangle_count() >= 990);
+    REQUIRE(stats.input_triangles == input.triangle_count());
+    REQUIRE(stats.clustered_triangles == input.triangle_count());
+    REQUIRE(stats.output_triangles == output.triangle_count());
+    REQUIRE(stats.max_error > 0.0f);
+    REQUIRE(output.has_normals());
+    REQUIRE(watertight(output));
+    REQUIRE(static_cast<long>(output.vertex_count()) - static_cast<long>(output.triangle_count()) / 2 == 2);
+    for (size_t v = 0; v < output.vertex_count(); ++v) {
+        const float* p = output.positions.data() + v * 3;
+        REQUIRE(std::abs(std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]) - 0.61f) < 0.02f);
+    }
+
+    // An error bound alone stops early on the curved surface
+    options.target_triangles = 0;
+    options.max_error = 0.001f;
+    Mesh bounded;
+    REQUIRE(MeshSimplifier::simplify(input, options, bounded, &stats));
+    REQUIRE(stats.max_error <= 0.001f);
+    REQUIRE(bounded.triangle_count() < input.triangle_count());
+    REQUIRE(bounded.triangle_count() > output.triangle_count());
+}
+
+TEST_CASE("Flat regions collapse at no error while the border stays", "[mesh_simplifier]") {
+    const int n = 20;
+    Mesh grid;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) grid.positions.insert(grid.positions.end(), {float(x) / n, float(y) / n, 0.0f});
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            const uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 2, d = a + n + 1;
+            grid.indices.insert(grid.indices.end(), {a, b, c, a, c, d});
+        }
+    }
+    SimplifyOptions options;
+    options.max_error = 1e-4f;
+    Mesh output;
+    REQUIRE(MeshSimplifier::simplify(grid, options, output));
+    REQUIRE(output.triangle_count() < 100);
+    float lo[3], hi[3];
+    REQUIRE(output.bounds(lo, hi));
+    REQUIRE(lo[0] == 0.0f);
+    REQUIRE(lo[1] == 0.0f);
+    REQUIRE(hi[0] == 1.0f);
+    REQUIRE(hi[1] == 1.0f);
+    double area = 0.0;
+    for (size_t t = 0; t < output.triangle_count(); ++t) {
+        const float* a = output.positions.data() + output.indices[t * 3] * 3;
+        const float* b = output.positions.data() + output.indices[t * 3 + 1] * 3;
+        const float* c = output.positions.data() + output.indices[t * 3 + 2] * 3;
+        REQUIRE(std::abs(a[2]) < 1e-6f);
+        area += 0.5 * ((b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]));
+    }
+    REQUIRE(std::abs(area - 1.0) < 1e-4);
+
+    // Neither bound set would collapse everything the link condition allows
+    REQUIRE_FALSE(MeshSimplifier::simplify(grid, SimplifyOptions(), output));
+
+    grid.indices.back() = static_cast<uint32_t>(grid.vertex_count());
+    REQUIRE_FALSE(MeshSimplifier::simplify(grid, options, output));
+}
+
+TEST_CASE("The clustering pre-pass is parallel and deterministic", "[mesh_simplifier]") {
+    const Mesh input = sphere(64, 0.7f);
+    SimplifyOptions options;
+    options.target_triangles = 600;
+    options.cluster_above = 5000;
+    const int threads = cv::getNumThreads();
+    Mesh reference;
+    MeshSimplifier::Stats stats;
+    cv::setNumThreads(1);
+    REQUIRE(MeshSimplifier::simplify(input, options, reference, &stats));
+    cv::setNumThreads(threads);
+    REQUIRE(stats.clustered_triangles < input.triangle_count());
+    REQUIRE(stats.clustered_triangles > 600);
+    REQUIRE(reference.triangle_count() <= 600);
+
+    Mesh output = input;  // in place
+    REQUIRE(MeshSimplifier::simplify(output, options, output));
+    REQUIRE(output.positions == reference.positions);
+    REQUIRE(output.indices == reference.indices);
+}
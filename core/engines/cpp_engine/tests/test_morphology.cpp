@@ -0,0 +1,87 @@
+// tests/test_morphology.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/filters/morphology.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using cppengine::filters::Morphology;
+
+namespace {
+
+// Brute-force rectangular min/max, out-of-image samples ignored
+std::vector<uint8_t> reference_morph(const std::vector<uint8_t>& src, int rows, int cols, int cn,
+                                     int kw, int kh, bool erode) {
+    std::vector<uint8_t> dst(src.size());
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            for (int c = 0; c < cn; ++c) {
+                int v = erode ? 255 : 0;
+                for (int dy = 0; dy < kh; ++dy) {
+                    for (int dx = 0; dx < kw; ++dx) {
+                        const int yy = y - kh / 2 + dy;
+                        const int xx = x - kw / 2 + dx;
+                        if (yy < 0 || yy >= rows || xx < 0 || xx >= cols) continue;
+                        const int p = src[(yy * cols + xx) * cn + c];
+                        v = erode ? std::min(v, p) : std::max(v, p);
+                    }
+                }
+                dst[(y * cols + x) * cn + c] = static_cast<uint8_t>(v);
+            }
+        }
+    }
+    return dst;
+}
+
+std::vector<uint8_t> random_image(std::mt19937& gen, int rows, int cols, int cn) {
+    std::vector<uint8_t> img(static_cast<size_t>(rows) * cols * cn);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (auto& v : img) v = static_cast<uint8_t>(dist(gen));
+    return img;
+}
+
+} // namespace
+
+TEST_CASE("Morphology: erode/dilate match brute force", "[morphology]") {
+    std::mt19937 gen(7);
+    Morphology morph;
+    for (int cn : {1, 3, 4}) {
+        for (int k : {1, 2, 3, 5, 8, 15, 31}) {
+            const int rows = 37, cols = 301;
+            auto src = random_image(gen, rows, cols, cn);
+            const size_t step = static_cast<size_t>(cols) * cn;
+            std::vector<uint8_t> out(src.size());
+
+            morph.erode(src.data(), step, out.data(), step, rows, cols, cn, k, k + 1);
+            REQUIRE(out == reference_morph(src, rows, cols, cn, k, k + 1, true));
+
+            morph.dilate(src.data(), step, out.data(), step, rows, cols, cn, k + 1, k);
+            REQUIRE(out == reference_morph(src, rows, cols, cn, k + 1, k, false));
+        }
+    }
+}
+
+TEST_CASE("Morphology: in-place compound operations", "[morphology]") {
+    std::mt19937 gen(11);
+    Morphology morph;
+    const int rows = 64, cols = 97, cn = 3, k = 9;
+    const size_t step = static_cast<size_t>(cols) * cn;
+    auto src = random_image(gen, rows, cols, cn);
+    const auto eroded = reference_morph(src, rows, cols, cn, k, k, true);
+    const auto dilated = reference_morph(src, rows, cols, cn, k, k, false);
+
+    auto opened = src;
+    morph.open(opened.data(), step, opened.data(), step, rows, cols, cn, k, k);
+    REQUIRE(opened == reference_morph(eroded, rows, cols, cn, k, k, false));
+
+    auto closed = src;
+    morph.close(closed.data(), step, closed.data(), step, rows, cols, cn, k, k);
+    REQUIRE(closed == reference_morph(dilated, rows, cols, cn, k, k, true));
+
+    std::vector<uint8_t> grad(src.size());
+    morph.gradient(src.data(), step, grad.data(), step, rows, cols, cn, k, k);
+    for (size_t i = 0; i < src.size(); ++i) {
+        REQUIRE(grad[i] == static_cast<uint8_t>(dilated[i] - eroded[i]));
+    }
+}
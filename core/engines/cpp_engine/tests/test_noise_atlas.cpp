@@ -0,0 +1,197 @@
+// tests/test_noise_atlas.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/noise_atlas.h"
+#include "../include/generators/perlin_noise.h"
+#include "../include/generators/procedural_generator.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using cpp_engine::generators::FractalParams;
+using cpp_engine::generators::NoiseAtlas;
+using cpp_engine::generators::NoiseAtlasKey;
+using cpp_engine::generators::NoiseAtlasOptions;
+using cpp_engine::generators::NoiseAtlasStore;
+using cpp_engine::generators::PerlinNoise;
+using cpp_engine::generators::ProceduralGenerator;
+using cpp_engine::generators::ProceduralKind;
+using cpp_engine::generators::ProceduralOptions;
+
+namespace {
+
+constexpr float HALF_TOLERANCE = 1.0f / 1024;  // float16 spacing below 1
+
+struct ScratchDir {
+    ScratchDir() {
+        path = (std::filesystem::temp_directory_path() /
+                ("cpp_engine_atlas_test_" + std::to_string(::getpid()))).string();
+        std::filesystem::remove_all(path);
+    }
+    ~ScratchDir() { std::filesystem::remove_all(path); }
+    std::string path;
+};
+
+// The fBm an atlas stores, evaluated directly: octave o on a lattice wrapping every period << o cells
+float periodic_fractal(const PerlinNoise& noise, const NoiseAtlas& atlas, float x, float y) {
+    const NoiseAtlasKey& key = atlas.key();
+    const double cells_per_texel = static_cast<double>(atlas.period_cells()) / atlas.size();
+    float sum = 0.0f, max_value = 0.0f, amplitude = 1.0f;
+    for (int o = 0; o < key.octaves; ++o, amplitude *= key.persistence) {
+        const double step = cells_per_texel * (1 << o);
+        sum += amplitude * noise.noise_periodic(static_cast<float>(x * step), static_cast<float>(y * step),
+                                                atlas.period_cells() << o);
+        max_value += amplitude;
+    }
+    return sum / max_value;
+}
+
+} // namespace
+
+TEST_CASE("Periodic noise wraps and equals plain noise at period 256", "[noise_atlas]") {
+    const PerlinNoise noise(9);
+    for (float y = -3.3f; y < 20.0f; y += 1.7f) {
+        for (float x = -5.1f; x < 20.0f; x += 0.9f) {
+            REQUIRE(noise.noise_periodic(x, y, 256) == noise.noise(x, y));
+            const float v = noise.noise_periodic(x, y, 7);
+            REQUIRE(std::fabs(noise.noise_periodic(x + 7.0f, y, 7) - v) < 1e-5f);
+            REQUIRE(std::fabs(noise.noise_periodic(x, y - 14.0f, 7) - v) < 1e-5f);
+        }
+    }
+}
+
+TEST_CASE("Atlas texels hold the tileable fBm in float16", "[noise_atlas]") {
+    ScratchDir dir;
+    NoiseAtlasOptions options;
+    options.directory = dir.path;
+    options.size = 128;
+    NoiseAtlasStore store(options);
+    const NoiseAtlasKey key{3, 5, 0.6f, 0.0625f};
+    const auto atlas = store.get(key);
+    REQUIRE(atlas);
+    REQUIRE(atlas->size() == 128);
+    REQUIRE(atlas->period_cells() == 8);
+    REQUIRE(atlas->bytes() == 32 + 128 * 128 * 2);
+
+    const PerlinNoise noise(key.seed);
+    float lowest = 1.0f, highest = -1.0f;
+    for (int y = -5; y < 300; y += 7) {
+        for (int x = -9; x < 300; x += 3) {
+            // Beyond the tile the wrapped texel still matches the periodic field there
+            REQUIRE(std::fabs(atlas->texel(x, y) - periodic_fractal(noise, *atlas, x, y)) <= HALF_TOLERANCE);
+            lowest = std::min(lowest, atlas->texel(x, y));
+            highest = std::max(highest, atlas->texel(x, y));
+        }
+    }
+    REQUIRE(highest - lowest > 0.3f);
+
+    // One texel per pixel: whole-pixel rows are the texels, other positions blend them
+    std::vector<float> row(300);
+    atlas->sample_row(-20.0f, 77.0f, 300, row.data());
+    for (int i = 0; i < 300; ++i) REQUIRE(row[i] == atlas->texel(i - 20, 77));
+    atlas->sample_row(0.5f, 10.0f, 8, row.data());
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(std::fabs(row[i] - 0.5f * (atlas->texel(i, 10) + atlas->texel(i + 1, 10))) < 1e-6f);
+    }
+    REQUIRE(std::fabs(atlas->sample(127.5f, 0.0f) - 0.5f * (atlas->texel(127, 0) + atlas->texel(0, 0))) < 1e-6f);
+}
+
+TEST_CASE("Atlas matches direct fBm inside the first period", "[noise_atlas]") {
+    ScratchDir dir;
+    NoiseAtlasOptions options;
+    options.directory = dir.path;
+    NoiseAtlasStore store(options);
+    FractalParams params;  // 4 octaves, 0.5, 2
+    const float scale = 0.01f;
+    const auto atlas = store.get({11, params.octaves, params.persistence, scale});
+    REQUIRE(atlas);
+    REQUIRE(atlas->size() == 1000);  // 1024 rounded to 10 whole cells
+
+    // Away from the last cell the wrapped lattice is the plain one
+    const PerlinNoise noise(11);
+    std::vector<float> direct(880), cached(880);
+    for (int y = 0; y < 880; y += 13) {
+        noise.fractal_row(0.0f, static_cast<float>(y), 880, scale, params, direct.data());
+        atlas->sample_row(0.0f, static_cast<float>(y), 880, cached.data());
+        for (int x = 0; x < 880; ++x) REQUIRE(std::fabs(direct[x] - cached[x]) < 2 * HALF_TOLERANCE);
+    }
+}
+
+TEST_CASE("Atlases persist across stores and stay within the disk budget", "[noise_atlas]") {
+    ScratchDir dir;
+    NoiseAtlasOptions options;
+    options.directory = dir.path;
+    options.size = 64;
+    const NoiseAtlasKey first{1, 3, 0.5f, 0.125f};
+    float texel = 0.0f;
+    size_t atlas_bytes = 0;
+    {
+        NoiseAtlasStore store(options);
+        const auto atlas = store.get(first);
+        REQUIRE(atlas);
+        REQUIRE(store.get(first) == atlas);
+        REQUIRE(store.stats().builds == 1);
+        REQUIRE(store.stats().memory_hits == 1);
+        texel = atlas->texel(5, 6);
+        atlas_bytes = atlas->bytes();
+    }
+    {
+        NoiseAtlasStore store(options);
+        const auto atlas = store.get(first);
+        REQUIRE(atlas);
+        REQUIRE(store.stats().builds == 0);
+        REQUIRE(store.stats().disk_hits == 1);
+        REQUIRE(atlas->texel(5, 6) == texel);
+    }
+
+    // Room for two atlases: building more evicts the least recently used
+    options.max_disk_bytes = 2 * atlas_bytes + atlas_bytes / 2;
+    NoiseAtlasStore store(options);
+    const auto kept = store.get({2, 3, 0.5f, 0.125f});
+    REQUIRE(kept);
+    REQUIRE(store.get({3, 3, 0.5f, 0.125f}));
+    REQUIRE(store.disk_bytes() <= options.max_disk_bytes);
+    REQUIRE(store.stats().evictions == 1);
+    REQUIRE_FALSE(std::filesystem::exists(std::filesystem::path(dir.path) / first.file_name(64)));
+    REQUIRE(kept->texel(1, 2) == kept->texel(65, 66));  // evicted or not, an open mapping stays valid
+
+    REQUIRE(store.get({4, 3, 0.5f, 0.125f}));
+    REQUIRE(store.disk_bytes() <= options.max_disk_bytes);
+    REQUIRE(store.stats().evictions == 2);
+}
+
+TEST_CASE("Generators sample the atlas for static perlin textures", "[noise_atlas]") {
+    ScratchDir dir;
+    NoiseAtlasOptions atlas_options;
+    atlas_options.directory = dir.path;
+    NoiseAtlasStore store(atlas_options);
+    ProceduralOptions options;
+    options.atlas = &store;
+
+    const int width = 1200, height = 64;
+    cv::Mat direct, cached;
+    REQUIRE(ProceduralGenerator().generate(ProceduralKind::PERLIN, width, height, 8, direct));
+    REQUIRE(ProceduralGenerator(options).generate(ProceduralKind::PERLIN, width, height, 8, cached));
+    REQUIRE(store.stats().builds == 1);
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* d = direct.ptr<uint8_t>(y);
+        const uint8_t* c = cached.ptr<uint8_t>(y);
+        for (int i = 0; i < 3 * 880; ++i) REQUIRE(std::abs(d[i] - c[i]) <= 1);
+        // The atlas tile is 1000 pixels wide at this scale
+        REQUIRE(std::equal(c + 3 * 1000, c + 3 * width, c));
+    }
+
+    cv::Mat again;
+    REQUIRE(ProceduralGenerator(options).generate(ProceduralKind::PERLIN, 300, 200, 8, again));
+    REQUIRE(store.stats().memory_hits == 1);
+    for (int y = 0; y < 64; ++y) REQUIRE(std::equal(again.ptr<uint8_t>(y), again.ptr<uint8_t>(y) + 900,
+                                                    cached.ptr<uint8_t>(y)));
+}
@@ -0,0 +1,66 @@
+// tests/test_parameter_sweep.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/optimization/parameter_sweep.h"
+#include "../include/filters/image_filter.h"
+#include "../include/effects/effects_engine.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <vector>
+
+using cppengine::optimization::ParameterSweep;
+
+namespace {
+
+cv::Mat random_image(int rows, int cols) {
+    cv::Mat image(rows, cols, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    return image;
+}
+
+} // namespace
+
+TEST_CASE("Sweep parameters parse", "[sweep]") {
+    REQUIRE(ParameterSweep::parse_params("5") == ParameterSweep::Params{5.0f});
+    REQUIRE(ParameterSweep::parse_params("0.5:0.25") == ParameterSweep::Params{0.5f, 0.25f});
+}
+
+TEST_CASE("Blur sweep matches cv::blur per radius", "[sweep]") {
+    const cv::Mat image = random_image(61, 47);
+    ParameterSweep sweep;
+    std::vector<cv::Mat> results;
+    const std::vector<ParameterSweep::Params> radii = {{1}, {2}, {3}, {6}, {9}, {15}};
+    REQUIRE(sweep.run("blur", image, radii, results));
+
+    cppengine::filters::ImageFilter filter;
+    for (size_t i = 0; i < radii.size(); ++i) {
+        cv::Mat expected;
+        REQUIRE(filter.apply_blur(image, expected, static_cast<int>(radii[i][0])));
+        // Integer rounding of the mean may differ from OpenCV's by one
+        REQUIRE(cv::norm(results[i], expected, cv::NORM_INF) <= 1.0);
+    }
+}
+
+TEST_CASE("Saturation and bloom sweeps match the single operations", "[sweep]") {
+    const cv::Mat image = random_image(40, 52);
+    ParameterSweep sweep;
+    std::vector<cv::Mat> results;
+
+    const std::vector<ParameterSweep::Params> factors = {{0.5f}, {1.0f}, {1.5f}, {2.0f}};
+    REQUIRE(sweep.run("saturation", image, factors, results));
+    cppengine::filters::ImageFilter filter;
+    for (size_t i = 0; i < factors.size(); ++i) {
+        cv::Mat expected;
+        REQUIRE(filter.adjust_saturation(image, expected, factors[i][0]));
+        REQUIRE(cv::norm(results[i], expected, cv::NORM_INF) == 0.0);
+    }
+
+    const std::vector<ParameterSweep::Params> blooms = {{0.8f, 0.3f}, {0.8f, 0.6f}, {0.6f, 0.6f}};
+    REQUIRE(sweep.run("bloom", image, blooms, results));
+    cppengine::effects::EffectsEngine effects;
+    for (size_t i = 0; i < blooms.size(); ++i) {
+        cv::Mat expected;
+        REQUIRE(effects.apply_bloom(image, expected, blooms[i][0], blooms[i][1]));
+        REQUIRE(cv::norm(results[i], expected, cv::NORM_INF) == 0.0);
+    }
+}
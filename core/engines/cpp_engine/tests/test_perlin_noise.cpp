@@ -0,0 +1,133 @@
+// tests/test_perlin_noise.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/perlin_noise.h"
+#include "legacy_noise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using cpp_engine::generators::FractalParams;
+using cpp_engine::generators::PerlinNoise;
+
+namespace {
+
+int to_pixel(double value) {
+    return static_cast<int>((value + 1.0) / 2.0 * 255.0);
+}
+
+} // namespace
+
+TEST_CASE("Row fractal matches the double-precision generator noise", "[noise]") {
+    struct Config { int octaves; float persistence; float scale; };
+    // Perlin, silhouette and metallic generator settings, then a deep one
+    const Config configs[] = {{4, 0.5f, 0.01f}, {5, 0.6f, 0.015f}, {4, 0.5f, 0.02f}, {8, 0.5f, 0.02f}};
+    const int width = 3843;  // 4K plus a tail for every vector width
+    std::vector<float> row(width);
+    for (unsigned int seed : {0u, 42u, 123456u}) {
+        PerlinNoise noise(seed);
+        legacy::PerlinNoise reference(seed);
+        for (const Config& c : configs) {
+            FractalParams params;
+            params.octaves = c.octaves;
+            params.persistence = c.persistence;
+            for (int y : {0, 1, 250, 2159}) {
+                for (float x0 : {0.0f, 0.5f}) {
+                    noise.fractal_row(x0, static_cast<float>(y), width, c.scale, params, row.data());
+                    double worst = 0.0;
+                    int worst_pixel = 0;
+                    for (int i = 0; i < width; ++i) {
+                        const double expected = reference.fractal((x0 + i) * static_cast<double>(c.scale),
+                                                                  y * static_cast<double>(c.scale), c.octaves,
+                                                                  c.persistence, 2.0);
+                        worst = std::max(worst, std::fabs(expected - row[i]));
+                        worst_pixel = std::max(worst_pixel, std::abs(to_pixel(expected) - to_pixel(row[i])));
+                    }
+                    REQUIRE(worst < 1e-4);
+                    REQUIRE(worst_pixel <= 1);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Row evaluation agrees with the point API and with itself in chunks", "[noise]") {
+    PerlinNoise noise(7);
+    FractalParams params;
+    params.octaves = 6;
+    const float scale = 0.013f;
+    const int width = 301;
+    std::vector<float> whole(width), chunk(width);
+    noise.fractal_row(0.0f, 33.0f, width, scale, params, whole.data());
+    for (int i = 0; i < width; ++i) {
+        REQUIRE(std::fabs(whole[i] - noise.fractal(i * scale, 33.0f * scale, params)) < 1e-5f);
+    }
+    // Chunks of odd sizes land pixels on different SIMD lanes and on the scalar tail
+    for (int begin = 0, size = 1; begin < width; begin += size, size = size * 2 + 1) {
+        const int n = std::min(size, width - begin);
+        noise.fractal_row(static_cast<float>(begin), 33.0f, n, scale, params, chunk.data() + begin);
+    }
+    for (int i = 0; i < width; ++i) REQUIRE(std::fabs(whole[i] - chunk[i]) < 1e-6f);
+}
+
+TEST_CASE("Noise stays in range and is zero on lattice points", "[noise]") {
+    PerlinNoise noise(3);
+    for (int i = 0; i < 1000; ++i) {
+        const float x = i * 0.173f, y = i * 0.311f;
+        REQUIRE(std::fabs(noise.noise(x, y)) <= 1.0f);
+    }
+    REQUIRE(noise.noise(5.0f, 9.0f) == 0.0f);
+}
+
+TEST_CASE("3D rows match the point API, their gradient and themselves in chunks", "[noise]") {
+    PerlinNoise noise(42);
+    FractalParams params;
+    params.octaves = 5;
+    const float scale = 0.015f, e = 0.05f;
+    const int width = 203;
+    std::vector<float> value(width), dx(width), dy(width), plain(width), chunk(width);
+    std::vector<float> xp(width), xm(width), yp(width), ym(width);
+    for (float z : {0.0f, 0.37f, 13.9f}) {
+        const float y = 77.0f;
+        noise.fractal_row_3d(0.0f, y, z, width, scale, params, value.data(), dx.data(), dy.data());
+        noise.fractal_row_3d(0.0f, y, z, width, scale, params, plain.data());
+        noise.fractal_row_3d(e, y, z, width, scale, params, xp.data());
+        noise.fractal_row_3d(-e, y, z, width, scale, params, xm.data());
+        noise.fractal_row_3d(0.0f, y + e, z, width, scale, params, yp.data());
+        noise.fractal_row_3d(0.0f, y - e, z, width, scale, params, ym.data());
+        for (int begin = 0, size = 1; begin < width; begin += size, size = size * 2 + 1) {
+            const int n = std::min(size, width - begin);
+            noise.fractal_row_3d(static_cast<float>(begin), y, z, n, scale, params, chunk.data() + begin);
+        }
+        float max_slope = 0.0f;
+        for (int i = 0; i < width; ++i) max_slope = std::max({max_slope, std::fabs(dx[i]), std::fabs(dy[i])});
+        REQUIRE(max_slope > 0.0f);
+        for (int i = 0; i < width; ++i) {
+            REQUIRE(value[i] == plain[i]);
+            REQUIRE(std::fabs(value[i] - chunk[i]) < 1e-6f);
+            REQUIRE(std::fabs(value[i] - noise.fractal3(i * scale, y * scale, z, params)) < 1e-5f);
+            REQUIRE(std::fabs(dx[i] - (xp[i] - xm[i]) / (2 * e)) < 0.02f * max_slope);
+            REQUIRE(std::fabs(dy[i] - (yp[i] - ym[i]) / (2 * e)) < 0.02f * max_slope);
+        }
+    }
+}
+
+TEST_CASE("3D noise stays in range and changes smoothly along time", "[noise]") {
+    PerlinNoise noise(9);
+    for (int i = 0; i < 20000; ++i) {
+        REQUIRE(std::fabs(noise.noise3(i * 0.173f, i * 0.311f, i * 0.057f)) <= 1.0f);
+    }
+    REQUIRE(noise.noise3(5.0f, 9.0f, 2.0f) == 0.0f);
+    FractalParams params;
+    const int width = 500;
+    std::vector<float> now(width), later(width);
+    noise.fractal_row_3d(0.0f, 10.0f, 3.0f, width, 0.01f, params, now.data());
+    noise.fractal_row_3d(0.0f, 10.0f, 3.01f, width, 0.01f, params, later.data());
+    float step = 0.0f, spread = 0.0f;
+    for (int i = 0; i < width; ++i) {
+        step = std::max(step, std::fabs(later[i] - now[i]));
+        spread = std::max(spread, std::fabs(now[i] - now[0]));
+    }
+    REQUIRE(step > 0.0f);
+    REQUIRE(step < 0.1f * spread);
+}
@@ -0,0 +1,119 @@
+// tests/test_procedural_generator.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/perlin_noise.h"
+#include "../include/generators/procedural_generator.h"
+#include "legacy_noise.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using cpp_engine::generators::FractalParams;
+using cpp_engine::generators::NoiseBackend;
+using cpp_engine::generators::PerlinNoise;
+using cpp_engine::generators::ProceduralGenerator;
+using cpp_engine::generators::ProceduralKind;
+using cpp_engine::generators::ProceduralOptions;
+
+namespace {
+
+cv::Mat render(ProceduralKind kind, int width, int height, unsigned int seed, int tile_size, int threads,
+               NoiseBackend noise = NoiseBackend::PERLIN) {
+    const int previous = cv::getNumThreads();
+    cv::setNumThreads(threads);
+    ProceduralOptions options;
+    options.tile_size = tile_size;
+    options.noise = noise;
+    cv::Mat image;
+    const bool ok = ProceduralGenerator(options).generate(kind, width, height, seed, image);
+    cv::setNumThreads(previous);
+    REQUIRE(ok);
+    return image;
+}
+
+} // namespace
+
+TEST_CASE("Tiled generation is bit-identical across thread counts and tile sizes", "[procedural]") {
+    const int width = 301, height = 187;  // partial tiles on both edges
+    for (ProceduralKind kind : {ProceduralKind::PERLIN, ProceduralKind::SILHOUETTE, ProceduralKind::METALLIC}) {
+        const cv::Mat reference = render(kind, width, height, 11, 256, 1);
+        REQUIRE(reference.rows == height);
+        REQUIRE(reference.cols == width);
+        REQUIRE(reference.type() == CV_8UC3);
+        for (int threads : {2, 4, 8}) {
+            REQUIRE(cv::norm(render(kind, width, height, 11, 64, threads), reference, cv::NORM_INF) == 0.0);
+        }
+        REQUIRE(cv::norm(render(kind, width, height, 11, 16, 3), reference, cv::NORM_INF) == 0.0);
+        REQUIRE(cv::norm(render(kind, width, height, 12, 64, 4), reference, cv::NORM_INF) > 0.0);
+    }
+}
+
+TEST_CASE("Perlin and silhouette match the single-threaded generators", "[procedural]") {
+    const int width = 160, height = 120;
+    const unsigned int seed = 3;
+
+    // Perlin: gray fBm, within one level of the double-precision original
+    const cv::Mat perlin = render(ProceduralKind::PERLIN, width, height, seed, 64, 4);
+    legacy::PerlinNoise reference(seed);
+    const double scale = 0.01f;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const cv::Vec3b p = perlin.at<cv::Vec3b>(y, x);
+            const int expected = static_cast<int>((reference.fractal(x * scale, y * scale, 4, 0.5, 2.0) + 1.0) / 2.0 * 255.0);
+            REQUIRE(std::abs(p[0] - expected) <= 1);
+            REQUIRE(p[0] == p[1]);
+            REQUIRE(p[0] == p[2]);
+        }
+    }
+
+    // Silhouette: the former full-image Canny, colorize and dilate over the same base
+    PerlinNoise noise(seed);
+    const FractalParams params{5, 0.6f, 2.0f};
+    cv::Mat base(height, width, CV_8UC1), edges;
+    std::vector<float> row(width);
+    for (int y = 0; y < height; ++y) {
+        noise.fractal_row(0.0f, static_cast<float>(y), width, 0.015f, params, row.data());
+        for (int x = 0; x < width; ++x) base.at<uchar>(y, x) = static_cast<uchar>((row[x] + 1.0) / 2.0 * 255.0);
+    }
+    cv::Canny(base, edges, 50, 150);
+    cv::Mat expected = cv::Mat::zeros(height, width, CV_8UC3);
+    expected.setTo(cv::Scalar(255, 200, 50), edges);
+    cv::dilate(expected, expected, cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(3, 3)));
+    REQUIRE(cv::countNonZero(edges) > 0);
+    REQUIRE(cv::norm(render(ProceduralKind::SILHOUETTE, width, height, seed, 32, 4), expected, cv::NORM_INF) == 0.0);
+}
+
+TEST_CASE("The simplex backend tiles deterministically and differs from perlin", "[procedural]") {
+    const int width = 301, height = 187;
+    for (ProceduralKind kind : {ProceduralKind::PERLIN, ProceduralKind::SILHOUETTE, ProceduralKind::METALLIC}) {
+        const cv::Mat reference = render(kind, width, height, 11, 256, 1, NoiseBackend::SIMPLEX);
+        REQUIRE(cv::norm(render(kind, width, height, 11, 48, 4, NoiseBackend::SIMPLEX), reference, cv::NORM_INF) ==
+                0.0);
+        REQUIRE(cv::norm(render(kind, width, height, 11, 256, 1), reference, cv::NORM_INF) > 0.0);
+    }
+
+    NoiseBackend backend;
+    REQUIRE(ProceduralGenerator::parse_backend("simplex", backend));
+    REQUIRE(backend == NoiseBackend::SIMPLEX);
+    REQUIRE(ProceduralGenerator::parse_backend("perlin", backend));
+    REQUIRE(backend == NoiseBackend::PERLIN);
+    REQUIRE_FALSE(ProceduralGenerator::parse_backend("opensimplex", backend));
+    REQUIRE(std::string(ProceduralGenerator::backend_name(NoiseBackend::SIMPLEX)) == "simplex");
+}
+
+TEST_CASE("Procedural kinds parse from generator type names", "[procedural]") {
+    ProceduralKind kind;
+    REQUIRE(ProceduralGenerator::parse_kind("metallic", kind));
+    REQUIRE(kind == ProceduralKind::METALLIC);
+    REQUIRE(ProceduralGenerator::parse_kind("silhouette_video", kind));
+    REQUIRE(kind == ProceduralKind::SILHOUETTE);
+    REQUIRE_FALSE(ProceduralGenerator::parse_kind("_video", kind));
+    REQUIRE_FALSE(ProceduralGenerator::parse_kind("marble", kind));
+    REQUIRE(std::string(ProceduralGenerator::kind_name(ProceduralKind::PERLIN)) == "perlin");
+
+    cv::Mat image;
+    REQUIRE_FALSE(ProceduralGenerator().generate(ProceduralKind::PERLIN, 0, 10, 1, image));
+    REQUIRE(ProceduralGenerator(ProceduralOptions{100}).tile_count(250, 100) == 3);
+}
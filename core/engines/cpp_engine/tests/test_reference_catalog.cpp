@@ -0,0 +1,259 @@
+// tests/test_reference_catalog.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/reference_catalog.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using cpp_engine::generators::ReferenceCatalog;
+using cpp_engine::generators::ReferenceCatalogOptions;
+using cpp_engine::generators::ReferenceFormat;
+
+namespace {
+
+struct ScratchDir {
+    ScratchDir() {
+        path = (std::filesystem::temp_directory_path() /
+                ("cpp_engine_catalog_test_" + std::to_string(::getpid()))).string();
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(std::filesystem::path(path) / "cats");
+    }
+    ~ScratchDir() { std::filesystem::remove_all(path); }
+    std::string path;
+};
+
+// Horizontal ramp, rising or falling: opposite difference hashes
+cv::Mat ramp(int width, int height, bool rising) {
+    cv::Mat image(height, width, CV_8UC3);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const uchar v = static_cast<uchar>((rising ? x : width - 1 - x) * 255 / (width - 1));
+            image.at<cv::Vec3b>(y, x) = cv::Vec3b(v, v, v);
+        }
+    }
+    return image;
+}
+
+// Waits for the watcher to apply an event
+bool wait_for_count(ReferenceCatalog& catalog, const std::string& name, size_t count) {
+    for (int i = 0; i < 200; ++i) {
+        if (catalog.images(name)->size() == count) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("ReferenceCatalog indexes a folder with metadata and hashes", "[reference_catalog]") {
+    ScratchDir dir;
+    const std::string cats = dir.path + "/cats/";
+    REQUIRE(cv::imwrite(cats + "a.png", ramp(64, 48, true)));
+    REQUIRE(cv::imwrite(cats + "b.png", ramp(128, 96, true)));
+    REQUIRE(cv::imwrite(cats + "c.png", ramp(64, 48, false)));
+    REQUIRE(cv::imwrite(cats + "notes.txt", ramp(8, 8, true)));  // not a reference extension
+
+    ReferenceCatalogOptions options;
+    options.root = dir.path;
+    options.watch = false;
+    ReferenceCatalog catalog(options);
+    const ReferenceCatalog::Images images = catalog.images("cats");
+    REQUIRE(images->size() == 3);
+    REQUIRE((*images)[0].path == cats + "a.png");
+    REQUIRE((*images)[1].width == 128);
+    REQUIRE((*images)[1].height == 96);
+    REQUIRE((*images)[0].format == ReferenceFormat::PNG);
+    REQUIRE((*images)[0].bytes == std::filesystem::file_size(cats + "a.png"));
+    // A rescaled copy hashes alike, the mirrored ramp as far apart as it gets
+    REQUIRE(ReferenceCatalog::hamming((*images)[0].phash, (*images)[1].phash) <= 4);
+    REQUIRE(ReferenceCatalog::hamming((*images)[0].phash, (*images)[2].phash) >= 48);
+
+    REQUIRE(catalog.images("cats") == images);  // unchanged folder: same snapshot
+    REQUIRE(catalog.images("missing")->empty());
+    REQUIRE(catalog.stats().images_probed == 3);
+
+    // Unknown names and deleted folders leave no entry behind
+    for (int i = 0; i < 100; ++i) REQUIRE(catalog.images("missing" + std::to_string(i))->empty());
+    REQUIRE(catalog.stats().folders_tracked == 1);
+
+    // Names never leave the root: parents, absolute paths and nested paths are refused
+    const std::string outside = dir.path + "_outside";
+    std::filesystem::create_directories(outside);
+    REQUIRE(cv::imwrite(outside + "/x.png", ramp(16, 16, true)));
+    const std::string escapes[] = {"..", ".", "../" + std::filesystem::path(outside).filename().string(), outside,
+                                   "cats/../cats", "cats/", std::string("cats\0x", 6)};
+    for (const std::string& name : escapes) {
+        INFO(name);
+        REQUIRE(catalog.images(name)->empty());
+    }
+    REQUIRE(catalog.stats().folders_tracked == 1);
+    std::filesystem::remove_all(outside);
+    std::filesystem::remove_all(cats);
+    REQUIRE(catalog.images("cats")->empty());
+    REQUIRE(catalog.stats().folders_tracked == 0);
+}
+
+TEST_CASE("ReferenceCatalog reloads its index without probing unchanged folders", "[reference_catalog]") {
+    ScratchDir dir;
+    const std::string cats = dir.path + "/cats/";
+    REQUIRE(cv::imwrite(cats + "a.png", ramp(64, 48, true)));
+    REQUIRE(cv::imwrite(cats + "b.png", ramp(64, 48, false)));
+    ReferenceCatalogOptions options;
+    options.root = dir.path;
+    options.watch = false;
+    uint64_t hash = 0;
+    {
+        ReferenceCatalog catalog(options);
+        REQUIRE(catalog.images("cats")->size() == 2);
+        hash = catalog.images("cats")->front().phash;
+    }
+    REQUIRE(std::filesystem::exists(dir.path + "/.reference_index"));
+
+    {
+        ReferenceCatalog catalog(options);
+        REQUIRE(catalog.stats().folders_loaded == 1);
+        REQUIRE(catalog.images("cats")->size() == 2);
+        REQUIRE(catalog.images("cats")->front().phash == hash);
+        REQUIRE(catalog.stats().folders_scanned == 0);
+        REQUIRE(catalog.stats().images_probed == 0);
+    }
+
+    // A new file moves the folder's mtime: rescanned, but only the new file is probed
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(cv::imwrite(cats + "c.png", ramp(32, 32, true)));
+    ReferenceCatalog catalog(options);
+    REQUIRE(catalog.images("cats")->size() == 3);
+    REQUIRE(catalog.stats().folders_scanned == 1);
+    REQUIRE(catalog.stats().images_probed == 1);
+}
+
+TEST_CASE("ReferenceCatalog follows a watched folder", "[reference_catalog]") {
+    ScratchDir dir;
+    const std::string cats = dir.path + "/cats/";
+    REQUIRE(cv::imwrite(cats + "a.png", ramp(64, 48, true)));
+    ReferenceCatalogOptions options;
+    options.root = dir.path;
+    ReferenceCatalog catalog(options);
+    REQUIRE(catalog.images("cats")->size() == 1);
+
+    REQUIRE(cv::imwrite(cats + "b.png", ramp(80, 60, false)));
+    REQUIRE(wait_for_count(catalog, "cats", 2));
+    REQUIRE(catalog.images("cats")->back().width == 80);
+
+    // Written elsewhere and moved in, as downloaders do
+    REQUIRE(cv::imwrite(dir.path + "/c.png", ramp(32, 32, true)));
+    std::filesystem::rename(dir.path + "/c.png", cats + "c.png");
+    REQUIRE(wait_for_count(catalog, "cats", 3));
+
+    std::filesystem::remove(cats + "a.png");
+    REQUIRE(wait_for_count(catalog, "cats", 2));
+    REQUIRE(catalog.images("cats")->front().path == cats + "b.png");
+    REQUIRE(catalog.stats().events >= 3);
+}
+
+TEST_CASE("ReferenceCatalog saves watched changes without being destroyed", "[reference_catalog]") {
+    ScratchDir dir;
+    const std::string cats = dir.path + "/cats/";
+    REQUIRE(cv::imwrite(cats + "a.png", ramp(64, 48, true)));
+    ReferenceCatalogOptions options;
+    options.root = dir.path;
+    options.save_delay_ms = 50;
+    ReferenceCatalog catalog(options);
+    REQUIRE(catalog.images("cats")->size() == 1);
+    REQUIRE(cv::imwrite(cats + "b.png", ramp(80, 60, false)));
+    REQUIRE(wait_for_count(catalog, "cats", 2));
+
+    // A copy of the index, read by a catalog that does not write back to the watched one's file
+    const std::string index = dir.path + "/.reference_index";
+    const std::string copy = dir.path + "/index_copy";
+    ReferenceCatalogOptions reader;
+    reader.root = dir.path;
+    reader.index_path = copy;
+    reader.watch = false;
+    bool saved = false;
+    for (int i = 0; i < 200 && !saved; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::filesystem::copy_file(index, copy, std::filesystem::copy_options::overwrite_existing);
+        ReferenceCatalog loaded(reader);
+        saved = loaded.images("cats")->size() == 2 && loaded.stats().folders_scanned == 0;
+    }
+    REQUIRE(saved);
+}
+
+TEST_CASE("ReferenceCatalog lookups race watch events safely", "[reference_catalog]") {
+    ScratchDir dir;
+    const std::string cats = dir.path + "/cats/";
+    const std::string dogs = dir.path + "/dogs/";
+    std::filesystem::create_directories(dogs);
+    ReferenceCatalogOptions options;
+    options.root = dir.path;
+    options.save_delay_ms = 10;
+    ReferenceCatalog catalog(options);
+
+    std::atomic<bool> done{false}, unsorted{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t]() {
+            while (!done) {
+                const auto images = catalog.images(t % 2 ? "cats" : "dogs");
+                for (size_t i = 1; i < images->size(); ++i) {
+                    if (!((*images)[i - 1].path < (*images)[i].path)) unsorted = true;
+                }
+                catalog.images("missing");
+            }
+        });
+    }
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(cv::imwrite(cats + std::to_string(i) + ".png", ramp(32 + i, 24, i % 2 == 0)));
+        REQUIRE(cv::imwrite(dogs + std::to_string(i) + ".png", ramp(24, 32 + i, i % 2 == 1)));
+    }
+    REQUIRE(wait_for_count(catalog, "cats", 10));
+    REQUIRE(wait_for_count(catalog, "dogs", 10));
+    done = true;
+    for (auto& reader : readers) reader.join();
+    REQUIRE_FALSE(unsorted.load());
+    REQUIRE(catalog.stats().folders_tracked == 2);
+}
+
+TEST_CASE("ReferenceCatalog keeps a first scan that raced watch events", "[reference_catalog]") {
+    ScratchDir dir;
+    const std::string cats = dir.path + "/cats/";
+    const int prefilled = 400;
+    for (int i = 0; i < prefilled; ++i) REQUIRE(cv::imwrite(cats + "p" + std::to_string(i) + ".png", ramp(16, 12, i % 2 == 0)));
+    ReferenceCatalogOptions options;
+    options.root = dir.path;
+    options.save_delay_ms = 10;
+    ReferenceCatalog catalog(options);
+
+    // Files keep landing while the first lookup lists and probes the folder
+    std::atomic<bool> scanned{false};
+    size_t first = 0;
+    std::thread lookup([&]() {
+        first = catalog.images("cats")->size();
+        scanned = true;
+    });
+    int written = 0;
+    while (!scanned && written < 200) {
+        REQUIRE(cv::imwrite(cats + "w" + std::to_string(written++) + ".png", ramp(16, 12, true)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    lookup.join();
+    REQUIRE(first >= static_cast<size_t>(prefilled));
+    const size_t total = static_cast<size_t>(prefilled + written);
+    REQUIRE(wait_for_count(catalog, "cats", total));
+
+    // What is persisted is the full folder too
+    REQUIRE(catalog.save());
+    ReferenceCatalogOptions reader = options;
+    reader.watch = false;
+    ReferenceCatalog loaded(reader);
+    REQUIRE(loaded.images("cats")->size() == total);
+}
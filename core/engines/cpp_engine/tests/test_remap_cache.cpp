@@ -0,0 +1,62 @@
+// tests/test_remap_cache.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/effects/effects_engine.h"
+#include "../include/effects/remap_cache.h"
+#include "legacy_effects.h"
+
+#include <opencv2/opencv.hpp>
+
+using cppengine::effects::EffectsEngine;
+using cppengine::effects::RemapCache;
+using cppengine::effects::RemapInterpolation;
+using cppengine::effects::RemapTable;
+
+namespace {
+
+cv::Mat random_image(int rows, int cols) {
+    cv::Mat image(rows, cols, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    return image;
+}
+
+} // namespace
+
+TEST_CASE("Cached wave and radial tables reproduce the per-pixel distortions", "[remap]") {
+    EffectsEngine engine;
+    const cv::Mat image = random_image(73, 129);
+    for (int frame = 0; frame < 2; ++frame) {  // table built, then reused
+        cv::Mat wave, radial;
+        REQUIRE(engine.apply_wave_distortion(image, wave, 9.5f, 2.0f));
+        REQUIRE(cv::norm(wave, legacy::wave_distortion(image, 9.5f, 2.0f), cv::NORM_INF) == 0.0);
+        REQUIRE(engine.apply_radial_distortion(image, radial, 0.4f));
+        REQUIRE(cv::norm(radial, legacy::radial_distortion(image, 0.4f), cv::NORM_INF) == 0.0);
+    }
+}
+
+TEST_CASE("Bilinear remap of an identity table copies the image", "[remap]") {
+    const cv::Mat image = random_image(31, 45);
+    for (auto interpolation : {RemapInterpolation::NEAREST, RemapInterpolation::BILINEAR}) {
+        auto table = RemapTable::wave(image.rows, image.cols, 0.0f, 1.0f, interpolation);
+        cv::Mat result(image.size(), image.type());
+        table->apply(image.data, result.data, 3, 0, image.rows);
+        REQUIRE(cv::norm(result, image, cv::NORM_INF) == 0.0);
+    }
+}
+
+TEST_CASE("Remap cache hits on repeated parameters and stays within its budget", "[remap]") {
+    const size_t table_bytes = 64 * 64 * sizeof(int32_t) + 64;  // nearest 64x64: index + per-row flag
+    RemapCache cache(3 * table_bytes);
+    auto first = cache.wave(64, 64, 3.0f, 1.0f, RemapInterpolation::NEAREST);
+    REQUIRE(cache.wave(64, 64, 3.0f, 1.0f, RemapInterpolation::NEAREST) == first);
+    REQUIRE(cache.wave(64, 64, 3.0f, 1.0f, RemapInterpolation::BILINEAR) != first);
+    REQUIRE(cache.stats().hits == 1);
+    REQUIRE(cache.stats().misses == 2);
+
+    for (int i = 0; i < 6; ++i) cache.radial(64, 64, 0.1f * i, RemapInterpolation::NEAREST);
+    const auto stats = cache.stats();
+    REQUIRE(stats.bytes <= 3 * table_bytes);
+    REQUIRE(stats.entries == 3);
+    REQUIRE(stats.evictions > 0);
+    // Evicted tables stay valid for holders
+    REQUIRE(first->index.size() == 64u * 64u);
+}
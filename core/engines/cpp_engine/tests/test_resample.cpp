@@ -0,0 +1,130 @@
+// tests/test_resample.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/filters/resample.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+using cppengine::filters::Resampler;
+using cppengine::filters::ResizeKernel;
+
+TEST_CASE("Resampler keeps flat images flat", "[resample]") {
+    Resampler resampler;
+    std::mt19937 rng(3);
+    for (int iter = 0; iter < 100; ++iter) {
+        const int src_rows = 1 + rng() % 80, src_cols = 1 + rng() % 80;
+        const int dst_rows = 1 + rng() % 80, dst_cols = 1 + rng() % 80;
+        const int cn = 1 + rng() % 4;
+        const ResizeKernel kernel = iter % 2 ? ResizeKernel::AREA : ResizeKernel::LANCZOS3;
+        std::vector<uint8_t> src(src_rows * src_cols * cn, 201), dst(dst_rows * dst_cols * cn, 0);
+        resampler.resize(src.data(), src_cols * cn, src_rows, src_cols,
+                         dst.data(), dst_cols * cn, dst_rows, dst_cols, cn, kernel);
+        for (uint8_t v : dst) REQUIRE(v == 201);
+    }
+}
+
+TEST_CASE("Area halving averages 2x2 blocks", "[resample]") {
+    const int rows = 48, cols = 38, cn = 3;
+    std::mt19937 rng(11);
+    std::vector<uint8_t> src(rows * cols * cn), dst((rows / 2) * (cols / 2) * cn);
+    for (auto& v : src) v = static_cast<uint8_t>(rng());
+
+    Resampler resampler;
+    resampler.resize(src.data(), cols * cn, rows, cols, dst.data(), (cols / 2) * cn, rows / 2, cols / 2, cn,
+                     ResizeKernel::AREA);
+    for (int y = 0; y < rows / 2; ++y) {
+        for (int x = 0; x < cols / 2; ++x) {
+            for (int c = 0; c < cn; ++c) {
+                int sum = 0;
+                for (int dy = 0; dy < 2; ++dy)
+                    for (int dx = 0; dx < 2; ++dx) sum += src[((2 * y + dy) * cols + 2 * x + dx) * cn + c];
+                // One rounding per pass
+                REQUIRE(std::abs(static_cast<int>(std::lround(sum / 4.0)) - dst[(y * (cols / 2) + x) * cn + c]) <= 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("Every channel layout resamples a channel identically", "[resample]") {
+    // 1, 3 and 4 channels take the SIMD horizontal paths, 2 the scalar one: all must agree exactly
+    std::mt19937 rng(5);
+    Resampler resampler;
+    for (int iter = 0; iter < 40; ++iter) {
+        const int src_rows = 1 + rng() % 70, src_cols = 1 + rng() % 90;
+        const int dst_rows = 1 + rng() % 70, dst_cols = 1 + rng() % 90;
+        const ResizeKernel kernel = iter % 2 ? ResizeKernel::AREA : ResizeKernel::LANCZOS3;
+        std::vector<uint8_t> rgba(static_cast<size_t>(src_rows) * src_cols * 4);
+        for (auto& v : rgba) v = static_cast<uint8_t>(rng());
+
+        auto resized = [&](int cn) {
+            std::vector<uint8_t> src(static_cast<size_t>(src_rows) * src_cols * cn);
+            for (size_t p = 0; p < static_cast<size_t>(src_rows) * src_cols; ++p) {
+                for (int c = 0; c < cn; ++c) src[p * cn + c] = rgba[p * 4 + c];
+            }
+            std::vector<uint8_t> dst(static_cast<size_t>(dst_rows) * dst_cols * cn);
+            resampler.resize(src.data(), src_cols * cn, src_rows, src_cols,
+                             dst.data(), dst_cols * cn, dst_rows, dst_cols, cn, kernel);
+            return dst;
+        };
+        const std::vector<uint8_t> four = resized(4);
+        for (int cn : {1, 2, 3}) {
+            const std::vector<uint8_t> fewer = resized(cn);
+            for (size_t p = 0; p < static_cast<size_t>(dst_rows) * dst_cols; ++p) {
+                for (int c = 0; c < cn; ++c) REQUIRE(fewer[p * cn + c] == four[p * 4 + c]);
+            }
+        }
+    }
+}
+
+TEST_CASE("JPEG size and DCT scale selection", "[resample]") {
+    const uint8_t header[] = {0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x04, 0x00, 0x00,
+                              0xFF, 0xC0, 0x00, 0x11, 0x08, 0x0F, 0xA0, 0x17, 0x70, 0x03};
+    int width = 0, height = 0;
+    REQUIRE(cppengine::filters::read_jpeg_size(header, sizeof(header), width, height));
+    REQUIRE(width == 6000);
+    REQUIRE(height == 4000);
+
+    const uint8_t png[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+    REQUIRE_FALSE(cppengine::filters::read_jpeg_size(png, sizeof(png), width, height));
+
+    REQUIRE(cppengine::filters::reduced_decode_factor(6000, 4000, 512, 341) == 8);
+    REQUIRE(cppengine::filters::reduced_decode_factor(6000, 4000, 1024, 683) == 4);
+    REQUIRE(cppengine::filters::reduced_decode_factor(6000, 4000, 4000, 2667) == 1);
+}
+
+TEST_CASE("JPEG EXIF orientation", "[resample]") {
+    // SOI, APP1 "Exif" with a one-entry IFD0 (Orientation = 6), SOF0 of 6000x4000
+    const uint8_t little[] = {0xFF, 0xD8, 0xFF, 0xE1, 0x00, 0x22, 'E', 'x', 'i', 'f', 0, 0,
+                              'I', 'I', 42, 0, 8, 0, 0, 0,
+                              1, 0, 0x12, 0x01, 3, 0, 1, 0, 0, 0, 6, 0, 0, 0,
+                              0, 0, 0, 0,
+                              0xFF, 0xC0, 0x00, 0x11, 0x08, 0x0F, 0xA0, 0x17, 0x70, 0x03};
+    REQUIRE(cppengine::filters::read_jpeg_orientation(little, sizeof(little)) == 6);
+    int width = 0, height = 0;
+    REQUIRE(cppengine::filters::read_jpeg_size(little, sizeof(little), width, height));
+    REQUIRE(width == 6000);
+    REQUIRE(height == 4000);
+
+    // Big-endian TIFF, Orientation = 3 (rotated 180: not transposed)
+    const uint8_t big[] = {0xFF, 0xD8, 0xFF, 0xE1, 0x00, 0x22, 'E', 'x', 'i', 'f', 0, 0,
+                           'M', 'M', 0, 42, 0, 0, 0, 8,
+                           0, 1, 0x01, 0x12, 0, 3, 0, 0, 0, 1, 0, 3, 0, 0,
+                           0, 0, 0, 0,
+                           0xFF, 0xC0, 0x00, 0x11, 0x08, 0x0F, 0xA0, 0x17, 0x70, 0x03};
+    REQUIRE(cppengine::filters::read_jpeg_orientation(big, sizeof(big)) == 3);
+
+    // No Exif, a truncated IFD, or not a JPEG: upright
+    const uint8_t plain[] = {0xFF, 0xD8, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x0F, 0xA0, 0x17, 0x70, 0x03};
+    REQUIRE(cppengine::filters::read_jpeg_orientation(plain, sizeof(plain)) == 1);
+    REQUIRE(cppengine::filters::read_jpeg_orientation(little, 30) == 1);
+    const uint8_t png[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+    REQUIRE(cppengine::filters::read_jpeg_orientation(png, sizeof(png)) == 1);
+
+    // A 4000x6000 portrait stored transposed decodes 4000 wide: only 1/4 still covers 1000x1500
+    std::swap(width, height);
+    REQUIRE(cppengine::filters::reduced_decode_factor(width, height, 1000, 1500) == 4);
+    REQUIRE(cppengine::filters::reduced_decode_factor(height, width, 1000, 1500) == 2);
+}
@@ -0,0 +1,99 @@
+// tests/test_simplex_noise.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/simplex_noise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using cpp_engine::generators::FractalParams;
+using cpp_engine::generators::SimplexNoise;
+
+TEST_CASE("Simplex rows match the point API in 2D, 3D and 4D", "[noise]") {
+    const int width = 203;  // every vector width plus a scalar tail
+    const float scale = 0.013f, z = 1.7f, w = -0.6f;
+    std::vector<float> row(width), dx(width), dy(width);
+    for (unsigned int seed : {0u, 42u}) {
+        const SimplexNoise noise(seed);
+        for (int octaves : {1, 5}) {
+            FractalParams params;
+            params.octaves = octaves;
+            for (float x0 : {0.0f, -37.5f}) {
+                for (float y : {0.0f, 91.0f, -250.25f}) {
+                    noise.fractal_row(x0, y, width, scale, params, row.data());
+                    for (int i = 0; i < width; ++i) {
+                        REQUIRE(std::fabs(row[i] - noise.fractal((x0 + i) * scale, y * scale, params)) < 1e-4f);
+                    }
+                    noise.fractal_row_3d(x0, y, z, width, scale, params, row.data(), dx.data(), dy.data());
+                    for (int i = 0; i < width; ++i) {
+                        REQUIRE(std::fabs(row[i] - noise.fractal3((x0 + i) * scale, y * scale, z, params)) < 1e-4f);
+                    }
+                    noise.fractal_row_4d(x0, y, z, w, width, scale, params, row.data());
+                    for (int i = 0; i < width; ++i) {
+                        REQUIRE(std::fabs(row[i] - noise.fractal4((x0 + i) * scale, y * scale, z, w, params)) <
+                                1e-4f);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Simplex gradients match central differences", "[noise]") {
+    const SimplexNoise noise(3);
+    FractalParams params;
+    params.octaves = 4;
+    const float scale = 0.02f, e = 0.05f, z = 0.3f, w = 2.2f;
+    const int width = 203;
+    std::vector<float> value(width), dx(width), dy(width);
+    std::vector<float> xp(width), xm(width), yp(width), ym(width);
+    auto check = [&](auto row) {
+        row(0.0f, 40.0f, value.data(), dx.data(), dy.data());
+        row(e, 40.0f, xp.data(), nullptr, nullptr);
+        row(-e, 40.0f, xm.data(), nullptr, nullptr);
+        row(0.0f, 40.0f + e, yp.data(), nullptr, nullptr);
+        row(0.0f, 40.0f - e, ym.data(), nullptr, nullptr);
+        float max_slope = 0.0f;
+        for (int i = 0; i < width; ++i) max_slope = std::max({max_slope, std::fabs(dx[i]), std::fabs(dy[i])});
+        REQUIRE(max_slope > 0.0f);
+        for (int i = 0; i < width; ++i) {
+            REQUIRE(std::fabs(dx[i] - (xp[i] - xm[i]) / (2 * e)) < 0.02f * max_slope);
+            REQUIRE(std::fabs(dy[i] - (yp[i] - ym[i]) / (2 * e)) < 0.02f * max_slope);
+        }
+    };
+    check([&](float x0, float y, float* out, float* gx, float* gy) {
+        noise.fractal_row(x0, y, width, scale, params, out, gx, gy);
+    });
+    check([&](float x0, float y, float* out, float* gx, float* gy) {
+        noise.fractal_row_3d(x0, y, z, width, scale, params, out, gx, gy);
+    });
+    check([&](float x0, float y, float* out, float* gx, float* gy) {
+        noise.fractal_row_4d(x0, y, z, w, width, scale, params, out, gx, gy);
+    });
+}
+
+TEST_CASE("Simplex noise stays in range and is continuous", "[noise]") {
+    const SimplexNoise noise(11);
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> coordinate(-300.0f, 300.0f);
+    const float e = 1e-3f;
+    float lowest = 0.0f, highest = 0.0f, steepest = 0.0f;
+    for (int k = 0; k < 200000; ++k) {
+        const float x = coordinate(gen), y = coordinate(gen), z = coordinate(gen), w = coordinate(gen);
+        const float values[3] = {noise.noise(x, y), noise.noise3(x, y, z), noise.noise4(x, y, z, w)};
+        for (float v : values) {
+            lowest = std::min(lowest, v);
+            highest = std::max(highest, v);
+        }
+        // A step at a simplex face would show up as a jump far beyond the slope bound
+        steepest = std::max({steepest, std::fabs(noise.noise(x + e, y) - values[0]) / e,
+                             std::fabs(noise.noise3(x + e, y, z) - values[1]) / e,
+                             std::fabs(noise.noise4(x + e, y, z, w) - values[2]) / e});
+    }
+    REQUIRE(lowest >= -1.01f);
+    REQUIRE(highest <= 1.01f);
+    REQUIRE(lowest < -0.7f);
+    REQUIRE(highest > 0.7f);
+    REQUIRE(steepest < 10.0f);
+}
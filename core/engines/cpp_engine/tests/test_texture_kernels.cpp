@@ -0,0 +1,82 @@
+// tests/test_texture_kernels.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/perlin_noise.h"
+#include "../include/generators/texture_kernels.h"
+#include "legacy_noise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using cpp_engine::generators::FractalParams;
+using cpp_engine::generators::MetallicParams;
+using cpp_engine::generators::PerlinNoise;
+using cpp_engine::generators::kernels::metallic_row;
+
+namespace {
+
+std::vector<uint8_t> metallic_image(const PerlinNoise& noise, int width, int height, int tile) {
+    const MetallicParams params;
+    std::vector<uint8_t> image(static_cast<size_t>(width) * height * 3);
+    std::vector<float> scratch(3 * static_cast<size_t>(width));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; x += tile) {
+            const int x_end = std::min(width, x + tile);
+            metallic_row(noise, params, y, x, x_end, width, height, &image[(static_cast<size_t>(y) * width + x) * 3],
+                         scratch.data());
+        }
+    }
+    return image;
+}
+
+double mean(const std::vector<uint8_t>& image) {
+    double sum = 0.0;
+    for (uint8_t v : image) sum += v;
+    return sum / image.size();
+}
+
+} // namespace
+
+TEST_CASE("Analytic gradient matches the values and central differences", "[noise]") {
+    PerlinNoise noise(42);
+    FractalParams params;
+    params.octaves = 5;
+    const float scale = 0.02f, e = 0.05f;
+    const int width = 203;  // every vector width plus a scalar tail
+    std::vector<float> value(width), dx(width), dy(width), plain(width);
+    std::vector<float> xp(width), xm(width), yp(width), ym(width);
+    for (float y : {0.0f, 17.0f, 333.5f}) {
+        noise.fractal_row_gradient(0.0f, y, width, scale, params, value.data(), dx.data(), dy.data());
+        noise.fractal_row(0.0f, y, width, scale, params, plain.data());
+        noise.fractal_row(e, y, width, scale, params, xp.data());
+        noise.fractal_row(-e, y, width, scale, params, xm.data());
+        noise.fractal_row(0.0f, y + e, width, scale, params, yp.data());
+        noise.fractal_row(0.0f, y - e, width, scale, params, ym.data());
+        float max_slope = 0.0f;
+        for (int i = 0; i < width; ++i) max_slope = std::max({max_slope, std::fabs(dx[i]), std::fabs(dy[i])});
+        REQUIRE(max_slope > 0.0f);
+        for (int i = 0; i < width; ++i) {
+            REQUIRE(value[i] == plain[i]);
+            REQUIRE(std::fabs(dx[i] - (xp[i] - xm[i]) / (2 * e)) < 0.02f * max_slope);
+            REQUIRE(std::fabs(dy[i] - (yp[i] - ym[i]) / (2 * e)) < 0.02f * max_slope);
+        }
+    }
+}
+
+TEST_CASE("Metallic rows are the same in tiles and keep the old brightness", "[noise]") {
+    const int width = 257, height = 140;
+    PerlinNoise noise(5);
+    const std::vector<uint8_t> whole = metallic_image(noise, width, height, width);
+    REQUIRE(metallic_image(noise, width, height, 37) == whole);
+    REQUIRE(metallic_image(PerlinNoise(6), width, height, width) != whole);
+
+    // Same overall level as the three-evaluation generator, with the centre highlight on top
+    REQUIRE(std::fabs(mean(whole) - mean(legacy::metallic(width, height, 5))) < 15.0);
+    const size_t centre = (static_cast<size_t>(height / 2) * width + width / 2) * 3;
+    REQUIRE(whole[centre] > mean(whole) + 60.0);
+    for (size_t i = 0; i < whole.size(); i += 3) {
+        REQUIRE(whole[i] == whole[i + 1]);
+        REQUIRE(whole[i] == whole[i + 2]);
+    }
+}
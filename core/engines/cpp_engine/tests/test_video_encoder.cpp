@@ -0,0 +1,81 @@
+// tests/test_video_encoder.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/generators/video_encoder.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+using cpp_engine::generators::VideoEncoder;
+using cpp_engine::generators::VideoEncoderOptions;
+
+namespace {
+
+std::string temp_video(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+cv::Mat gradient_frame(int width, int height, int index) {
+    cv::Mat frame(height, width, CV_8UC3);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            frame.at<cv::Vec3b>(y, x) = cv::Vec3b(static_cast<uchar>(x * 4 + index), static_cast<uchar>(y * 4),
+                                                  static_cast<uchar>(index * 16));
+        }
+    }
+    return frame;
+}
+
+} // namespace
+
+TEST_CASE("VideoEncoder writes every queued frame in order", "[video_encoder]") {
+    const std::string path = temp_video("test_video_encoder.avi");
+    VideoEncoderOptions options;
+    options.codec = "mjpeg";  // built into OpenCV and libavcodec alike
+    options.queue_frames = 2;  // a fast producer blocks instead of piling frames up
+    VideoEncoder encoder;
+    REQUIRE(encoder.open(path, 64, 48, 25.0, options));
+    REQUIRE(encoder.is_open());
+    REQUIRE(encoder.backend() != VideoEncoder::Backend::NONE);
+    if (VideoEncoder::libavcodec_available()) REQUIRE(encoder.backend() == VideoEncoder::Backend::LIBAVCODEC);
+    for (int i = 0; i < 12; ++i) REQUIRE(encoder.write(gradient_frame(64, 48, i)));
+    REQUIRE(encoder.close());
+    REQUIRE_FALSE(encoder.is_open());
+    const VideoEncoder::Stats stats = encoder.stats();
+    REQUIRE(stats.frames == 12);
+    REQUIRE(stats.peak_queued <= 2);
+
+    cv::VideoCapture capture(path);
+    REQUIRE(capture.isOpened());
+    cv::Mat frame;
+    int frames = 0;
+    for (; capture.read(frame); ++frames) {
+        REQUIRE(frame.cols == 64);
+        REQUIRE(frame.rows == 48);
+        // Red steps with the frame index: order kept through the queue (within JPEG error)
+        REQUIRE(std::abs(frame.at<cv::Vec3b>(24, 32)[2] - frames * 16) <= 8);
+    }
+    REQUIRE(frames == 12);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("VideoEncoder rejects bad sizes and frames", "[video_encoder]") {
+    const std::string path = temp_video("test_video_encoder_bad.avi");
+    VideoEncoderOptions options;
+    options.codec = "mjpeg";
+    VideoEncoder encoder;
+    REQUIRE_FALSE(encoder.open(path, 0, 48, 25.0, options));
+    REQUIRE_FALSE(encoder.open(path, 64, 48, 0.0, options));
+    REQUIRE_FALSE(encoder.write(gradient_frame(64, 48, 0)));  // not open
+
+    REQUIRE(encoder.open(path, 64, 48, 25.0, options));
+    REQUIRE_FALSE(encoder.write(gradient_frame(32, 48, 0)));
+    REQUIRE_FALSE(encoder.write(cv::Mat(48, 64, CV_8UC1, cv::Scalar(0))));
+    REQUIRE(encoder.write(gradient_frame(64, 48, 0)));
+    REQUIRE(encoder.close());
+    REQUIRE(encoder.stats().frames == 1);
+    REQUIRE(encoder.close());  // idempotent
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,152 @@
+// tests/test_video_pipeline.cpp
+#include <catch2/catch_all.hpp>
+#include "../include/optimization/video_pipeline.h"
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using cppengine::optimization::VideoPipeline;
+
+namespace {
+
+// Frames carry their sequence number in every pixel
+VideoPipeline::Source counting_source(int frames, std::atomic<int>* decoded = nullptr) {
+    return [frames, decoded](VideoPipeline::Frame& frame) {
+        if (frame.sequence >= frames) return false;
+        frame.image = cv::Mat(8, 8, CV_8UC1, cv::Scalar(static_cast<double>(frame.sequence % 256)));
+        if (decoded) ++*decoded;
+        return true;
+    };
+}
+
+// Copies the frame after a random delay, so frames finish out of order
+VideoPipeline::TransformFactory jittered_copy() {
+    return []() -> VideoPipeline::Transform {
+        auto rng = std::make_shared<std::mt19937>(std::random_device{}());
+        return [rng](VideoPipeline::Frame& frame, cv::Mat& out) {
+            std::this_thread::sleep_for(std::chrono::microseconds((*rng)() % 2000));
+            frame.image.copyTo(out);
+            return true;
+        };
+    };
+}
+
+} // namespace
+
+TEST_CASE("VideoPipeline delivers every frame in sequence order", "[video_pipeline]") {
+    VideoPipeline::Config config;
+    config.transform_threads = 4;
+    config.ring_frames = 6;
+    VideoPipeline pipeline(config);
+
+    std::vector<int64_t> order;
+    bool pixels_match = true;
+    const auto stats = pipeline.run(counting_source(100), jittered_copy(), [&](int64_t sequence, const cv::Mat& frame) {
+        order.push_back(sequence);
+        pixels_match = pixels_match && frame.at<uchar>(0, 0) == static_cast<uchar>(sequence % 256);
+        return true;
+    });
+
+    REQUIRE(stats.ok);
+    CHECK(stats.frames == 100);
+    REQUIRE(order.size() == 100);
+    for (int64_t i = 0; i < 100; ++i) CHECK(order[static_cast<size_t>(i)] == i);
+    CHECK(pixels_match);
+    CHECK(stats.peak_reorder <= config.ring_frames);
+}
+
+TEST_CASE("VideoPipeline keeps the decoder within the ring of the sink", "[video_pipeline]") {
+    VideoPipeline::Config config;
+    config.transform_threads = 3;
+    config.ring_frames = 4;
+    VideoPipeline pipeline(config);
+
+    std::atomic<int> decoded{0};
+    int max_ahead = 0;
+    const auto stats = pipeline.run(counting_source(40, &decoded), jittered_copy(), [&](int64_t sequence, const cv::Mat&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));  // slow sink: the decoder must wait
+        max_ahead = std::max(max_ahead, decoded.load() - static_cast<int>(sequence));
+        return true;
+    });
+
+    REQUIRE(stats.ok);
+    CHECK(stats.frames == 40);
+    CHECK(max_ahead <= static_cast<int>(config.ring_frames));
+}
+
+TEST_CASE("VideoPipeline passes per-frame context to the transform", "[video_pipeline]") {
+    VideoPipeline::Config config;
+    config.transform_threads = 2;
+    VideoPipeline pipeline(config);
+
+    const auto stats = pipeline.run(
+        [](VideoPipeline::Frame& frame) {
+            if (frame.sequence >= 20) return false;
+            frame.image = cv::Mat(4, 4, CV_8UC1, cv::Scalar(0));
+            frame.context = static_cast<int>(frame.sequence * 3);
+            return true;
+        },
+        []() -> VideoPipeline::Transform {
+            return [](VideoPipeline::Frame& frame, cv::Mat& out) {
+                const int* value = std::any_cast<int>(&frame.context);
+                if (!value) return false;
+                out.setTo(cv::Scalar(*value));
+                return true;
+            };
+        },
+        [](int64_t sequence, const cv::Mat& frame) { return frame.at<uchar>(0, 0) == sequence * 3; });
+
+    CHECK(stats.ok);
+    CHECK(stats.frames == 20);
+}
+
+TEST_CASE("VideoPipeline stops on a failing stage", "[video_pipeline]") {
+    VideoPipeline::Config config;
+    config.transform_threads = 2;
+    config.ring_frames = 4;
+    VideoPipeline pipeline(config);
+
+    SECTION("transform") {
+        const auto stats = pipeline.run(
+            counting_source(1000),
+            []() -> VideoPipeline::Transform {
+                return [](VideoPipeline::Frame& frame, cv::Mat& out) {
+                    if (frame.sequence == 10) return false;
+                    frame.image.copyTo(out);
+                    return true;
+                };
+            },
+            [](int64_t, const cv::Mat&) { return true; });
+        CHECK_FALSE(stats.ok);
+        CHECK(stats.frames <= 10);
+    }
+
+    SECTION("sink") {
+        std::atomic<int> decoded{0};
+        const auto stats = pipeline.run(counting_source(1000, &decoded), jittered_copy(),
+                                        [](int64_t sequence, const cv::Mat&) { return sequence < 5; });
+        CHECK_FALSE(stats.ok);
+        CHECK(stats.frames == 5);
+        CHECK(decoded.load() < 1000);
+    }
+
+    SECTION("source") {
+        const auto stats = pipeline.run(
+            [](VideoPipeline::Frame& frame) -> bool {
+                if (frame.sequence == 3) throw std::runtime_error("corrupt packet");
+                frame.image = cv::Mat(4, 4, CV_8UC1, cv::Scalar(1));
+                return true;
+            },
+            jittered_copy(), [](int64_t, const cv::Mat&) { return true; });
+        CHECK_FALSE(stats.ok);
+    }
+}